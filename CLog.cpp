@@ -20,7 +20,7 @@ CLog::CLog(
     const char* pszFile,
     const char* pszFunction)
 {
-    strcpy(m_szFQFS, gpSh->m_pShMemng->szLogFQDS);
+    strcpy(m_szFQFS, gpShMemCfg->get(SHM_STR_LOG_FQDS).c_str());
     strcat(m_szFQFS, gpOS->file2filenamesansext(pszFile).c_str());
     strcat(m_szFQFS, "::");
     strcat(m_szFQFS, pszFunction);
@@ -25,14 +25,71 @@ CVpaRpc::CVpaRpc(std::string ssServer, std::string ssService)
 
     m_ssSvr = ssServer;
     m_ssSvc = ssService;
+    m_bBatch = false;
+    m_bPipelined = false;
 
-    m_vparpc_request_auth.eVersion = VPARPC_VERSION_1;
-    m_vparpc_request_auth.nSize = sizeof(m_vparpc_request_auth);
-    m_vparpc_request_auth.eFunc = VPARPC_FUNC_GET_AUTH;
+    vparpc_idl<vparpc_request_auth_t>::init(m_vparpc_request_auth);
     strcpy((char*)m_vparpc_request_auth.szPSK,CFG_VPA_RPC_PSK);
-    gpVpaRpc->client(m_ssSvr, m_ssSvc,
-                     &m_vparpc_request_auth,
-                     sizeof(vparpc_request_auth_t)); // Use struct size
+
+    // A local socket or ring server knows who we are from the transport
+    // itself, so the session starts without a GET_AUTH round trip; the
+    // requests go with an empty token.
+    std::string ssPath;
+    if (rpcResolver::unix_path(m_ssSvc, ssPath) ||
+        rpcShmRing::ring_name(m_ssSvc, ssPath))
+    {
+        return;
+    }
+    call(&m_vparpc_request_auth,
+         sizeof(vparpc_request_auth_t)); // Use struct size
+}
+
+/**
+ * Makes one request now, or queues it when a batch is open.
+ */
+void CVpaRpc::call(void* pPacket, size_t stLen)
+{
+    if (!m_bBatch)
+    {
+        gpVpaRpc->client(m_ssSvr, m_ssSvc, pPacket, stLen);
+        return;
+    }
+    if (m_bPipelined)
+    {
+        gpVpaRpc->pipeline_send(m_ssSvr, m_ssSvc, pPacket, stLen);
+        return;
+    }
+    m_batch.push_back({pPacket, stLen});
+}
+
+void CVpaRpc::begin_batch(bool bPipelined)
+{
+    gpSysLog->loginfo(__PRETTY_FUNCTION__);
+
+    m_bBatch = true;
+    m_bPipelined = bPipelined;
+    m_batch.clear();
+}
+
+bool CVpaRpc::end_batch()
+{
+    gpSysLog->loginfo(__PRETTY_FUNCTION__);
+
+    bool bOk;
+    if (m_bPipelined)
+    {
+        bOk = gpVpaRpc->pipeline_collect();
+    }
+    else
+    {
+        bOk = m_batch.empty() ||
+              gpVpaRpc->client_batch(m_ssSvr, m_ssSvc,
+                                     m_batch.data(), m_batch.size());
+    }
+    m_bBatch = false;
+    m_bPipelined = false;
+    m_batch.clear();
+    return bOk;
 }
 
 /**
@@ -67,9 +124,8 @@ std::string CVpaRpc::get_version()
     m_vparpc_request_version.eFunc = VPARPC_FUNC_VERSION;
     strcpy((char*)m_vparpc_request_version.szAuth,
            m_vparpc_request_auth.szAuth);
-    gpVpaRpc->client(m_ssSvr, m_ssSvc,
-                     &m_vparpc_request_version,
-                     sizeof(vparpc_request_version_t)); // Use struct size
+    call(&m_vparpc_request_version,
+         sizeof(vparpc_request_version_t)); // Use struct size
     return (m_vparpc_request_version.szVersion);
 }
 
@@ -122,10 +178,8 @@ int CVpaRpc::get_lookup()
             m_vparpc_request_lookup.iHandle);
     gpSysLog->loginfo(szLogger);
 
-    gpVpaRpc->client(m_ssSvr, m_ssSvc,
-                     &m_vparpc_request_lookup,
-                     sizeof(vparpc_request_lookup_t)
-    );
+    call(&m_vparpc_request_lookup,
+         sizeof(vparpc_request_lookup_t));
 
     // Log the response
     sprintf(szLogger, "Received lookup response - Handle: %d, Status: %d",
@@ -160,9 +214,29 @@ void CVpaRpc::get_creds()
     m_vparpc_request_creds.eFunc = VPARPC_FUNC_CREDS;
     strcpy((char*)m_vparpc_request_creds.szAuth, m_vparpc_request_auth.szAuth);
     m_vparpc_request_creds.iHandle = m_vparpc_request_lookup.iHandle;
-    gpVpaRpc->client(m_ssSvr, m_ssSvc,
-                     &m_vparpc_request_creds,
-                     sizeof(vparpc_request_creds_t)); // Use struct size
+    memset(m_vparpc_request_creds.szAuthUUID, 0,
+           sizeof(m_vparpc_request_creds.szAuthUUID));
+    call(&m_vparpc_request_creds,
+         sizeof(vparpc_request_creds_t)); // Use struct size
+}
+
+void CVpaRpc::get_creds(std::string ssAuthUUID)
+{
+    gpSysLog->loginfo(__PRETTY_FUNCTION__);
+
+    // Same as get_creds(), but the server resolves the session by its
+    // UUID rather than by the passwd.csv row in iHandle.
+    m_vparpc_request_creds.eVersion = VPARPC_VERSION_1;
+    m_vparpc_request_creds.nSize = sizeof(m_vparpc_request_creds);
+    m_vparpc_request_creds.eFunc = VPARPC_FUNC_CREDS;
+    strcpy((char*)m_vparpc_request_creds.szAuth, m_vparpc_request_auth.szAuth);
+    m_vparpc_request_creds.iHandle = CFG_NO_HANDLE;
+    memset(m_vparpc_request_creds.szAuthUUID, 0,
+           sizeof(m_vparpc_request_creds.szAuthUUID));
+    strncpy(m_vparpc_request_creds.szAuthUUID, ssAuthUUID.c_str(),
+            sizeof(m_vparpc_request_creds.szAuthUUID) - 1);
+    call(&m_vparpc_request_creds,
+         sizeof(vparpc_request_creds_t)); // Use struct size
 }
 
 /**
@@ -249,9 +323,8 @@ void CVpaRpc::get_urls()
     m_vparpc_request_urls.nSize = sizeof(m_vparpc_request_urls);
     m_vparpc_request_urls.eFunc = VPARPC_FUNC_URLS;
     strcpy((char*)m_vparpc_request_urls.szAuth, m_vparpc_request_auth.szAuth);
-    gpVpaRpc->client(m_ssSvr, m_ssSvc,
-                     &m_vparpc_request_urls,
-                     sizeof(vparpc_request_urls_t)); // Use struct size
+    call(&m_vparpc_request_urls,
+         sizeof(vparpc_request_urls_t)); // Use struct size
 }
 
 std::string CVpaRpc::get_urls_ip()
@@ -173,7 +173,11 @@ void RTkGPIO::set(pinch_t pin, led_ofs_t index)
     usleep(delay); // 1 millisecond
     fputc('1', m_pDevice);
     usleep(delay); // 1 millisecond
-    gpSh->m_pShMemng->bLedCntl[index] = true;
+    {
+        shmLedsGuard guard;
+        gpSh->m_pShMemng->bLedCntl[index] = true;
+    }
+    shm_notify::publish(SHM_CHANNEL_LEDS);
 }
 
 void RTkGPIO::reset(pinch_t pin, led_ofs_t index)
@@ -184,7 +188,11 @@ void RTkGPIO::reset(pinch_t pin, led_ofs_t index)
     usleep(delay); // 1 millisecond
     fputc('0', m_pDevice);
     usleep(delay); // 1 millisecond
-    gpSh->m_pShMemng->bLedCntl[index] = false;
+    {
+        shmLedsGuard guard;
+        gpSh->m_pShMemng->bLedCntl[index] = false;
+    }
+    shm_notify::publish(SHM_CHANNEL_LEDS);
 }
 
 // int GPIOmap[] = {
@@ -14,7 +14,7 @@ using namespace std;
 void cfgHandler(char * pArgv0)
 {
     // Establish addressability to config filespec
-    std::string ssCfgFQFS = gpSh->m_pShMemng->szConfigFQDS;
+    std::string ssCfgFQFS = gpShMemCfg->get(SHM_STR_CONFIG_FQDS);
     ssCfgFQFS.append(gpOS->file2filenamesansext(__FILE__));
     ssCfgFQFS.append(".ini");
     cfgini config(ssCfgFQFS.c_str());
@@ -13,10 +13,17 @@
  */
 cgihtml::cgihtml()
 {
-    for (int index = 0; index < 28; index++)
+    bool bChanged = false;
+    for (size_t index = 0; index < std::size(gpSh->m_pShMemng->bLedCntl);
+         index++)
     {
+        bChanged |= gpSh->m_pShMemng->bLedCntl[index];
         gpSh->m_pShMemng->bLedCntl[index] = false;
     }
+    if (bChanged)
+    {
+        shm_notify::publish(SHM_CHANNEL_LEDS);
+    }
 }
 
 
@@ -735,33 +742,33 @@ void cgihtml::dump_shm_vars()
 
     emit_shm("iSignature",         gpSh->m_pShMemng->iSignature);
 
-    emit_shm("szDevoDir",gpSh->m_pShMemng->szDevoDir);
+    emit_shm("szDevoDir",gpShMemCfg->get(SHM_STR_DEVO_DIR).c_str());
 
-    emit_shm("szBuildFQDS",gpSh->m_pShMemng->szBuildFQDS);
+    emit_shm("szBuildFQDS",gpShMemCfg->get(SHM_STR_BUILD_FQDS).c_str());
 
-    emit_shm("szCgiRoot",gpSh->m_pShMemng->szCgiRoot);
-    emit_shm("szConfigFQDS",gpSh->m_pShMemng->szConfigFQDS);
-    emit_shm("szConfigFQFS",gpSh->m_pShMemng->szConfigFQFS);
-    emit_shm("szHomeFQDS",gpSh->m_pShMemng->szHomeFQDS);
-    emit_shm("szHostName",gpSh->m_pShMemng->szHostname);
-    emit_shm("szIface",gpSh->m_pShMemng->szIface);
-    emit_shm(">szImgRoot",gpSh->m_pShMemng->szImgRoot);
-    emit_shm("szIP",gpSh->m_pShMemng->szIP);
-    emit_shm("szLogFQDS",gpSh->m_pShMemng->szLogFQDS);
+    emit_shm("szCgiRoot",gpShMemCfg->get(SHM_STR_CGI_ROOT).c_str());
+    emit_shm("szConfigFQDS",gpShMemCfg->get(SHM_STR_CONFIG_FQDS).c_str());
+    emit_shm("szConfigFQFS",gpShMemCfg->get(SHM_STR_CONFIG_FQFS).c_str());
+    emit_shm("szHomeFQDS",gpShMemCfg->get(SHM_STR_HOME_FQDS).c_str());
+    emit_shm("szHostName",gpShMemCfg->get(SHM_STR_HOSTNAME).c_str());
+    emit_shm("szIface",gpShMemCfg->get(SHM_STR_IFACE).c_str());
+    emit_shm(">szImgRoot",gpShMemCfg->get(SHM_STR_IMG_ROOT).c_str());
+    emit_shm("szIP",gpShMemCfg->get(SHM_STR_IP).c_str());
+    emit_shm("szLogFQDS",gpShMemCfg->get(SHM_STR_LOG_FQDS).c_str());
     emit_shm("szRemoteAddr",gpSh->m_pShMemng->szRemoteAddr);
     emit_shm("szRemoteAuth",gpSh->m_pShMemng->szRemoteAuth);
 
     emit_shm("szRemoteHost",gpSh->m_pShMemng->szRemoteHost);
     emit_shm("szRemoteVer",gpSh->m_pShMemng->szRemoteVer);
-    emit_shm("szPublicIP",gpSh->m_pShMemng->szPublicIP);
-    emit_shm("szProtocol",gpSh->m_pShMemng->szProtocol);
-    emit_shm("szRpcUuid",gpSh->m_pShMemng->szRpcUuid);
-    emit_shm("szSourceFQDS",gpSh->m_pShMemng->szSourceFQDS);
+    emit_shm("szPublicIP",gpShMemCfg->get(SHM_STR_PUBLIC_IP).c_str());
+    emit_shm("szProtocol",gpShMemCfg->get(SHM_STR_PROTOCOL).c_str());
+    emit_shm("szRpcUuid",gpShMemCfg->get(SHM_STR_RPC_UUID).c_str());
+    emit_shm("szSourceFQDS",gpShMemCfg->get(SHM_STR_SOURCE_FQDS).c_str());
     emit_shm("szStatus",gpSh->m_pShMemng->szStatus);
-    emit_shm("szStylesRoot",gpSh->m_pShMemng->szStylesFQDS);
-    emit_shm("szTempFQDS",gpSh->m_pShMemng->szTempFQDS);
-    emit_shm("szUser",gpSh->m_pShMemng->szUser);
-    emit_shm("szUserdirFQDS",gpSh->m_pShMemng->szUserdirFQDS);
+    emit_shm("szStylesRoot",gpShMemCfg->get(SHM_STR_STYLES_FQDS).c_str());
+    emit_shm("szTempFQDS",gpShMemCfg->get(SHM_STR_TEMP_FQDS).c_str());
+    emit_shm("szUser",gpShMemCfg->get(SHM_STR_USER).c_str());
+    emit_shm("szUserdirFQDS",gpShMemCfg->get(SHM_STR_USERDIR_FQDS).c_str());
     for (int iRow = ROW_DATA; iRow < ROW_DATA + CFG_MAX_USERS; iRow++) {
         if (gpSh->m_pShMemng->creds[iRow].iAuthHandle > 2)
         {
@@ -781,6 +788,7 @@ void cgihtml::dump_shm_vars()
 
     render_leds();
 
+    gpShMemMgr->releaseSharedMemory();
     close_table();
 }
 
@@ -1445,13 +1453,13 @@ void cgihtml::hidden(const char* pszName, const char* pszValue)
  */
 void cgihtml::imgsrc(const char* pszImageFN, int width, int height)
 {
-    std::string ssImgFQFS = gpSh->m_pShMemng->szImgRoot;
+    std::string ssImgFQFS = gpShMemCfg->get(SHM_STR_IMG_ROOT);
     ssImgFQFS.append(pszImageFN);
 
     CLog log(__FILE__, __FUNCTION__);
     log.writev("%s: %s() started",__FILE__, __FUNCTION__);
     char szTag[FILENAME_MAX];
-    log.namedString("std::string ssImgFQFS = gpSh->m_pShMemng->szImgRoot;\n"
+    log.namedString("std::string ssImgFQFS = gpShMemCfg->get(SHM_STR_IMG_ROOT);\n"
                     "ssImgFQFS.append(pszImageFN);",
                     ssImgFQFS.c_str());
 
@@ -1757,7 +1765,7 @@ void cgihtml::set_style(const char* pszStylesheet)
 {
     gpLog->writev("%s: %s() started",__FILE__, __FUNCTION__);
     printf("<link rel=\"stylesheet\" href=\"%s%s.css\"/>",
-           gpSh->m_pShMemng->szStylesFQDS,
+           gpShMemCfg->get(SHM_STR_STYLES_FQDS).c_str(),
            pszStylesheet);
 }
 
@@ -143,7 +143,7 @@ void cliLogin::queryUserForLogin(cfgini& config)
 
 void cliLogin::checkPreviousLogin()
 {
-    cfgini config(gpSh->m_pShMemng->szConfigFQFS);
+    cfgini config(gpShMemCfg->get(SHM_STR_CONFIG_FQFS).c_str());
 
     // Try to load existing config
     if (!config.load())
@@ -11,10 +11,10 @@
 config::config()
 {
     gpSysLog->loginfo(__PRETTY_FUNCTION__);
-    if (access(gpSh->m_pShMemng->szConfigFQDS,F_OK))
+    if (access(gpShMemCfg->get(SHM_STR_CONFIG_FQDS).c_str(),F_OK))
     {
         //gpSysLog->loginfo("config directory does not exist");
-        std::filesystem::create_directories(gpSh->m_pShMemng->szConfigFQDS);
+        std::filesystem::create_directories(gpShMemCfg->get(SHM_STR_CONFIG_FQDS).c_str());
     }
     else
     {
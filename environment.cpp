@@ -64,6 +64,14 @@ environment::environment()
 	 */
 	gpSh = new shared();
 
+	/**
+	 * A segment restored from the warm-start snapshot still carries the
+	 * network identity of the previous boot. It is checked once, without
+	 * any of the probes below, and whatever is stale is cleared so that
+	 * the probes run for it again.
+	 */
+	validate_warm_start();
+
 	/**
 	 * Now that we have access to the shared memory structure, we can
 	 * begin collecting the project data. The location of the development
@@ -88,125 +96,125 @@ environment::environment()
 	// Development Directories //
 	/////////////////////////////
 
-	if (strlen(gpSh->m_pShMemng->szDevoDir) == 0)
+	if (gpShMemCfg->get(SHM_STR_DEVO_DIR).empty())
 	{
 		ssDevoDir = __FILE__;
 		ssDevoDir = std::filesystem::path(ssDevoDir).remove_filename();
-		strcpy(gpSh->m_pShMemng->szDevoDir, ssDevoDir.c_str());
+		gpShMemCfg->set(SHM_STR_DEVO_DIR, ssDevoDir);
 	}
 
-	if (strlen(gpSh->m_pShMemng->szBuildFQDS) == 0)
+	if (gpShMemCfg->get(SHM_STR_BUILD_FQDS).empty())
 	{
 		std::string ssBuildFQDS = ssDevoDir;
 		ssBuildFQDS.append("build/");
-		strcpy(gpSh->m_pShMemng->szBuildFQDS, ssBuildFQDS.c_str());
+		gpShMemCfg->set(SHM_STR_BUILD_FQDS, ssBuildFQDS);
 	}
 
-	if (strlen(gpSh->m_pShMemng->szCgiBinFQDS) == 0)
+	if (gpShMemCfg->get(SHM_STR_CGIBIN_FQDS).empty())
 	{
 		std::string ssCgiBinFQDS = ssDevoDir;
 		ssCgiBinFQDS.append("cgi-bin/");
-		strcpy(gpSh->m_pShMemng->szCgiBinFQDS, ssCgiBinFQDS.c_str());
+		gpShMemCfg->set(SHM_STR_CGIBIN_FQDS, ssCgiBinFQDS);
 	}
 
-	if (strlen(gpSh->m_pShMemng->szDocFQDS) == 0)
+	if (gpShMemCfg->get(SHM_STR_DOC_FQDS).empty())
 	{
 		std::string ssDocFQDS = ssDevoDir;
 		ssDocFQDS.append("doc/");
-		strcpy(gpSh->m_pShMemng->szDocFQDS, ssDocFQDS.c_str());
+		gpShMemCfg->set(SHM_STR_DOC_FQDS, ssDocFQDS);
 	}
 
-	if (strlen(gpSh->m_pShMemng->szImgFQDS) == 0)
+	if (gpShMemCfg->get(SHM_STR_IMG_FQDS).empty())
 	{
 		std::string ssImgFQDS = ssDevoDir;
 		ssImgFQDS.append("images/");
-		strcpy(gpSh->m_pShMemng->szImgFQDS, ssImgFQDS.c_str());
+		gpShMemCfg->set(SHM_STR_IMG_FQDS, ssImgFQDS);
 	}
 
-	if (strlen(gpSh->m_pShMemng->szIncludeFQDS) == 0)
+	if (gpShMemCfg->get(SHM_STR_INCLUDE_FQDS).empty())
 	{
 		std::string ssIncludeFQDS = ssDevoDir;
 		ssIncludeFQDS.append("include/");
-		strcpy(gpSh->m_pShMemng->szIncludeFQDS, ssIncludeFQDS.c_str());
+		gpShMemCfg->set(SHM_STR_INCLUDE_FQDS, ssIncludeFQDS);
 	}
 
 
-	if (strlen(gpSh->m_pShMemng->szLogFQDS) == 0)
+	if (gpShMemCfg->get(SHM_STR_LOG_FQDS).empty())
 	{
 		std::string ssLogFQDS = ssDevoDir;
 		ssLogFQDS.append("log/");
-		strcpy(gpSh->m_pShMemng->szLogFQDS, ssLogFQDS.c_str());
+		gpShMemCfg->set(SHM_STR_LOG_FQDS, ssLogFQDS);
 	}
 
-	if (strlen(gpSh->m_pShMemng->szSchemasFQDS) == 0)
+	if (gpShMemCfg->get(SHM_STR_SCHEMAS_FQDS).empty())
 	{
 		std::string ssSchemasFQDS = ssDevoDir;
 		ssSchemasFQDS.append("schemas/");
-		strcpy(gpSh->m_pShMemng->szSchemasFQDS, ssSchemasFQDS.c_str());
+		gpShMemCfg->set(SHM_STR_SCHEMAS_FQDS, ssSchemasFQDS);
 	}
 
-	if (strlen(gpSh->m_pShMemng->szScriptsFQDS) == 0)
+	if (gpShMemCfg->get(SHM_STR_SCRIPTS_FQDS).empty())
 	{
 		std::string ssScriptsFQDS = ssDevoDir;
 		ssScriptsFQDS.append("scripts/");
-		strcpy(gpSh->m_pShMemng->szScriptsFQDS, ssScriptsFQDS.c_str());
+		gpShMemCfg->set(SHM_STR_SCRIPTS_FQDS, ssScriptsFQDS);
 	}
 
-	if (strlen(gpSh->m_pShMemng->szStylesFQDS) == 0)
+	if (gpShMemCfg->get(SHM_STR_STYLES_FQDS).empty())
 	{
 		std::string ssStylesFQDS = ssDevoDir;
 		ssStylesFQDS.append("styles/");
-		strcpy(gpSh->m_pShMemng->szStylesFQDS, ssStylesFQDS.c_str());
+		gpShMemCfg->set(SHM_STR_STYLES_FQDS, ssStylesFQDS);
 	}
 
-	if (strlen(gpSh->m_pShMemng->szTempFQDS) == 0)
+	if (gpShMemCfg->get(SHM_STR_TEMP_FQDS).empty())
 	{
 		std::string ssTempFQDS = ssDevoDir;
 		ssTempFQDS.append("tmp/");
-		strcpy(gpSh->m_pShMemng->szTempFQDS, ssTempFQDS.c_str());
+		gpShMemCfg->set(SHM_STR_TEMP_FQDS, ssTempFQDS);
 	}
 
 	//////////////////////
 	// User Information //
 	//////////////////////
 
-	if (0 == strlen(gpSh->m_pShMemng->szUser))
+	if (gpShMemCfg->get(SHM_STR_USER).empty())
 	{
 		std::string ssTemp = __FILE__;
 		ssTemp = ssTemp.substr(6, ssTemp.length());
 		int offset = ssTemp.find('/');
 		ssTemp = ssTemp.substr(0, offset);
-		strcpy(gpSh->m_pShMemng->szUser, ssTemp.c_str());
+		gpShMemCfg->set(SHM_STR_USER, ssTemp);
 	}
 
-	if (0 == strlen(gpSh->m_pShMemng->szHomeFQDS))
+	if (gpShMemCfg->get(SHM_STR_HOME_FQDS).empty())
 	{
 		std::string ssTemp = "/home/";
-		ssTemp.append(gpSh->m_pShMemng->szUser);
+		ssTemp.append(gpShMemCfg->get(SHM_STR_USER));
 		ssTemp.append("/");
-		strcpy(gpSh->m_pShMemng->szHomeFQDS, ssTemp.c_str());
+		gpShMemCfg->set(SHM_STR_HOME_FQDS, ssTemp);
 	}
 
 	/********************************************************************
 	 * Determine the Userdir of the user under which this application
 	 * is running and save the result in the shared segment.
 	 ***********************************************************************/
-	if (0 == strlen(gpSh->m_pShMemng->szUserdirFQDS))
+	if (gpShMemCfg->get(SHM_STR_USERDIR_FQDS).empty())
 	{
 		char szUserdir[FILENAME_MAX];
 		strcpy(szUserdir, ssDevoDir.c_str());
 		szUserdir[strlen(szUserdir) - 3] = '\0';
-		strcpy(gpSh->m_pShMemng->szUserdirFQDS, szUserdir);
+		gpShMemCfg->set(SHM_STR_USERDIR_FQDS, szUserdir);
 	}
 
 	/********************************************************************
 	 * Determine the Sourcedir of the user under which this application
 	 * is running and save the result in the shared segment.
 	 ***********************************************************************/
-	if (0 == strlen(gpSh->m_pShMemng->szSourceFQDS))
+	if (gpShMemCfg->get(SHM_STR_SOURCE_FQDS).empty())
 	{
 		std::string ssSourceFQDS = ssDevoDir;
-		strcpy(gpSh->m_pShMemng->szSourceFQDS, ssSourceFQDS.c_str());
+		gpShMemCfg->set(SHM_STR_SOURCE_FQDS, ssSourceFQDS);
 	}
 
 	// /********************************************************************
@@ -225,23 +233,23 @@ environment::environment()
 	 * Determine the config root of the user under which this application
 	 * is running and save the result in the shared segment.
 	 ***********************************************************************/
-	if (0 == strlen(gpSh->m_pShMemng->szConfigFQDS))
+	if (gpShMemCfg->get(SHM_STR_CONFIG_FQDS).empty())
 	{
 		// construct_szConfigFQDS();
-		std::string ssConfigFQDS = gpSh->m_pShMemng->szHomeFQDS;
+		std::string ssConfigFQDS = gpShMemCfg->get(SHM_STR_HOME_FQDS);
 		ssConfigFQDS.append(".config/multiware/");
-		strcpy(gpSh->m_pShMemng->szConfigFQDS, ssConfigFQDS.c_str());
+		gpShMemCfg->set(SHM_STR_CONFIG_FQDS, ssConfigFQDS);
 	}
 
 	/********************************************************************
 	 * Determine the config filename for the user under which this application
 	 * is running and save the result in the shared segment.
 	 ***********************************************************************/
-	if (0 == strlen(gpSh->m_pShMemng->szConfigFQFS))
+	if (gpShMemCfg->get(SHM_STR_CONFIG_FQFS).empty())
 	{
-		std::string ssConfigFQFS = gpSh->m_pShMemng->szConfigFQDS;
+		std::string ssConfigFQFS = gpShMemCfg->get(SHM_STR_CONFIG_FQDS);
 		ssConfigFQFS.append("config.ini");
-		strcpy(gpSh->m_pShMemng->szConfigFQFS, ssConfigFQFS.c_str());
+		gpShMemCfg->set(SHM_STR_CONFIG_FQFS, ssConfigFQFS);
 	}
 
 	if (strlen(gpSh->m_pShMemng->szStatus) == 0)
@@ -255,22 +263,22 @@ environment::environment()
 	// Network Information //
 	/////////////////////////
 
-	if (0 == strlen(gpSh->m_pShMemng->szHostname))
+	if (gpShMemCfg->get(SHM_STR_HOSTNAME).empty())
 	{
 		std::string ssEtcHostnameFQFS = "/etc/hostname";
 		std::ifstream ifs(ssEtcHostnameFQFS);
 		std::string ssInbuf;
 		ifs >> ssInbuf;
-		strcpy(gpSh->m_pShMemng->szHostname, ssInbuf.c_str());
+		gpShMemCfg->set(SHM_STR_HOSTNAME, ssInbuf);
 	}
 
 	/********************************************************************
 	 * Determine the name of the primary network interface in use and
 	 * save it in the shared segment.
 	 ***********************************************************************/
-	if (0 == strlen(gpSh->m_pShMemng->szIface))
+	if (gpShMemCfg->get(SHM_STR_IFACE).empty())
 	{
-		std::string ssUser = gpSh->m_pShMemng->szUser;
+		std::string ssUser = gpShMemCfg->get(SHM_STR_USER);
 		gpXinetd->trigger(VPA_NETSTAT_PORT);
 
 		char szNetstatStdoutFQFS[128];
@@ -292,7 +300,7 @@ environment::environment()
 		ifs >> szBuffer; ifs >> szBuffer; ifs >> szBuffer; ifs >> szBuffer;
 
 		strncpy(m_szIface, szBuffer, IFNAMSIZ);
-		strncpy(gpSh->m_pShMemng->szIface, m_szIface, IFNAMSIZ);
+		gpShMemCfg->set(SHM_STR_IFACE, m_szIface);
 	}
 
 
@@ -303,12 +311,12 @@ environment::environment()
 	 * Note: The szIface must be value before this function runs or you
 	 * get the localhost IP of 127.0.0.1 instead of the actual IP.
      ***********************************************************************/
-	if (0 == strlen(gpSh->m_pShMemng->szIP))
+	if (gpShMemCfg->get(SHM_STR_IP).empty())
 	{
 		// define a buffer for reading lines from the
 		// /tmp/ip.out file.
 		char szBuffer[BUFSIZ];
-		std::string ssUser = gpSh->m_pShMemng->szUser;
+		std::string ssUser = gpShMemCfg->get(SHM_STR_USER);
 		gpSysLog->loginfo(ssUser.c_str());
 
 		std::ofstream ofs("/home/"
@@ -390,7 +398,7 @@ environment::environment()
 			m_szIP[destindex++] = szBuffer[index++];
 		}
 
-		strncpy(gpSh->m_pShMemng->szIP, m_szIP, DNS_FQDN_SIZE_MAX);
+		gpShMemCfg->set(SHM_STR_IP, m_szIP);
 
 	}
 
@@ -401,8 +409,8 @@ environment::environment()
 	 * Determine the protocol supported by Apache2 on the current system and
 	 * save to the shared system. It would be https:// or http://
      ***********************************************************************/
-	if (0 == strcmp("http://", gpSh->m_pShMemng->szProtocol) ||
-		0 == strcmp("https://", gpSh->m_pShMemng->szProtocol))
+	std::string ssProtocol = gpShMemCfg->get(SHM_STR_PROTOCOL);
+	if ("http://" == ssProtocol || "https://" == ssProtocol)
 	{
 		//m_pSysLog->loginfo("environment::environment: valid szProtocol already set");
 	}
@@ -439,7 +447,7 @@ environment::environment()
 
 		if (0l != l_fSize)
 		{
-			strcpy(gpSh->m_pShMemng->szProtocol, "https://");
+			gpShMemCfg->set(SHM_STR_PROTOCOL, "https://");
 		}
 		else
 		{
@@ -474,7 +482,7 @@ environment::environment()
 
 			if (0l != l_fSize)
 			{
-				strcpy(gpSh->m_pShMemng->szProtocol, "http://");
+				gpShMemCfg->set(SHM_STR_PROTOCOL, "http://");
 			}
 			else
 			{
@@ -491,7 +499,7 @@ environment::environment()
 	 * Determine the publically visible IPv4 number of the host system
 	 * and save in the shared segment.
      ***********************************************************************/
-	if (0 == strlen(gpSh->m_pShMemng->szPublicIP))
+	if (gpShMemCfg->get(SHM_STR_PUBLIC_IP).empty())
 	{
 		//m_pSysLog->loginfo("environment::environment: Extracting szPublicIP");
 		set_public_ip();
@@ -501,25 +509,25 @@ environment::environment()
 	 * Create the base URL for calling our CGIs
 	 * for instance: "http://172.20.10.4/cgi-bin/"
      ***********************************************************************/
-	if (0 == strlen(gpSh->m_pShMemng->szCgiRoot))
+	if (gpShMemCfg->get(SHM_STR_CGI_ROOT).empty())
 	{
-		std::string ssCgiRoot = gpSh->m_pShMemng->szProtocol;
-		ssCgiRoot.append(gpSh->m_pShMemng->szIP);
+		std::string ssCgiRoot = gpShMemCfg->get(SHM_STR_PROTOCOL);
+		ssCgiRoot.append(gpShMemCfg->get(SHM_STR_IP));
 		ssCgiRoot.append("/~");
-		ssCgiRoot.append(gpSh->m_pShMemng->szUser);
+		ssCgiRoot.append(gpShMemCfg->get(SHM_STR_USER));
 		ssCgiRoot.append("/fw/cgi-bin/");
-		strcpy(gpSh->m_pShMemng->szCgiRoot, ssCgiRoot.c_str());
+		gpShMemCfg->set(SHM_STR_CGI_ROOT, ssCgiRoot);
 	}
 
 
-	if (0 == strlen(gpSh->m_pShMemng->szHtmlRoot))
+	if (gpShMemCfg->get(SHM_STR_HTML_ROOT).empty())
 	{
-		std::string ssHtmlRoot = gpSh->m_pShMemng->szProtocol;
-		ssHtmlRoot.append(gpSh->m_pShMemng->szIP);
+		std::string ssHtmlRoot = gpShMemCfg->get(SHM_STR_PROTOCOL);
+		ssHtmlRoot.append(gpShMemCfg->get(SHM_STR_IP));
 		ssHtmlRoot.append("/~");
-		ssHtmlRoot.append(gpSh->m_pShMemng->szUser);
+		ssHtmlRoot.append(gpShMemCfg->get(SHM_STR_USER));
 		ssHtmlRoot.append("/fw/html/");
-		strcpy(gpSh->m_pShMemng->szHtmlRoot, ssHtmlRoot.c_str());
+		gpShMemCfg->set(SHM_STR_HTML_ROOT, ssHtmlRoot);
 	}
 
 
@@ -530,7 +538,7 @@ environment::environment()
 	 * Create the base URL for accessing images
 	 * for instance: "http://172.20.10.4/~doug/fw/images/"
      ***********************************************************************/
-	if (0 == strlen(gpSh->m_pShMemng->szImgRoot))
+	if (gpShMemCfg->get(SHM_STR_IMG_ROOT).empty())
 	{
 		//m_pSysLog->loginfo("environment::environment: Extracting szImgRoot");
 		set_img_root(false);
@@ -540,12 +548,70 @@ environment::environment()
 	 * Create the base filesystem root for filesystem access to styles
 	 * for instance: "/home/monk/public_html/fw/styles/"
 	 ***********************************************************************/
-	if (0 == strlen(gpSh->m_pShMemng->szStylesFileRoot))
+	if (gpShMemCfg->get(SHM_STR_STYLES_FILE_ROOT).empty())
 	{
 		//m_pSysLog->loginfo("environment::environment: Extracting szStylesFileRoot");
 		set_styles_file_root(false);
 	}
 
+	/********************************************************************
+	 * Save what was just probed, so that the first process after the
+	 * next reboot can skip the probes. This is a no-op unless one of the
+	 * config strings actually changed.
+	 ***********************************************************************/
+	gpSh->checkpoint();
+}
+
+/**
+ * Checks the interface and IPv4 address restored from the warm-start
+ * snapshot against the interfaces the kernel reports now. getifaddrs()
+ * answers from a single netlink query, so this costs microseconds where
+ * the netstat and ip probes cost seconds. Only the first process to see
+ * the restored segment does the check. If the address is no longer
+ * assigned to the interface, the interface, both IP addresses and the
+ * URL roots built from them are cleared and probed again.
+ */
+void environment::validate_warm_start()
+{
+	uint32_t uExpected = SHM_WARM_RESTORED;
+	if (!std::atomic_ref<uint32_t>(gpSh->m_pShMemng->warm.uState)
+		.compare_exchange_strong(uExpected, SHM_WARM_VALIDATED))
+	{
+		return;
+	}
+
+	std::string ssIface = gpShMemCfg->get(SHM_STR_IFACE);
+	std::string ssIP = gpShMemCfg->get(SHM_STR_IP);
+	bool bValid = false;
+	struct ifaddrs* pIfaddrs = nullptr;
+	if (!ssIface.empty() && !ssIP.empty() && 0 == getifaddrs(&pIfaddrs))
+	{
+		for (struct ifaddrs* p = pIfaddrs; p && !bValid; p = p->ifa_next)
+		{
+			char szAddr[INET_ADDRSTRLEN];
+			if (nullptr == p->ifa_addr || AF_INET != p->ifa_addr->sa_family ||
+				ssIface != p->ifa_name)
+			{
+				continue;
+			}
+			inet_ntop(AF_INET, &((struct sockaddr_in*)p->ifa_addr)->sin_addr,
+					  szAddr, sizeof(szAddr));
+			bValid = (ssIP == szAddr);
+		}
+		freeifaddrs(pIfaddrs);
+	}
+
+	if (!bValid)
+	{
+		gpSysLog->loginfo("environment::validate_warm_start: network "
+						  "changed since the snapshot; probing again");
+		for (shm_str_t id : {SHM_STR_IFACE, SHM_STR_IP, SHM_STR_PUBLIC_IP,
+							 SHM_STR_CGI_ROOT, SHM_STR_HTML_ROOT,
+							 SHM_STR_IMG_ROOT})
+		{
+			gpShMemCfg->set(id, "");
+		}
+	}
 }
 
 
@@ -572,11 +638,11 @@ void environment::set_vpad_startup_script()
 	char szFileFQFS[FILENAME_MAX];
 	char szCommand[80];
 
-	sprintf(szFileFQFS, szTempFQFS, gpSh->m_pShMemng->szUser);
+	sprintf(szFileFQFS, szTempFQFS, gpShMemCfg->get(SHM_STR_USER).c_str());
 	FILE* fp = fopen(szFileFQFS, "w");
 	fprintf(fp, "#!/bin/sh\n");
 	fprintf(fp, "/home/%s/public_html/fw/scripts/start-vpad.sh &\n",
-	        gpSh->m_pShMemng->szUser);
+	        gpShMemCfg->get(SHM_STR_USER).c_str());
 	fclose(fp);
 	sprintf(szCommand, "chmod +x %s", szFileFQFS);
 	system(szCommand);
@@ -616,7 +682,7 @@ void environment::set_public_ip()
 	std::ifstream ifs(szTempFQFS);
 	ifs >> ssMyIp;
 	strcpy(szPublicIP, ssMyIp.c_str());
-	strcpy(gpSh->m_pShMemng->szPublicIP, szPublicIP);
+	gpShMemCfg->set(SHM_STR_PUBLIC_IP, szPublicIP);
 }
 
 /**
@@ -633,9 +699,9 @@ void environment::set_public_ip()
  * @throws std::runtime_error If the network request to retrieve the public
  *         IP address encounters an error or the service is unavailable.
  */
-char* environment::get_public_ip()
+const char* environment::get_public_ip()
 {
-	return gpSh->m_pShMemng->szPublicIP;
+	return SharedMemoryConfig::str(gpShMemCfg->current(), SHM_STR_PUBLIC_IP);
 }
 
 
@@ -691,7 +757,7 @@ bool environment::check_curl_installed()
  */
 std::string environment::get_cgi_root(bool bDebug)
 {
-	std::string ssCgiRoot = gpSh->m_pShMemng->szCgiRoot;
+	std::string ssCgiRoot = gpShMemCfg->get(SHM_STR_CGI_ROOT);
 	return ssCgiRoot;
 }
 
@@ -706,9 +772,9 @@ std::string environment::get_cgi_root(bool bDebug)
  *         The caller should ensure that this pointer is used in a read-only
  *         manner and does not attempt to modify or free the memory it points to.
  */
-char* environment::get_cgi_root_as_sz(bool bDebug)
+const char* environment::get_cgi_root_as_sz(bool bDebug)
 {
-	return gpSh->m_pShMemng->szCgiRoot;
+	return SharedMemoryConfig::str(gpShMemCfg->current(), SHM_STR_CGI_ROOT);
 }
 
 
@@ -764,7 +830,7 @@ std::string environment::get_hostname(bool bDebug)
  */
 std::string environment::get_img_root(bool bDebug)
 {
-	std::string ssImgRoot = gpSh->m_pShMemng->szProtocol;
+	std::string ssImgRoot = gpShMemCfg->get(SHM_STR_PROTOCOL);
 	return ssImgRoot;
 }
 
@@ -776,12 +842,12 @@ std::string environment::get_img_root(bool bDebug)
  */
 void environment::set_img_root(bool bDebug)
 {
-	std::string ssImgRoot = gpSh->m_pShMemng->szProtocol;
-	ssImgRoot.append(gpSh->m_pShMemng->szIP);
+	std::string ssImgRoot = gpShMemCfg->get(SHM_STR_PROTOCOL);
+	ssImgRoot.append(gpShMemCfg->get(SHM_STR_IP));
 	ssImgRoot.append("/~");
-	ssImgRoot.append(gpSh->m_pShMemng->szUser);
+	ssImgRoot.append(gpShMemCfg->get(SHM_STR_USER));
 	ssImgRoot.append("/fw/images/");
-	strcpy(gpSh->m_pShMemng->szImgRoot, ssImgRoot.c_str());
+	gpShMemCfg->set(SHM_STR_IMG_ROOT, ssImgRoot);
 }
 
 
@@ -798,7 +864,7 @@ void environment::set_img_root(bool bDebug)
  */
 std::string environment::get_styles_file_root(bool bDebug)
 {
-	std::string ssStylesRoot = gpSh->m_pShMemng->szStylesFileRoot;
+	std::string ssStylesRoot = gpShMemCfg->get(SHM_STR_STYLES_FILE_ROOT);
 	return ssStylesRoot;
 }
 
@@ -816,9 +882,9 @@ std::string environment::get_styles_file_root(bool bDebug)
 void environment::set_styles_file_root(bool bDebug)
 {
 	std::string ssStylesFileRoot = "/home/";
-	ssStylesFileRoot.append(gpSh->m_pShMemng->szUser);
+	ssStylesFileRoot.append(gpShMemCfg->get(SHM_STR_USER));
 	ssStylesFileRoot.append("/public_html/fw/styles/");
-	strcpy(gpSh->m_pShMemng->szStylesFileRoot, ssStylesFileRoot.c_str());
+	gpShMemCfg->set(SHM_STR_STYLES_FILE_ROOT, ssStylesFileRoot);
 }
 
 /**
@@ -11,7 +11,7 @@
 
 void do_config(char * argv0)
 {
-    std::string ssCfgFQFS = gpSh->m_pShMemng->szConfigFQDS;
+    std::string ssCfgFQFS = gpShMemCfg->get(SHM_STR_CONFIG_FQDS);
     ssCfgFQFS.append(gpOS->file2filenamesansext(__FILE__));
     ssCfgFQFS.append(".ini");
     cfgini config(ssCfgFQFS.c_str());
@@ -216,7 +216,7 @@ int main(int argc, char** argv)
     // Example: "/home/user/.config/fw/example-cfgini.ini"
 
     // Get config directory from shared memory
-    std::string ssCfgFQFS = gpSh->m_pShMemng->szConfigFQDS;
+    std::string ssCfgFQFS = gpShMemCfg->get(SHM_STR_CONFIG_FQDS);
     // Add source filename without extension
     ssCfgFQFS.append(gpOS->file2filenamesansext(__FILE__));
     // Add INI extension
@@ -67,7 +67,7 @@ int main()
     buffer[n] = '\0';
 
     char szTemp[1024];
-    sprintf(szTemp,"Client : %s\n", gpSh->m_pShMemng->szIP);
+    sprintf(szTemp,"Client : %s\n", gpShMemCfg->get(SHM_STR_IP).c_str());
 
     sendto(sockfd, (char *)szTemp, strlen(szTemp)+1,
            MSG_CONFIRM, (const struct sockaddr*)&cliaddr,
@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/example-rpc-bench.cpp 2026-10-17 21:10 dwg -  //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+/**
+ * @file example-rpc-bench.cpp
+ * @brief Compares the epoll and io_uring backends of rpcServer.
+ *
+ * @details
+ * Runs an rpcServer on the loopback interface once per backend, each
+ * time with a handler that answers every request with itself, and
+ * drives it from several client threads in two patterns:
+ * - keep-alive: each client sends its requests one after another on one
+ *   connection, so the cost is a recv and a send per request;
+ * - connect: each request has a connection of its own, which adds an
+ *   accept and a close to every request, as xinetd-style clients do.
+ *
+ * For each run it shows requests per second and the median and 99th
+ * percentile round trip.
+ *
+ * @usage
+ * ./example-rpc-bench [clients] [requests-per-client] [port]
+ *
+ * @example
+ * ./example-rpc-bench 8 20000 47200
+ */
+
+#include "mwfw2.h"
+
+struct bench_result_t
+{
+    double dRate;
+    double dP50;
+    double dP99;
+    int iErrors;
+};
+
+/**
+ * Sends nRequests VERSION frames to 127.0.0.1:iPort, on one connection or
+ * on a new one each, and records every round trip in microseconds.
+ */
+static void client(int iPort, int nRequests, bool bConnect,
+                   std::vector<double>& latency, std::atomic<int>& errors)
+{
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(iPort);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    vparpc_request_version_t req = {};
+    vparpc_idl<vparpc_request_version_t>::init(req);
+    vparpc_request_t reply;
+
+    int fd = -1;
+    for (int i = 0; i < nRequests; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        if (-1 == fd)
+        {
+            fd = socket(AF_INET, SOCK_STREAM, 0);
+            int opt = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+            if (-1 == connect(fd, (struct sockaddr*)&addr, sizeof(addr)))
+            {
+                close(fd);
+                fd = -1;
+                errors++;
+                continue;
+            }
+        }
+        req.uRequestId = i;
+        if (!vparpc::send_frame(fd, &req, sizeof(req)) ||
+            vparpc::recv_frame(fd, &reply, sizeof(reply)) <= 0)
+        {
+            close(fd);
+            fd = -1;
+            errors++;
+            continue;
+        }
+        if (bConnect)
+        {
+            close(fd);
+            fd = -1;
+        }
+        latency.push_back(std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+    if (-1 != fd)
+    {
+        close(fd);
+    }
+}
+
+static bench_result_t run_clients(int iPort, int nClients, int nRequests,
+                                  bool bConnect)
+{
+    std::vector<std::vector<double>> latency(nClients);
+    std::atomic<int> errors(0);
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nClients; i++)
+    {
+        latency[i].reserve(nRequests);
+        threads.emplace_back(client, iPort, nRequests, bConnect,
+                             std::ref(latency[i]), std::ref(errors));
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    double dSeconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> all;
+    for (auto& one : latency)
+    {
+        all.insert(all.end(), one.begin(), one.end());
+    }
+    bench_result_t result = {0, 0, 0, errors.load()};
+    if (!all.empty())
+    {
+        std::sort(all.begin(), all.end());
+        result.dRate = all.size() / dSeconds;
+        result.dP50 = all[all.size() / 2];
+        result.dP99 = all[all.size() * 99 / 100];
+    }
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    mwfw2* pMwFw = new mwfw2(__FILE__, __FUNCTION__);
+
+    int nClients = argc > 1 ? atoi(argv[1]) : 8;
+    int nRequests = argc > 2 ? atoi(argv[2]) : 20000;
+    int iPort = argc > 3 ? atoi(argv[3]) : 47200;
+
+    auto* pWin = new window();
+    gpSemiGr->cosmetics(
+        SRUL, SRUR, SRLL,
+        SRLR, SVSR, SVSL,
+        SH, SV);
+    char szRow[128];
+    snprintf(szRow, sizeof(szRow),
+             "rpcServer backends: %d clients x %d requests", nClients,
+             nRequests);
+    pWin->set_title(szRow);
+    pWin->add_row("  backend  pattern       req/s     p50 us    p99 us  errors");
+
+    for (rpc_backend_t eBackend : {RPC_BACKEND_EPOLL, RPC_BACKEND_URING})
+    {
+        rpcServer server(
+            sizeof(vparpc_request_t),
+            [](const char* pBuffer, size_t stHave) {
+                return vparpc::frame_length(pBuffer, stHave,
+                                            sizeof(vparpc_request_t));
+            },
+            [](char*, size_t stLen, size_t) {
+                return stLen;
+            });
+        if (!server.listen(iPort))
+        {
+            std::cout << "cannot listen on port " << iPort << ": "
+                << strerror(errno) << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::thread reactor([&server, eBackend] {
+            server.run(CFG_VPARPC_WORKERS, eBackend);
+        });
+        usleep(100000);
+
+        const char* pszBackend =
+            RPC_BACKEND_URING == server.backend() ? "uring" : "epoll";
+        for (bool bConnect : {false, true})
+        {
+            bench_result_t result = run_clients(iPort, nClients,
+                bConnect ? nRequests / 10 : nRequests, bConnect);
+            snprintf(szRow, sizeof(szRow),
+                     "  %-7s  %-10s %9.0f %10.1f %9.1f  %6d", pszBackend,
+                     bConnect ? "connect" : "keep-alive", result.dRate,
+                     result.dP50, result.dP99, result.iErrors);
+            pWin->add_row(szRow);
+        }
+
+        server.stop();
+        reactor.join();
+    }
+
+    pWin->render();
+    delete pWin;
+    delete pMwFw;
+    return EXIT_SUCCESS;
+}
+
+/////////////////////////////////
+// eof - example-rpc-bench.cpp //
+/////////////////////////////////
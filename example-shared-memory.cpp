@@ -183,49 +183,49 @@ int main(int argc, char** argv)
     // Phase 0 - Development directory information
     pWin->add_row("");
     pWin->add_row("=== DEVELOPMENT DIRECTORIES ===");
-    pWin->add_row(std::string("szDevoDir:        ") + gpSh->m_pShMemng->szDevoDir);
-    pWin->add_row(std::string("szBuildFQDS:      ") + gpSh->m_pShMemng->szBuildFQDS);
-    pWin->add_row(std::string("szCgiBinFQDS:     ") + gpSh->m_pShMemng->szCgiBinFQDS);
-    pWin->add_row(std::string("szDocFQDS:        ") + gpSh->m_pShMemng->szDocFQDS);
-    pWin->add_row(std::string("szImgFQDS:        ") + gpSh->m_pShMemng->szImgFQDS);
-    pWin->add_row(std::string("szIncludeFQDS:    ") + gpSh->m_pShMemng->szIncludeFQDS);
-    pWin->add_row(std::string("szLogFQDSS:       ") + gpSh->m_pShMemng->szLogFQDS);
-    pWin->add_row(std::string("szSchemasFQDS:    ") + gpSh->m_pShMemng->szSchemasFQDS);
-    pWin->add_row(std::string("szScriptsFQDS:    ") + gpSh->m_pShMemng->szScriptsFQDS);
-    pWin->add_row(std::string("szStylesFQDS:     ") + gpSh->m_pShMemng->szStylesFQDS);
-    pWin->add_row(std::string("szTempFQDS:       ") + gpSh->m_pShMemng->szTempFQDS);
+    pWin->add_row(std::string("szDevoDir:        ") + gpShMemCfg->get(SHM_STR_DEVO_DIR));
+    pWin->add_row(std::string("szBuildFQDS:      ") + gpShMemCfg->get(SHM_STR_BUILD_FQDS));
+    pWin->add_row(std::string("szCgiBinFQDS:     ") + gpShMemCfg->get(SHM_STR_CGIBIN_FQDS));
+    pWin->add_row(std::string("szDocFQDS:        ") + gpShMemCfg->get(SHM_STR_DOC_FQDS));
+    pWin->add_row(std::string("szImgFQDS:        ") + gpShMemCfg->get(SHM_STR_IMG_FQDS));
+    pWin->add_row(std::string("szIncludeFQDS:    ") + gpShMemCfg->get(SHM_STR_INCLUDE_FQDS));
+    pWin->add_row(std::string("szLogFQDSS:       ") + gpShMemCfg->get(SHM_STR_LOG_FQDS));
+    pWin->add_row(std::string("szSchemasFQDS:    ") + gpShMemCfg->get(SHM_STR_SCHEMAS_FQDS));
+    pWin->add_row(std::string("szScriptsFQDS:    ") + gpShMemCfg->get(SHM_STR_SCRIPTS_FQDS));
+    pWin->add_row(std::string("szStylesFQDS:     ") + gpShMemCfg->get(SHM_STR_STYLES_FQDS));
+    pWin->add_row(std::string("szTempFQDS:       ") + gpShMemCfg->get(SHM_STR_TEMP_FQDS));
 
     // User information
     pWin->add_row("");
     pWin->add_row("=== USER INFORMATION ===");
-    pWin->add_row(std::string("szUser:           ") + gpSh->m_pShMemng->szUser);
-    pWin->add_row(std::string("szHomeFQDS:           ") + gpSh->m_pShMemng->szHomeFQDS);
-    pWin->add_row(std::string("szUserdirFQDS:    ") + gpSh->m_pShMemng->szUserdirFQDS);
-    pWin->add_row(std::string("szSourceFQDS:     ") + gpSh->m_pShMemng->szSourceFQDS);
-    pWin->add_row(std::string("szConfigFQDS:     ") + gpSh->m_pShMemng->szConfigFQDS);
-    pWin->add_row(std::string("szConfigFQFS:     ") + gpSh->m_pShMemng->szConfigFQFS);
+    pWin->add_row(std::string("szUser:           ") + gpShMemCfg->get(SHM_STR_USER));
+    pWin->add_row(std::string("szHomeFQDS:           ") + gpShMemCfg->get(SHM_STR_HOME_FQDS));
+    pWin->add_row(std::string("szUserdirFQDS:    ") + gpShMemCfg->get(SHM_STR_USERDIR_FQDS));
+    pWin->add_row(std::string("szSourceFQDS:     ") + gpShMemCfg->get(SHM_STR_SOURCE_FQDS));
+    pWin->add_row(std::string("szConfigFQDS:     ") + gpShMemCfg->get(SHM_STR_CONFIG_FQDS));
+    pWin->add_row(std::string("szConfigFQFS:     ") + gpShMemCfg->get(SHM_STR_CONFIG_FQFS));
     pWin->add_row(std::string("szStatus:         ") + gpSh->m_pShMemng->szStatus);
 
     // Network information
     pWin->add_row("");
     pWin->add_row("=== NETWORK INFORMATION ===");
-    pWin->add_row(std::string("szHostname:       ") + gpSh->m_pShMemng->szHostname);
-    pWin->add_row(std::string("szIface:          ") + gpSh->m_pShMemng->szIface);
-    pWin->add_row(std::string("szIP:             ") + gpSh->m_pShMemng->szIP);
-    pWin->add_row(std::string("szPublicIP:       ") + gpSh->m_pShMemng->szPublicIP);
-    pWin->add_row(std::string("szProtocol:       ") + gpSh->m_pShMemng->szProtocol);
+    pWin->add_row(std::string("szHostname:       ") + gpShMemCfg->get(SHM_STR_HOSTNAME));
+    pWin->add_row(std::string("szIface:          ") + gpShMemCfg->get(SHM_STR_IFACE));
+    pWin->add_row(std::string("szIP:             ") + gpShMemCfg->get(SHM_STR_IP));
+    pWin->add_row(std::string("szPublicIP:       ") + gpShMemCfg->get(SHM_STR_PUBLIC_IP));
+    pWin->add_row(std::string("szProtocol:       ") + gpShMemCfg->get(SHM_STR_PROTOCOL));
 
     // Web server roots
     pWin->add_row("");
     pWin->add_row("=== WEB SERVER ROOTS ===");
-    pWin->add_row(std::string("szCgiRoot:        ") + gpSh->m_pShMemng->szCgiRoot);
-    pWin->add_row(std::string("szHtmlRoot:       ") + gpSh->m_pShMemng->szImgRoot);
-    pWin->add_row(std::string("szImgRoot:        ") + gpSh->m_pShMemng->szImgRoot);
+    pWin->add_row(std::string("szCgiRoot:        ") + gpShMemCfg->get(SHM_STR_CGI_ROOT));
+    pWin->add_row(std::string("szHtmlRoot:       ") + gpShMemCfg->get(SHM_STR_IMG_ROOT));
+    pWin->add_row(std::string("szImgRoot:        ") + gpShMemCfg->get(SHM_STR_IMG_ROOT));
 
     // RPC and Remote information
     pWin->add_row("");
     pWin->add_row("=== RPC & REMOTE INFORMATION ===");
-    pWin->add_row(std::string("szRpcUuid:        ") + gpSh->m_pShMemng->szRpcUuid);
+    pWin->add_row(std::string("szRpcUuid:        ") + gpShMemCfg->get(SHM_STR_RPC_UUID));
     pWin->add_row(std::string("szRemoteHost:     ") + gpSh->m_pShMemng->szRemoteHost);
     pWin->add_row(std::string("szRemoteAddr:     ") + gpSh->m_pShMemng->szRemoteAddr);
     pWin->add_row(std::string("szRemoteAuth:     ") + gpSh->m_pShMemng->szRemoteAuth);
@@ -319,15 +319,17 @@ int main(int argc, char** argv)
     pWin->add_row("");
     pWin->add_row("=== USER PREFERENCES ===");
     bool foundPrefs = false;
+    MFW_PREFS_T prefs;
     for (int i = 0; i < ROW_DATA+CFG_MAX_USERS && i < 5; i++) { // Limit to first 5 for display
-        if (strlen(gpSh->m_pShMemng->prefs[i].szBodyFGcolor) > 0 || 
-            strlen(gpSh->m_pShMemng->prefs[i].szBodyBGcolor) > 0) {
+        SharedMemoryPrefs::load(i, prefs);
+        if (strlen(prefs.szBodyFGcolor) > 0 || 
+            strlen(prefs.szBodyBGcolor) > 0) {
             char szPrefInfo[128];
             sprintf(szPrefInfo, "User %d Colors - Body: %s/%s, Table: %s/%s", i,
-                    gpSh->m_pShMemng->prefs[i].szBodyFGcolor,
-                    gpSh->m_pShMemng->prefs[i].szBodyBGcolor,
-                    gpSh->m_pShMemng->prefs[i].szTableFGcolor,
-                    gpSh->m_pShMemng->prefs[i].szTableBGcolor);
+                    prefs.szBodyFGcolor,
+                    prefs.szBodyBGcolor,
+                    prefs.szTableFGcolor,
+                    prefs.szTableBGcolor);
             pWin->add_row(szPrefInfo);
             foundPrefs = true;
         }
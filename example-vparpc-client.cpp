@@ -118,11 +118,18 @@ int main(int argc, char** argv)
 
         // Perform RPC calls to retrieve server information
         // Each call populates internal data structures within the CVpaRpc object
-        
+        // Calls in a batch share one round trip; get_creds() needs the
+        // handle get_lookup() returns, so it goes in the second batch.
+
+        pVpaRpc->begin_batch();
         pVpaRpc->get_version();  // Retrieve server version information
         pVpaRpc->get_lookup();   // Perform service lookup operation
+        pVpaRpc->end_batch();
+
+        pVpaRpc->begin_batch();
         pVpaRpc->get_creds();    // Authenticate and get user credentials
         pVpaRpc->get_urls();     // Fetch server URL configurations
+        pVpaRpc->end_batch();
 
         char szAuthToken[64];
         sprintf(szAuthToken, "  auth:         %s",
@@ -43,7 +43,7 @@ std::string htmlbind::hb_ahref(
 {
     std::string ssBuffer;
     ssBuffer = "<a href=\"";
-    ssBuffer.append(gpSh->m_pShMemng->szCgiRoot);
+    ssBuffer.append(gpShMemCfg->get(SHM_STR_CGI_ROOT));
     ssBuffer.append(szUrl);
     ssBuffer.append("\">");
     ssBuffer.append(hb_imgsrc(szImgUrl, width, height));
@@ -69,7 +69,7 @@ std::string htmlbind::hb_imgsrc(
 {
     std::string ssBuffer;
     ssBuffer = "<img src=\"";
-    ssBuffer.append(gpSh->m_pShMemng->szImgRoot);
+    ssBuffer.append(gpShMemCfg->get(SHM_STR_IMG_ROOT));
     ssBuffer.append(szImgUrl);
     ssBuffer.append("\" width=\"");
     ssBuffer.append(std::to_string(width));
@@ -14,8 +14,36 @@ class CVpaRpc
 {
     std::string m_ssSvr; // set by CVpaRpc::CVpaRpc()
     std::string m_ssSvc; // set by CVpaRpc::CVpaRpc()
+    bool m_bBatch;       // set by begin_batch(), cleared by end_batch()
+    bool m_bPipelined;
+    std::vector<vparpc_call_t> m_batch;
+
+    void call(void* pPacket, size_t stLen);
+
 public:
     CVpaRpc(std::string ssHost, std::string ssService);
+
+    /**
+     * Makes the get_ calls that follow only queue their requests; their
+     * results are available from the accessors once end_batch() returns.
+     * A batch is sent in a single write when end_batch() is called. In
+     * pipelined mode each request is sent as soon as it is queued, so the
+     * server is already working on it while the caller queues the rest.
+     *
+     * Each get_ call reuses its own request member, so queue each kind at
+     * most once per batch. get_creds() sends the handle of the previous
+     * get_lookup(), so it cannot share a batch with that lookup;
+     * get_creds(ssAuthUUID) can.
+     */
+    void begin_batch(bool bPipelined = false);
+
+    /**
+     * Sends or collects the queued calls and waits for every reply.
+     *
+     * @return false if any call went unanswered.
+     */
+    bool end_batch();
+
     std::string get_auth();
 
     std::string get_version();
@@ -24,6 +52,7 @@ public:
     int get_lookup();
 
     void get_creds();
+    void get_creds(std::string ssAuthUUID);
     std::string get_creds_username();
     std::string get_creds_firstname();
     std::string get_creds_lastname();
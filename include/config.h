@@ -15,6 +15,13 @@
 #define CFG_HANDLE_NA                0
 #define CFG_FORK_CHILD               0
 #define CFG_MAX_USERS                6
+#define CFG_MAX_SESSIONS         32768  // shared session slots
+#define CFG_SESSION_INDEX_SIZE   65536  // power of two, >= 2x slots
+#define CFG_SESSION_MAX_PROBE       64  // bound on index probe length
+#define CFG_SESSION_MAX_TOMBS     8192  // sweep() rebuilds the index beyond this
+#define CFG_SESSION_LEASE_S       3600  // session lease, renewed on use
+#define CFG_WHEEL_LEVELS             4  // session expiry timing wheel
+#define CFG_WHEEL_SHIFT              6  // 64 one-second slots per level
 //#define CFG_NUM_PASSWDS              2
 #define CFG_NO_HANDLE                0
 #define CFG_PRE_STARTING_HANDLE  ROW_DATA_HDR
@@ -23,8 +30,48 @@
 #define CFG_META_VERSION             "1"
 #define CFG_MUTEX_NAME           "/fw_shmem_mutex"
 #define CFG_MUTEX_MAX_SIZE           64
+#define CFG_SHMLOCK_MAX  (16 + CFG_SHMHEAP_ROOTS) // fixed locks, one per heap map
+#define CFG_STRPOOL_SIZE           8192  // config string arena bytes
+#define CFG_SEQLOCK_STALL        10000  // odd-sequence yields before checking the writer
+#define CFG_SHMVAR_MAX              256  // registered shared variables
+#define CFG_SHMVAR_INDEX_SIZE       512  // power of two, >= 2x variables
+#define CFG_SHMVAR_HEAP_SIZE      32768  // string variable bytes
+#define CFG_SHM_COUNTERS             32  // named sharded counters
+#define CFG_COUNTER_SHARDS           16  // power of two, per-CPU shards
+#define CFG_SHM_NOTIFY_CHANNELS      16  // change notification channels
+#define CFG_SHM_LAYOUT_VERSION        9  // bump on any MFW_SHMEMNG_T change
+#define CFG_SHM_MAX_FIELDS           64  // field table entries in header
+#define CFG_SHM_READY_TIMEOUT_MS  10000  // wait for a segment being built
+#define CFG_SHM_SNAPSHOT_NAME  "shmem.snap" // warm start, in the config dir
+#define CFG_SHMHEAP_NAME     "/fw_shmem_heap" // POSIX shm, variable-size records
+#define CFG_SHMHEAP_VERSION           1  // bump on any MFW_HEAP_T change
+#define CFG_SHMHEAP_SIZE   (64ull << 20) // reserved, pages touched on use
+#define CFG_SHMHEAP_ROOTS            64  // named objects in the heap
 // Generated with: head -c 4096 /dev/urandom | sha256sum | cut -b1-32
 #define CFG_VPA_RPC_PSK    "348bcdbe62fead7028c8010490b27332"
+#define CFG_VPARPC_BACKLOG         1024  // listen() queue of the RPC server
+#define CFG_VPARPC_WORKERS            0  // RPC handler threads, 0 = one per CPU
+#define CFG_VPARPC_MAX_CONNS       4096  // open RPC connections before shedding
+#define CFG_VPARPC_URING_ENTRIES   1024  // io_uring submission queue of the RPC server
+#define CFG_VPARPC_IO_TIMEOUT_MS   5000  // a peer must finish each transfer in this
+#define CFG_VPARPC_KEEPALIVE_MS   15000  // idle wait for the next request on a connection
+#define CFG_VPARPC_PIPELINE_DEPTH    32  // pipelined requests outstanding before waiting
+#define CFG_VPARPC_POOL_IDLE_MS   10000  // pooled connection age limit, under KEEPALIVE
+#define CFG_VPARPC_POOL_MAX_IDLE      4  // pooled connections kept per (host, service)
+#define CFG_VPARPC_DNS_TTL_MS    300000  // cached name and service resolution
+#define CFG_VPARPC_DNS_NEG_TTL_MS  5000  // cached resolution failure
+#define CFG_VPARPC_UNIX_PREFIX   "unix:"  // service names of local AF_UNIX sockets
+#define CFG_VPARPC_UNIX_DIR "/run/vparpc" // where bare unix: names live, as NAME.sock
+#define CFG_VPARPC_UNIX_GROUP "www-data" // local peers of this group skip the PSK
+#define CFG_VPARPC_SHM_PREFIX     "shm:"  // service names of shared-memory rings
+#define CFG_VPARPC_SHM_SLOTS         64  // requests in flight on one ring, power of 2
+#define CFG_VPARPC_SHM_SPIN        4000  // polls before a futex sleep, multi-CPU only
+#define CFG_VPARPC_PREFORK_START      4  // workers vparpc_inetd_server --daemon forks first
+#define CFG_VPARPC_PREFORK_MIN_IDLE   2  // fork more workers below this many idle
+#define CFG_VPARPC_PREFORK_MAX_IDLE   8  // retire idle workers above this many
+#define CFG_VPARPC_PREFORK_MAX       32  // workers of one generation, at most
+#define CFG_VPARPC_PREFORK_SLOTS     64  // scoreboard entries, room for a reload
+#define CFG_VPARPC_PREFORK_RECYCLE 10000 // connections a worker serves before it retires
 
 //#define DANTE_LOCAL_IP_ADDR "192.168.4.194"
 //#define DANTE_PUBLIC_IP_ADDR "12.74.98.86"
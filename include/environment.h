@@ -246,7 +246,7 @@ public:
 	 *         The caller is responsible for handling the memory if the
 	 *         implementation dictates so.
 	 *************************************************************************/
-	char* get_public_ip();
+	const char* get_public_ip();
 
 	/************************************************************************
 	* Updates and stores the system's public IP address in shared memory.
@@ -258,6 +258,13 @@ public:
 	*************************************************************************/
 	void set_public_ip();
 
+	/************************************************************************
+	* Checks the network identity restored from the warm-start snapshot
+	* and clears it if it no longer matches this host's interfaces. Runs
+	* at most once per restored segment.
+	*************************************************************************/
+	void validate_warm_start();
+
 	/************************************************************************
 	 * Checks if the cURL library is installed in the current environment.
 	 *
@@ -370,7 +377,7 @@ public:
 	 * @return A pointer to a null-terminated string containing the CGI root
 	 *         directory path.
 	 *************************************************************************/
-	char* get_cgi_root_as_sz(bool bDebug);
+	const char* get_cgi_root_as_sz(bool bDebug);
 
 	/************************************************************************
 	 * Sets the root directory for CGI scripts.
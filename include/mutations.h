@@ -6,9 +6,9 @@
 // Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
 ////////////////////////////////////////////////////////////////////
 
-#pragma
+#pragma once
 
-#define CFG_MUTEX_NAME           "/fw_shmem_mutex"
+#include "mwfw2.h"
 
 class mutations {
 public:
@@ -16,10 +16,16 @@ public:
 
 };
 
+/**
+ * @class muteInt
+ * @brief An int in the shared segment with atomic get and put.
+ *
+ * Formerly a named semaphore around every access; now a thin wrapper
+ * over shm_atomic<int>, kept for source compatibility. New code should
+ * use shm_atomic<T> directly, or shm_counter for event counts.
+ */
 class muteInt {
-    int * m_pInt;
-    char m_szMutexName[CFG_MUTEX_MAX_SIZE];
-    sem_t* m_mutex_;
+    shm_atomic<int> m_value;
 public:
     muteInt(const char *,int *);
     int get();
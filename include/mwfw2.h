@@ -18,7 +18,6 @@
 //#include "vpadiscserver.h"
 #include "testdiscclient.h"
 #include "testdiscclient.h"
-#include "mutations.h"
 
 
 #ifndef gpCrt
@@ -35,7 +34,19 @@ extern semigraphics* gpSemiGr;
 #include "window.h"
 
 #include "installer.h"
+#include "rpcUring.h"
+#include "rpcServer.h"
 #include "vparpc.h"
+#include "vparpcWire.h"
+#include "vparpcIdl.hh"
+#include "rpcClient.h"
+#include "rpcPool.h"
+#include "rpcShmRing.h"
+#include "rpcPrefork.h"
+
+#ifndef gpRpcPool
+extern rpcPool* gpRpcPool;
+#endif
 #include "CVpaRpc.h"
 
 #ifndef gpSysLog
@@ -107,6 +118,17 @@ extern osIface* gpOS;
 extern schema* gpSchema;
 #endif
 
+#include "shMemMutex.h"
+#include "shMemSess.h"
+#include "shMemCfg.h"
+#include "shMemHdr.h"
+#include "shMemAtomic.h"
+#include "shMemNotify.h"
+#include "shMemHeap.h"
+#include "shMemPrefs.h"
+#include "mutations.h"
+#include "shmvars.h"
+
 #ifndef gpSh
 #include "shared.h"
 extern shared* gpSh;
@@ -122,6 +144,22 @@ extern SharedMemoryMutex* gpShMemMutex;
 extern SharedMemoryManager* gpShMemMgr;
 #endif
 
+#ifndef gpShMemSess
+extern SharedMemorySessions* gpShMemSess;
+#endif
+
+#ifndef gpShMemCfg
+extern SharedMemoryConfig* gpShMemCfg;
+#endif
+
+#ifndef gpShMemVars
+extern shmvars* gpShMemVars;
+#endif
+
+#ifndef gpShMemHeap
+extern shm_heap* gpShMemHeap;
+#endif
+
 #ifndef gpPassword
 #include "password.h"
 extern password* gpPassword;
@@ -137,6 +175,8 @@ extern readCsv* gpCsv;
 extern schemaCompiler* gpSchCC;
 #endif
 
+#include "rpcCompiler.h"
+
 #ifndef gpXinetd
 #include "xinetdctl.h"
 extern xinetdctl* gpXinetd;
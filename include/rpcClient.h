@@ -0,0 +1,251 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/rpcClient.h 2026-10-17 18:40 dwg -            //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "mwfw2.h"
+
+struct rpc_async_call_t;
+
+/**
+ * @struct rpc_reply_t
+ * @brief The outcome of one asynchronous VPA RPC call.
+ *
+ * iError is 0 on success and otherwise an errno value: ETIMEDOUT when
+ * the deadline passed, ECANCELED when the call was cancelled or the
+ * client destroyed, EHOSTUNREACH when the host or service did not
+ * resolve, EPROTO when the reply was not a valid frame, or whatever
+ * connect() or the transfer failed with.
+ */
+struct rpc_reply_t
+{
+    int iError;
+    std::vector<char> reply;
+
+    /**
+     * Copies the reply into a request struct of the matching kind.
+     *
+     * @return false if the call failed or the reply is not that size.
+     */
+    template <typename T>
+    bool as(T& packet) const
+    {
+        if (0 != iError || reply.size() != sizeof(T))
+        {
+            return false;
+        }
+        memcpy(&packet, reply.data(), sizeof(T));
+        return true;
+    }
+};
+
+/**
+ * @class rpcClient
+ * @brief Asynchronous VPA RPC calls driven by one event-loop thread.
+ *
+ * Every call gets its own non-blocking connection. The loop thread
+ * connects, writes the request and reads the reply for all of them at
+ * once, so a dashboard that asks several VPA nodes waits for the slowest
+ * node rather than for the sum of them. Each call has a deadline that
+ * covers connect, send and receive together, and may be cancelled.
+ *
+ * Results are delivered three ways, all on the loop thread: to a
+ * callback, through a std::future, or by resuming a coroutine that
+ * co_awaits the call. Completion handlers and resumed coroutines must
+ * not block, or they hold up every other call.
+ *
+ * @code
+ * rpcClient client;
+ * auto a = client.call("daphne", "vpa", &reqA, sizeof(reqA));
+ * auto b = client.call("luna", "vpa", &reqB, sizeof(reqB));
+ * a.get().as(reqA);
+ * b.get().as(reqB);
+ * @endcode
+ *
+ * Host and service names are resolved on the calling thread, through
+ * rpcResolver's cache, before the call is queued.
+ */
+class rpcClient
+{
+public:
+    typedef uint64_t call_id_t;
+    typedef std::function<void(rpc_reply_t&&)> done_t;
+
+    /**
+     * Starts the loop thread.
+     */
+    rpcClient();
+
+    /**
+     * Completes every outstanding call with ECANCELED and joins the loop
+     * thread. A call made while the destructor runs, for instance from a
+     * completion handler, completes at once with ECANCELED on the thread
+     * that made it.
+     */
+    ~rpcClient();
+
+    rpcClient(const rpcClient&) = delete;
+    rpcClient& operator=(const rpcClient&) = delete;
+
+    /**
+     * Starts a call and returns at once. The request is copied, so the
+     * packet may be reused as soon as start() returns.
+     *
+     * @param pPacket A request; its nSize is the frame length.
+     * @param stLen The size of the packet's buffer.
+     * @param iDeadlineMs Time allowed for the whole call.
+     * @param done Called once, on the loop thread, with the outcome.
+     * @return The call's id, for cancel().
+     */
+    call_id_t start(const std::string& ssHost, const std::string& ssService,
+                    const void* pPacket, size_t stLen, done_t done,
+                    int iDeadlineMs = CFG_VPARPC_IO_TIMEOUT_MS);
+
+    /**
+     * Starts a call whose outcome arrives through a future.
+     *
+     * @param pId If not null, receives the call's id.
+     */
+    std::future<rpc_reply_t> call(const std::string& ssHost,
+                                  const std::string& ssService,
+                                  const void* pPacket, size_t stLen,
+                                  int iDeadlineMs = CFG_VPARPC_IO_TIMEOUT_MS,
+                                  call_id_t* pId = nullptr);
+
+    /**
+     * Makes a call complete with ECANCELED, unless it has completed
+     * already. Unknown ids are ignored.
+     */
+    void cancel(call_id_t id);
+
+    /**
+     * The awaitable returned by co_call(). The call starts when the
+     * coroutine suspends on it, and the coroutine resumes on the loop
+     * thread with the rpc_reply_t as the value of the co_await.
+     */
+    class awaitable
+    {
+    public:
+        awaitable(rpcClient* pClient, std::string ssHost,
+                  std::string ssService, const void* pPacket, size_t stLen,
+                  int iDeadlineMs, call_id_t* pId);
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle);
+
+        rpc_reply_t await_resume()
+        {
+            return std::move(m_reply);
+        }
+
+    private:
+        rpcClient* m_pClient;
+        std::string m_ssHost;
+        std::string m_ssService;
+        std::vector<char> m_request;
+        int m_iDeadlineMs;
+        call_id_t* m_pId;
+        rpc_reply_t m_reply;
+    };
+
+    /**
+     * Starts a call for a coroutine: co_await client.co_call(...).
+     */
+    awaitable co_call(const std::string& ssHost,
+                      const std::string& ssService,
+                      const void* pPacket, size_t stLen,
+                      int iDeadlineMs = CFG_VPARPC_IO_TIMEOUT_MS,
+                      call_id_t* pId = nullptr);
+
+private:
+    int m_fdEpoll;
+    int m_fdWake;
+    std::atomic<call_id_t> m_nextId;
+
+    std::mutex m_queueLock;
+    bool m_bStop;                               // under m_queueLock
+    std::vector<rpc_async_call_t*> m_submitted; // under m_queueLock
+    std::vector<call_id_t> m_cancelled;         // under m_queueLock
+
+    std::unordered_map<call_id_t, rpc_async_call_t*> m_calls; // loop only
+    std::thread m_thread;
+
+    call_id_t submit(const std::string& ssHost, const std::string& ssService,
+                     const void* pPacket, size_t stLen, done_t done,
+                     int iDeadlineMs, call_id_t* pId);
+    void wake();
+    void run();
+    void begin(rpc_async_call_t* pCall);
+    void on_event(rpc_async_call_t* pCall);
+    void finish(rpc_async_call_t* pCall, int iError);
+    int next_timeout();
+};
+
+/**
+ * @struct rpc_task
+ * @brief The return type of a coroutine that makes rpcClient calls.
+ *
+ * The coroutine starts running as soon as it is called; wait() blocks
+ * until it has returned.
+ *
+ * @code
+ * rpc_task query(rpcClient& client, vparpc_request_version_t* pReq)
+ * {
+ *     rpc_reply_t r = co_await client.co_call("daphne", "vpa",
+ *                                             pReq, sizeof(*pReq));
+ *     r.as(*pReq);
+ * }
+ * @endcode
+ */
+struct rpc_task
+{
+    struct promise_type
+    {
+        std::promise<void> done;
+
+        rpc_task get_return_object()
+        {
+            return rpc_task{done.get_future()};
+        }
+
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void()
+        {
+            done.set_value();
+        }
+
+        void unhandled_exception()
+        {
+            done.set_exception(std::current_exception());
+        }
+    };
+
+    std::future<void> m_done;
+
+    void wait()
+    {
+        m_done.get();
+    }
+};
+
+///////////////////////
+// eof - rpcClient.h //
+///////////////////////
@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/rpcCompiler.h 2026-10-17 20:30 dwg -          //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "mwfw2.h"
+
+/**
+ * @enum RPC_IDL_METADATA_T
+ * @brief The columns of an RPC IDL's meta data row.
+ *
+ * - COL_IDL_META_TYPES: The header that receives the message types.
+ * - COL_IDL_META_STUBS: The header that receives codecs, the handler
+ *   list and the client stubs.
+ * - COL_IDL_META_FRAME_SIZE: The size every request struct must have,
+ *   which is the v1 frame length.
+ */
+enum RPC_IDL_METADATA_T
+{
+    COL_IDL_META_ACTIVE,
+    COL_IDL_META_VERSION,
+    COL_IDL_META_META_COLUMNS,
+    COL_IDL_META_DATA_COLUMNS,
+    COL_IDL_META_IDL,
+    COL_IDL_META_TYPES,
+    COL_IDL_META_STUBS,
+    COL_IDL_META_FRAME_SIZE,
+    COL_IDL_META_DESCRIPTION
+};
+
+/**
+ * @enum RPC_IDL_COLUMNS_T
+ * @brief The columns of an RPC IDL's data rows.
+ *
+ * A "func" row declares a function: COL_IDL_FUNCTION is its
+ * vparpc_func_t suffix, COL_IDL_MEMBER names its request struct, handler
+ * and stub (empty if it has none), and COL_IDL_TYPE is "handler" when
+ * the servers implement it. The "field" rows that follow give its
+ * request struct's fields in layout order: COL_IDL_TYPE is char, char8,
+ * int, status or pad, COL_IDL_SIZE the array length, COL_IDL_TAG the v2
+ * wire tag and COL_IDL_DIRECTION in, out or inout.
+ */
+enum RPC_IDL_COLUMNS_T
+{
+    COL_IDL_ACTIVE,
+    COL_IDL_KIND,
+    COL_IDL_FUNCTION,
+    COL_IDL_MEMBER,
+    COL_IDL_TYPE,
+    COL_IDL_SIZE,
+    COL_IDL_TAG,
+    COL_IDL_DIRECTION,
+    COL_IDL_DESCRIPTION
+};
+
+/**
+ * @class rpcCompiler
+ * @brief Generates the VPA RPC message types, codecs, dispatch list and
+ *        client stubs from a CSV IDL, as schemaCompiler does for forms.
+ *
+ * Adding an RPC function then takes a few rows in
+ * schemas/v1/vparpc-idl.csv, a handler in each server, and a run of
+ * "vpautil -i". The generated headers are checked in, so a build does
+ * not need to run the compiler.
+ */
+class rpcCompiler
+{
+public:
+    /**
+     * Reads the IDL and, if it is active and of version 1, writes both
+     * generated headers into include/.
+     *
+     * @param ssIdlName The IDL's file name under schemas/v1/.
+     */
+    rpcCompiler(std::string ssIdlName, bool bDebug);
+
+    /**
+     * @return false if the IDL was inactive, of the wrong version, or
+     *         malformed; nothing is written then.
+     */
+    bool ok() const
+    {
+        return m_bOk;
+    }
+
+private:
+    struct field_t
+    {
+        std::string ssName;
+        std::string ssType;
+        std::string ssSize;
+        std::string ssDirection;
+        std::string ssDescription;
+        int iTag;
+    };
+
+    struct func_t
+    {
+        std::string ssFunc;
+        std::string ssMember;
+        std::string ssDescription;
+        bool bHandler;
+        std::vector<field_t> fields;
+
+        bool has_struct() const
+        {
+            return !ssMember.empty();
+        }
+
+        bool has_codec() const;
+        std::string struct_name() const;
+    };
+
+    readCsv* m_pCsv;
+    std::string m_ssIdl;
+    std::string m_ssFrameSize;
+    std::string m_ssDescription;
+    std::vector<func_t> m_funcs;
+    bool m_bOk;
+
+    bool parse();
+    std::string include_path(const std::string& ssHeader);
+    void write_banner(std::ofstream& ofs, const std::string& ssHeader);
+    void write_eof(std::ofstream& ofs, const std::string& ssHeader);
+    void write_types(const std::string& ssHeader);
+    void write_stubs(const std::string& ssHeader);
+    void write_encode(std::ofstream& ofs, const func_t& func);
+    void write_decode(std::ofstream& ofs, const func_t& func);
+    void write_stub(std::ofstream& ofs, const func_t& func);
+
+    static bool carries(const field_t& field, bool bReply);
+};
+
+/////////////////////////
+// eof - rpcCompiler.h //
+/////////////////////////
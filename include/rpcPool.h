@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/rpcPool.h 2026-10-17 19:20 dwg -              //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "mwfw2.h"
+
+/**
+ * @struct rpc_addr_t
+ * @brief A resolved peer address, ready for connect().
+ */
+struct rpc_addr_t
+{
+    struct sockaddr_storage addr;
+    socklen_t addrLen;
+};
+
+/**
+ * @class rpcResolver
+ * @brief A process-wide cache of resolved (host, service) pairs.
+ *
+ * Names are resolved with getaddrinfo(), which is thread-safe and looks
+ * up the host and the service in one call. A successful answer is kept
+ * for CFG_VPARPC_DNS_TTL_MS and a failure for
+ * CFG_VPARPC_DNS_NEG_TTL_MS, so repeated calls to one peer neither
+ * query DNS nor scan /etc/services. Only IPv4 addresses are returned,
+ * since the RPC servers listen on IPv4 only.
+ *
+ * A service named CFG_VPARPC_UNIX_PREFIX followed by a path, or by a bare
+ * name that stands for CFG_VPARPC_UNIX_DIR/NAME.sock, is a local AF_UNIX
+ * socket instead; the host is then ignored.
+ */
+class rpcResolver
+{
+public:
+    /**
+     * @return false if the host or service does not resolve.
+     */
+    static bool resolve(const std::string& ssHost,
+                        const std::string& ssService, rpc_addr_t& addr);
+
+    /**
+     * Forgets every cached answer, for instance after /etc/hosts changed.
+     */
+    static void flush();
+
+    /**
+     * @return true, with the socket path in ssPath, if ssService names a
+     *         local AF_UNIX socket.
+     */
+    static bool unix_path(const std::string& ssService, std::string& ssPath);
+};
+
+/**
+ * @class rpcPool
+ * @brief Idle RPC connections kept for reuse, keyed by (host, service).
+ *
+ * A connection is released to the pool after a complete exchange and
+ * handed out again for the next call to the same peer, so that call
+ * skips both name resolution and the TCP handshake. Before a connection
+ * is handed out it is health-checked: one that has been idle longer than
+ * CFG_VPARPC_POOL_IDLE_MS, or that the server has closed or written to
+ * unasked, is closed instead. At most CFG_VPARPC_POOL_MAX_IDLE idle
+ * connections are kept per peer.
+ *
+ * The pool is thread-safe; a connection belongs to one caller between
+ * acquire() and release() or discard().
+ */
+class rpcPool
+{
+public:
+    rpcPool();
+
+    /**
+     * Closes every idle connection.
+     */
+    ~rpcPool();
+
+    /**
+     * Hands out a healthy idle connection to the peer, or connects a new
+     * one with CFG_VPARPC_IO_TIMEOUT_MS set on it.
+     *
+     * @param bReused Set to whether the connection came from the pool.
+     * @return The socket, or -1 with errno set (EHOSTUNREACH if the peer
+     *         does not resolve).
+     */
+    int acquire(const std::string& ssHost, const std::string& ssService,
+                bool& bReused);
+
+    /**
+     * Returns a connection after a complete exchange. The caller must not
+     * use it afterwards.
+     */
+    void release(const std::string& ssHost, const std::string& ssService,
+                 int fd);
+
+    /**
+     * Closes a connection that failed or is in an unknown state.
+     */
+    void discard(int fd);
+
+    /**
+     * @return The number of idle connections held, over all peers.
+     */
+    size_t idle();
+
+private:
+    struct idle_t
+    {
+        int fd;
+        std::chrono::steady_clock::time_point since;
+    };
+
+    std::mutex m_lock;
+    std::unordered_map<std::string, std::deque<idle_t>> m_idle;
+
+    static bool healthy(const idle_t& conn,
+                        std::chrono::steady_clock::time_point now);
+};
+
+/////////////////////
+// eof - rpcPool.h //
+/////////////////////
@@ -0,0 +1,173 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/rpcPrefork.h 2026-10-17 23:40 dwg -           //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "mwfw2.h"
+
+#define RPCPREFORK_MAGIC      0x4b524f46  // "FORK"
+#define RPCPREFORK_VERSION    1           // bump on any MFW_PREFORK_T change
+
+/**
+ * The life of a scoreboard entry, as its worker reports it. The master
+ * fills an EMPTY entry when it forks a worker (STARTING); the worker is
+ * IDLE while it waits in accept(), BUSY while it holds a connection and
+ * EXITING on its way out, and the master empties the entry once it has
+ * reaped the worker.
+ */
+enum rpcprefork_state_t
+{
+    RPCPREFORK_EMPTY = 0,
+    RPCPREFORK_STARTING,
+    RPCPREFORK_IDLE,
+    RPCPREFORK_BUSY,
+    RPCPREFORK_EXITING
+};
+
+/**
+ * @struct MFW_PREFORK_SLOT_T
+ * @brief One worker. The worker writes its state and counters; the master
+ *        writes pid, uGeneration and uRetire, which it sets when it tells
+ *        the worker to go.
+ */
+struct MFW_PREFORK_SLOT_T
+{
+    alignas(64) uint32_t uState;
+    uint32_t uRetire;
+    uint32_t uGeneration;
+    pid_t pid;
+    uint64_t u64Connections;
+    uint64_t u64Requests;
+    int64_t i64Started;         // when forked, seconds since the epoch
+    int64_t i64Since;           // when uState last changed, likewise
+};
+
+/**
+ * @struct MFW_PREFORK_T
+ * @brief The scoreboard of a daemon: its master, the generation now being
+ *        forked, and an entry per worker of this and older generations.
+ */
+struct MFW_PREFORK_T
+{
+    uint32_t uMagic;
+    uint32_t uVersion;
+    pid_t pidMaster;
+    uint32_t uGeneration;       // advanced by every reload
+    uint64_t u64Reloads;
+    int64_t i64Started;
+    MFW_PREFORK_SLOT_T slots[CFG_VPARPC_PREFORK_SLOTS];
+};
+
+static_assert(CFG_VPARPC_PREFORK_MAX <= CFG_VPARPC_PREFORK_SLOTS,
+              "a generation must fit on the scoreboard");
+
+/**
+ * @class rpcPrefork
+ * @brief A pre-forked pool of worker processes sharing one listening
+ *        socket, with a master that keeps the pool sized and reloads it.
+ *
+ * Each worker blocks in accept() on the listening socket and serves the
+ * connection it gets with the handler, then goes back for another; the
+ * kernel wakes one worker per connection. The process setup that xinetd
+ * would repeat per connection is done once, in the master, and inherited
+ * by every fork.
+ *
+ * Once a second the master counts the IDLE workers of its generation on
+ * the scoreboard. It forks more while there are fewer than
+ * CFG_VPARPC_PREFORK_MIN_IDLE of them, or fewer than
+ * CFG_VPARPC_PREFORK_START workers in all, and retires one while there
+ * are more than CFG_VPARPC_PREFORK_MAX_IDLE. It forks at most one worker
+ * in the first second of a shortage and at most twice as many in each
+ * second it lasts, which also bounds how fast it replaces workers that
+ * keep dying. A worker leaves by itself after CFG_VPARPC_PREFORK_RECYCLE
+ * connections, and when the master dies.
+ *
+ * SIGHUP reloads: every worker finishes its current request and exits,
+ * and the master re-executes its program with the listening socket still
+ * on standard input, so that a new binary and configuration take over
+ * without a connection being refused. The new master finds the old
+ * workers on the scoreboard and reaps them. SIGTERM and SIGINT stop the
+ * pool the same way, without the re-execution.
+ *
+ * The scoreboard is a POSIX shared memory object that everyone may read,
+ * so that snapshot() can show it from another process. Only the master's
+ * user may write it, and the master signals only pids that are its own
+ * unreaped children, whatever the scoreboard says.
+ */
+class rpcPrefork
+{
+public:
+    /**
+     * Serves one accepted connection, which the worker closes when it
+     * returns.
+     *
+     * @return The number of requests answered on the connection.
+     */
+    typedef std::function<size_t(int fd)> conn_handler_t;
+
+    /**
+     * Creates, or takes over after a reload, the scoreboard ssName. An
+     * object of that name that this user did not create is replaced.
+     *
+     * @param fdListen A listening stream socket, which must be standard
+     *        input for reload() to keep it across the re-execution.
+     * @throws std::system_error if the scoreboard cannot be set up.
+     */
+    rpcPrefork(const std::string& ssName, int fdListen);
+
+    /**
+     * Unmaps the scoreboard and removes it.
+     */
+    ~rpcPrefork();
+
+    /**
+     * @return true if fd is a listening socket, as standard input is
+     *         when xinetd runs a "wait = yes" stream service.
+     */
+    static bool is_listener(int fd);
+
+    /**
+     * Copies the scoreboard ssName of a running daemon into board.
+     *
+     * @return false if there is no such daemon.
+     */
+    static bool snapshot(const std::string& ssName, MFW_PREFORK_T& board);
+
+    /**
+     * @return true in a worker that has been told to go; its connection
+     *         handler should return once the current request is answered.
+     */
+    static bool retiring();
+
+    /**
+     * Runs the master until SIGTERM or SIGINT; workers never return.
+     *
+     * @param argv The program's arguments, re-executed by a reload; with
+     *        nullptr a reload only replaces the workers.
+     * @return The exit status for the master.
+     */
+    int run(const conn_handler_t& handler, char* const argv[]);
+
+private:
+    std::string m_ssObject;
+    int m_fdListen;
+    MFW_PREFORK_T* m_pBoard;
+    int m_iRate;                // workers the next shortage may fork
+
+    bool spawn(uint32_t uSlot, const conn_handler_t& handler);
+    [[noreturn]] void worker(uint32_t uSlot, const conn_handler_t& handler);
+    void reap();
+    void retire(uint32_t uSlot);
+    void balance(const conn_handler_t& handler);
+    void reload(char* const argv[]);
+    void drain();
+};
+
+////////////////////////
+// eof - rpcPrefork.h //
+////////////////////////
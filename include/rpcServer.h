@@ -0,0 +1,215 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/rpcServer.h 2026-10-17 17:50 dwg -            //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "mwfw2.h"
+
+struct rpc_conn_t;
+class rpcUring;
+
+/**
+ * @enum rpc_backend_t
+ * @brief How rpcServer::run() waits for and performs socket I/O.
+ *
+ * - RPC_BACKEND_EPOLL: Non-blocking sockets and epoll; every accept,
+ *   recv, send and re-arm is a system call of its own.
+ * - RPC_BACKEND_URING: io_uring. One multishot accept serves every new
+ *   peer, requests and replies move through a registered buffer, each
+ *   reply is linked to the read of the next request, and a single
+ *   io_uring_enter() submits all of that and waits. Falls back to
+ *   RPC_BACKEND_EPOLL where the kernel lacks a needed feature.
+ */
+enum rpc_backend_t
+{
+    RPC_BACKEND_EPOLL = 0,
+    RPC_BACKEND_URING
+};
+
+/**
+ * @class rpcServer
+ * @brief A request/response TCP server built on an epoll reactor and a
+ *        fixed pool of worker threads.
+ *
+ * The thread that calls run() is the reactor. It owns the listening
+ * socket and every connection: it accepts, reads requests with
+ * non-blocking sockets, writes whatever part of a reply the worker could
+ * not, enforces CFG_VPARPC_IO_TIMEOUT_MS on each transfer and closes.
+ * A peer that sends slowly or not at all therefore only ties up its own
+ * connection, never the accept loop.
+ *
+ * Connections persist: after a reply the reactor waits up to
+ * CFG_VPARPC_KEEPALIVE_MS for the next request on the same connection,
+ * and a request that arrived early, behind the previous one, is kept
+ * and served in order.
+ *
+ * Once a request is complete the reactor queues it for the workers. A
+ * worker runs the handler in place on the connection's buffer, tries to
+ * send the reply at once, and passes the connection back through a
+ * second queue and an eventfd. The reactor is the only thread that frees
+ * a connection, so a connection is never closed under a worker.
+ *
+ * The handler runs on several threads at once and must be thread-safe.
+ *
+ * With RPC_BACKEND_URING the reactor drives an io_uring instead, and the
+ * workers leave the sending to it; everything else is the same.
+ *
+ * listen_unix() serves a local AF_UNIX socket instead of TCP. Each peer's
+ * credentials are read with SO_PEERCRED when it connects, and while a
+ * worker runs the request of a trusted one peer_trusted() is true.
+ */
+class rpcServer
+{
+public:
+    /**
+     * Inspects the bytes received so far.
+     *
+     * @return The total length of the request, 0 if more bytes are needed
+     *         to tell, or -1 if the request is malformed.
+     */
+    typedef std::function<ssize_t(const char* pBuffer, size_t stHave)>
+        framer_t;
+
+    /**
+     * Processes a complete request of stLen bytes, writing the reply over
+     * it in the same buffer of stMax bytes.
+     *
+     * @return The length of the reply.
+     */
+    typedef std::function<size_t(char* pBuffer, size_t stLen, size_t stMax)>
+        handler_t;
+
+    /**
+     * @param stMaxMessage The largest request or reply, in bytes.
+     * @param framer Finds the end of a request.
+     * @param handler Turns a request into a reply.
+     */
+    rpcServer(size_t stMaxMessage, framer_t framer, handler_t handler);
+
+    /**
+     * Closes the listening socket and the epoll and wake-up descriptors.
+     */
+    ~rpcServer();
+
+    /**
+     * Binds a non-blocking listening socket to iPort on all interfaces.
+     *
+     * @return false, with errno set, if the socket cannot be set up.
+     */
+    bool listen(int iPort, int iBacklog = CFG_VPARPC_BACKLOG);
+
+    /**
+     * Binds a non-blocking listening socket to the AF_UNIX path ssPath,
+     * which the destructor removes again.
+     *
+     * @return false, with errno set, if the socket cannot be set up or
+     *         another server is already listening on it.
+     */
+    bool listen_unix(const std::string& ssPath,
+                     int iBacklog = CFG_VPARPC_BACKLOG);
+
+    /**
+     * Called from a handler.
+     *
+     * @return true if the request came over listen_unix() from root, from
+     *         the server's own user or from a member of
+     *         CFG_VPARPC_UNIX_GROUP, which need no further authentication.
+     */
+    static bool peer_trusted();
+
+    /**
+     * Sets what peer_trusted() returns on this thread, for transports
+     * that vouch for their peers without rpcServer, such as rpcShmRing.
+     */
+    static void set_peer_trusted(bool bTrusted);
+
+    /**
+     * Starts the workers and runs the reactor until stop() is called,
+     * then joins the workers and closes every connection.
+     *
+     * @param iWorkers The number of worker threads; 0 means one per
+     *        online CPU.
+     * @param eBackend The I/O backend to try; see backend().
+     */
+    void run(int iWorkers = CFG_VPARPC_WORKERS,
+             rpc_backend_t eBackend = RPC_BACKEND_EPOLL);
+
+    /**
+     * @return The backend run() is using, or last used. It differs from
+     *         the one asked for after a fallback to epoll.
+     */
+    rpc_backend_t backend() const
+    {
+        return m_eBackend;
+    }
+
+    /**
+     * Makes run() return. Safe to call from another thread or from a
+     * signal handler.
+     */
+    void stop();
+
+private:
+    size_t m_stMaxMessage;
+    framer_t m_framer;
+    handler_t m_handler;
+
+    int m_fdListen;
+    std::string m_ssUnixPath;           // listen_unix() only
+    gid_t m_gidTrusted;
+    int m_fdEpoll;
+    int m_fdWake;
+    std::atomic<bool> m_bStop;
+    rpc_backend_t m_eBackend;
+
+    std::mutex m_queueLock;
+    std::condition_variable m_queueCond;
+    std::deque<rpc_conn_t*> m_ready;    // requests waiting for a worker
+    std::deque<rpc_conn_t*> m_done;     // replies handed back to the reactor
+
+    std::unordered_set<rpc_conn_t*> m_conns;   // reactor thread only
+
+    // RPC_BACKEND_URING only; all owned by the reactor thread.
+    rpcUring* m_pRing;
+    std::vector<char> m_arena;          // the registered buffer, in slots
+    std::vector<int> m_freeSlots;
+    bool m_bMultishot;
+    uint64_t m_u64Wake;
+    struct __kernel_timespec m_tsExpire;
+
+    void run_epoll();
+    void run_uring();
+    bool uring_setup();
+    void uring_accept();
+    void uring_read(rpc_conn_t* pConn);
+    void uring_write(rpc_conn_t* pConn);
+    void uring_event(const struct io_uring_cqe& cqe);
+    void uring_on_accept(const struct io_uring_cqe& cqe);
+    void uring_on_read(rpc_conn_t* pConn, int iResult);
+    void uring_on_write(rpc_conn_t* pConn, int iResult);
+    void uring_drain_done();
+    void uring_arm_wake();
+    void uring_arm_expire();
+    rpc_conn_t* new_conn(int fd);
+    bool trusted(int fd) const;
+    void accept_all();
+    int dispatch(rpc_conn_t* pConn);
+    void on_readable(rpc_conn_t* pConn);
+    void on_writable(rpc_conn_t* pConn);
+    void next_request(rpc_conn_t* pConn);
+    void drain_done();
+    void expire();
+    void arm(rpc_conn_t* pConn, uint32_t uEvents);
+    void close_conn(rpc_conn_t* pConn);
+    void free_conn(rpc_conn_t* pConn);
+    void worker();
+};
+
+///////////////////////
+// eof - rpcServer.h //
+///////////////////////
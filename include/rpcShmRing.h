@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/rpcShmRing.h 2026-10-17 22:30 dwg -           //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "mwfw2.h"
+
+#define RPCSHM_MAGIC          0x474e4952  // "RING"
+#define RPCSHM_VERSION        1           // bump on any MFW_RPCSHM_T change
+
+enum rpcshm_state_t
+{
+    RPCSHM_UNUSED = 0,
+    RPCSHM_READY
+};
+
+/**
+ * The life of a slot. A caller claims a FREE slot, fills it in place and
+ * queues it; a server worker takes it (BUSY), answers in place and marks
+ * it REPLIED; the caller reads the reply and frees it. A caller that
+ * gives up marks its slot ABANDONED, and the server frees it instead.
+ */
+enum rpcshm_slot_state_t
+{
+    RPCSHM_SLOT_FREE = 0,
+    RPCSHM_SLOT_CLAIMED,
+    RPCSHM_SLOT_QUEUED,
+    RPCSHM_SLOT_BUSY,
+    RPCSHM_SLOT_REPLIED,
+    RPCSHM_SLOT_ABANDONED
+};
+
+/**
+ * @struct MFW_RPCSHM_SLOT_T
+ * @brief One request in flight: its state, which is also the futex word
+ *        its caller sleeps on, and the request itself, answered in place.
+ */
+struct MFW_RPCSHM_SLOT_T
+{
+    alignas(64) uint32_t uState;
+    uint32_t uWaiting;          // the caller sleeps on uState
+    uint32_t uEpoch;            // MFW_RPCSHM_T::uEpoch when claimed
+    pid_t pidOwner;
+    uint64_t u64Len;            // request length, then reply length
+    alignas(64) char buffer[sizeof(vparpc_request_t)];
+};
+
+/**
+ * @struct MFW_RPCSHM_T
+ * @brief The region: a header, a bounded MPMC queue of slot numbers
+ *        (Vyukov's, one sequence number per cell) and the slots.
+ *
+ * The queue has a cell per slot and a slot is queued at most once at a
+ * time, so a caller that holds a slot always finds room to queue it.
+ */
+struct MFW_RPCSHM_T
+{
+    uint32_t uMagic;
+    uint32_t uVersion;
+    uint32_t uState;
+    uint32_t uEpoch;            // advanced whenever a server resets the ring
+    pid_t pidServer;
+    alignas(64) uint64_t u64Tail;       // callers queue here
+    alignas(64) uint64_t u64Head;       // workers take from here
+    alignas(64) uint32_t uDoorbell;     // the futex word idle workers sleep on
+    uint32_t uSleepers;
+    struct
+    {
+        alignas(16) uint64_t u64Seq;
+        uint32_t uSlot;
+    } cells[CFG_VPARPC_SHM_SLOTS];
+    MFW_RPCSHM_SLOT_T slots[CFG_VPARPC_SHM_SLOTS];
+};
+
+static_assert(0 == (CFG_VPARPC_SHM_SLOTS & (CFG_VPARPC_SHM_SLOTS - 1)),
+              "CFG_VPARPC_SHM_SLOTS must be a power of two");
+
+/**
+ * @class rpcShmRing
+ * @brief A request/response transport between processes on one host,
+ *        through a POSIX shared memory region instead of a socket.
+ *
+ * A caller claims a slot, writes its request straight into it and queues
+ * the slot number; a server worker runs the handler on the slot buffer
+ * where it lies, and the reply flips the slot's state. Nothing is copied
+ * and, while both sides are busy, no system call is made: each side
+ * polls for CFG_VPARPC_SHM_SPIN rounds, on hosts with more than one CPU,
+ * before it sleeps on a futex, and a futex is woken only if somebody
+ * sleeps on it.
+ *
+ * The server creates the region, readable and writable by its user and
+ * by CFG_VPARPC_UNIX_GROUP, and treats every request as coming from a
+ * trusted peer (see rpcServer::peer_trusted()): whoever can map the
+ * region is one of them. It therefore always creates a new object, and
+ * callers map only one that a trusted user owns and nobody else can
+ * write. A server that finds an older region retires it, advancing its
+ * uEpoch, which fails the calls that were in flight instead of
+ * answering them, and callers move to the new region on their next
+ * call. Slots claimed by callers that have since died are freed by an
+ * idle worker.
+ */
+class rpcShmRing
+{
+public:
+    /**
+     * Creates the region of a server, retiring any older one.
+     *
+     * @throws std::system_error if it cannot be set up.
+     */
+    explicit rpcShmRing(const std::string& ssName);
+
+    /**
+     * Unmaps the region. The server's region is left in place, so that
+     * callers still mapping it fail their calls rather than crash.
+     */
+    ~rpcShmRing();
+
+    /**
+     * @return true, with the ring's name in ssRing, if ssService names a
+     *         ring: CFG_VPARPC_SHM_PREFIX and a name.
+     */
+    static bool ring_name(const std::string& ssService, std::string& ssRing);
+
+    /**
+     * @return The caller's mapping of a ring, mapped on first use and
+     *         kept until a newer server retires the ring, or nullptr if
+     *         no server has created it or its owner is not trusted.
+     */
+    static rpcShmRing* attach(const std::string& ssRing);
+
+    /**
+     * Claims a free slot, waiting up to CFG_VPARPC_IO_TIMEOUT_MS for one.
+     *
+     * @return The slot's buffer, sizeof(vparpc_request_t) bytes, or
+     *         nullptr.
+     */
+    char* claim();
+
+    /**
+     * Queues the request of stLen bytes in a claimed buffer.
+     *
+     * @return false if the slot is no longer the caller's, because a
+     *         server reset the ring since it was claimed; the request was
+     *         not queued and the buffer must not be used again.
+     */
+    bool submit(char* pBuffer, size_t stLen);
+
+    /**
+     * Waits up to CFG_VPARPC_IO_TIMEOUT_MS for the reply to a submitted
+     * buffer, which is then in the buffer.
+     *
+     * @return The length of the reply, or 0 if there is none; the slot
+     *         is then no longer the caller's and must not be released.
+     */
+    size_t wait(char* pBuffer);
+
+    /**
+     * Frees a buffer after its reply has been read, or one that was
+     * claimed and never submitted.
+     */
+    void release(char* pBuffer);
+
+    /**
+     * Runs the handler on every request with iWorkers threads until
+     * stop() is called. The handler is the one rpcServer takes.
+     *
+     * @param iWorkers The number of worker threads; 0 means one per
+     *        online CPU.
+     */
+    void serve(int iWorkers, const rpcServer::handler_t& handler);
+
+    /**
+     * Makes serve() return. Safe to call from another thread.
+     */
+    void stop();
+
+private:
+    rpcShmRing(MFW_RPCSHM_T* pRing);
+
+    MFW_RPCSHM_T* m_pRing;
+    std::atomic<bool> m_bStop;
+    bool m_bSpin;
+
+    MFW_RPCSHM_SLOT_T* slot_of(char* pBuffer);
+    bool dequeue(uint32_t& uSlot);
+    void handle(uint32_t uSlot, const rpcServer::handler_t& handler);
+    void reap();
+    void worker(const rpcServer::handler_t& handler);
+};
+
+////////////////////////
+// eof - rpcShmRing.h //
+////////////////////////
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/rpcUring.h 2026-10-17 21:10 dwg -             //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "mwfw2.h"
+
+/**
+ * @class rpcUring
+ * @brief A minimal io_uring: the two mapped rings and the three system
+ *        calls, used directly so the framework needs no liburing.
+ *
+ * Only what rpcServer uses is here. Submission entries are filled in
+ * place and go to the kernel together on the next submit(), so one
+ * system call both hands over every queued operation and waits for the
+ * next completion. The ring is not thread-safe; one thread owns it.
+ */
+class rpcUring
+{
+public:
+    rpcUring();
+
+    /**
+     * Unmaps the rings and closes the ring, which cancels whatever is
+     * still in flight.
+     */
+    ~rpcUring();
+
+    /**
+     * Creates a ring with uEntries submission entries and twice as many
+     * completion entries.
+     *
+     * @return false, with errno set, if the kernel refuses.
+     */
+    bool setup(unsigned uEntries);
+
+    /**
+     * @return true if this kernel has io_uring, does not drop completions
+     *         when the queue is full, and knows every operation rpcServer
+     *         submits.
+     */
+    static bool supported();
+
+    /**
+     * Registers one buffer for IORING_OP_READ_FIXED and
+     * IORING_OP_WRITE_FIXED, which then use buf_index 0 and any address
+     * inside it.
+     *
+     * @return false, with errno set, if the kernel refuses, typically
+     *         because RLIMIT_MEMLOCK is too low.
+     */
+    bool register_buffer(void* pBase, size_t stLen);
+
+    /**
+     * @return A cleared submission entry; if the queue is full the
+     *         pending entries are submitted first to make room.
+     */
+    struct io_uring_sqe* sqe();
+
+    /**
+     * Makes room for uCount entries the same way, so that the next
+     * uCount calls to sqe() neither fail nor submit. A linked chain must
+     * be reserved as a whole, or part of it may reach the kernel before
+     * its link flag is set.
+     *
+     * @return false if the kernel has not consumed enough entries.
+     */
+    bool reserve(unsigned uCount);
+
+    /**
+     * Submits the pending entries and waits until at least uWait
+     * completions are ready.
+     *
+     * @return The number submitted, or -1 with errno set.
+     */
+    int submit(unsigned uWait);
+
+    /**
+     * Takes the oldest completion.
+     *
+     * @return false if none is ready.
+     */
+    bool cqe(struct io_uring_cqe& cqe);
+
+private:
+    int m_fd;
+    void* m_pSqRing;
+    size_t m_stSqRing;
+    void* m_pCqRing;
+    size_t m_stCqRing;
+    struct io_uring_sqe* m_pSqes;
+    size_t m_stSqes;
+
+    unsigned* m_puSqHead;
+    unsigned* m_puSqTail;
+    unsigned* m_puSqArray;
+    unsigned m_uSqMask;
+    unsigned m_uSqEntries;
+    unsigned m_uSqTail;         // entries filled in, not yet published
+
+    unsigned* m_puCqHead;
+    unsigned* m_puCqTail;
+    unsigned m_uCqMask;
+    struct io_uring_cqe* m_pCqes;
+};
+
+//////////////////////
+// eof - rpcUring.h //
+//////////////////////
@@ -0,0 +1,246 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/shMemAtomic.h 2026-10-17 14:10 dwg -          //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "mwfw2.h"
+
+#define SHM_COUNTER_NAME_SIZE_MAX 32
+
+/**
+ * Slow path of shm_atomic<T> for types the hardware cannot update
+ * atomically: the segment lock (gpShMemMutex). Defined out of line so
+ * that this header does not depend on the order in which mwfw2.h
+ * declares the framework globals.
+ */
+void shm_atomic_lock();
+void shm_atomic_unlock();
+
+/**
+ * @class shm_atomic
+ * @brief Atomic access to a value of type T that lives in the shared
+ *        segment.
+ *
+ * The value itself stays a plain T inside MFW_SHMEMNG_T, so the segment
+ * layout does not change. If std::atomic_ref<T> is always lock-free for
+ * T, every operation is a single atomic instruction on the shared value.
+ * Otherwise, for example for a large struct, every operation takes the
+ * segment lock instead; the choice is made at compile time.
+ *
+ * @tparam T A trivially copyable type.
+ */
+template<typename T>
+class shm_atomic
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "shm_atomic<T> requires a trivially copyable T");
+
+    T* m_pValue;
+
+public:
+    static constexpr bool lock_free =
+        std::atomic_ref<T>::is_always_lock_free;
+
+    /**
+     * @param pValue The value in the shared segment. It must be suitably
+     *        aligned for std::atomic_ref<T>.
+     */
+    explicit shm_atomic(T* pValue) : m_pValue(pValue)
+    {
+    }
+
+    T load(std::memory_order order = std::memory_order_seq_cst) const
+    {
+        if constexpr (lock_free)
+        {
+            return std::atomic_ref<T>(*m_pValue).load(order);
+        }
+        else
+        {
+            shm_atomic_lock();
+            T value = *m_pValue;
+            shm_atomic_unlock();
+            return value;
+        }
+    }
+
+    void store(T value, std::memory_order order = std::memory_order_seq_cst)
+    {
+        if constexpr (lock_free)
+        {
+            std::atomic_ref<T>(*m_pValue).store(value, order);
+        }
+        else
+        {
+            shm_atomic_lock();
+            *m_pValue = value;
+            shm_atomic_unlock();
+        }
+    }
+
+    T exchange(T value, std::memory_order order = std::memory_order_seq_cst)
+    {
+        if constexpr (lock_free)
+        {
+            return std::atomic_ref<T>(*m_pValue).exchange(value, order);
+        }
+        else
+        {
+            shm_atomic_lock();
+            T old = *m_pValue;
+            *m_pValue = value;
+            shm_atomic_unlock();
+            return old;
+        }
+    }
+
+    /**
+     * On failure, expected receives the current value. The locked
+     * variant compares the object representations, which is what
+     * std::atomic_ref does as well.
+     */
+    bool compare_exchange(T& expected, T desired,
+                          std::memory_order order = std::memory_order_seq_cst)
+    {
+        if constexpr (lock_free)
+        {
+            return std::atomic_ref<T>(*m_pValue).compare_exchange_strong(
+                expected, desired, order);
+        }
+        else
+        {
+            shm_atomic_lock();
+            bool bEqual = 0 == memcmp(m_pValue, &expected, sizeof(T));
+            if (bEqual)
+            {
+                *m_pValue = desired;
+            }
+            else
+            {
+                expected = *m_pValue;
+            }
+            shm_atomic_unlock();
+            return bEqual;
+        }
+    }
+
+    /**
+     * Integral types only.
+     *
+     * @return The value before the addition.
+     */
+    T fetch_add(T delta, std::memory_order order = std::memory_order_seq_cst)
+        requires std::is_integral_v<T>
+    {
+        return std::atomic_ref<T>(*m_pValue).fetch_add(delta, order);
+    }
+
+    T fetch_sub(T delta, std::memory_order order = std::memory_order_seq_cst)
+        requires std::is_integral_v<T>
+    {
+        return std::atomic_ref<T>(*m_pValue).fetch_sub(delta, order);
+    }
+};
+
+/**
+ * Lifecycle of a counter slot; the same protocol as the lock table.
+ */
+enum shmcounter_state_t
+{
+    SHMCOUNTER_UNUSED = 0,
+    SHMCOUNTER_INITIALIZING,
+    SHMCOUNTER_READY
+};
+
+/**
+ * @struct MFW_COUNTER_T
+ * @brief One sharded counter. Each shard has a cache line to itself, so
+ *        processes running on different CPUs never contend for a line.
+ */
+struct MFW_COUNTER_T
+{
+    alignas(64) uint32_t uState;               // shmcounter_state_t
+    char szName[SHM_COUNTER_NAME_SIZE_MAX];
+    struct
+    {
+        alignas(64) uint64_t u64Count;
+    } shards[CFG_COUNTER_SHARDS];
+};
+
+/**
+ * @struct MFW_COUNTER_TABLE_T
+ * @brief The named counters, embedded in MFW_SHMEMNG_T.
+ */
+struct MFW_COUNTER_TABLE_T
+{
+    MFW_COUNTER_T counters[CFG_SHM_COUNTERS];
+};
+
+/**
+ * @class shm_counter
+ * @brief A named, per-CPU sharded event counter in the shared segment.
+ *
+ * add() increments only the shard of the CPU the caller is running on:
+ * one uncontended atomic add on a cache line that, in the common case,
+ * is already local to that CPU. value() sums the shards, so reading is
+ * the expensive side, which suits counters that are bumped on every
+ * request and read by a monitor now and then. A process that migrates
+ * between CPUs mid-call simply adds to another shard; the total is
+ * still exact.
+ */
+class shm_counter
+{
+    MFW_COUNTER_T* m_pCounter;
+
+public:
+    /**
+     * Binds to the counter with the given name, claiming a free slot for
+     * it on first use.
+     *
+     * @throws std::system_error if the counter table is full.
+     */
+    explicit shm_counter(const char* pszName);
+
+    /**
+     * Adds to the shard of the current CPU.
+     */
+    void add(uint64_t u64Delta = 1)
+    {
+        unsigned uShard = (unsigned)sched_getcpu() & (CFG_COUNTER_SHARDS - 1);
+        std::atomic_ref<uint64_t>(m_pCounter->shards[uShard].u64Count)
+            .fetch_add(u64Delta, std::memory_order_relaxed);
+    }
+
+    /**
+     * @return The sum of all shards. Not a snapshot: increments racing
+     *         the read may or may not be included.
+     */
+    uint64_t value() const;
+
+    /**
+     * @return The name of the counter.
+     */
+    const char* name() const;
+
+    /**
+     * Calls fn(name, value) for every counter in the table. For monitors
+     * such as view_shared.
+     */
+    static void for_each(const std::function<void(const char*, uint64_t)>& fn);
+
+    /**
+     * Carries the table over from an older segment during a layout
+     * migration; see shm_migrate_fn. A slot caught mid-claim is freed.
+     */
+    static void migrate(void* pDst, const void* pSrc,
+                        size_t stDst, size_t stSrc);
+};
+
+/////////////////////////
+// eof - shMemAtomic.h //
+/////////////////////////
@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/shMemCfg.h 2026-10-17 09:40 dwg -             //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "mwfw2.h"
+
+/**
+ * Identifies one configuration string in the string pool. The order
+ * matters: the arena is always packed in enum order, so the strings that
+ * nearly every request reads are listed first and end up together in
+ * the first cache lines after the descriptors.
+ */
+enum shm_str_t
+{
+    // hot - read on nearly every request
+    SHM_STR_PROTOCOL = 0,
+    SHM_STR_IP,
+    SHM_STR_USER,
+    SHM_STR_CGI_ROOT,
+    SHM_STR_IMG_ROOT,
+    SHM_STR_LOG_FQDS,
+    SHM_STR_RPC_UUID,
+    SHM_STR_CONFIG_FQDS,
+    SHM_STR_CONFIG_FQFS,
+    SHM_STR_STYLES_FQDS,
+    SHM_STR_HTML_ROOT,
+    SHM_STR_STYLES_FILE_ROOT,
+
+    // cold - start-up, installer and diagnostics
+    SHM_STR_HOSTNAME,
+    SHM_STR_PUBLIC_IP,
+    SHM_STR_IFACE,
+    SHM_STR_DEVO_DIR,
+    SHM_STR_BUILD_FQDS,
+    SHM_STR_CGIBIN_FQDS,
+    SHM_STR_DOC_FQDS,
+    SHM_STR_HOME_FQDS,
+    SHM_STR_IMG_FQDS,
+    SHM_STR_INCLUDE_FQDS,
+    SHM_STR_SCHEMAS_FQDS,
+    SHM_STR_SCRIPTS_FQDS,
+    SHM_STR_SOURCE_FQDS,
+    SHM_STR_TEMP_FQDS,
+    SHM_STR_USERDIR_FQDS,
+    SHM_STR_CGIBIN_FQFS,
+
+    SHM_STR_COUNT
+};
+
+/**
+ * @struct MFW_STRDESC_T
+ * @brief Locates one string inside the arena. A zero length means the
+ *        string is empty; the arena copy is always NUL terminated.
+ */
+struct MFW_STRDESC_T
+{
+    uint16_t uOffset;
+    uint16_t uLength;
+};
+
+/**
+ * @struct MFW_STRPOOL_T
+ * @brief Fixed header of descriptors followed by a packed string arena.
+ *
+ * Only the first uUsed bytes of the arena are meaningful, so copying a
+ * pool costs the header plus the strings actually stored rather than the
+ * tens of kilobytes of padding the old fixed-size fields carried.
+ */
+struct MFW_STRPOOL_T
+{
+    uint32_t      uUsed;
+    MFW_STRDESC_T desc[SHM_STR_COUNT];
+    char          arena[CFG_STRPOOL_SIZE];
+};
+
+/**
+ * @struct MFW_CONFIG_BLOCK_T
+ * @brief A seqlock-protected MFW_STRPOOL_T, embedded in MFW_SHMEMNG_T.
+ *
+ * uSequence is even while the block is stable and odd while a writer is
+ * updating it. It is only ever touched through std::atomic_ref. The
+ * sequence sits on its own cache line so that polling it does not share
+ * a line with the data being copied.
+ */
+struct MFW_CONFIG_BLOCK_T
+{
+    alignas(64) uint32_t uSequence;
+    alignas(64) MFW_STRPOOL_T pool;
+};
+
+/**
+ * @class SharedMemoryConfig
+ * @brief Lock-free access to the shared configuration strings.
+ *
+ * Readers copy a consistent snapshot without taking any lock and retry
+ * only if a writer was active during the copy. Each thread also keeps a
+ * private copy that current() refreshes only when the sequence has moved,
+ * so the steady-state cost of a read is a single atomic load.
+ *
+ * Writers go through set(), which serializes on the config region lock,
+ * repacks the arena in enum order and bumps the sequence only if the
+ * value actually changed.
+ */
+class SharedMemoryConfig
+{
+    MFW_CONFIG_BLOCK_T* m_pBlock;
+
+    bool store(shm_str_t id, const std::string& ssValue);
+
+public:
+    /**
+     * Binds the object to the config block in the segment that gpSh has
+     * already attached. If the segment is new, the RPC UUID is generated
+     * here, exactly once per segment.
+     */
+    SharedMemoryConfig();
+
+    /**
+     * Copies a consistent view of the pool into pool without taking any
+     * lock.
+     *
+     * @param pool Receives the snapshot.
+     * @return The version of the snapshot; it changes every time a
+     *         writer stores a different value.
+     */
+    uint32_t snapshot(MFW_STRPOOL_T& pool) const;
+
+    /**
+     * Returns this thread's copy of the pool, refreshing it first if a
+     * writer has stored since the last call. Use it with str() when
+     * several strings must come from the same version. The contents may
+     * change on the next call to current() or get().
+     */
+    const MFW_STRPOOL_T& current();
+
+    /**
+     * @param id The string of interest.
+     * @return A copy of the current value; empty if it was never set.
+     */
+    std::string get(shm_str_t id);
+
+    /**
+     * Stores a new value, truncated to the string's legacy maximum size.
+     * Writers serialize on the config region lock.
+     *
+     * @param id The string to change.
+     * @param ssValue The new value.
+     * @return True if the value is stored, false if the arena is full.
+     */
+    bool set(shm_str_t id, const std::string& ssValue);
+
+    /**
+     * @return The version most recently published. Never blocks.
+     */
+    uint32_t version() const;
+
+    /**
+     * @return The number of arena bytes currently in use.
+     */
+    size_t used();
+
+    /**
+     * Looks a string up in a pool obtained from current() or snapshot().
+     *
+     * @return A NUL-terminated string inside pool; "" if unset.
+     */
+    static const char* str(const MFW_STRPOOL_T& pool, shm_str_t id);
+
+    /**
+     * @return The legacy field name of a string, for example "szCgiRoot".
+     */
+    static const char* name(shm_str_t id);
+
+    /**
+     * @return The size, including the terminator, of the fixed field the
+     *         string used to occupy in MFW_SHMEMNG_T.
+     */
+    static size_t max_size(shm_str_t id);
+
+    /**
+     * Carries the block over from an older segment during a layout
+     * migration; see shm_migrate_fn. The source is read with the seqlock
+     * protocol, so the copy is consistent even if an older binary is
+     * storing a value at the same time.
+     */
+    static void migrate(void* pDst, const void* pSrc,
+                        size_t stDst, size_t stSrc);
+};
+
+//////////////////////
+// eof - shMemCfg.h //
+//////////////////////
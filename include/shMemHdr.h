@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/shMemHdr.h 2026-10-17 11:05 dwg -             //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "mwfw2.h"
+
+// "MWFW" read as a little-endian 32-bit word
+#define SHMHDR_MAGIC            0x5746574D
+#define SHMHDR_FIELD_NAME_SIZE  32
+
+/**
+ * Lifecycle of a segment. A new segment is zero filled by the kernel, so
+ * SHMHDR_EMPTY is what other processes see until the creator has written
+ * the header. Attachers wait for SHMHDR_READY. A segment whose contents
+ * have been migrated into a newer layout is marked SHMHDR_RETIRED.
+ */
+enum shmhdr_state_t
+{
+    SHMHDR_EMPTY = 0,
+    SHMHDR_BUILDING,
+    SHMHDR_READY,
+    SHMHDR_RETIRED
+};
+
+/**
+ * Field flags. A field marked SHMFIELD_NOMIGRATE is never copied out of
+ * an older segment, for example because it holds process-shared mutexes
+ * that are only valid at the address they were initialized at. A field
+ * marked SHMFIELD_VOLATILE is carried across a layout migration but is
+ * left out of the warm-start snapshot, because it describes logins or
+ * hardware state that does not survive a reboot. A NOMIGRATE field is
+ * never checkpointed either.
+ */
+#define SHMFIELD_NOMIGRATE 0x00000001
+#define SHMFIELD_VOLATILE  0x00000002
+
+/**
+ * @struct MFW_SHMFIELD_T
+ * @brief Describes one member of MFW_SHMEMNG_T, as stored in the segment.
+ *
+ * uVersion is the layout version of the member itself. It only needs to
+ * change when the member's element layout changes; an array that merely
+ * grows or shrinks keeps its version and is copied up to the smaller of
+ * the two sizes.
+ */
+struct MFW_SHMFIELD_T
+{
+    char     szName[SHMHDR_FIELD_NAME_SIZE];
+    uint32_t uOffset;
+    uint32_t uSize;
+    uint32_t uVersion;
+    uint32_t uFlags;
+};
+
+/**
+ * @struct MFW_SHMHDR_T
+ * @brief Self-describing header at offset zero of every segment.
+ *
+ * Together with the field table it lets a binary built against a newer
+ * layout find every member of an older segment by name, without having
+ * been compiled against the older struct. uState is only ever touched
+ * through std::atomic_ref. The header's own layout, CFG_SHM_MAX_FIELDS
+ * included, is frozen: any binary must be able to read the header of any
+ * older segment.
+ */
+struct MFW_SHMHDR_T
+{
+    uint32_t       uMagic;
+    uint32_t       uLayoutVersion;
+    alignas(8) uint32_t uState;              // shmhdr_state_t
+    uint32_t       uFieldCount;
+    uint64_t       u64Size;                  // sizeof(MFW_SHMEMNG_T)
+    time_t         tCreated;
+    uint32_t       uMigratedFrom;            // 0 if built from scratch
+    uint32_t       uMigratedFields;
+    MFW_SHMFIELD_T fields[CFG_SHM_MAX_FIELDS];
+};
+
+/**
+ * Where the contents of a segment came from, as recorded in
+ * MFW_WARMSTART_T. A restored segment still carries the network identity
+ * of the previous boot until environment's constructor has checked it.
+ */
+enum shm_warm_t
+{
+    SHM_WARM_COLD = 0,
+    SHM_WARM_RESTORED,
+    SHM_WARM_VALIDATED
+};
+
+/**
+ * @struct MFW_WARMSTART_T
+ * @brief Warm-start bookkeeping, embedded in MFW_SHMEMNG_T.
+ *
+ * uConfigVersion is the config block version most recently written to,
+ * or read from, the snapshot file, so a checkpoint that would write the
+ * same strings again is skipped. uState and uConfigVersion are only ever
+ * touched through std::atomic_ref.
+ */
+struct MFW_WARMSTART_T
+{
+    alignas(8) uint32_t uState;              // shm_warm_t
+    uint32_t uConfigVersion;
+    time_t   tRestored;
+    time_t   tCheckpoint;
+    uint32_t uCheckpoints;
+};
+
+// "MWFWSNAP" read as a little-endian 64-bit word
+#define SHMSNAP_MAGIC 0x50414E5357464D57ULL
+
+/**
+ * @struct MFW_SHMSNAP_T
+ * @brief Prefix of the warm-start snapshot file.
+ *
+ * It is followed by the checkpointed members, packed. The embedded
+ * MFW_SHMHDR_T describes them exactly as it describes the members of a
+ * segment, with offsets counted from the start of hdr, so a snapshot is
+ * restored by the same code, and with the same per-member version
+ * checks, as an older segment is migrated. u64Checksum covers every byte
+ * from hdr to the end of the file.
+ */
+struct MFW_SHMSNAP_T
+{
+    uint64_t     u64Magic;
+    uint64_t     u64Checksum;
+    uint64_t     u64Length;                  // bytes from hdr to eof
+    time_t       tSaved;
+    char         szHostname[DNS_FQDN_SIZE_MAX];
+    alignas(64) MFW_SHMHDR_T hdr;
+};
+
+/**
+ * Copies one member from an older segment into a newer one. stDst and
+ * stSrc are the sizes of the member in the two layouts.
+ */
+typedef void (*shm_migrate_fn)(void* pDst, const void* pSrc,
+                               size_t stDst, size_t stSrc);
+
+/**
+ * @struct shm_field_desc_t
+ * @brief Compiled-in description of one member of MFW_SHMEMNG_T.
+ *
+ * This is the process-side counterpart of MFW_SHMFIELD_T: the shared
+ * constructor writes it into the header of every segment it creates, and
+ * uses pfnMigrate, or a plain copy when it is null, to carry the member
+ * over from an older segment.
+ */
+struct shm_field_desc_t
+{
+    const char*    pszName;
+    size_t         stOffset;
+    size_t         stSize;
+    uint32_t       uVersion;
+    uint32_t       uFlags;
+    shm_migrate_fn pfnMigrate;
+};
+
+//////////////////////
+// eof - shMemHdr.h //
+//////////////////////
@@ -0,0 +1,767 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/shMemHeap.h 2026-10-17 16:20 dwg -            //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "mwfw2.h"
+
+#define SHMHEAP_MAGIC         0x50414548  // "HEAP"
+#define SHMHEAP_BLOCK_USED    0x554b4c42  // "BLKU"
+#define SHMHEAP_BLOCK_FREE    0x464b4c42  // "BLKF"
+#define SHMHEAP_MIN_BLOCK     32          // smallest block, header included
+#define SHMHEAP_CLASSES       16          // 32 bytes .. 1 MiB, powers of two
+#define SHMHEAP_ROOT_NAME_SIZE 48
+
+static_assert(CFG_SHMHEAP_SIZE <= (1ull << 36),
+              "shm_hash_map packs heap offsets into 32 bits");
+
+enum shmheap_state_t
+{
+    SHMHEAP_UNUSED = 0,
+    SHMHEAP_INITIALIZING,
+    SHMHEAP_READY
+};
+
+/**
+ * @struct MFW_HEAPBLOCK_T
+ * @brief The 16-byte header in front of every heap block.
+ *
+ * u64Next links the block into its class free list while it is free and
+ * is not touched while it is in use.
+ */
+struct MFW_HEAPBLOCK_T
+{
+    uint32_t uClass;
+    uint32_t uMagic;
+    uint64_t u64Next;
+};
+
+/**
+ * @struct MFW_HEAP_T
+ * @brief The header at offset 0 of the heap region.
+ *
+ * Blocks are carved from u64Used upwards and never given back to the
+ * region; a freed block goes onto the free list of its size class and is
+ * reused for the next allocation of that class. Each free list head packs
+ * a block offset into its low 40 bits and a change count into its high
+ * 24 bits, so a pop that raced with a pop and push of the same block
+ * fails its CAS instead of corrupting the list.
+ *
+ * roots[] is a small directory of named objects, claimed the same way as
+ * the counter table, so cooperating processes can find the maps they
+ * share without any pointer having to survive in the SysV segment.
+ */
+struct MFW_HEAP_T
+{
+    uint32_t uMagic;
+    uint32_t uVersion;
+    uint32_t uState;
+    uint32_t uPad;
+    uint64_t u64Size;
+    alignas(64) uint64_t u64Used;       // bump offset for fresh blocks
+    uint64_t u64Failures;               // allocations that found no space
+    alignas(64) uint64_t freelists[SHMHEAP_CLASSES];
+    uint64_t u64Live[SHMHEAP_CLASSES];  // blocks in use, per class
+    struct
+    {
+        alignas(8) uint32_t uState;
+        char szName[SHMHEAP_ROOT_NAME_SIZE];
+        uint64_t u64Off;
+    } roots[CFG_SHMHEAP_ROOTS];
+};
+
+/**
+ * @class shm_ptr
+ * @brief A pointer into the heap region, stored as an offset.
+ *
+ * Every process maps the region at its own address, so nothing stored in
+ * the heap may hold a raw pointer. A shm_ptr holds the offset from the
+ * start of the region instead and is turned into an address by the
+ * shm_heap of the reading process. Offset 0 is the header and doubles as
+ * the null pointer.
+ */
+template<typename T>
+class shm_ptr
+{
+    uint64_t m_u64Off = 0;
+
+public:
+    shm_ptr() = default;
+    explicit shm_ptr(uint64_t u64Off) : m_u64Off(u64Off) {}
+
+    uint64_t offset() const { return m_u64Off; }
+    explicit operator bool() const { return 0 != m_u64Off; }
+
+    /**
+     * @return The address of the object in this process, or nullptr.
+     */
+    T* get(const class shm_heap& heap) const;
+};
+
+/**
+ * @struct shm_blob
+ * @brief A variable-length byte string held in the heap.
+ */
+struct shm_blob
+{
+    uint64_t u64Off;
+    uint64_t u64Len;
+};
+
+/**
+ * @class shm_heap
+ * @brief A slab allocator in a POSIX shared memory region.
+ *
+ * The MFW_SHMEMNG_T segment has a fixed layout: every string in it has a
+ * compile-time maximum. The heap is a second, separate region for records
+ * whose size is only known at run time. It is created with shm_open() by
+ * the first process that needs it and mapped by the others wherever their
+ * address space has room, so its contents refer to each other only by
+ * offset (see shm_ptr and shm_blob).
+ *
+ * Allocation rounds up to a power-of-two size class and pops that class's
+ * lock-free free list, falling back to carving a new block. Requests larger
+ * than the biggest class fail. The region is reserved at CFG_SHMHEAP_SIZE
+ * but, being a sparse file in /dev/shm, only costs memory for the pages
+ * that have been used.
+ */
+class shm_heap
+{
+    MFW_HEAP_T* m_pHeap;
+    size_t m_stSize;
+    char m_szName[NAME_MAX];
+
+public:
+    /**
+     * Opens the heap, creating and formatting it if no process has.
+     *
+     * The name is suffixed with CFG_SHMHEAP_VERSION, so a build with a
+     * different header layout never maps an incompatible region.
+     *
+     * @throws std::system_error if the region cannot be opened or mapped,
+     *         or another process did not finish formatting it in time.
+     */
+    explicit shm_heap(const char* pszName = CFG_SHMHEAP_NAME,
+                      size_t stSize = CFG_SHMHEAP_SIZE);
+
+    /**
+     * Unmaps the region. The region itself persists until it is removed
+     * with shm_unlink(), like the SysV segment persists until ipcrm.
+     */
+    ~shm_heap();
+
+    shm_heap(const shm_heap&) = delete;
+    shm_heap& operator=(const shm_heap&) = delete;
+
+    /**
+     * Allocates at least stBytes bytes, 16-byte aligned.
+     *
+     * @return The offset of the new block, or 0 if the request is larger
+     *         than the largest size class or the region is full.
+     */
+    uint64_t allocate(size_t stBytes);
+
+    /**
+     * Returns a block to its size-class free list. Offset 0 is ignored,
+     * and a block that is not in use is logged and left alone.
+     */
+    void deallocate(uint64_t u64Off);
+
+    /**
+     * @return The usable size of the block at u64Off.
+     */
+    size_t usable(uint64_t u64Off) const;
+
+    /**
+     * @return true if [u64Off, u64Off + stLen) lies inside the region.
+     */
+    bool contains(uint64_t u64Off, size_t stLen) const
+    {
+        return u64Off >= sizeof(MFW_HEAP_T) && u64Off <= m_stSize &&
+               stLen <= m_stSize - u64Off;
+    }
+
+    /**
+     * @return The address of the object at u64Off, or nullptr for 0.
+     */
+    template<typename T>
+    T* at(uint64_t u64Off) const
+    {
+        return u64Off ? (T*)((char*)m_pHeap + u64Off) : nullptr;
+    }
+
+    /**
+     * Finds the named object, allocating stBytes of zeroed storage for it
+     * if it does not exist yet.
+     *
+     * @return The offset of the object, or 0 if the directory or the heap
+     *         is full.
+     */
+    uint64_t root(const char* pszName, size_t stBytes);
+
+    /**
+     * Copies bytes into a new block.
+     *
+     * @return The new blob; u64Off is 0 if the allocation failed.
+     */
+    shm_blob store(const void* pData, size_t stLen);
+
+    /**
+     * Frees the block behind a blob.
+     */
+    void release(const shm_blob& blob) { deallocate(blob.u64Off); }
+
+    /**
+     * @return The bytes of a blob, or an empty view if the blob does not
+     *         lie inside the region.
+     */
+    std::string_view view(const shm_blob& blob) const;
+
+    /**
+     * @return Bytes carved from the region so far.
+     */
+    uint64_t used() const;
+
+    /**
+     * @return Bytes reserved for the region.
+     */
+    uint64_t size() const { return m_stSize; }
+
+    /**
+     * @return Blocks in use and the bytes they occupy, headers included.
+     */
+    std::pair<uint64_t, uint64_t> live() const;
+
+    /**
+     * @return Allocations that failed for lack of space.
+     */
+    uint64_t failures() const;
+
+    /**
+     * Calls fn with the name and offset of every named object.
+     */
+    void for_each_root(
+        const std::function<void(const char*, uint64_t)>& fn) const;
+};
+
+template<typename T>
+T* shm_ptr<T>::get(const shm_heap& heap) const
+{
+    return heap.at<T>(m_u64Off);
+}
+
+/**
+ * @struct MFW_SHMMAP_T
+ * @brief The root object of a shm_hash_map, found by name in the heap.
+ */
+struct MFW_SHMMAP_T
+{
+    alignas(8) uint32_t uSequence;      // seqlock, odd while writing
+    uint32_t uCount;                    // live entries
+    uint32_t uTombs;                    // erased entries not yet rehashed
+    uint32_t uCapacity;                 // power of two, 0 before first use
+    uint64_t u64Table;                  // uint64_t[uCapacity]
+};
+
+/**
+ * @class shm_hash_map
+ * @brief An open-addressing hash map from strings to V, in the heap.
+ *
+ * Keys may be of any length. V must be trivially copyable because it is
+ * stored in the heap as it is; a shm_blob holds a variable-length value,
+ * and the map frees the old blob when an entry is replaced or erased.
+ *
+ * The table is an array of 64-bit slots, each packing the key hash and
+ * the offset of a record that holds the key and the value. Probing is
+ * linear; erased slots become tombstones, and the table is rebuilt at
+ * twice the size once live entries and tombstones fill half of it.
+ *
+ * Writers serialise on a SharedMemoryMutex named after the map; the lock
+ * table has a slot for every heap root, so every map can have one. Readers
+ * take no lock: they probe optimistically under the map's seqlock and
+ * start again if a writer ran meanwhile; a reader that waits too long
+ * on an odd sequence takes the lock and repairs the map if its writer
+ * died. Because the heap never returns memory to the system, a record a
+ * reader is looking at may be reused but never unmapped, and every
+ * offset is bounds-checked before use.
+ */
+template<typename V>
+class shm_hash_map
+{
+    static_assert(std::is_trivially_copyable_v<V>,
+                  "shm_hash_map values are copied as bytes");
+
+    static constexpr uint64_t TOMB = ~0ull;
+
+    struct record_t
+    {
+        uint32_t uHash;
+        uint32_t uKeyLen;
+        V value;
+        // uKeyLen key bytes follow
+    };
+
+    shm_heap& m_heap;
+    uint64_t m_u64Map;
+    std::unique_ptr<SharedMemoryMutex> m_pLock;
+
+    MFW_SHMMAP_T* map() const { return m_heap.at<MFW_SHMMAP_T>(m_u64Map); }
+
+    static uint32_t hash(std::string_view svKey)
+    {
+        uint32_t uHash = 2166136261u;
+        for (unsigned char c : svKey)
+        {
+            uHash = (uHash ^ c) * 16777619u;
+        }
+        return uHash;
+    }
+
+    static uint64_t slot(uint32_t uHash, uint64_t u64Record)
+    {
+        return ((uint64_t)uHash << 32) | (u64Record >> 4);
+    }
+
+    /**
+     * Checks that a table slot refers to svKey. Bounds are checked first,
+     * since an optimistic reader may be looking at a reused record.
+     */
+    const record_t* match(uint64_t u64Slot, uint32_t uHash,
+                          std::string_view svKey) const
+    {
+        if ((uint32_t)(u64Slot >> 32) != uHash)
+        {
+            return nullptr;
+        }
+        uint64_t u64Record = (u64Slot & 0xffffffffull) << 4;
+        if (!m_heap.contains(u64Record, sizeof(record_t) + svKey.size()))
+        {
+            return nullptr;
+        }
+        auto* pRecord = m_heap.at<const record_t>(u64Record);
+        if (pRecord->uKeyLen != svKey.size() ||
+            0 != memcmp(pRecord + 1, svKey.data(), svKey.size()))
+        {
+            return nullptr;
+        }
+        return pRecord;
+    }
+
+    /**
+     * Locates svKey. Must be called with the lock held.
+     *
+     * @return The index of its slot, or of the first free slot on its
+     *         probe sequence (negated and minus one) if it is absent.
+     */
+    int64_t locate(uint32_t uHash, std::string_view svKey) const
+    {
+        MFW_SHMMAP_T* pMap = map();
+        auto* pTable = m_heap.at<uint64_t>(pMap->u64Table);
+        uint64_t u64Mask = pMap->uCapacity - 1;
+        int64_t iFree = -1;
+        for (uint64_t i = 0, u = uHash & u64Mask; i <= u64Mask;
+             i++, u = (u + 1) & u64Mask)
+        {
+            if (0 == pTable[u])
+            {
+                return -1 - (iFree >= 0 ? iFree : (int64_t)u);
+            }
+            if (TOMB == pTable[u])
+            {
+                if (iFree < 0) iFree = (int64_t)u;
+                continue;
+            }
+            if (match(pTable[u], uHash, svKey))
+            {
+                return (int64_t)u;
+            }
+        }
+        return -1 - iFree;
+    }
+
+    void write_begin()
+    {
+        std::atomic_ref<uint32_t> seq(map()->uSequence);
+        seq.store(seq.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void write_end()
+    {
+        std::atomic_ref<uint32_t> seq(map()->uSequence);
+        seq.store(seq.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_release);
+    }
+
+    /**
+     * Called with the lock held. An odd sequence means the last writer
+     * died between write_begin() and write_end(), so the header may not
+     * match the table. The capacity is taken from the size of the table's
+     * block, since rehash() may have died between storing the two, the
+     * counts are recomputed from the table, and the sequence is made even.
+     */
+    void repair() const
+    {
+        MFW_SHMMAP_T* pMap = map();
+        std::atomic_ref<uint32_t> seq(pMap->uSequence);
+        uint32_t uSeq = seq.load(std::memory_order_relaxed);
+        if (0 == (uSeq & 1))
+        {
+            return;
+        }
+
+        uint32_t uCapacity = 0;
+        if (0 != pMap->u64Table)
+        {
+            uCapacity = (uint32_t)std::bit_floor(
+                m_heap.usable(pMap->u64Table) / sizeof(uint64_t));
+        }
+        uint32_t uCount = 0;
+        uint32_t uTombs = 0;
+        auto* pTable = m_heap.at<uint64_t>(pMap->u64Table);
+        for (uint32_t i = 0; i < uCapacity; i++)
+        {
+            if (TOMB == pTable[i])
+            {
+                uTombs++;
+            }
+            else if (0 != pTable[i])
+            {
+                uCount++;
+            }
+        }
+        pMap->uCapacity = uCapacity;
+        pMap->uCount = uCount;
+        pMap->uTombs = uTombs;
+        seq.store(uSeq + 1, std::memory_order_release);
+        gpSysLog->loginfo("shm_hash_map: repaired after a writer died");
+    }
+
+    void free_value(const V& value)
+    {
+        if constexpr (std::is_same_v<V, shm_blob>)
+        {
+            m_heap.release(value);
+        }
+    }
+
+    /**
+     * Rebuilds the table at uCapacity slots, dropping tombstones. Records
+     * are not moved. Must be called with the lock held.
+     */
+    bool rehash(uint32_t uCapacity)
+    {
+        uint64_t u64Table = m_heap.allocate(uCapacity * sizeof(uint64_t));
+        if (0 == u64Table)
+        {
+            return false;
+        }
+        auto* pNew = m_heap.at<uint64_t>(u64Table);
+        memset(pNew, 0, uCapacity * sizeof(uint64_t));
+
+        MFW_SHMMAP_T* pMap = map();
+        auto* pOld = m_heap.at<uint64_t>(pMap->u64Table);
+        for (uint32_t i = 0; i < pMap->uCapacity; i++)
+        {
+            if (0 == pOld[i] || TOMB == pOld[i])
+            {
+                continue;
+            }
+            uint32_t u = (uint32_t)(pOld[i] >> 32) & (uCapacity - 1);
+            while (0 != pNew[u])
+            {
+                u = (u + 1) & (uCapacity - 1);
+            }
+            pNew[u] = pOld[i];
+        }
+
+        uint64_t u64Old = pMap->u64Table;
+        write_begin();
+        pMap->u64Table = u64Table;
+        pMap->uCapacity = uCapacity;
+        pMap->uTombs = 0;
+        write_end();
+        m_heap.deallocate(u64Old);
+        return true;
+    }
+
+public:
+    /**
+     * Attaches to the map of the given name, creating it empty if no
+     * process has.
+     *
+     * @param heap The heap holding the map, normally *gpShMemHeap.
+     * @param pszName A name unique among the maps in the heap, at most
+     *        CFG_MUTEX_MAX_SIZE - sizeof(CFG_MUTEX_NAME ".map.") bytes.
+     * @throws std::system_error if the heap directory is full.
+     */
+    shm_hash_map(shm_heap& heap, const char* pszName) : m_heap(heap)
+    {
+        std::string ssName = std::string("map.") + pszName;
+        m_u64Map = m_heap.root(ssName.c_str(), sizeof(MFW_SHMMAP_T));
+        if (0 == m_u64Map)
+        {
+            throw std::system_error(ENOSPC, std::system_category(),
+                                    "shared heap directory is full");
+        }
+        m_pLock = std::make_unique<SharedMemoryMutex>(
+            (std::string(CFG_MUTEX_NAME ".") + ssName).c_str());
+    }
+
+    /**
+     * Inserts svKey or replaces its value.
+     *
+     * @return false if the heap had no room for the record or table.
+     */
+    bool insert_or_assign(std::string_view svKey, const V& value)
+    {
+        uint32_t uHash = hash(svKey);
+        std::lock_guard<SharedMemoryMutex> guard(*m_pLock);
+        repair();
+        MFW_SHMMAP_T* pMap = map();
+
+        // Grow when live entries alone would fill a quarter of the table;
+        // otherwise the rebuild just clears out tombstones.
+        if ((pMap->uCount + pMap->uTombs + 1) * 2 > pMap->uCapacity)
+        {
+            uint32_t uCapacity = pMap->uCapacity;
+            if (0 == uCapacity)
+            {
+                uCapacity = 16;
+            }
+            else if ((pMap->uCount + 1) * 4 > uCapacity)
+            {
+                uCapacity *= 2;
+            }
+            if (!rehash(uCapacity))
+            {
+                return false;
+            }
+        }
+
+        int64_t iSlot = locate(uHash, svKey);
+        auto* pTable = m_heap.at<uint64_t>(pMap->u64Table);
+        if (iSlot >= 0)
+        {
+            auto* pRecord = m_heap.at<record_t>(
+                (pTable[iSlot] & 0xffffffffull) << 4);
+            V old = pRecord->value;
+            write_begin();
+            pRecord->value = value;
+            write_end();
+            free_value(old);
+            return true;
+        }
+
+        uint64_t u64Record = m_heap.allocate(sizeof(record_t) + svKey.size());
+        if (0 == u64Record)
+        {
+            return false;
+        }
+        auto* pRecord = m_heap.at<record_t>(u64Record);
+        pRecord->uHash = uHash;
+        pRecord->uKeyLen = (uint32_t)svKey.size();
+        pRecord->value = value;
+        memcpy(pRecord + 1, svKey.data(), svKey.size());
+
+        uint64_t u = (uint64_t)(-1 - iSlot);
+        write_begin();
+        if (TOMB == pTable[u])
+        {
+            pMap->uTombs--;
+        }
+        std::atomic_ref<uint64_t>(pTable[u]).store(
+            slot(uHash, u64Record), std::memory_order_release);
+        pMap->uCount++;
+        write_end();
+        return true;
+    }
+
+    /**
+     * Calls fn with the value of svKey without taking the lock.
+     *
+     * fn may be called more than once if a writer interferes, and only
+     * the last call stands, so it should do nothing but copy the value
+     * (and, for a shm_blob, the bytes it refers to).
+     *
+     * @return true if the key was found.
+     */
+    template<typename F>
+    bool read(std::string_view svKey, F&& fn) const
+    {
+        uint32_t uHash = hash(svKey);
+        MFW_SHMMAP_T* pMap = map();
+        std::atomic_ref<uint32_t> seq(pMap->uSequence);
+        int iStall = 0;
+        for (;;)
+        {
+            uint32_t uBegin = seq.load(std::memory_order_acquire);
+            if (uBegin & 1)
+            {
+                if (++iStall >= CFG_SEQLOCK_STALL && m_pLock->try_lock())
+                {
+                    iStall = 0;
+                    repair();
+                    m_pLock->unlock();
+                }
+                sched_yield();
+                continue;
+            }
+
+            bool bFound = false;
+            uint64_t u64Mask = pMap->uCapacity - 1;
+            uint64_t u64Table = pMap->u64Table;
+            if (pMap->uCapacity &&
+                m_heap.contains(u64Table, pMap->uCapacity * sizeof(uint64_t)))
+            {
+                auto* pTable = m_heap.at<uint64_t>(u64Table);
+                for (uint64_t i = 0, u = uHash & u64Mask; i <= u64Mask;
+                     i++, u = (u + 1) & u64Mask)
+                {
+                    uint64_t u64Slot = std::atomic_ref<uint64_t>(
+                        pTable[u]).load(std::memory_order_acquire);
+                    if (0 == u64Slot)
+                    {
+                        break;
+                    }
+                    if (TOMB == u64Slot)
+                    {
+                        continue;
+                    }
+                    if (const record_t* pRecord =
+                            match(u64Slot, uHash, svKey))
+                    {
+                        V value = pRecord->value;
+                        fn(value);
+                        bFound = true;
+                        break;
+                    }
+                }
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) == uBegin)
+            {
+                return bFound;
+            }
+        }
+    }
+
+    /**
+     * Copies the value of svKey into value.
+     *
+     * @return true if the key was found.
+     */
+    bool find(std::string_view svKey, V& value) const
+    {
+        return read(svKey, [&](const V& v) { value = v; });
+    }
+
+    /**
+     * Removes svKey.
+     *
+     * @return true if the key was present.
+     */
+    bool erase(std::string_view svKey)
+    {
+        uint32_t uHash = hash(svKey);
+        std::lock_guard<SharedMemoryMutex> guard(*m_pLock);
+        repair();
+        MFW_SHMMAP_T* pMap = map();
+        if (0 == pMap->uCapacity)
+        {
+            return false;
+        }
+
+        int64_t iSlot = locate(uHash, svKey);
+        if (iSlot < 0)
+        {
+            return false;
+        }
+        auto* pTable = m_heap.at<uint64_t>(pMap->u64Table);
+        uint64_t u64Record = (pTable[iSlot] & 0xffffffffull) << 4;
+        V old = m_heap.at<record_t>(u64Record)->value;
+
+        write_begin();
+        std::atomic_ref<uint64_t>(pTable[iSlot]).store(
+            TOMB, std::memory_order_relaxed);
+        pMap->uCount--;
+        pMap->uTombs++;
+        write_end();
+
+        m_heap.deallocate(u64Record);
+        free_value(old);
+        return true;
+    }
+
+    /**
+     * @return The number of live entries.
+     */
+    uint32_t size() const
+    {
+        return std::atomic_ref<uint32_t>(map()->uCount).load(
+            std::memory_order_relaxed);
+    }
+
+    /**
+     * Calls fn with every key and value, holding the lock throughout, so
+     * fn must not modify this map.
+     */
+    template<typename F>
+    void for_each(F&& fn)
+    {
+        std::lock_guard<SharedMemoryMutex> guard(*m_pLock);
+        repair();
+        MFW_SHMMAP_T* pMap = map();
+        auto* pTable = m_heap.at<uint64_t>(pMap->u64Table);
+        for (uint32_t i = 0; i < pMap->uCapacity; i++)
+        {
+            if (0 == pTable[i] || TOMB == pTable[i])
+            {
+                continue;
+            }
+            auto* pRecord = m_heap.at<const record_t>(
+                (pTable[i] & 0xffffffffull) << 4);
+            fn(std::string_view((const char*)(pRecord + 1),
+                                pRecord->uKeyLen),
+               pRecord->value);
+        }
+    }
+};
+
+/**
+ * @class shm_string_map
+ * @brief A shm_hash_map from strings to strings of any length.
+ */
+class shm_string_map : public shm_hash_map<shm_blob>
+{
+    shm_heap& m_heap;
+
+public:
+    shm_string_map(shm_heap& heap, const char* pszName)
+        : shm_hash_map<shm_blob>(heap, pszName), m_heap(heap) {}
+
+    /**
+     * Stores a copy of svValue under svKey.
+     *
+     * @return false if the heap had no room.
+     */
+    bool set(std::string_view svKey, std::string_view svValue);
+
+    /**
+     * Copies the value of svKey into ssValue.
+     *
+     * @return true if the key was found.
+     */
+    bool get(std::string_view svKey, std::string& ssValue) const;
+};
+
+///////////////////////
+// eof - shMemHeap.h //
+///////////////////////
@@ -8,6 +8,22 @@
 
 #pragma once
 
+/**
+ * Independently locked regions of MFW_SHMEMNG_T. Each region has its own
+ * SharedMemoryMutex, so writers of unrelated state never block each
+ * other. When more than one region must be held at once, acquire them
+ * in ascending enum order; lockSharedMemory() does exactly that.
+ */
+enum shm_region_t
+{
+    SHM_REGION_CONFIG = 0,      // paths, hostnames, URLs, szStatus
+    SHM_REGION_CREDS,           // creds[]
+    SHM_REGION_PREFS,           // prefs[]
+    SHM_REGION_TESTS,           // tests_* and num_tests_* counters
+    SHM_REGION_LEDS,            // bLedCntl[]
+    SHM_REGION_COUNT
+};
+
 /**
  * @class SharedMemoryManager
  * @brief Manages synchronized access to a shared memory region using a mutex.
@@ -16,9 +32,12 @@
  * releasing shared memory resources. It ensures thread-safe operations on
  * shared memory using RAII-based locking mechanisms.
  *
- * The operations use a shared memory mutex to prevent multiple entities
- * from accessing the shared memory region simultaneously. The locking and
- * unlocking are managed internally.
+ * The segment is split into the regions of shm_region_t, each guarded
+ * by its own named lock ("<name>.config", "<name>.creds", ...). Code
+ * that touches one region should hold only that region, preferably
+ * through one of the shmRegionGuard typedefs below. lockSharedMemory()
+ * and releaseSharedMemory() remain for callers that need a consistent
+ * view of the whole segment.
  */
 class SharedMemoryManager
 {
@@ -38,14 +57,12 @@ public:
     SharedMemoryManager(const char* name);
 
     /**
-     * Locks the shared memory to ensure safe and synchronized access across
-     * multiple threads or processes. This function uses a mutex to provide
-     * thread-safety and prevents race conditions during shared memory
-     * operations.
+     * Locks the whole shared memory segment by acquiring the segment
+     * lock and then every region lock in ascending order, so that no
+     * region writer can run until releaseSharedMemory() is called.
      *
-     * This method is designed to be called before performing any operations
-     * on the shared memory. The lock remains active until it is explicitly
-     * released by calling the corresponding `releaseSharedMemory` method.
+     * Prefer a region guard when only one region is involved; this call
+     * serializes against every writer in the framework.
      *
      * Note: Misuse of this function, such as failing to release the lock, may
      * lead to deadlocks or blocked access for other threads or processes.
@@ -70,12 +87,8 @@ public:
     /**
      * Releases the lock held on shared memory.
      *
-     * This method is responsible for unlocking the shared memory
-     * resource previously locked by the `lockSharedMemory()` method.
-     * It utilizes a RAII-style lock management mechanism to safely
-     * handle concurrency.
-     *
-     * Thread safety: Ensured through `SharedMemoryMutex`.
+     * This method unlocks every region lock in descending order and then
+     * the segment lock, undoing a previous lockSharedMemory().
      *
      * This method should be called after performing all necessary
      * operations on the shared memory resource to avoid deadlocks
@@ -83,6 +96,35 @@ public:
      */
     void releaseSharedMemory();
 
+    /**
+     * Acquires the lock of a single region.
+     *
+     * @param region The region to lock.
+     * @throws std::system_error if the lock cannot be acquired.
+     */
+    void lockRegion(shm_region_t region);
+
+    /**
+     * Releases the lock of a single region previously acquired with
+     * lockRegion().
+     *
+     * @param region The region to unlock.
+     */
+    void unlockRegion(shm_region_t region);
+
+    /**
+     * @param region The region of interest.
+     * @return The mutex guarding that region, for callers that want to
+     *         use it with std::lock_guard or inspect its statistics.
+     */
+    SharedMemoryMutex& getRegionMutex(shm_region_t region);
+
+    /**
+     * @param region The region of interest.
+     * @return The short name of the region, for example "creds".
+     */
+    static const char* getRegionName(shm_region_t region);
+
     /**
      * A mutex object used to provide thread-safe access to shared memory.
      *
@@ -93,12 +135,61 @@ public:
      * locking, unlocking, and ensuring safe operations on shared memory.
      *
      * The `mutex_` is initialized with a unique name and leverages
-     * system-level semaphores to manage access contention.
+     * a robust process-shared mutex in the segment to manage access
+     * contention.
      */
 private:
     SharedMemoryMutex mutex_;
+
+    /**
+     * One lock per shm_region_t, named after mutex_ with the region name
+     * appended.
+     */
+    std::unique_ptr<SharedMemoryMutex> m_pRegion[SHM_REGION_COUNT];
+};
+
+extern SharedMemoryManager* gpShMemMgr;
+
+/**
+ * @class shmRegionGuard
+ * @brief RAII guard that holds the lock of one shared memory region for
+ *        the lifetime of the guard.
+ *
+ * Example:
+ *     {
+ *         shmTestsGuard guard;
+ *         gpSh->m_pShMemng->num_tests_passed++;
+ *     }
+ *
+ * @tparam R The region to lock.
+ */
+template <shm_region_t R>
+class shmRegionGuard
+{
+    SharedMemoryManager* m_pMgr;
+
+public:
+    explicit shmRegionGuard(SharedMemoryManager* pMgr = gpShMemMgr)
+        : m_pMgr(pMgr)
+    {
+        m_pMgr->lockRegion(R);
+    }
+
+    ~shmRegionGuard()
+    {
+        m_pMgr->unlockRegion(R);
+    }
+
+    shmRegionGuard(const shmRegionGuard&) = delete;
+    shmRegionGuard& operator=(const shmRegionGuard&) = delete;
 };
 
+typedef shmRegionGuard<SHM_REGION_CONFIG> shmConfigGuard;
+typedef shmRegionGuard<SHM_REGION_CREDS>  shmCredsGuard;
+typedef shmRegionGuard<SHM_REGION_PREFS>  shmPrefsGuard;
+typedef shmRegionGuard<SHM_REGION_TESTS>  shmTestsGuard;
+typedef shmRegionGuard<SHM_REGION_LEDS>   shmLedsGuard;
+
 //////////////////////
 // eof - shMemMgr.h //
 //////////////////////
@@ -8,30 +8,67 @@
 
 #pragma once
 
+/**
+ * Initialization states of a lock slot in the shared segment. The slot
+ * is claimed with a CAS from SHMLOCK_UNUSED to SHMLOCK_INITIALIZING by
+ * exactly one process, which initializes the mutex and then publishes
+ * SHMLOCK_READY. If that process dies first, the slot is taken over by
+ * the next one to find it still initializing.
+ */
+enum shmlock_state_t
+{
+    SHMLOCK_UNUSED = 0,
+    SHMLOCK_INITIALIZING,
+    SHMLOCK_READY
+};
+
+/**
+ * @struct MFW_SHMLOCK_T
+ * @brief A named, process-shared, robust mutex plus its contention
+ *        statistics, as it lives in the shared segment.
+ *
+ * The statistics are only written by the current lock holder, so they
+ * need no synchronization of their own; readers such as view_shared may
+ * see slightly stale values, which is fine for monitoring.
+ */
+struct MFW_SHMLOCK_T
+{
+    alignas(64) pthread_mutex_t mutex;
+    uint32_t uState;                           // shmlock_state_t
+    pid_t    pidInit;                          // who set it up, or is doing so
+    char     szName[CFG_MUTEX_MAX_SIZE];
+
+    uint64_t u64Acquisitions;                  // successful lock() calls
+    uint64_t u64Contentions;                   // lock() calls that waited
+    uint64_t u64WaitNsTotal;                   // time spent waiting
+    uint64_t u64WaitNsMax;                     // longest single wait
+    uint64_t u64OwnerDeaths;                   // EOWNERDEAD recoveries
+};
+
 /**
  * @class SharedMemoryMutex
- * @brief A mutex implementation for synchronizing access to shared memory
- *        using named semaphores.
+ * @brief A mutex for synchronizing access to shared memory, backed by a
+ *        robust process-shared pthread mutex embedded in the segment.
  *
- * This class provides a mechanism to synchronize access to shared resources
- * across multiple processes using named semaphores. It ensures thread safety
- * and proper resource handling. The mutex is created or opened using a
- * specified name.
+ * The mutex is identified by name, as the old named-semaphore version
+ * was, but it lives in the locks[] table of MFW_SHMEMNG_T instead of in
+ * /dev/shm. Uncontended lock() and unlock() calls complete in user space
+ * without a system call. If a process dies while holding the lock, the
+ * next process to lock it recovers the mutex instead of blocking
+ * forever.
  */
 class SharedMemoryMutex
 {
     /**
-     * Constructs a SharedMemoryMutex object and initializes a named
-     * semaphore. The constructor creates or opens a POSIX named semaphore
-     * associated with the provided name. If the semaphore cannot be created
-     * or opened, it throws a system_error exception.
+     * Constructs a SharedMemoryMutex object bound to the lock of the
+     * given name in the shared segment, creating and initializing that
+     * lock if no process has done so yet. gpSh must already be attached.
      *
-     * @param name A pointer to a null-terminated string that represents the
-     *             name of the semaphore. The name must begin with a slash
-     *             ('/') and be followed by one or more characters.
-     * @return A new instance of SharedMemoryMutex with the semaphore
-     *         initialized. Throws a system_error on failure to create or
-     *         open the semaphore.
+     * @param name A pointer to a null-terminated string that names the
+     *             lock, for example CFG_MUTEX_NAME. At most
+     *             CFG_MUTEX_MAX_SIZE-1 characters are significant.
+     * @throws std::system_error if the lock table is full or the mutex
+     *         cannot be initialized.
      */
 public:
     SharedMemoryMutex(const char* name);
@@ -39,53 +76,57 @@ public:
     /**
      * Destructor for the SharedMemoryMutex class.
      *
-     * Cleans up resources associated with the shared memory mutex.
-     * Closes the semaphore if it was successfully opened, ensuring no
-     * resource leaks.
+     * The mutex belongs to the segment rather than to this object, so
+     * nothing is released here.
      */
     ~SharedMemoryMutex();
 
     /**
      * Acquires the lock for the shared memory mutex.
      *
-     * This method blocks the calling thread until the lock is successfully
-     * acquired. If the semaphore operation fails, a `std::system_error`
-     * exception is thrown.
+     * An uncontended acquisition is a single trylock in user space. When
+     * the lock is held elsewhere the call blocks, and the wait is counted
+     * and timed in the lock statistics. If the previous holder died the
+     * mutex is made consistent again and the death is counted.
      *
-     * @throws std::system_error if the semaphore operation fails, with the
-     *         error code and a corresponding message.
+     * @throws std::system_error if the mutex cannot be acquired, for
+     *         example because it has become unrecoverable.
      */
     void lock();
 
+    /**
+     * Attempts to acquire the lock without blocking. A dead holder is
+     * recovered from as in lock().
+     *
+     * @return True if the lock was acquired.
+     */
+    bool try_lock();
+
     /**
      * Unlocks the shared memory mutex, releasing the lock held by the
      * current process.
      *
-     * This method signals the underlying semaphore to indicate that the
-     * critical section is no longer held, allowing other processes or
-     * threads waiting to acquire the lock to proceed. If the semaphore
-     * operation fails, an exception of type std::system_error is thrown,
-     * encapsulating the error code and a descriptive message.
-     *
-     * @throws std::system_error If the semaphore operation (sem_post) fails.
+     * Never throws, since std::lock_guard calls it from its destructor. A
+     * failure, for example because the caller does not own the mutex, is
+     * logged.
      */
-    void unlock();
+    void unlock() noexcept;
 
     /**
-     * @brief Pointer to a named semaphore used for managing access to
-     *        shared resources.
-     *
-     * This variable holds a pointer to a `sem_t` semaphore, which is used
-     * for synchronizing access to shared resources between multiple
-     * processes in a thread-safe manner. It is created or opened using the
-     * `sem_open` system call and enables locking and unlocking mechanisms
-     * for interprocess communication.
-     *
-     * The semaphore is initialized during the construction of the
-     * `SharedMemoryMutex` object and released during its destruction.
+     * @return The lock slot in the shared segment, for callers that want
+     *         to display its name and statistics.
+     */
+    const MFW_SHMLOCK_T* get_lock() const;
+
+    /**
+     * @brief Pointer to the lock slot in the shared segment that this
+     *        object is bound to.
      */
 private:
-    sem_t* mutex_;
+    MFW_SHMLOCK_T* m_pLock;
+
+    void recover();
+    void record_acquisition(bool bContended, uint64_t u64WaitNs);
 };
 
 ////////////////////////
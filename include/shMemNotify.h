@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/shMemNotify.h 2026-10-17 15:05 dwg -          //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "mwfw2.h"
+
+/**
+ * Notification channels. The first five match shm_region_t one for one,
+ * so a region writer can publish (shm_channel_t)region. SHM_CHANNEL_ANY
+ * advances whenever any other channel does, for monitors that redraw on
+ * every change.
+ */
+enum shm_channel_t
+{
+    SHM_CHANNEL_CONFIG = 0,     // SharedMemoryConfig strings
+    SHM_CHANNEL_CREDS,          // creds[]
+    SHM_CHANNEL_PREFS,          // prefs[]
+    SHM_CHANNEL_TESTS,          // tests_* and num_tests_* counters
+    SHM_CHANNEL_LEDS,           // bLedCntl[]
+    SHM_CHANNEL_SESSIONS,       // the session table
+    SHM_CHANNEL_VARS,           // shmvars values and registrations
+    SHM_CHANNEL_ANY,            // any of the above
+    SHM_CHANNEL_COUNT
+};
+
+/**
+ * @struct MFW_NOTIFY_T
+ * @brief Per-channel generation counters, embedded in MFW_SHMEMNG_T.
+ *
+ * uGeneration is also the futex word that waiters sleep on. uWaiters
+ * lets a publisher skip the wake-up system call when nobody is waiting.
+ * Each channel has its own cache line.
+ */
+struct MFW_NOTIFY_T
+{
+    struct
+    {
+        alignas(64) uint32_t uGeneration;
+        uint32_t uWaiters;
+    } channels[CFG_SHM_NOTIFY_CHANNELS];
+};
+
+/**
+ * @class shm_notify
+ * @brief Change notification for the shared segment.
+ *
+ * A writer calls publish() after it has changed the state of a channel.
+ * A consumer reads generation(), reads the state, and then calls wait()
+ * with the generation it read; wait() returns as soon as the generation
+ * has moved on, or at once if it already has, so no change between the
+ * read and the wait is lost. Waiting is a futex on the generation word,
+ * which works across processes because the word lives in the segment.
+ *
+ * Generations only say that something changed, not what or how often:
+ * a consumer that was busy sees several publishes as one.
+ */
+class shm_notify
+{
+public:
+    /**
+     * @return The current generation of a channel.
+     */
+    static uint32_t generation(shm_channel_t channel);
+
+    /**
+     * Advances the generation of a channel and of SHM_CHANNEL_ANY and
+     * wakes their waiters. Costs two atomic adds when nobody waits.
+     */
+    static void publish(shm_channel_t channel);
+
+    /**
+     * Blocks until the generation of a channel differs from uSeen.
+     *
+     * @param channel The channel to wait on.
+     * @param uSeen The generation the caller last acted on.
+     * @param iTimeoutMs The longest wait in milliseconds, or -1 to wait
+     *        without limit.
+     * @return true if the generation advanced, false on timeout.
+     */
+    static bool wait(shm_channel_t channel, uint32_t uSeen,
+                     int iTimeoutMs = -1);
+};
+
+/////////////////////////
+// eof - shMemNotify.h //
+/////////////////////////
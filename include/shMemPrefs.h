@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/shMemPrefs.h 2026-10-17 17:05 dwg -           //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "mwfw2.h"
+
+#define SHM_PREFS_HANDLES (ROW_DATA + CFG_MAX_USERS)
+
+/**
+ * @struct MFW_PREFS_T
+ * @brief The colour set of one user, as written by prefs-action and
+ *        rendered into CSS by stylist.
+ */
+struct MFW_PREFS_T
+{
+    char szBodyFGcolor[COLOR_SIZE_MAX];
+    char szBodyBGcolor[COLOR_SIZE_MAX];
+    char szTableFGcolor[COLOR_SIZE_MAX];
+    char szTableBGcolor[COLOR_SIZE_MAX];
+    char szTrFGcolor[COLOR_SIZE_MAX];
+    char szTrBGcolor[COLOR_SIZE_MAX];
+    char szThFGcolor[COLOR_SIZE_MAX];
+    char szThBGcolor[COLOR_SIZE_MAX];
+    char szTdFGcolor[COLOR_SIZE_MAX];
+    char szTdBGcolor[COLOR_SIZE_MAX];
+    char szDbFGcolor[COLOR_SIZE_MAX];
+    char szDbBGcolor[COLOR_SIZE_MAX];
+};
+
+/**
+ * @struct MFW_PREFS_SLOT_T
+ * @brief Two copies of one user's colour set and the index of the one
+ *        that is published.
+ *
+ * A writer fills the copy that is not published and then flips uActive,
+ * so readers of the published copy are never disturbed. Each copy also
+ * has its own sequence number, odd while the copy is being written: a
+ * reader that was slow enough to still be reading a copy when a second
+ * publish starts overwriting it sees the number change and reads again.
+ */
+struct MFW_PREFS_SLOT_T
+{
+    alignas(64) uint32_t uActive;
+    uint32_t uSequence[2];
+    MFW_PREFS_T copies[2];
+};
+
+/**
+ * @class SharedMemoryPrefs
+ * @brief Publication and lock-free reading of per-user preferences.
+ *
+ * Only writers lock, on SHM_REGION_PREFS, and only against each other.
+ * Handles are the row handles used throughout the framework; an out of
+ * range handle is refused rather than indexed.
+ */
+class SharedMemoryPrefs
+{
+public:
+    /**
+     * Copies the published colour set of a user.
+     *
+     * @return false if the handle is out of range.
+     */
+    static bool load(int iHandle, MFW_PREFS_T& prefs);
+
+    /**
+     * Publishes a new colour set for a user, as a whole, and notifies
+     * SHM_CHANNEL_PREFS. Publishing the set that is already published
+     * does nothing.
+     *
+     * @return false if the handle is out of range.
+     */
+    static bool publish(int iHandle, const MFW_PREFS_T& prefs);
+
+    /**
+     * Fills one colour of a set from a string, truncating it to fit.
+     */
+    static void set(char (&szColor)[COLOR_SIZE_MAX],
+                    const std::string& ssValue);
+
+    /**
+     * Carries the prefs over from an older segment or snapshot. Besides
+     * its own layout it accepts the single-copy array of layout 6 and
+     * earlier, which becomes copy 0 of each slot.
+     */
+    static void migrate(void* pDst, const void* pSrc,
+                        size_t stDst, size_t stSrc);
+};
+
+////////////////////////
+// eof - shMemPrefs.h //
+////////////////////////
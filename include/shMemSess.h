@@ -0,0 +1,249 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/shMemSess.h 2026-10-17 06:50 dwg -            //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "mwfw2.h"
+
+/**
+ * Lifecycle of a session slot. A slot is claimed with a CAS from
+ * SESSION_SLOT_FREE to SESSION_SLOT_CLAIMED, filled in, and then
+ * published as SESSION_SLOT_LIVE. Removal reverses the process.
+ */
+enum session_slot_state_t
+{
+    SESSION_SLOT_FREE = 0,
+    SESSION_SLOT_CLAIMED,
+    SESSION_SLOT_LIVE
+};
+
+/**
+ * Empty and deleted markers for the open-addressing index. An index
+ * entry packs the 32-bit UUID hash in the upper half and (slot + 1) in
+ * the lower half, so a zero entry is always "never used".
+ */
+#define SESSION_INDEX_EMPTY     0x0000000000000000ULL
+#define SESSION_INDEX_TOMBSTONE 0xFFFFFFFFFFFFFFFFULL
+
+/**
+ * @struct MFW_SESSION_T
+ * @brief One authenticated session as it lives in the shared segment.
+ *
+ * The credential fields mirror the legacy creds[] row so that callers
+ * can move from the row-indexed table to UUID resolution without any
+ * change in what they display. uState and uGeneration are only ever
+ * touched through std::atomic_ref; uGeneration is odd while a writer
+ * owns the slot, which lets readers detect a copy torn by reuse.
+ *
+ * uLease is the second of SharedMemorySessions::now() at which the
+ * session lapses. It occupies what used to be padding, so the slot size
+ * and every other offset are unchanged.
+ */
+struct MFW_SESSION_T
+{
+    alignas(8) uint32_t uState;                // session_slot_state_t
+    uint32_t uGeneration;                      // odd while being written
+    int      iAuthHandle;                      // passwd.csv row
+    uint32_t uLease;                           // expiry, monotonic seconds
+    time_t   tCreated;
+
+    char szAuthUserName[UT_NAMESIZE];
+    char szAuthFirstName[UT_NAMESIZE];
+    char szAuthLastName[UT_NAMESIZE];
+    char szAuthUUID[UUID_SIZE];
+    char szAuthLevel[UT_NAMESIZE];
+
+    char szRemoteHost[DNS_FQDN_SIZE_MAX];
+    char szRemoteAddr[DNS_FQDN_SIZE_MAX];
+    char szHttpUserAgent[128];
+};
+
+/**
+ * Number of buckets per timing wheel level, and the span of the wheel.
+ */
+#define SESSION_WHEEL_SLOTS (1u << CFG_WHEEL_SHIFT)
+#define SESSION_WHEEL_SPAN  (1u << (CFG_WHEEL_SHIFT * CFG_WHEEL_LEVELS))
+
+/**
+ * @struct MFW_SESSION_WHEEL_T
+ * @brief Hierarchical timing wheel that schedules session expiry.
+ *
+ * Level 0 has one bucket per second, level 1 one per 64 seconds, and so
+ * on; a session sits in the lowest level whose span covers its lease.
+ * Buckets are doubly linked lists threaded through links[], which runs
+ * parallel to the session slots. All links hold (slot + 1) and a bucket
+ * number held in uBucket is (bucket + 1), so zero always means "none".
+ * The wheel is only touched under the sessions lock.
+ */
+struct MFW_SESSION_WHEEL_T
+{
+    alignas(64) uint32_t uTick;                // last second swept
+    uint32_t uScheduled;                       // sessions on the wheel
+    uint32_t buckets[CFG_WHEEL_LEVELS * SESSION_WHEEL_SLOTS];
+    struct
+    {
+        uint32_t uNext;
+        uint32_t uPrev;
+        uint32_t uBucket;
+    } links[CFG_MAX_SESSIONS];
+};
+
+/**
+ * @struct MFW_SESSION_TABLE_T
+ * @brief Session slots plus their UUID hash index, embedded in
+ *        MFW_SHMEMNG_T.
+ *
+ * The index has twice as many entries as there are slots so that the
+ * load factor never exceeds one half, which keeps linear probe runs
+ * short enough that CFG_SESSION_MAX_PROBE is never the limiting factor
+ * in practice.
+ */
+struct MFW_SESSION_TABLE_T
+{
+    alignas(64) uint32_t uCursor;              // allocation hint
+    uint32_t uLive;                            // number of live slots
+    uint32_t uTombs;                           // tombstones in index[]
+    uint32_t uIndexGen;                        // odd while index[] is rebuilt
+    alignas(64) uint64_t index[CFG_SESSION_INDEX_SIZE];
+    MFW_SESSION_T slots[CFG_MAX_SESSIONS];
+    MFW_SESSION_WHEEL_T wheel;                 // last, see migrate()
+};
+
+/**
+ * @class SharedMemorySessions
+ * @brief Lock-free session table in the shared segment, keyed by the
+ *        szAuthUUID issued at login.
+ *
+ * Writers allocate slots with compare-and-swap and publish them into an
+ * open-addressing index; readers resolve a UUID with at most
+ * CFG_SESSION_MAX_PROBE index loads and a single validated copy of the
+ * slot, so lookups are wait-free and never take the segment lock.
+ *
+ * Every session holds a lease. Lookups treat a lapsed lease as "not
+ * found" with one integer compare, and renew the lease of a session in
+ * use. Lapsed sessions are reclaimed by sweep(), which advances a timing
+ * wheel in the segment. The wheel and the index are only written under
+ * the sessions lock; lookups never take it.
+ *
+ * Logout and expiry leave tombstones in the index. Once there are more
+ * than CFG_SESSION_MAX_TOMBS of them, sweep() rebuilds the index without
+ * them, bracketed by an odd uIndexGen; a lookup that misses while the
+ * index is being rebuilt looks again.
+ */
+class SharedMemorySessions
+{
+    MFW_SESSION_TABLE_T* m_pTable;
+    std::unique_ptr<SharedMemoryMutex> m_pLock;
+
+    static uint32_t hash(const char* pszUUID);
+    bool copy_slot(uint32_t uSlot, MFW_SESSION_T& sess);
+    bool release(const char* pszUUID, uint32_t* puSlot);
+
+public:
+    /**
+     * Binds the object to the session table in the segment that gpSh
+     * has already attached.
+     */
+    SharedMemorySessions();
+
+    /**
+     * Publishes a new session. The caller fills in the credential fields
+     * of sess (szAuthUUID must be unique and non-empty); the state and
+     * generation fields are managed here.
+     *
+     * @return The slot number on success, or -1 if the table is full or
+     *         no index position could be found within the probe limit.
+     */
+    int create(const MFW_SESSION_T& sess);
+
+    /**
+     * Resolves a session by UUID and copies it out. A session past half
+     * of its lease is renewed for another CFG_SESSION_LEASE_S seconds.
+     *
+     * @return True if a live, unexpired session with that UUID was found
+     *         and sess holds a consistent copy of it.
+     */
+    bool find(const char* pszUUID, MFW_SESSION_T& sess);
+
+    /**
+     * Resolves a session by UUID without copying it.
+     *
+     * @return The slot number, or -1 if no live session has that UUID.
+     */
+    int find_slot(const char* pszUUID);
+
+    /**
+     * Removes the session with the given UUID and returns its slot to
+     * the free pool.
+     *
+     * @return True if a session was removed.
+     */
+    bool remove(const char* pszUUID);
+
+    /**
+     * Resolves the credentials behind an RPC or CGI request. A non-empty
+     * UUID is looked up in the session table. Older clients send only
+     * iHandle, in which case the session is the one whose UUID is held
+     * by that legacy creds[] row. Either way the lookup goes through
+     * find(), so it renews the lease.
+     *
+     * @return True if sess was filled from a live session; false if the
+     *         UUID is unknown or its lease has lapsed, or the row is out
+     *         of range, empty or no longer logged in.
+     */
+    bool resolve(const char* pszUUID, int iHandle, MFW_SESSION_T& sess);
+
+    /**
+     * Copies out the session in a given slot if it is live. Intended
+     * for monitors such as look and view_shared that walk the table.
+     */
+    bool get(int iSlot, MFW_SESSION_T& sess);
+
+    /**
+     * Expires every session whose lease has lapsed, recycles its slot and
+     * clears the creds[] row it was issued with. Cheap enough to call on
+     * every request: unless the wheel is behind the clock it is a single
+     * compare, and if another process is already sweeping it returns at
+     * once.
+     *
+     * @return The number of sessions expired.
+     */
+    int sweep();
+
+    /**
+     * The clock that leases are measured against: CLOCK_MONOTONIC_COARSE
+     * in whole seconds, which the kernel keeps up to date in the vDSO
+     * page, so reading it is not a system call.
+     */
+    static uint32_t now();
+
+    /**
+     * @return The number of live sessions.
+     */
+    int count();
+
+    /**
+     * @return The total number of session slots.
+     */
+    static constexpr int capacity() { return CFG_MAX_SESSIONS; }
+
+    /**
+     * Carries the table over from an older segment during a layout
+     * migration; see shm_migrate_fn. The copy is taken while older
+     * binaries may still be logging in and out, so slots caught half
+     * written are released and the index, live count and timing wheel
+     * are rebuilt to match the slots that survived. Sessions from a
+     * layout without leases get a fresh one.
+     */
+    static void migrate(void* pDst, const void* pSrc,
+                        size_t stDst, size_t stSrc);
+};
+
+///////////////////////
+// eof - shMemSess.h //
+///////////////////////
@@ -58,9 +58,42 @@ class shared
 {
 	int m_smsi;
 
+	void build_header();
+	void wait_until_ready();
+	void migrate_from_predecessor();
+	void reap_retired();
+	uint32_t migrate_fields(const MFW_SHMHDR_T* pOld, size_t stOldSize,
+	                        uint32_t uSkipFlags);
+	bool restore_snapshot();
+	static std::string snapshot_path();
+
 public:
 	shared();
 
+	/**
+	 * Every layout version lives under its own key, so that a segment in
+	 * an older layout can stay attached by the binaries that still use
+	 * it while a newer binary builds its replacement alongside. Layout
+	 * version 0 is the original, headerless segment at SHARED_ROOT_KEY.
+	 *
+	 * @param uLayoutVersion A CFG_SHM_LAYOUT_VERSION value.
+	 * @return The System V IPC key of the segment for that layout.
+	 */
+	static key_t key_for(uint32_t uLayoutVersion);
+
+	/**
+	 * Writes the warm-start snapshot: every member of the segment except
+	 * the volatile ones (sessions, credentials, locks, LEDs, test state),
+	 * to CFG_SHM_SNAPSHOT_NAME in the config dir. The file is built under
+	 * a temporary name through a shared mapping and renamed into place,
+	 * so a reader never sees a partial snapshot.
+	 *
+	 * @param bForce Write even if the config block has not changed since
+	 *        the last checkpoint, for example after prefs were saved.
+	 * @return True if the snapshot is current on return.
+	 */
+	bool checkpoint(bool bForce = false);
+
 #include "shmemng.h"
 };
 
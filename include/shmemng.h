@@ -11,47 +11,24 @@
 #include "mwfw2.h"
 
 /**
- * If you change the MFW_SHMEM_T schema, you need to reboot to assure
- * that you don't use a stale shared memory segment that is mis-aligned.
+ * If you change the MFW_SHMEMNG_T schema, bump CFG_SHM_LAYOUT_VERSION in
+ * config.h and keep the field table in shared.cpp in step with it. The
+ * next binary to start then builds a segment under the new key and
+ * migrates the running one into it by field name, so no reboot or
+ * remove-shared-memory.sh is needed. Bump a member's own version in the
+ * field table only if its element layout changed.
  * 2024/12/30 08:33 This is the shmemng structure for the HTML project.
  */
 struct MFW_SHMEMNG_T {
+    MFW_SHMHDR_T hdr;           // must stay first; see shMemHdr.h
     int iSignature;
 
-    // Phase 0 - locate development directory path & derivatives
-    char szDevoDir[FILENAME_MAX];
-
-    // Fully Qualified Directory Specs for all Devo folders
-    //    A fully qualified directory spec is a path to a directory
-    //    that is relative to the root of the file system.
-    //    It includes a trailing forward slash so that a  filename
-    //    can be appended to it.
-    char szBuildFQDS[FILENAME_MAX];
-    char szCgiBinFQDS[FILENAME_MAX];
-    char szConfigFQDS[FILENAME_MAX];
-    char szDocFQDS[FILENAME_MAX];
-    char szHomeFQDS[UT_NAMESIZE];
-    char szImgFQDS[FILENAME_MAX];
-    char szIncludeFQDS[FILENAME_MAX];
-    char szLogFQDS[FILENAME_MAX];
-    char szSchemasFQDS[FILENAME_MAX];
-    char szScriptsFQDS[FILENAME_MAX];
-    char szSourceFQDS[FILENAME_MAX];
-    char szStylesFQDS[FILENAME_MAX];
-    char szTempFQDS[FILENAME_MAX];
-    char szUserdirFQDS[UT_NAMESIZE];
-
-    // Fully Qualified File Specs for all Devo files
-    //    A fully qualified file spec is a path to a file
-    //    that is relative to the root of the file system.
-    //    It is ready as-is to be used in a file open call.
-    char szCgiBinFQFS[FILENAME_MAX];
-    char szConfigFQFS[FILENAME_MAX];
-
-    // Development Strings
-    char szHostname[DNS_FQDN_SIZE_MAX];
-    char szUser[UT_NAMESIZE];
-
+    /*************************************************************************
+     * The development paths, host identity and URL roots that used to be  *
+     * fixed char[FILENAME_MAX] and char[INET_URL_SIZE_MAX] fields here now *
+     * live packed in the config string pool below. Use                     *
+     * gpShMemCfg->get(SHM_STR_XXX) and set() instead. 2026-10-17 dwg       *
+     ************************************************************************/
 
       char szStatus[128];
 
@@ -59,19 +36,10 @@ struct MFW_SHMEMNG_T {
     bool bLedCntl[17];          // for html generation and real I/O
 
      size_t stShMemSize;
-    char szIP[DNS_FQDN_SIZE_MAX];
-    char szPublicIP[DNS_FQDN_SIZE_MAX];
-    char szIface[IFNAMSIZ];
-    char szProtocol[INET_PROT_NAME_MAX];
-    char szCgiRoot[INET_URL_SIZE_MAX];
-    char szHtmlRoot[INET_URL_SIZE_MAX];
-    char szImgRoot[INET_URL_SIZE_MAX];
 
 //    char szStylesRoot[INET_URL_SIZE_MAX];
-    char szStylesFileRoot[INET_URL_SIZE_MAX];
  //   char szTmpRoot[FILENAME_MAX];
 
-    char szRpcUuid[UUID_SIZE];             // 37
 
     char szRemoteHost[DNS_FQDN_SIZE_MAX];
     char szRemoteAddr[IPV4_ADDR_SIZE_MAX];
@@ -104,20 +72,36 @@ struct MFW_SHMEMNG_T {
 
     } creds[ROW_DATA+CFG_MAX_USERS];     // sizeof(creds) = 7236
 
-    struct {
-        char szBodyFGcolor[COLOR_SIZE_MAX];
-        char szBodyBGcolor[COLOR_SIZE_MAX];
-        char szTableFGcolor[COLOR_SIZE_MAX];
-        char szTableBGcolor[COLOR_SIZE_MAX];
-        char szTrFGcolor[COLOR_SIZE_MAX];
-        char szTrBGcolor[COLOR_SIZE_MAX];
-        char szThFGcolor[COLOR_SIZE_MAX];
-        char szThBGcolor[COLOR_SIZE_MAX];
-        char szTdFGcolor[COLOR_SIZE_MAX];
-        char szTdBGcolor[COLOR_SIZE_MAX];
-        char szDbFGcolor[COLOR_SIZE_MAX];
-        char szDbBGcolor[COLOR_SIZE_MAX];
-    } prefs[ROW_DATA+CFG_MAX_USERS];
+    /*************************************************************************
+     * sessions holds every live login keyed by szAuthUUID. Unlike creds[]  *
+     * it is not indexed by passwd.csv row, so any number of concurrent     *
+     * logins of the same user can coexist. Access it only through the      *
+     * SharedMemorySessions class (gpShMemSess). 2026-10-17 dwg             *
+     ************************************************************************/
+    MFW_SESSION_TABLE_T sessions;
+
+    /*************************************************************************
+     * locks holds the robust process-shared mutexes behind every           *
+     * SharedMemoryMutex, looked up by name, together with their contention *
+     * statistics. Slots are claimed on first use and never released, so a *
+     * lock outlives the processes that use it. 2026-10-17 dwg              *
+     ************************************************************************/
+    MFW_SHMLOCK_T locks[CFG_SHMLOCK_MAX];
+
+    /*************************************************************************
+     * config is the seqlock-protected string pool holding the mostly-read  *
+     * configuration strings: descriptors plus a packed arena with the hot  *
+     * strings first. Access it only through SharedMemoryConfig             *
+     * (gpShMemCfg); readers never take a lock. 2026-10-17 dwg              *
+     ************************************************************************/
+    MFW_CONFIG_BLOCK_T config;
+
+    /*************************************************************************
+     * prefs holds two copies of each user's colours and publishes one at a *
+     * time, so readers never lock and never see a half-written set. Use    *
+     * SharedMemoryPrefs to read and write it. 2026-10-17 dwg               *
+     ************************************************************************/
+    MFW_PREFS_SLOT_T prefs[SHM_PREFS_HANDLES];
 
     bool   tests_started;
     time_t time_started;
@@ -139,68 +123,35 @@ struct MFW_SHMEMNG_T {
     bool   bDisplayEnvVars;
     bool   bDisplaySchema;
 
-} *m_pShMemng;
+    /*************************************************************************
+     * warm records whether this segment was restored from the warm-start  *
+     * snapshot in the config dir, and what the last checkpoint wrote.     *
+     * See shared::checkpoint(). 2026-10-17 dwg                             *
+     ************************************************************************/
+    MFW_WARMSTART_T warm;
 
-class SharedMemoryMutex {
-public:
-    SharedMemoryMutex(const char* name) {
-        // Create or open a named semaphore
-        mutex_ = sem_open(name, O_CREAT, 0644, 1);
-        if (mutex_ == SEM_FAILED) {
-            throw std::system_error(errno, std::system_category(), "sem_open failed");
-        }
-    }
-
-    ~SharedMemoryMutex() {
-        if (mutex_ != SEM_FAILED) {
-            sem_close(mutex_);
-        }
-    }
-
-    void lock() {
-        if (sem_wait(mutex_) != 0) {
-            throw std::system_error(errno, std::system_category(), "sem_wait failed");
-        }
-    }
-
-    void unlock() {
-        if (sem_post(mutex_) != 0) {
-            throw std::system_error(errno, std::system_category(), "sem_post failed");
-        }
-    }
-
-private:
-    sem_t* mutex_;
-};
-
-class SharedMemoryManager {
-public:
-    SharedMemoryManager() 
-        : mutex_("/fw_shmem_mutex") { // Create mutex with unique name
-    }
-
-    void lockSharedMemory() {
-        std::lock_guard<SharedMemoryMutex> lock(mutex_);
-    }
-
-    void accessSharedMemory() {
-        // RAII-style locking
-        std::lock_guard<SharedMemoryMutex> lock(mutex_);
-        
-        // Now you can safely access m_pShMemng
-        //m_pShMemng->iSignature++;
-        // ... other operations ...
-    }
-
-    void releaseSharedMemory() {
-        // RAII-style unlocking
-        std::lock_guard<SharedMemoryMutex> unlock(mutex_);
-    }
-
-private:
-    SharedMemoryMutex mutex_;
-};
+    /*************************************************************************
+     * vars is the registry of named, typed variables that modules publish *
+     * at run time. Access it only through the shmvars class               *
+     * (gpShMemVars). 2026-10-17 dwg                                        *
+     ************************************************************************/
+    MFW_SHMVARS_T vars;
 
+    /*************************************************************************
+     * counters holds the named, per-CPU sharded event counters, such as   *
+     * the RPC request counts. Access it only through shm_counter.         *
+     * 2026-10-17 dwg                                                       *
+     ************************************************************************/
+    MFW_COUNTER_TABLE_T counters;
+
+    /*************************************************************************
+     * notify holds the change generations that monitors wait on. Writers  *
+     * call shm_notify::publish() after changing a region. Generations     *
+     * start over in a new segment, so it is never migrated. 2026-10-17 dwg *
+     ************************************************************************/
+    MFW_NOTIFY_T notify;
+
+} *m_pShMemng;
 
 /////////////////////
 // eof - shmemng.h //
@@ -1,5 +1,5 @@
 ////////////////////////////////////////////////////////////////////
-// ~/public_html/fw/shmvars.h 2025-07-16 08:08 dwg -              //
+// ~/public_html/fw/shmvars.h 2026-10-17 13:20 dwg -              //
 // This file is part of MultiWare Engineering's VPA and FrameWork //
 ////////////////////////////////////////////////////////////////////
 // This file is made available under the                          //
@@ -8,92 +8,171 @@
 
 #pragma once
 
-#define CHARDATA_SIZE_MAX 2083
+#include "mwfw2.h"
+
 #define SHMVAR_NAME_SIZE_MAX 32
-#define SHMVAR_VALUE_SIZE_MAX 2083
 
+/**
+ * Type of a registered variable. Numeric variables live entirely in the
+ * slot and are read and written with single atomic operations; strings
+ * get a buffer of the capacity requested at registration, carved out of
+ * the registry heap.
+ */
 enum svar_type_t
 {
-    SVAR_TYPE_INT,
+    SVAR_TYPE_NONE = 0,
+    SVAR_TYPE_INT64,
     SVAR_TYPE_DOUBLE,
-    SVAR_TYPE_LONG,
-    SVAR_TYPE_CHAR
+    SVAR_TYPE_STRING
 };
 
-enum svar_status_t
+/**
+ * @struct MFW_SHMVAR_T
+ * @brief One registered variable, exactly one cache line long.
+ *
+ * Everything but u64Value, uSequence and uLength is written once, before
+ * the slot is published in the index, and never changes afterwards.
+ * u64Value holds an int64_t or the bit pattern of a double. For a string,
+ * uSequence is a seqlock (odd while a writer is copying) over uLength and
+ * the heap buffer at uOffset.
+ */
+struct MFW_SHMVAR_T
 {
-    SVAR_STATUS_OK,
-    SVAR_STATUS_ERROR
+    alignas(64) char szName[SHMVAR_NAME_SIZE_MAX];
+    uint32_t uType;                            // svar_type_t
+    uint32_t uHash;
+    uint32_t uCapacity;                        // strings only
+    uint32_t uOffset;                          // strings only
+    uint64_t u64Value;                         // numeric only
+    uint32_t uSequence;                        // strings only
+    uint32_t uLength;                          // strings only
 };
 
-enum shmvar_index_t
+/**
+ * @struct MFW_SHMVARS_T
+ * @brief The variable registry, embedded in MFW_SHMEMNG_T.
+ *
+ * index is an open-addressing hash of variable names; an entry holds
+ * (slot + 1), so zero means empty. Variables are never removed, so there
+ * are no tombstones and a lookup stops at the first empty entry.
+ */
+struct MFW_SHMVARS_T
 {
-    SV_RMAJ,
-    SV_RMIN,
-    SV_RREV,
-    SV_RBLD,
-    SV_RSTRING,
-    SV_RSHORT,
-    SV_RLONG,
-    SV_RDATE,
-    SV_RTIME,
-    SV_RBUILD,
-    SV_RTYPE,
-    SV_RARCH,
-    SV_ROS,
-    SV_RHOST,
-    SV_RUSER,
-    SV_RDOMAIN,
-    SV_RIP,
-    SV_RMAC,
-    SV_RCPU,
-    SV_RCOMMENT,
-    SHMVAR_COUNT
+    alignas(64) uint32_t uCount;               // slots in use
+    uint32_t uHeapUsed;                        // string heap bytes in use
+    uint32_t index[CFG_SHMVAR_INDEX_SIZE];
+    MFW_SHMVAR_T vars[CFG_SHMVAR_MAX];
+    char heap[CFG_SHMVAR_HEAP_SIZE];
 };
 
-typedef struct shmvar_t
+/**
+ * @class shmvars
+ * @brief Registry of named, typed variables in the shared segment.
+ *
+ * Any module can publish a variable at run time by registering a name
+ * and a type; every process that registers the same name gets the same
+ * handle. Handles are slot numbers and stay valid for the life of the
+ * segment, so a caller resolves a name once and then reads and writes
+ * through the handle without hashing. Registration and string writes
+ * serialize on the registry's own shared lock; lookups, reads and
+ * numeric writes never lock.
+ */
+class shmvars
 {
-    char svar_name[SHMVAR_NAME_SIZE_MAX];
-    int svar_type;
-    int svar_status;
-
-    union
-    {
-        struct
-        {
-            int data;
-        } uInt;
-
-        struct
-        {
-            double data;
-        } uDouble;
-
-        struct
-        {
-            long data;
-        } uLong;
-
-        struct
-        {
-            char data[CHARDATA_SIZE_MAX];
-        } uChar;
-    } svar_value;
-};
+    MFW_SHMVARS_T* m_pVars;
+    std::unique_ptr<SharedMemoryMutex> m_pLock;
 
+    static uint32_t hash(const char* pszName);
+    MFW_SHMVAR_T* slot(int iHandle, svar_type_t type);
 
-class shmvars
-{
 public:
+    /**
+     * Binds the object to the registry in the segment that gpSh has
+     * already attached.
+     */
     shmvars();
-    void set(
-        shmvar_index_t index, std::string ssName, std::string ssValue);
-    void set(
-        shmvar_index_t index, std::string ssName, int iValue);
 
-    std::string get_string(int index);
-};
+    /**
+     * Registers a variable, or returns the existing one of that name.
+     *
+     * @param pszName Up to SHMVAR_NAME_SIZE_MAX - 1 characters, for
+     *        example "vparpc.requests".
+     * @param type The type of the variable.
+     * @param stCapacity For strings, the largest value to be stored,
+     *        including the terminator; ignored for numeric types.
+     * @return The handle, or -1 if the name is already registered with
+     *         another type or the registry is full.
+     */
+    int reg(const char* pszName, svar_type_t type, size_t stCapacity = 64);
+
+    /**
+     * Resolves a name without registering it.
+     *
+     * @return The handle, or -1 if no such variable exists.
+     */
+    int find(const char* pszName) const;
+
+    /**
+     * Stores a value. The call is ignored if iHandle does not name a
+     * variable of the matching type. Strings longer than the capacity
+     * are truncated. Every change, like every registration, is published
+     * on SHM_CHANNEL_VARS; counts bumped on every request belong in a
+     * shm_counter instead.
+     */
+    void set(int iHandle, int64_t i64Value);
+    void set(int iHandle, double dValue);
+    void set(int iHandle, const std::string& ssValue);
 
+    /**
+     * Atomically adds to an int64 variable.
+     *
+     * @return The new value, or 0 if iHandle is not an int64 variable.
+     */
+    int64_t add(int iHandle, int64_t i64Delta);
+
+    /**
+     * @return The value of an int64 variable; 0 for any other handle.
+     */
+    int64_t get_int(int iHandle) const;
+
+    /**
+     * @return The value of a double variable; 0.0 for any other handle.
+     */
+    double get_double(int iHandle) const;
+
+    /**
+     * Returns any variable formatted as a string. Numbers are formatted
+     * only here, on demand, never when they are stored.
+     *
+     * @return The value, or "" for an invalid handle.
+     */
+    std::string get_string(int iHandle) const;
+
+    /**
+     * @return The name of a variable, or "" for an invalid handle.
+     */
+    const char* name(int iHandle) const;
+
+    /**
+     * @return The type of a variable, or SVAR_TYPE_NONE.
+     */
+    svar_type_t type(int iHandle) const;
+
+    /**
+     * @return The number of registered variables. Handles run from zero
+     *         to count() - 1.
+     */
+    int count() const;
+
+    /**
+     * Carries the registry over from an older segment during a layout
+     * migration; see shm_migrate_fn. A string caught mid-write is left
+     * with an even sequence so that readers of the new segment never
+     * wait for a writer that is not there.
+     */
+    static void migrate(void* pDst, const void* pSrc,
+                        size_t stDst, size_t stSrc);
+};
 
 /////////////////////
 // eof - shmvars.h //
@@ -20,21 +20,33 @@
 #include <arpa/inet.h>
 //#include <errno.h>        // deprecated by <cerrno>
 #include <fcntl.h>
+#include <grp.h>              // added 2026-10-17 for rpcServer peer credentials
+#include <ifaddrs.h>          // added 2026-10-17 for warm-start checks
 #include <memory.h>
+#include <linux/futex.h>     // added 2026-10-17 for shm_notify
+#include <linux/io_uring.h>  // added 2026-10-17 for rpcUring
 #include <net/if.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>      // added 2026-10-17 for example-rpc-bench
+#include <poll.h>             // added 2026-10-17 for vparpc batches
 #include <pthread.h>
 #include <pwd.h>
 //#include <stdio.h>        // deprecated by <cstdio>
 //#include <stdlib.h>       // deprecated by <cstdlib>
+#include <sys/epoll.h>        // added 2026-10-17 for rpcServer
+#include <sys/eventfd.h>      // added 2026-10-17 for rpcServer
 #include <sys/ipc.h>
+#include <sys/mman.h>         // added 2026-10-17 for shm snapshots
+#include <sys/prctl.h>        // added 2026-10-17 for rpcPrefork
 #include <sys/shm.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/syscall.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <sys/un.h>             // added 2026-10-17 for unix: RPC services
+#include <sys/wait.h>         // added 2026-10-17 for rpcPrefork
 //#include <string.h>         // deprecated by <cstring>
 #include <strings.h>
 #include <syslog.h>
@@ -53,6 +65,7 @@
 #include <any>
 #include <array>
 #include <atomic>
+#include <bit>                 // added 2026-10-17 for shm_hash_map
 #include <bitset>
 #include <cassert>
 #include <ccomplex>
@@ -68,7 +81,9 @@
 #include <cmath>
 #include <codecvt>
 #include <complex>
+#include <coroutine>           // added 2026-10-17 for rpcClient
 #include <condition_variable>
+#include <csignal>             // added 2026-10-17 for rpcShmRing
 #include <cstdarg>
 #include <cstdint>
 #include <cstdio>
@@ -19,7 +19,10 @@
  * The initial or no version state.
  *
  * @constant VPARPC_VERSION_1
- * Version 1 of the vparpc protocol.
+ * Version 1 of the vparpc protocol: whole request structs on the wire.
+ *
+ * @constant VPARPC_VERSION_2
+ * Version 2: a compact header and tagged fields (see vparpcWire).
  *
  * @constant VPARPC_VERSION_COUNT
  * The total count of available versions. Used for validation.
@@ -28,36 +31,10 @@ enum vparpc_version_t
 {
     VPARPC_VERSION_NONE = 0,
     VPARPC_VERSION_1,
+    VPARPC_VERSION_2,
     VPARPC_VERSION_COUNT
 };
 
-/**
- * @enum vparpc_func_t
- * @brief Enumerates the available functions for the virtual process RPC.
- *
- * This enumeration defines the functions that can be invoked in the
- * virtual process RPC interface. Each function serves a specific
- * purpose in the operation of the system.
- *
- * - VPARPC_FUNC_NONE: Represents a no-operation or null function.
- * - VPARPC_FUNC_GET_AUTH: Used for authentication retrieval.
- * - VPARPC_FUNC_HOST2IPV4ADDR: Resolves a hostname to its corresponding IPv4 address.
- * - VPARPC_FUNC_VERSION: Retrieves the version information of the RPC system.
- * - VPARPC_FUNC_COUNT: Represents the total count of available functions and is used
- *   for validation purposes.
- */
-enum vparpc_func_t
-{
-    VPARPC_FUNC_NONE = 0, // No operation/null function
-    VPARPC_FUNC_GET_AUTH, // Authentication retrieval function
-    VPARPC_FUNC_HOST2IPV4ADDR, // Hostname to IPv4 address resolution function
-    VPARPC_FUNC_VERSION, // Version information retrieval function
-    VPARPC_FUNC_LOOKUP, // using username/password , get handle
-    VPARPC_FUNC_CREDS, // using handle, get credentials
-    VPARPC_FUNC_URLS, // Get VPA URLS function
-    VPARPC_FUNC_COUNT // Total count of available functions
-};
-
 /**
  * @enum vparpc_status_t
  * @brief Enumerates the possible status codes for vparpc operations.
@@ -101,129 +78,39 @@ enum vparpc_status_t
 #define VPARPC_MAX_PAYLOAD_SIZE 512
 
 /**
- * @struct vparpc_request_generic_t
- * @brief Represents a generic RPC request structure in the vparpc system.
- *
- * This structure encapsulates the essential components of a generic request
- * made to the vparpc system. It includes information about the version of the
- * protocol, the size of the request data, the function being invoked, and
- * a universally unique identifier (UUID) associated with the request.
+ * vparpc_func_t, the request structs (vparpc_request_generic_t,
+ * vparpc_request_auth_t, ...) and vparpc_request_t are generated by
+ * rpcCompiler from schemas/v1/vparpc-idl.csv.
+ *
+ * Every request begins with eVersion, uRequestId, nSize and eFunc.
+ * uRequestId occupies what was alignment padding before nSize, so every
+ * request keeps its size and layout. The client numbers its requests and
+ * the server echoes the number in the reply, which lets a client that has
+ * several requests outstanding tell the replies apart.
  */
-struct vparpc_request_generic_t
-{
-    vparpc_version_t eVersion;
-    size_t nSize;
-    vparpc_func_t eFunc;
-    char8_t szUUID[UUID_SIZE];
-    char szPadding[1016];
-};
-
+#include "vparpcIdlTypes.hh"
 
-/***********************************************************************
- * @struct vparpc_request_auth_t
- * @brief Represents an authentication request in the vparpc protocol.
- *
- * This structure is used to handle and encapsulate authentication requests
- * in the vparpc communication protocol.
- *
- * @var eVersion
- * The version of the vparpc protocol being used for this request.
- *
- * @var nSize
- * The size of the request in bytes.
- *
- * @var eFunc
- * The function or operation identifier associated with the authentication
- * request.
- *
- * @var szPSK
- * The Pre-Shared Key (PSK) used for authentication. This array is sized
- * based on UUID_SIZE.
- *
- * @var eStatus
- * The status of the authentication request. Indicates any errors or success.
- *
- * @var szAuth
- * The resulting authentication token or identifier. This array is sized
- * based on UUID_SIZE.
+/**
+ * Every request begins with eVersion and nSize, and nSize is the length
+ * of the whole request, so the first VPARPC_FRAME_HEADER_SIZE bytes of a
+ * request say how long it is. Replies are framed the same way; a reply
+ * is the request with its response fields filled in. v2 frames (see
+ * vparpcWire) begin with the same header.
  */
-struct vparpc_request_auth_t
-{
-    vparpc_version_t eVersion;
-    size_t nSize;
-    vparpc_func_t eFunc;
-    char8_t szPSK[UUID_SIZE];
-    vparpc_status_t eStatus;
-    char szAuth[UUID_SIZE];
-    char szPadding[976];
-};
-
-
-struct vparpc_request_version_t
-{
-    vparpc_version_t eVersion;
-    size_t nSize;
-    vparpc_func_t eFunc;
-    char8_t szAuth[UUID_SIZE];
-    vparpc_status_t eStatus;
-    char szVersion[VERSION_SIZE_MAX];
-    char szPadding[1000];
-};
+#define VPARPC_FRAME_HEADER_SIZE offsetof(vparpc_request_generic_t, eFunc)
 
+static_assert(offsetof(vparpc_request_generic_t, nSize) == 8,
+              "uRequestId must not move nSize");
 
-struct vparpc_request_lookup_t
-{
-    vparpc_version_t eVersion;
-    size_t nSize;
-    vparpc_func_t eFunc;
-    char8_t szAuth[UUID_SIZE];
-    char szUsername[UT_NAMESIZE];
-    char szPassword[UT_NAMESIZE];
-    vparpc_status_t eStatus;
-    int iHandle;
-    char szPadding[944];
-};
-
-struct vparpc_request_creds_t
-{
-    vparpc_version_t eVersion;
-    size_t nSize;
-    vparpc_func_t eFunc;
-    char8_t szAuth[UUID_SIZE];
-    int iHandle;
-    vparpc_status_t eStatus;
-    char szAuthUserName[UT_NAMESIZE];
-    char szAuthFirstName[UT_NAMESIZE];
-    char szAuthLastName[UT_NAMESIZE];
-    char szAuthUUID[UUID_SIZE];
-    char szAuthLevel[UT_NAMESIZE];
-    char szRemoteHost[DNS_FQDN_SIZE_MAX];
-    char szRemoteAddr[DNS_FQDN_SIZE_MAX];
-    char szHttpUserAgent[128];
-    char szPadding[208];
-};
-
-struct vparpc_request_urls_t
-{
-    vparpc_version_t eVersion;
-    size_t nSize;
-    vparpc_func_t eFunc;
-    char8_t szAuth[UUID_SIZE];
-    vparpc_status_t eStatus;
-    char szIP[DNS_FQDN_SIZE_MAX];
-    char szCgiRoot[DNS_FQDN_SIZE_MAX];
-    char szStylesRoot[DNS_FQDN_SIZE_MAX];
-    char szpadding[DNS_FQDN_SIZE_MAX];
-};
-
-union vparpc_request_t
+/**
+ * @struct vparpc_call_t
+ * @brief One request of a batch or pipeline: the packet, which its reply
+ *        overwrites, and the size of the packet's buffer.
+ */
+struct vparpc_call_t
 {
-    struct vparpc_request_generic_t req_generic;
-    struct vparpc_request_auth_t req_auth;
-    struct vparpc_request_version_t req_version;
-    struct vparpc_request_lookup_t req_lookup;
-    struct vparpc_request_creds_t req_creds;
-    struct vparpc_request_urls_t req_urls;
+    void* pPacket;
+    size_t stLen;
 };
 
 
@@ -232,10 +119,30 @@ class vparpc
 private:
     window* v_pWin;
     int v_nListenSocket;
-    int v_nSendSocket;
+    int v_nSendSocket;          // the pipeline's connection, or -1
+    std::mutex v_sendLock;
+    uint32_t v_uNextId;
+    std::vector<vparpc_call_t> v_pipeline;  // sent on v_nSendSocket, unanswered
+    std::string v_ssPipeHost;               // where v_pipeline was sent
+    std::string v_ssPipeService;
+    bool v_bPipelineOk;                     // no pipelined call failed so far
+
+    bool number_calls(vparpc_call_t* pCalls, size_t nCalls, window& win);
+    bool start_calls(const std::string& ssHostName,
+                     const std::string& ssServiceName,
+                     const vparpc_call_t* pCalls, size_t nCalls,
+                     window& win, int& fd, bool& bFresh);
+    int receive_calls(int fd, std::vector<vparpc_call_t>& pending,
+                      vparpc_version_t& ePeer);
+    bool complete_calls(const std::string& ssHostName,
+                        const std::string& ssServiceName,
+                        std::vector<vparpc_call_t>& pending,
+                        window& win, int& fd, bool bFresh);
+    bool collect_pipeline(window& win);
 
 public:
     vparpc();
+    ~vparpc();
     void handle_auth_request(char* buffer, window* pWin);
     void handle_version_request(char* buffer, window* pWin);
     void handle_lookup_request(char* buffer, window* pWin);
@@ -243,8 +150,89 @@ public:
     void handle_urls_request(char* buffer, window* pWin);
 
     void server(std::string ssService);
+
+    /**
+     * Serves RPC requests with an epoll reactor and a pool of worker
+     * threads (see rpcServer) instead of one client at a time. Returns
+     * only if the listening socket cannot be set up.
+     *
+     * @param ssService The service name to resolve to a port number, or
+     *        a CFG_VPARPC_UNIX_PREFIX name of a local socket, whose root,
+     *        same-user and CFG_VPARPC_UNIX_GROUP peers skip the PSK and
+     *        the auth token, or a CFG_VPARPC_SHM_PREFIX name of a
+     *        shared-memory ring (see rpcShmRing), whose callers all do.
+     * @param iWorkers Worker threads; 0 means one per online CPU.
+     * @param iBacklog The listen() queue length.
+     * @param eBackend The I/O backend; RPC_BACKEND_URING falls back to
+     *        epoll on kernels without the io_uring features it needs.
+     */
+    void server_pool(std::string ssService,
+                     int iWorkers = CFG_VPARPC_WORKERS,
+                     int iBacklog = CFG_VPARPC_BACKLOG,
+                     rpc_backend_t eBackend = RPC_BACKEND_EPOLL);
     void process(char* pszBuffer);
     void client(std::string host, std::string service, void* pkt, size_t len);
+
+    /**
+     * Sends several requests to one server in a single write and waits
+     * for all of their replies, each into its own packet. The server
+     * answers them in order on the one connection, so N calls cost one
+     * round trip instead of N.
+     *
+     * @return false if any call went unanswered.
+     */
+    bool client_batch(std::string host, std::string service,
+                      vparpc_call_t* pCalls, size_t nCalls);
+
+    /**
+     * Sends a request without waiting for its reply. The packet must stay
+     * in place until pipeline_collect() has returned; its reply is matched
+     * to it by uRequestId. After CFG_VPARPC_PIPELINE_DEPTH outstanding
+     * requests, or a request to a different server, the outstanding
+     * replies are collected first.
+     *
+     * @return false if the request could not be sent.
+     */
+    bool pipeline_send(std::string host, std::string service,
+                       void* pkt, size_t len);
+
+    /**
+     * Waits for the reply to every request pipeline_send() has sent.
+     *
+     * @return false if any of them went unanswered.
+     */
+    bool pipeline_collect();
+
+    /**
+     * Checks the frame at the start of pBuffer.
+     *
+     * @return The length of the frame, 0 if fewer than
+     *         VPARPC_FRAME_HEADER_SIZE bytes are present, or -1 if nSize
+     *         is shorter than the header or longer than stMax.
+     */
+    static ssize_t frame_length(const void* pBuffer, size_t stHave,
+                                size_t stMax);
+
+    /**
+     * Writes a whole frame, however many writes it takes.
+     *
+     * @return false if the descriptor failed or timed out first.
+     */
+    static bool send_frame(int fd, const void* pFrame, size_t stLen);
+
+    /**
+     * Reads exactly one frame: the header, then the rest of nSize bytes.
+     *
+     * @return The length of the frame, 0 if the peer closed before
+     *         sending anything, or -1 on error, timeout or a bad nSize.
+     */
+    static ssize_t recv_frame(int fd, void* pBuffer, size_t stMax);
+
+    /**
+     * Sets SO_RCVTIMEO and SO_SNDTIMEO to CFG_VPARPC_IO_TIMEOUT_MS, which
+     * on Linux also bounds a blocking connect().
+     */
+    static void set_io_timeout(int fd);
     int svc2port(std::string ssSvcName);
     std::string host2ipv4addr(const std::string& ssHost);
     void render();
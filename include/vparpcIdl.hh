@@ -0,0 +1,488 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/include/vparpcIdl.hh                          //
+// Generated by rpcCompiler from schemas/v1/vparpc-idl.csv.       //
+// Do not edit; change the IDL and run "vpautil -i".              //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+template <>
+struct vparpc_idl<vparpc_request_auth_t>
+{
+    static constexpr vparpc_func_t eFunc = VPARPC_FUNC_GET_AUTH;
+
+    static void init(vparpc_request_auth_t& m)
+    {
+        memset(&m, 0, sizeof(m));
+        m.eVersion = VPARPC_VERSION_1;
+        m.nSize = sizeof(m);
+        m.eFunc = eFunc;
+    }
+
+    static void encode(const vparpc_request_auth_t& m, bool bReply,
+                       vparpcWire::writer& out)
+    {
+        if (bReply)
+        {
+            out.status(m.eStatus);
+            out.put(2, m.szAuth);
+            return;
+        }
+        out.put(1, m.szPSK);
+    }
+
+    static bool decode(vparpc_request_auth_t& m, bool bReply,
+                       vparpcWire::reader& in)
+    {
+        uint32_t uTag;
+        std::string_view value;
+        if (bReply)
+        {
+            m.eStatus = (vparpc_status_t)in.status();
+            vparpcWire::clear(m.szAuth);
+            while (in.next(uTag, value))
+            {
+                switch (uTag)
+                {
+                case 2:
+                    vparpcWire::get(m.szAuth, value);
+                    break;
+                }
+            }
+            return in.valid();
+        }
+        while (in.next(uTag, value))
+        {
+            switch (uTag)
+            {
+            case 1:
+                vparpcWire::get(m.szPSK, value);
+                break;
+            }
+        }
+        return in.valid();
+    }
+};
+
+template <>
+struct vparpc_idl<vparpc_request_version_t>
+{
+    static constexpr vparpc_func_t eFunc = VPARPC_FUNC_VERSION;
+
+    static void init(vparpc_request_version_t& m)
+    {
+        memset(&m, 0, sizeof(m));
+        m.eVersion = VPARPC_VERSION_1;
+        m.nSize = sizeof(m);
+        m.eFunc = eFunc;
+    }
+
+    static void encode(const vparpc_request_version_t& m, bool bReply,
+                       vparpcWire::writer& out)
+    {
+        if (bReply)
+        {
+            out.status(m.eStatus);
+            out.put(2, m.szVersion);
+            return;
+        }
+        out.put(1, m.szAuth);
+    }
+
+    static bool decode(vparpc_request_version_t& m, bool bReply,
+                       vparpcWire::reader& in)
+    {
+        uint32_t uTag;
+        std::string_view value;
+        if (bReply)
+        {
+            m.eStatus = (vparpc_status_t)in.status();
+            vparpcWire::clear(m.szVersion);
+            while (in.next(uTag, value))
+            {
+                switch (uTag)
+                {
+                case 2:
+                    vparpcWire::get(m.szVersion, value);
+                    break;
+                }
+            }
+            return in.valid();
+        }
+        while (in.next(uTag, value))
+        {
+            switch (uTag)
+            {
+            case 1:
+                vparpcWire::get(m.szAuth, value);
+                break;
+            }
+        }
+        return in.valid();
+    }
+};
+
+template <>
+struct vparpc_idl<vparpc_request_lookup_t>
+{
+    static constexpr vparpc_func_t eFunc = VPARPC_FUNC_LOOKUP;
+
+    static void init(vparpc_request_lookup_t& m)
+    {
+        memset(&m, 0, sizeof(m));
+        m.eVersion = VPARPC_VERSION_1;
+        m.nSize = sizeof(m);
+        m.eFunc = eFunc;
+    }
+
+    static void encode(const vparpc_request_lookup_t& m, bool bReply,
+                       vparpcWire::writer& out)
+    {
+        if (bReply)
+        {
+            out.status(m.eStatus);
+            out.put(4, m.iHandle);
+            return;
+        }
+        out.put(1, m.szAuth);
+        out.put(2, m.szUsername);
+        out.put(3, m.szPassword);
+    }
+
+    static bool decode(vparpc_request_lookup_t& m, bool bReply,
+                       vparpcWire::reader& in)
+    {
+        uint32_t uTag;
+        std::string_view value;
+        if (bReply)
+        {
+            m.eStatus = (vparpc_status_t)in.status();
+            vparpcWire::clear(m.iHandle);
+            while (in.next(uTag, value))
+            {
+                switch (uTag)
+                {
+                case 4:
+                    if (!vparpcWire::get(m.iHandle, value))
+                    {
+                        return false;
+                    }
+                    break;
+                }
+            }
+            return in.valid();
+        }
+        while (in.next(uTag, value))
+        {
+            switch (uTag)
+            {
+            case 1:
+                vparpcWire::get(m.szAuth, value);
+                break;
+            case 2:
+                vparpcWire::get(m.szUsername, value);
+                break;
+            case 3:
+                vparpcWire::get(m.szPassword, value);
+                break;
+            }
+        }
+        return in.valid();
+    }
+};
+
+template <>
+struct vparpc_idl<vparpc_request_creds_t>
+{
+    static constexpr vparpc_func_t eFunc = VPARPC_FUNC_CREDS;
+
+    static void init(vparpc_request_creds_t& m)
+    {
+        memset(&m, 0, sizeof(m));
+        m.eVersion = VPARPC_VERSION_1;
+        m.nSize = sizeof(m);
+        m.eFunc = eFunc;
+    }
+
+    static void encode(const vparpc_request_creds_t& m, bool bReply,
+                       vparpcWire::writer& out)
+    {
+        if (bReply)
+        {
+            out.status(m.eStatus);
+            out.put(3, m.szAuthUserName);
+            out.put(4, m.szAuthFirstName);
+            out.put(5, m.szAuthLastName);
+            out.put(6, m.szAuthUUID);
+            out.put(7, m.szAuthLevel);
+            out.put(8, m.szRemoteHost);
+            out.put(9, m.szRemoteAddr);
+            out.put(10, m.szHttpUserAgent);
+            return;
+        }
+        out.put(1, m.szAuth);
+        out.put(2, m.iHandle);
+        out.put(6, m.szAuthUUID);
+    }
+
+    static bool decode(vparpc_request_creds_t& m, bool bReply,
+                       vparpcWire::reader& in)
+    {
+        uint32_t uTag;
+        std::string_view value;
+        if (bReply)
+        {
+            m.eStatus = (vparpc_status_t)in.status();
+            vparpcWire::clear(m.szAuthUserName);
+            vparpcWire::clear(m.szAuthFirstName);
+            vparpcWire::clear(m.szAuthLastName);
+            vparpcWire::clear(m.szAuthUUID);
+            vparpcWire::clear(m.szAuthLevel);
+            vparpcWire::clear(m.szRemoteHost);
+            vparpcWire::clear(m.szRemoteAddr);
+            vparpcWire::clear(m.szHttpUserAgent);
+            while (in.next(uTag, value))
+            {
+                switch (uTag)
+                {
+                case 3:
+                    vparpcWire::get(m.szAuthUserName, value);
+                    break;
+                case 4:
+                    vparpcWire::get(m.szAuthFirstName, value);
+                    break;
+                case 5:
+                    vparpcWire::get(m.szAuthLastName, value);
+                    break;
+                case 6:
+                    vparpcWire::get(m.szAuthUUID, value);
+                    break;
+                case 7:
+                    vparpcWire::get(m.szAuthLevel, value);
+                    break;
+                case 8:
+                    vparpcWire::get(m.szRemoteHost, value);
+                    break;
+                case 9:
+                    vparpcWire::get(m.szRemoteAddr, value);
+                    break;
+                case 10:
+                    vparpcWire::get(m.szHttpUserAgent, value);
+                    break;
+                }
+            }
+            return in.valid();
+        }
+        while (in.next(uTag, value))
+        {
+            switch (uTag)
+            {
+            case 1:
+                vparpcWire::get(m.szAuth, value);
+                break;
+            case 2:
+                if (!vparpcWire::get(m.iHandle, value))
+                {
+                    return false;
+                }
+                break;
+            case 6:
+                vparpcWire::get(m.szAuthUUID, value);
+                break;
+            }
+        }
+        return in.valid();
+    }
+};
+
+template <>
+struct vparpc_idl<vparpc_request_urls_t>
+{
+    static constexpr vparpc_func_t eFunc = VPARPC_FUNC_URLS;
+
+    static void init(vparpc_request_urls_t& m)
+    {
+        memset(&m, 0, sizeof(m));
+        m.eVersion = VPARPC_VERSION_1;
+        m.nSize = sizeof(m);
+        m.eFunc = eFunc;
+    }
+
+    static void encode(const vparpc_request_urls_t& m, bool bReply,
+                       vparpcWire::writer& out)
+    {
+        if (bReply)
+        {
+            out.status(m.eStatus);
+            out.put(2, m.szIP);
+            out.put(3, m.szCgiRoot);
+            out.put(4, m.szStylesRoot);
+            return;
+        }
+        out.put(1, m.szAuth);
+    }
+
+    static bool decode(vparpc_request_urls_t& m, bool bReply,
+                       vparpcWire::reader& in)
+    {
+        uint32_t uTag;
+        std::string_view value;
+        if (bReply)
+        {
+            m.eStatus = (vparpc_status_t)in.status();
+            vparpcWire::clear(m.szIP);
+            vparpcWire::clear(m.szCgiRoot);
+            vparpcWire::clear(m.szStylesRoot);
+            while (in.next(uTag, value))
+            {
+                switch (uTag)
+                {
+                case 2:
+                    vparpcWire::get(m.szIP, value);
+                    break;
+                case 3:
+                    vparpcWire::get(m.szCgiRoot, value);
+                    break;
+                case 4:
+                    vparpcWire::get(m.szStylesRoot, value);
+                    break;
+                }
+            }
+            return in.valid();
+        }
+        while (in.next(uTag, value))
+        {
+            switch (uTag)
+            {
+            case 1:
+                vparpcWire::get(m.szAuth, value);
+                break;
+            }
+        }
+        return in.valid();
+    }
+};
+
+/**
+ * The v2 codec of each function, indexed by vparpc_func_t.
+ */
+inline constexpr vparpc_idl_codec_t vparpc_idl_codecs[VPARPC_FUNC_COUNT] = {
+    {0, nullptr, nullptr}, // NONE
+    VPARPC_IDL_CODEC(vparpc_request_auth_t), // GET_AUTH
+    {0, nullptr, nullptr}, // HOST2IPV4ADDR
+    VPARPC_IDL_CODEC(vparpc_request_version_t), // VERSION
+    VPARPC_IDL_CODEC(vparpc_request_lookup_t), // LOOKUP
+    VPARPC_IDL_CODEC(vparpc_request_creds_t), // CREDS
+    VPARPC_IDL_CODEC(vparpc_request_urls_t), // URLS
+};
+
+/**
+ * X(FUNC, member) for every function the servers handle, each by
+ * a handle_<member>_request(char*, window*).
+ */
+#define VPARPC_IDL_HANDLERS(X) \
+    X(GET_AUTH, auth) \
+    X(VERSION, version) \
+    X(LOOKUP, lookup) \
+    X(CREDS, creds) \
+
+
+/**
+ * Calls VPARPC_FUNC_GET_AUTH: Authentication retrieval function.
+ *
+ * @param reply Receives the answered request.
+ * @return false if the call went unanswered.
+ */
+inline bool vparpc_call_auth(
+    vparpc& rpc, const std::string& ssHost, const std::string& ssService,
+    std::string_view szPSK,
+    vparpc_request_auth_t& reply)
+{
+    vparpc_idl<vparpc_request_auth_t>::init(reply);
+    vparpcWire::set(reply.szPSK, szPSK);
+    vparpc_call_t call = {&reply, sizeof(reply)};
+    return rpc.client_batch(ssHost, ssService, &call, 1);
+}
+
+/**
+ * Calls VPARPC_FUNC_VERSION: Version information retrieval function.
+ *
+ * @param reply Receives the answered request.
+ * @return false if the call went unanswered.
+ */
+inline bool vparpc_call_version(
+    vparpc& rpc, const std::string& ssHost, const std::string& ssService,
+    std::string_view szAuth,
+    vparpc_request_version_t& reply)
+{
+    vparpc_idl<vparpc_request_version_t>::init(reply);
+    vparpcWire::set(reply.szAuth, szAuth);
+    vparpc_call_t call = {&reply, sizeof(reply)};
+    return rpc.client_batch(ssHost, ssService, &call, 1);
+}
+
+/**
+ * Calls VPARPC_FUNC_LOOKUP: using username/password get handle.
+ *
+ * @param reply Receives the answered request.
+ * @return false if the call went unanswered.
+ */
+inline bool vparpc_call_lookup(
+    vparpc& rpc, const std::string& ssHost, const std::string& ssService,
+    std::string_view szAuth,
+    std::string_view szUsername,
+    std::string_view szPassword,
+    vparpc_request_lookup_t& reply)
+{
+    vparpc_idl<vparpc_request_lookup_t>::init(reply);
+    vparpcWire::set(reply.szAuth, szAuth);
+    vparpcWire::set(reply.szUsername, szUsername);
+    vparpcWire::set(reply.szPassword, szPassword);
+    vparpc_call_t call = {&reply, sizeof(reply)};
+    return rpc.client_batch(ssHost, ssService, &call, 1);
+}
+
+/**
+ * Calls VPARPC_FUNC_CREDS: using handle get credentials.
+ *
+ * @param reply Receives the answered request.
+ * @return false if the call went unanswered.
+ */
+inline bool vparpc_call_creds(
+    vparpc& rpc, const std::string& ssHost, const std::string& ssService,
+    std::string_view szAuth,
+    int iHandle,
+    std::string_view szAuthUUID,
+    vparpc_request_creds_t& reply)
+{
+    vparpc_idl<vparpc_request_creds_t>::init(reply);
+    vparpcWire::set(reply.szAuth, szAuth);
+    reply.iHandle = iHandle;
+    vparpcWire::set(reply.szAuthUUID, szAuthUUID);
+    vparpc_call_t call = {&reply, sizeof(reply)};
+    return rpc.client_batch(ssHost, ssService, &call, 1);
+}
+
+/**
+ * Calls VPARPC_FUNC_URLS: Get VPA URLS function.
+ *
+ * @param reply Receives the answered request.
+ * @return false if the call went unanswered.
+ */
+inline bool vparpc_call_urls(
+    vparpc& rpc, const std::string& ssHost, const std::string& ssService,
+    std::string_view szAuth,
+    vparpc_request_urls_t& reply)
+{
+    vparpc_idl<vparpc_request_urls_t>::init(reply);
+    vparpcWire::set(reply.szAuth, szAuth);
+    vparpc_call_t call = {&reply, sizeof(reply)};
+    return rpc.client_batch(ssHost, ssService, &call, 1);
+}
+
+////////////////////////
+// eof - vparpcIdl.hh //
+////////////////////////
@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/include/vparpcIdlTypes.hh                     //
+// Generated by rpcCompiler from schemas/v1/vparpc-idl.csv.       //
+// Do not edit; change the IDL and run "vpautil -i".              //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/**
+ * @enum vparpc_func_t
+ * @brief VPA RPC functions and their request packets.
+ */
+enum vparpc_func_t
+{
+    VPARPC_FUNC_NONE = 0, // No operation/null function
+    VPARPC_FUNC_GET_AUTH, // Authentication retrieval function
+    VPARPC_FUNC_HOST2IPV4ADDR, // Hostname to IPv4 address resolution function
+    VPARPC_FUNC_VERSION, // Version information retrieval function
+    VPARPC_FUNC_LOOKUP, // using username/password get handle
+    VPARPC_FUNC_CREDS, // using handle get credentials
+    VPARPC_FUNC_URLS, // Get VPA URLS function
+    VPARPC_FUNC_COUNT // Total count of available functions
+};
+
+/**
+ * Every request struct is this long, so that a v1 peer can read
+ * any request into a vparpc_request_t.
+ */
+#define VPARPC_IDL_FRAME_SIZE 1080
+
+/**
+ * @struct vparpc_request_generic_t
+ * @brief VPARPC_FUNC_NONE: No operation/null function.
+ */
+struct vparpc_request_generic_t
+{
+    vparpc_version_t eVersion;
+    uint32_t uRequestId;
+    size_t nSize;
+    vparpc_func_t eFunc;
+    char8_t szUUID[UUID_SIZE];
+    char szPadding[1016];
+};
+
+static_assert(sizeof(vparpc_request_generic_t) == VPARPC_IDL_FRAME_SIZE,
+              "vparpc_request_generic_t must keep the v1 frame size");
+static_assert(offsetof(vparpc_request_generic_t, nSize) == 8,
+              "vparpc_request_generic_t must keep the v1 frame header");
+
+/**
+ * @struct vparpc_request_auth_t
+ * @brief VPARPC_FUNC_GET_AUTH: Authentication retrieval function.
+ */
+struct vparpc_request_auth_t
+{
+    vparpc_version_t eVersion;
+    uint32_t uRequestId;
+    size_t nSize;
+    vparpc_func_t eFunc;
+    char8_t szPSK[UUID_SIZE]; // The pre-shared key
+    vparpc_status_t eStatus;
+    char szAuth[UUID_SIZE]; // The token later calls present
+    char szPadding[976];
+};
+
+static_assert(sizeof(vparpc_request_auth_t) == VPARPC_IDL_FRAME_SIZE,
+              "vparpc_request_auth_t must keep the v1 frame size");
+static_assert(offsetof(vparpc_request_auth_t, nSize) == 8,
+              "vparpc_request_auth_t must keep the v1 frame header");
+
+/**
+ * @struct vparpc_request_version_t
+ * @brief VPARPC_FUNC_VERSION: Version information retrieval function.
+ */
+struct vparpc_request_version_t
+{
+    vparpc_version_t eVersion;
+    uint32_t uRequestId;
+    size_t nSize;
+    vparpc_func_t eFunc;
+    char8_t szAuth[UUID_SIZE];
+    vparpc_status_t eStatus;
+    char szVersion[VERSION_SIZE_MAX];
+    char szPadding[1000];
+};
+
+static_assert(sizeof(vparpc_request_version_t) == VPARPC_IDL_FRAME_SIZE,
+              "vparpc_request_version_t must keep the v1 frame size");
+static_assert(offsetof(vparpc_request_version_t, nSize) == 8,
+              "vparpc_request_version_t must keep the v1 frame header");
+
+/**
+ * @struct vparpc_request_lookup_t
+ * @brief VPARPC_FUNC_LOOKUP: using username/password get handle.
+ */
+struct vparpc_request_lookup_t
+{
+    vparpc_version_t eVersion;
+    uint32_t uRequestId;
+    size_t nSize;
+    vparpc_func_t eFunc;
+    char8_t szAuth[UUID_SIZE];
+    char szUsername[UT_NAMESIZE];
+    char szPassword[UT_NAMESIZE];
+    vparpc_status_t eStatus;
+    int iHandle; // The passwd.csv row or -1
+    char szPadding[944];
+};
+
+static_assert(sizeof(vparpc_request_lookup_t) == VPARPC_IDL_FRAME_SIZE,
+              "vparpc_request_lookup_t must keep the v1 frame size");
+static_assert(offsetof(vparpc_request_lookup_t, nSize) == 8,
+              "vparpc_request_lookup_t must keep the v1 frame header");
+
+/**
+ * @struct vparpc_request_creds_t
+ * @brief VPARPC_FUNC_CREDS: using handle get credentials.
+ */
+struct vparpc_request_creds_t
+{
+    vparpc_version_t eVersion;
+    uint32_t uRequestId;
+    size_t nSize;
+    vparpc_func_t eFunc;
+    char8_t szAuth[UUID_SIZE];
+    int iHandle; // The passwd.csv row for older clients
+    vparpc_status_t eStatus;
+    char szAuthUserName[UT_NAMESIZE];
+    char szAuthFirstName[UT_NAMESIZE];
+    char szAuthLastName[UT_NAMESIZE];
+    char szAuthUUID[UUID_SIZE]; // The session to resolve
+    char szAuthLevel[UT_NAMESIZE];
+    char szRemoteHost[DNS_FQDN_SIZE_MAX];
+    char szRemoteAddr[DNS_FQDN_SIZE_MAX];
+    char szHttpUserAgent[128];
+    char szPadding[208];
+};
+
+static_assert(sizeof(vparpc_request_creds_t) == VPARPC_IDL_FRAME_SIZE,
+              "vparpc_request_creds_t must keep the v1 frame size");
+static_assert(offsetof(vparpc_request_creds_t, nSize) == 8,
+              "vparpc_request_creds_t must keep the v1 frame header");
+
+/**
+ * @struct vparpc_request_urls_t
+ * @brief VPARPC_FUNC_URLS: Get VPA URLS function.
+ */
+struct vparpc_request_urls_t
+{
+    vparpc_version_t eVersion;
+    uint32_t uRequestId;
+    size_t nSize;
+    vparpc_func_t eFunc;
+    char8_t szAuth[UUID_SIZE];
+    vparpc_status_t eStatus;
+    char szIP[DNS_FQDN_SIZE_MAX];
+    char szCgiRoot[DNS_FQDN_SIZE_MAX];
+    char szStylesRoot[DNS_FQDN_SIZE_MAX];
+    char szpadding[DNS_FQDN_SIZE_MAX];
+};
+
+static_assert(sizeof(vparpc_request_urls_t) == VPARPC_IDL_FRAME_SIZE,
+              "vparpc_request_urls_t must keep the v1 frame size");
+static_assert(offsetof(vparpc_request_urls_t, nSize) == 8,
+              "vparpc_request_urls_t must keep the v1 frame header");
+
+union vparpc_request_t
+{
+    struct vparpc_request_generic_t req_generic;
+    struct vparpc_request_auth_t req_auth;
+    struct vparpc_request_version_t req_version;
+    struct vparpc_request_lookup_t req_lookup;
+    struct vparpc_request_creds_t req_creds;
+    struct vparpc_request_urls_t req_urls;
+};
+
+inline constexpr const char* vparpc_func_names[VPARPC_FUNC_COUNT] = {
+    "  Function None",
+    "  Function Get_Auth",
+    "  Function Host2ipv4addr",
+    "  Function Version",
+    "  Function Lookup",
+    "  Function Creds",
+    "  Function Urls",
+};
+
+/////////////////////////////
+// eof - vparpcIdlTypes.hh //
+/////////////////////////////
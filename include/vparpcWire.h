@@ -0,0 +1,269 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/vparpcWire.h 2026-10-17 19:50 dwg -           //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "mwfw2.h"
+
+/**
+ * The newest wire encoding this build speaks. A server marks its v1
+ * replies with it, which is how a client learns it may send v2.
+ */
+#define VPARPC_VERSION_LATEST VPARPC_VERSION_2
+
+/**
+ * A v2 frame is the v1 frame header (eVersion, uRequestId, nSize) and
+ * three bytes more: the function, the status and the flags. Fields
+ * follow, each a varint tag, a varint length and that many bytes.
+ * Strings are sent without their terminator and empty ones are left
+ * out; integers are zigzag varints.
+ */
+#define VPARPC_WIRE_FUNC_OFFSET   VPARPC_FRAME_HEADER_SIZE
+#define VPARPC_WIRE_STATUS_OFFSET (VPARPC_FRAME_HEADER_SIZE + 1)
+#define VPARPC_WIRE_FLAGS_OFFSET  (VPARPC_FRAME_HEADER_SIZE + 2)
+#define VPARPC_WIRE_HEADER_SIZE   (VPARPC_FRAME_HEADER_SIZE + 3)
+
+/**
+ * Set in the flags of a reply. A v1 server echoes a v2 request it does
+ * not understand, and this is how the client tells the echo from an
+ * answer.
+ */
+#define VPARPC_WIRE_FLAG_REPLY 0x01
+
+/**
+ * The generated traits of each request struct: init(), and the v2
+ * encode() and decode() of its fields (see vparpcIdl.hh).
+ */
+template <typename T>
+struct vparpc_idl;
+
+/**
+ * @class vparpcWire
+ * @brief The compact (v2) encoding of VPA RPC requests and replies.
+ *
+ * A v1 request is its whole vparpc_request_*_t, padding and all, so a
+ * VERSION call moves over 2 KB for some 50 bytes of payload. A v2 frame
+ * carries only the fields one direction needs: a VERSION request is the
+ * auth token and its reply the version string.
+ *
+ * The servers and CVpaRpc keep working on the v1 structs. The client
+ * encodes a request into v2 just before sending it and decodes the reply
+ * back into the caller's packet; the server decodes a v2 request into a
+ * struct, processes it as before and encodes the reply. A client sends
+ * v2 only to a peer that has answered a v1 request with eVersion set to
+ * VPARPC_VERSION_2 or later, so v1 servers and v1 clients are unaffected.
+ */
+class vparpcWire
+{
+public:
+    /**
+     * @class reader
+     * @brief Walks the fields of a v2 frame without copying them; each
+     *        value is a view into the frame.
+     */
+    class reader
+    {
+    public:
+        reader(const char* pFrame, size_t stLen);
+
+        /**
+         * @return false if the header is malformed, or next() has met a
+         *         field that runs past the end of the frame.
+         */
+        bool valid() const
+        {
+            return m_bValid;
+        }
+
+        uint8_t func() const;
+        uint8_t status() const;
+        bool reply() const;
+
+        /**
+         * Moves to the next field.
+         *
+         * @return false at the end of the frame or on a malformed field.
+         */
+        bool next(uint32_t& uTag, std::string_view& value);
+
+    private:
+        const char* m_pFrame;
+        size_t m_stLen;
+        size_t m_stAt;
+        bool m_bValid;
+    };
+
+    /**
+     * @class writer
+     * @brief Appends the fields of a v2 frame after its header. A field
+     *        that does not fit makes ok() false; the frame is then
+     *        unusable.
+     */
+    class writer
+    {
+    public:
+        writer(char* pFrame, size_t stMax);
+
+        /**
+         * Writes a string field, without its terminator; an empty one is
+         * left out.
+         */
+        template <typename C, size_t N>
+        void put(uint32_t uTag, const C (&szValue)[N])
+        {
+            static_assert(1 == sizeof(C), "string fields are byte arrays");
+            put_bytes(uTag, (const char*)szValue,
+                      strnlen((const char*)szValue, N));
+        }
+
+        /**
+         * Writes an integer field as a zigzag varint.
+         */
+        void put(uint32_t uTag, int iValue);
+
+        void status(vparpc_status_t eStatus);
+
+        bool ok() const
+        {
+            return m_bOk;
+        }
+
+        size_t length() const
+        {
+            return m_stAt;
+        }
+
+    private:
+        char* m_pFrame;
+        size_t m_stMax;
+        size_t m_stAt;
+        bool m_bOk;
+
+        void put_bytes(uint32_t uTag, const char* pValue, size_t stLen);
+    };
+
+    /**
+     * Copies a string field into its array, truncated and terminated.
+     */
+    template <typename C, size_t N>
+    static void get(C (&szValue)[N], std::string_view value)
+    {
+        static_assert(1 == sizeof(C), "string fields are byte arrays");
+        size_t stCopy = std::min(value.size(), N - 1);
+        memcpy(szValue, value.data(), stCopy);
+        szValue[stCopy] = 0;
+    }
+
+    /**
+     * @return false if the value is not a varint.
+     */
+    static bool get(int& iValue, std::string_view value);
+
+    /**
+     * Fills a string field of a request, truncated and terminated.
+     */
+    template <typename C, size_t N>
+    static void set(C (&szValue)[N], std::string_view value)
+    {
+        get(szValue, value);
+    }
+
+    template <typename C, size_t N>
+    static void clear(C (&szValue)[N])
+    {
+        memset(szValue, 0, N);
+    }
+
+    static void clear(int& iValue)
+    {
+        iValue = 0;
+    }
+
+    /**
+     * Encodes the request fields, or with bReply the reply fields and the
+     * status, of a vparpc_request_*_t as a v2 frame.
+     *
+     * @return The frame length, or 0 if the function is unknown or the
+     *         frame would not fit in stMax bytes.
+     */
+    static size_t encode(const void* pPacket, bool bReply, char* pFrame,
+                         size_t stMax);
+
+    /**
+     * Decodes a v2 frame into a vparpc_request_*_t. A request is decoded
+     * into a cleared struct. A reply is decoded over the request it
+     * answers: its reply fields and status are replaced and the request
+     * fields kept, just as a v1 reply leaves them.
+     *
+     * @return false if the frame is malformed, of an unknown function,
+     *         not of the expected direction, or its struct would not fit
+     *         in stMax bytes.
+     */
+    static bool decode(const char* pFrame, size_t stLen, void* pPacket,
+                       size_t stMax, bool bReply);
+
+    /**
+     * Serves one request frame of either version, in place. A v1 request
+     * is processed as it stands and its reply marked with
+     * VPARPC_VERSION_LATEST; a v2 request is decoded, processed and its
+     * reply encoded over it. A malformed v2 request is answered with
+     * VPARPC_STATUS_ERROR.
+     *
+     * @param stMax The size of the buffer; at least
+     *        sizeof(vparpc_request_t).
+     * @return The length of the reply.
+     */
+    static size_t respond(char* pBuffer, size_t stLen, size_t stMax,
+                          const std::function<void(char*)>& process);
+
+    /**
+     * @return The newest encoding the peer is known to accept;
+     *         VPARPC_VERSION_1 until it has said otherwise.
+     */
+    static vparpc_version_t peer_version(const std::string& ssHost,
+                                         const std::string& ssService);
+
+    /**
+     * Records what a peer's reply said it accepts.
+     */
+    static void set_peer_version(const std::string& ssHost,
+                                 const std::string& ssService,
+                                 vparpc_version_t eVersion);
+};
+
+/**
+ * @struct vparpc_idl_codec_t
+ * @brief One entry of the generated vparpc_idl_codecs jump table.
+ */
+struct vparpc_idl_codec_t
+{
+    size_t stSize;
+    void (*pfnEncode)(const void* pPacket, bool bReply,
+                      vparpcWire::writer& out);
+    bool (*pfnDecode)(void* pPacket, bool bReply, vparpcWire::reader& in);
+};
+
+template <typename T>
+void vparpc_idl_encode(const void* pPacket, bool bReply,
+                       vparpcWire::writer& out)
+{
+    vparpc_idl<T>::encode(*(const T*)pPacket, bReply, out);
+}
+
+template <typename T>
+bool vparpc_idl_decode(void* pPacket, bool bReply, vparpcWire::reader& in)
+{
+    return vparpc_idl<T>::decode(*(T*)pPacket, bReply, in);
+}
+
+#define VPARPC_IDL_CODEC(T) \
+    {sizeof(T), &vparpc_idl_encode<T>, &vparpc_idl_decode<T>}
+
+////////////////////////
+// eof - vparpcWire.h //
+////////////////////////
@@ -37,15 +37,13 @@
 /**
  * @brief Manages the shared memory operations and prints the status of test statistics.
  *
- * This method uses a shared memory manager to update the signature of the shared memory.
- * It increments the `iSignature` field of the shared memory object twice, each time using
- * a different shared memory management instance. After locking, updating, and releasing
- * shared memory, it prints the counts of tests processed, skipped, passed, and failed.
+ * This method holds the test results region of the shared memory while it prints the
+ * counts of tests processed, skipped, passed, and failed.
  * Additionally, it resets the `num_tests_processed` field to zero and prints binary projections
  * of test metrics using the available printBinary utility.
  *
  * @details
- * - Updates the signature of the shared memory using two different shared memory managers.
+ * - Holds the test results region lock (shmTestsGuard) for the duration.
  * - Outputs the count of tests:
  *   - processed
  *   - skipped
@@ -59,14 +57,7 @@
  */
 void shmvars()
 {
-    shared::SharedMemoryManager manager;
-    manager.lockSharedMemory();
-    gpSh->m_pShMemng->iSignature++;
-    manager.releaseSharedMemory();
-
-    gpShMemMgr->lockSharedMemory();
-    gpSh->m_pShMemng->iSignature++;
-    gpShMemMgr->releaseSharedMemory();
+    shmTestsGuard guard;
 
     printf("num_tests_processed is %d\n",
            gpSh->m_pShMemng->num_tests_processed);
@@ -149,7 +140,7 @@ void auth_users()
  */
 void configini()
 {
-    cfgini config(gpSh->m_pShMemng->szConfigFQFS);
+    cfgini config(gpShMemCfg->get(SHM_STR_CONFIG_FQFS).c_str());
 
     // Create a new config or load existing
     if (!config.load())
@@ -767,7 +758,7 @@ bool installer::is_devo_root()
 
     std::string ssDevoRoot = gpOS->file2path(__FILE__);
     std::string ssDevoRoot2 = "/home/";
-    ssDevoRoot2.append(gpSh->m_pShMemng->szUser);
+    ssDevoRoot2.append(gpShMemCfg->get(SHM_STR_USER));
     ssDevoRoot2.append("/public_html/fw/");
     if (ssDevoRoot == ssDevoRoot2) {
         m_pWin->add_row("is_devo_root() returning true");
@@ -38,6 +38,8 @@ int main()
        /**
         * Invalidate authentication information in shared
         */
+       gpShMemMgr->lockRegion(SHM_REGION_CREDS);
+       gpShMemSess->remove(gpSh->m_pShMemng->creds[iHandle].szAuthUUID);
        memset(gpSh->m_pShMemng->creds[iHandle].szAuthUserName, 0,
               sizeof(gpSh->m_pShMemng->creds[iHandle].szAuthUserName));
        memset(gpSh->m_pShMemng->creds[iHandle].szAuthFirstName, 0,
@@ -47,9 +49,11 @@ int main()
        memset(gpSh->m_pShMemng->creds[iHandle].szAuthUUID, 0,
               sizeof(gpSh->m_pShMemng->creds[iHandle].szAuthUUID));
        gpSh->m_pShMemng->creds[iHandle].iAuthHandle = 0;
+       gpShMemMgr->unlockRegion(SHM_REGION_CREDS);
+       shm_notify::publish(SHM_CHANNEL_CREDS);
 
        std::string ssIniCommand = "sudo rm ";
-       ssIniCommand.append(gpSh->m_pShMemng->szConfigFQDS);
+       ssIniCommand.append(gpShMemCfg->get(SHM_STR_CONFIG_FQDS));
        ssIniCommand.append("/config.ini");
        system(ssIniCommand.c_str());
 
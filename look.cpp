@@ -55,15 +55,13 @@ void sine()
 /**
  * @brief Manages the shared memory operations and prints the status of test statistics.
  *
- * This method uses a shared memory manager to update the signature of the shared memory.
- * It increments the `iSignature` field of the shared memory object twice, each time using
- * a different shared memory management instance. After locking, updating, and releasing
- * shared memory, it prints the counts of tests processed, skipped, passed, and failed.
+ * This method holds the test results region of the shared memory while it prints the
+ * counts of tests processed, skipped, passed, and failed.
  * Additionally, it resets the `num_tests_processed` field to zero and prints binary projections
  * of test metrics using the available printBinary utility.
  *
  * @details
- * - Updates the signature of the shared memory using two different shared memory managers.
+ * - Holds the test results region lock (shmTestsGuard) for the duration.
  * - Outputs the count of tests:
  *   - processed
  *   - skipped
@@ -78,14 +76,7 @@ void sine()
  */
 void shmvars()
 {
-    shared::SharedMemoryManager manager;
-    manager.lockSharedMemory();
-    gpSh->m_pShMemng->iSignature++;
-    manager.releaseSharedMemory();
-
-    gpShMemMgr->lockSharedMemory();
-    gpSh->m_pShMemng->iSignature++;
-    gpShMemMgr->releaseSharedMemory();
+    shmTestsGuard guard;
 
     printf("num_tests_processed is %d\n",
            gpSh->m_pShMemng->num_tests_processed);
@@ -115,7 +106,8 @@ void shmvars()
  * only processes user entries starting at a predetermined offset (`ROW_DATA`).
  * If a user has a valid authentication handle (`iAuthHandle > 0`), their details
  * are printed in a formatted manner, including username, first name, last name,
- * UUID, authentication handle, and HTTP user agent string.
+ * UUID, authentication handle, and HTTP user agent string. The live entries of
+ * the UUID-keyed session table follow.
  *
  * The function depends on predefined constants such as `ROW_DATA`, `CFG_MAX_USERS`,
  * and assumes a shared memory structure pointed to by `gpSh`.
@@ -142,6 +134,23 @@ void auth_users()
                    gpSh->m_pShMemng->creds[iRow].szHttpUserAgent);
         }
     }
+
+    printf("\n\nActive Sessions (%d of %d slots in use):",
+           gpShMemSess->count(), SharedMemorySessions::capacity());
+    MFW_SESSION_T sess;
+    for (int iSlot = 0; iSlot < SharedMemorySessions::capacity(); iSlot++)
+    {
+        if (gpShMemSess->get(iSlot, sess))
+        {
+            printf("\n-------------------------------------------\n");
+            printf("iSlot           is %d\n", iSlot);
+            printf("szAuthUserName  is %s\n", sess.szAuthUserName);
+            printf("szAuthUUID      is %s\n", sess.szAuthUUID);
+            printf("iAuthHandle     is %d\n", sess.iAuthHandle);
+            printf("szRemoteAddr    is %s\n", sess.szRemoteAddr);
+            printf("iHttpUserAgent  is %s\n", sess.szHttpUserAgent);
+        }
+    }
 }
 
 /**
@@ -168,7 +177,7 @@ void auth_users()
  */
 void configini()
 {
-    cfgini config(gpSh->m_pShMemng->szConfigFQFS);
+    cfgini config(gpShMemCfg->get(SHM_STR_CONFIG_FQFS).c_str());
 
     // Create a new config or load existing
     if (!config.load())
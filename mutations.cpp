@@ -22,56 +22,36 @@ mutations::mutations() = default;
 /**
  * @brief Constructs a muteInt object.
  *
- * This constructor initializes the muteInt object with a specified mutex
- * name and an integer pointer. It creates or opens a named semaphore for
- * synchronization using the given mutex name.
+ * Binds the object to an integer in the shared segment. int is always
+ * lock-free, so get() and put() are single atomic loads and stores;
+ * there is no semaphore to open and nothing that can fail.
  *
- * @param pszName A C-style string representing the name of the semaphore to
- * create or open.
- * @param pInt A pointer to an integer that will be protected using the
- * semaphore.
- *
- * @throws std::system_error If the semaphore creation/opening fails, a
- * system_error is thrown with the appropriate error code and message.
+ * @param pszName Formerly the name of the guarding semaphore; unused,
+ * kept so that existing callers still compile.
+ * @param pInt A pointer to the integer in the shared segment.
  */
-muteInt::muteInt(const char * pszName,int * pInt) {
-    strcpy(m_szMutexName,pszName);
-    m_pInt = pInt;
-    m_mutex_ = sem_open(pszName,O_CREAT, 0644, 1);
-    if (m_mutex_ == SEM_FAILED) {
-        throw std::system_error(errno, std::system_category(),
-            "sem_open failed");
-    }
+muteInt::muteInt(const char * pszName,int * pInt) : m_value(pInt) {
+    (void)pszName;
 }
 
 /**
- * Retrieves the value of the integer with thread-safe access.
- *
- * This method provides synchronized access to the integer
- * value it manages by acquiring a mutex before reading the value
- * and releasing the mutex afterward.
+ * Retrieves the value of the integer with one atomic load.
  *
  * @return The integer value managed by the muteInt instance.
  */
 int muteInt::get() {
-    sem_wait(m_mutex_);
-    int iValue = *m_pInt;
-    sem_post(m_mutex_);
-    return iValue;
+    return m_value.load();
 }
 
 /**
- * Updates the value of the shared integer variable in a thread-safe manner.
- *
- * Uses a semaphore to ensure exclusive access to the shared integer
- * during the update operation. After the operation, the semaphore is
- * released to signal completion.
+ * Updates the value of the shared integer with one atomic store.
  *
  * @param value The new value to assign to the shared integer.
  */
 void muteInt::put(int value) {
-    sem_wait(m_mutex_);
-    *m_pInt = value;
-    sem_post(m_mutex_);
+    m_value.store(value);
 }
 
+/////////////////////////
+// eof - mutations.cpp //
+/////////////////////////
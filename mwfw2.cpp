@@ -336,9 +336,10 @@ shared* gpSh;
  *
  * The `gpShMemMutex` variable is a global pointer that refers to an
  * instance of the `SharedMemoryMutex` class. It facilitates interprocess
- * synchronization by utilizing a POSIX named semaphore. This mutex is
- * typically employed to ensure safe access to shared resources in a
- * concurrent or multi-process environment.
+ * synchronization by utilizing a robust process-shared pthread mutex
+ * that lives in the locks[] table of the shared segment, so it must be
+ * constructed after gpSh. This mutex is typically employed to ensure
+ * safe access to shared resources in a multi-process environment.
  *
  * Key responsibilities of `gpShMemMutex` include:
  * - Enabling safe and synchronized access to critical sections or shared
@@ -376,6 +377,50 @@ SharedMemoryMutex* gpShMemMutex;
 SharedMemoryManager* gpShMemMgr;
 
 
+/**************************************************************************
+ * Global pointer to the shared-memory session table.
+ *
+ * The `gpShMemSess` object resolves logins by their szAuthUUID through a
+ * lock-free hash index in the shared segment. It replaces scanning or
+ * row-indexing the fixed creds[] array whenever a caller has the session
+ * UUID at hand.
+ **************************************************************************/
+SharedMemorySessions* gpShMemSess;
+
+
+/**************************************************************************
+ * Global pointer to the seqlock-protected configuration block.
+ *
+ * The `gpShMemCfg` object gives lock-free, tear-free read access to the
+ * mostly-read configuration strings (URL roots, host identity, log and
+ * image directories). environment publishes into it; htmlbind, osIface
+ * and CLog read from it.
+ **************************************************************************/
+SharedMemoryConfig* gpShMemCfg;
+
+
+/**************************************************************************
+ * Global pointer to the shared variable registry.
+ *
+ * The `gpShMemVars` object lets any module publish named int64, double
+ * or string variables at run time. Handles returned by reg() are stable,
+ * so hot paths resolve a name once and then use lock-free atomic reads
+ * and writes.
+ **************************************************************************/
+shmvars* gpShMemVars;
+
+
+/**************************************************************************
+ * Global pointer to the shared heap.
+ *
+ * The `gpShMemHeap` object maps the POSIX shared memory region that holds
+ * variable-length records, for which the fixed layout of the main segment
+ * has no room. Modules keep their data there in shm_hash_map or
+ * shm_string_map instances attached by name.
+ **************************************************************************/
+shm_heap* gpShMemHeap;
+
+
 /**************************************************************************
  * Global pointer for system logging functionality.
  *
@@ -420,6 +465,17 @@ CSysLog* gpSysLog;
 vparpc* gpVpaRpc;
 
 
+/**************************************************************************
+ * Global pointer to the RPC connection pool.
+ *
+ * `gpRpcPool` holds the idle connections vparpc::client() and its batch
+ * and pipeline variants return after each exchange, keyed by host and
+ * service, so that the next call to the same server reuses one instead
+ * of resolving the name and connecting again.
+ **************************************************************************/
+rpcPool* gpRpcPool;
+
+
 /**************************************************************************
  * Global pointer for managing xinetd configuration and operations.
  *
@@ -477,6 +533,16 @@ mwfw2::mwfw2(const char* pszFile, const char* pszFunction)
 	 * in the current context may access the shared region.
 	 */
 	gpSh = new shared();
+	gpShMemSess = new SharedMemorySessions();
+
+	/* 2026-10-17 dwg -
+	 * CLog takes its log directory from the config block, and several
+	 * of the classes below log from their constructors, so the config
+	 * block and the locks that guard it come up first.
+	 */
+	gpShMemMutex = new SharedMemoryMutex(CFG_MUTEX_NAME);
+	gpShMemMgr = new SharedMemoryManager(CFG_MUTEX_NAME);
+	gpShMemCfg = new SharedMemoryConfig();
 
 	/* 2025/07/17 02:12 dwg -
 	 * The second responsibility of the framework constructor is to
@@ -503,12 +569,15 @@ mwfw2::mwfw2(const char* pszFile, const char* pszFunction)
 	 */
 
 	gpCrt = new crtbind();
+	gpRpcPool = new rpcPool();
 	gpVpaRpc = new vparpc();
 	gpSemiGr = new semigraphics();
 	gpSysLog = new CSysLog();
 	gbHere = false;
-	gpShMemMutex = new SharedMemoryMutex(CFG_MUTEX_NAME);
-	gpShMemMgr = new SharedMemoryManager(CFG_MUTEX_NAME);
+	gpShMemVars = new shmvars();
+	gpShMemHeap = new shm_heap();
+	gpShMemVars->add(gpShMemVars->reg("fw.processes", SVAR_TYPE_INT64), 1);
+	gpShMemSess->sweep();	// reclaim lapsed sessions, once per second
 	gpEnv = new environment();
 	gpLog = new CLog(__FILE__, __FUNCTION__);
 	gpOS = new osIface();
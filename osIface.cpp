@@ -193,7 +193,7 @@ std::string osIface::file2filenamesansext(const char* pszFile)
 std::string osIface::genImgPath(const char* pszImgName, bool bDebug)
 {
     std::string ssPath = __FILE__;
-    ssPath = gpSh->m_pShMemng->szImgFQDS;
+    ssPath = gpShMemCfg->get(SHM_STR_IMG_FQDS);
     ssPath.append(pszImgName);
     return ssPath;
 }
@@ -225,7 +225,7 @@ std::string osIface::genImgPath(const char* pszImgName, bool bDebug)
 
 std::string osIface::genImgUrl(const char* pszImgName)
 {
-    std::string ssUrl = gpSh->m_pShMemng->szImgRoot;
+    std::string ssUrl = gpShMemCfg->get(SHM_STR_IMG_ROOT);
     ssUrl.append(pszImgName);
     return ssUrl;
 }
@@ -267,7 +267,7 @@ std::string osIface::genImgUrl(const char* pszImgName)
 const char* osIface::genScriptFQFS(const char* pszFile, bool bDebug)
 {
     std::string ssFile = pszFile;
-    std::string ssPath = gpSh->m_pShMemng->szScriptsFQDS;
+    std::string ssPath = gpShMemCfg->get(SHM_STR_SCRIPTS_FQDS);
     ssPath.append(pszFile);
     strcpy(gszPath, ssPath.c_str());
     return gszPath;
@@ -300,7 +300,7 @@ std::string osIface::genCurlCgiBinUrl(const char* pszCgiName,
     std::string ssCommand;
 
     ssCommand.append("curl "); // curl
-    ssCommand.append(gpSh->m_pShMemng->szCgiRoot);
+    ssCommand.append(gpShMemCfg->get(SHM_STR_CGI_ROOT));
     ssCommand.append(pszCgiName); // fw-test3.py
     ssCommand.append(" > /tmp/"); // > /tmp/
     ssCommand.append(pszCgiName); // fw-test3.py
@@ -340,7 +340,7 @@ std::string osIface::genCgiBinUrl(const char* pszCgiName,
     std::string ssURL;
 
     // fetch the appropriate protocol based on host (kludge)
-    ssURL.append(gpSh->m_pShMemng->szCgiRoot);
+    ssURL.append(gpShMemCfg->get(SHM_STR_CGI_ROOT));
     ssURL.append(pszCgiName); // fw-test3.py
 
     return ssURL;
@@ -373,17 +373,18 @@ std::string osIface::genHtmlUrl(const char* pszPageName,
 
 
     std::string ssCommand;
+    const MFW_STRPOOL_T& pool = gpShMemCfg->current();
 
     ssCommand.append("curl "); // curl
 
     // fetch the appropriate protocol based on host (kludge)
-    ssCommand.append(gpSh->m_pShMemng->szProtocol); // http://
+    ssCommand.append(SharedMemoryConfig::str(pool, SHM_STR_PROTOCOL)); // http://
     if (bDebug)
     {
         std::cout << ssCommand << std::endl;
     }
 
-    ssCommand.append(gpSh->m_pShMemng->szIP); // daphne.goodall.com
+    ssCommand.append(SharedMemoryConfig::str(pool, SHM_STR_IP)); // daphne.goodall.com
     if (bDebug)
     {
         std::cout << ssCommand << std::endl;
@@ -396,7 +397,7 @@ std::string osIface::genHtmlUrl(const char* pszPageName,
     }
 
     //ssCommand.append(getenv("LOGNAME"));            // doug
-    ssCommand.append(gpSh->m_pShMemng->szUser);
+    ssCommand.append(SharedMemoryConfig::str(pool, SHM_STR_USER));
     if (bDebug)
     {
         std::cout << ssCommand << std::endl;
@@ -537,10 +538,11 @@ std::string osIface::genCgiCBDUrl(const char* pszCgiName, bool bDebug)
         std::cout << __FUNCTION__ << " called" << std::endl;
     }
 
-    std::string ssUrl = gpSh->m_pShMemng->szProtocol;
-    ssUrl.append(gpSh->m_pShMemng->szIP);
+    const MFW_STRPOOL_T& pool = gpShMemCfg->current();
+    std::string ssUrl = SharedMemoryConfig::str(pool, SHM_STR_PROTOCOL);
+    ssUrl.append(SharedMemoryConfig::str(pool, SHM_STR_IP));
     ssUrl.append("/~");
-    ssUrl.append(gpSh->m_pShMemng->szUser);
+    ssUrl.append(SharedMemoryConfig::str(pool, SHM_STR_USER));
     ssUrl.append("/fw/cmake-build-debug/");
     ssUrl.append(pszCgiName);
     return ssUrl;
@@ -780,10 +782,13 @@ std::string osIface::parseSchemaName(std::string ssSchemaName, bool bDebug)
 std::string osIface::get_handle_style(int iHandle)
 {
     std::string ssUsername;
+    MFW_SESSION_T sess;
 
-    if (iHandle > CFG_PRE_STARTING_HANDLE)
+    // resolve() bounds-checks the handle against the creds[] table
+    if (iHandle > CFG_PRE_STARTING_HANDLE &&
+        gpShMemSess->resolve(nullptr, iHandle, sess))
     {
-        ssUsername = gpSh->m_pShMemng->creds[iHandle].szAuthUserName;
+        ssUsername = sess.szAuthUserName;
     }
     else
     {
@@ -113,7 +113,7 @@ void set_configini_creds(int handle)
     char szConfigFQFS[FQFS_SIZE_MAX];
     time_t t = time(NULL);
 
-    strcpy(szConfigFQFS, gpSh->m_pShMemng->szConfigFQDS);
+    strcpy(szConfigFQFS, gpShMemCfg->get(SHM_STR_CONFIG_FQDS).c_str());
     strcat(szConfigFQFS, "/config.ini");
     cfgini config(szConfigFQFS);
     if (!config.load())
@@ -209,20 +209,52 @@ int password::lookup_username_password(std::string ssUsername,
                     std::string ssDescr =
                         gpCsv->m_parsed_data[iRow][COL_PASSWD_DESCR];
 
-                    strcpy(gpSh->m_pShMemng->creds[iRow].szHttpUserAgent,
-                           gpCgi->getEnvironment().getUserAgent().c_str());
-
-                    strcpy(gpSh->m_pShMemng->creds[iRow].szAuthUserName,
-                           ssUserName.c_str());
-                    strcpy(gpSh->m_pShMemng->creds[iRow].szAuthFirstName,
-                           ssFirstName.c_str());
-                    strcpy(gpSh->m_pShMemng->creds[iRow].szAuthLastName,
-                           ssLastName.c_str());
-                    strcpy(gpSh->m_pShMemng->creds[iRow].szAuthLevel,
-                           ssAuthLevel.c_str());
                     std::string ssUUID = get_uuid();
-                    strcpy(gpSh->m_pShMemng->creds[iRow].szAuthUUID, gszUUID);
-                    gpSh->m_pShMemng->creds[iRow].iAuthHandle = iRow;
+
+                    {
+                        shmCredsGuard credsGuard;
+                        strcpy(gpSh->m_pShMemng->creds[iRow].szHttpUserAgent,
+                            gpCgi->getEnvironment().getUserAgent().c_str());
+
+                        strcpy(gpSh->m_pShMemng->creds[iRow].szAuthUserName,
+                               ssUserName.c_str());
+                        strcpy(gpSh->m_pShMemng->creds[iRow].szAuthFirstName,
+                               ssFirstName.c_str());
+                        strcpy(gpSh->m_pShMemng->creds[iRow].szAuthLastName,
+                               ssLastName.c_str());
+                        strcpy(gpSh->m_pShMemng->creds[iRow].szAuthLevel,
+                               ssAuthLevel.c_str());
+                        strcpy(gpSh->m_pShMemng->creds[iRow].szAuthUUID,
+                               gszUUID);
+                        gpSh->m_pShMemng->creds[iRow].iAuthHandle = iRow;
+                    }
+                    shm_notify::publish(SHM_CHANNEL_CREDS);
+
+                    // Also publish the login in the session table so it
+                    // can be resolved by UUID, independent of the row.
+                    MFW_SESSION_T sess = {};
+                    sess.iAuthHandle = iRow;
+                    strncpy(sess.szAuthUserName, ssUserName.c_str(),
+                            sizeof(sess.szAuthUserName) - 1);
+                    strncpy(sess.szAuthFirstName, ssFirstName.c_str(),
+                            sizeof(sess.szAuthFirstName) - 1);
+                    strncpy(sess.szAuthLastName, ssLastName.c_str(),
+                            sizeof(sess.szAuthLastName) - 1);
+                    strncpy(sess.szAuthLevel, ssAuthLevel.c_str(),
+                            sizeof(sess.szAuthLevel) - 1);
+                    strncpy(sess.szAuthUUID, gszUUID,
+                            sizeof(sess.szAuthUUID) - 1);
+                    strncpy(sess.szRemoteHost,
+                            gpCgi->getEnvironment().getRemoteHost().c_str(),
+                            sizeof(sess.szRemoteHost) - 1);
+                    strncpy(sess.szRemoteAddr,
+                            gpCgi->getEnvironment().getRemoteAddr().c_str(),
+                            sizeof(sess.szRemoteAddr) - 1);
+                    strncpy(sess.szHttpUserAgent,
+                            gpCgi->getEnvironment().getUserAgent().c_str(),
+                            sizeof(sess.szHttpUserAgent) - 1);
+                    gpShMemSess->create(sess);
+
                     set_configini_creds(iRow);
                     return iRow;
                 } // if password
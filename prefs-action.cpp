@@ -31,31 +31,37 @@ int main()
     std::string ssUsername = gpCgiBind->get_form_variable("username");
     std::string ssPassword = gpCgiBind->get_form_variable("pwname");
 
-    std::string ssBodyFg = gpCgiBind->get_form_variable("bodyfgcolor");
-    std::string ssBodyBg = gpCgiBind->get_form_variable("bodybgcolor");
-    std::string ssTableFg = gpCgiBind->get_form_variable("tablefgcolor");
-    std::string ssTableBg = gpCgiBind->get_form_variable("tablebgcolor");
-    std::string ssTrFg = gpCgiBind->get_form_variable("trfgcolor");
-    std::string ssTrBg = gpCgiBind->get_form_variable("trbgcolor");
-    std::string ssThFg = gpCgiBind->get_form_variable("thfgcolor");
-    std::string ssThBg = gpCgiBind->get_form_variable("thbgcolor");
-    std::string ssTdFg = gpCgiBind->get_form_variable("tdfgcolor");
-    std::string ssTdBg = gpCgiBind->get_form_variable("tdbgcolor");
-    std::string ssDbFg = gpCgiBind->get_form_variable("dbfgcolor");
-    std::string ssDbBg = gpCgiBind->get_form_variable("dbbgcolor");
+    // Fill a private copy, then publish the whole set at once so that
+    // concurrent stylist runs never render half the old colours.
+    MFW_PREFS_T prefs;
+    SharedMemoryPrefs::set(prefs.szBodyFGcolor,
+                           gpCgiBind->get_form_variable("bodyfgcolor"));
+    SharedMemoryPrefs::set(prefs.szBodyBGcolor,
+                           gpCgiBind->get_form_variable("bodybgcolor"));
+    SharedMemoryPrefs::set(prefs.szTableFGcolor,
+                           gpCgiBind->get_form_variable("tablefgcolor"));
+    SharedMemoryPrefs::set(prefs.szTableBGcolor,
+                           gpCgiBind->get_form_variable("tablebgcolor"));
+    SharedMemoryPrefs::set(prefs.szTrFGcolor,
+                           gpCgiBind->get_form_variable("trfgcolor"));
+    SharedMemoryPrefs::set(prefs.szTrBGcolor,
+                           gpCgiBind->get_form_variable("trbgcolor"));
+    SharedMemoryPrefs::set(prefs.szThFGcolor,
+                           gpCgiBind->get_form_variable("thfgcolor"));
+    SharedMemoryPrefs::set(prefs.szThBGcolor,
+                           gpCgiBind->get_form_variable("thbgcolor"));
+    SharedMemoryPrefs::set(prefs.szTdFGcolor,
+                           gpCgiBind->get_form_variable("tdfgcolor"));
+    SharedMemoryPrefs::set(prefs.szTdBGcolor,
+                           gpCgiBind->get_form_variable("tdbgcolor"));
+    SharedMemoryPrefs::set(prefs.szDbFGcolor,
+                           gpCgiBind->get_form_variable("dbfgcolor"));
+    SharedMemoryPrefs::set(prefs.szDbBGcolor,
+                           gpCgiBind->get_form_variable("dbbgcolor"));
+    SharedMemoryPrefs::publish(h, prefs);
 
-    strcpy(gpSh->m_pShMemng->prefs[h].szBodyFGcolor, ssBodyFg.c_str());
-    strcpy(gpSh->m_pShMemng->prefs[h].szBodyBGcolor, ssBodyBg.c_str());
-    strcpy(gpSh->m_pShMemng->prefs[h].szTableFGcolor, ssTableFg.c_str());
-    strcpy(gpSh->m_pShMemng->prefs[h].szTableBGcolor, ssTableBg.c_str());
-    strcpy(gpSh->m_pShMemng->prefs[h].szTrFGcolor, ssTrFg.c_str());
-    strcpy(gpSh->m_pShMemng->prefs[h].szTrBGcolor, ssTrBg.c_str());
-    strcpy(gpSh->m_pShMemng->prefs[h].szThFGcolor, ssThFg.c_str());
-    strcpy(gpSh->m_pShMemng->prefs[h].szThBGcolor, ssThBg.c_str());
-    strcpy(gpSh->m_pShMemng->prefs[h].szTdFGcolor, ssTdFg.c_str());
-    strcpy(gpSh->m_pShMemng->prefs[h].szTdBGcolor, ssTdBg.c_str());
-    strcpy(gpSh->m_pShMemng->prefs[h].szDbFGcolor, ssDbFg.c_str());
-    strcpy(gpSh->m_pShMemng->prefs[h].szDbBGcolor, ssDbBg.c_str());
+    // Keep the new colors across a reboot
+    gpSh->checkpoint(true);
 
     stylist* pStylist = new stylist(h);
 
@@ -77,7 +77,7 @@ std::string vpa_call(diagnose_request_t& req)
     char szPort[16];
     sprintf(szPort, "%d",VPA_PORT);
     std::string ssUrl;
-    ssUrl.append(gpSh->m_pShMemng->szProtocol);
+    ssUrl.append(gpShMemCfg->get(SHM_STR_PROTOCOL));
     //ssUrl.append(OCULAR_ADDR);
     ssUrl.append(gpSh->m_pShMemng->szRemoteAddr);
     ssUrl.append(":");
@@ -0,0 +1,490 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/rpcClient.cpp 2026-10-17 18:40 dwg -          //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#include "mwfw2.h"
+
+#define RPC_CLIENT_EVENTS_MAX 64
+
+enum rpc_call_state_t
+{
+    RPC_CALL_CONNECTING = 0,    // waiting for the non-blocking connect
+    RPC_CALL_WRITING,           // sending the request
+    RPC_CALL_READING            // receiving the reply
+};
+
+/**
+ * One call in flight. Created by the caller's thread, owned by the loop
+ * thread from the moment it is queued until finish() deletes it.
+ */
+struct rpc_async_call_t
+{
+    rpcClient::call_id_t id;
+    int fd;
+    int iError;                 // set before queueing if the call cannot start
+    rpc_call_state_t eState;
+    struct sockaddr_storage addr;
+    socklen_t addrLen;
+    std::vector<char> buffer;   // the request, then the reply
+    size_t stFrame;             // request length
+    size_t stDone;              // bytes sent or received so far
+    std::chrono::steady_clock::time_point deadline;
+    rpcClient::done_t done;
+};
+
+// Epoll data for the wake-up descriptor.
+static char gcClientWakeTag;
+
+rpcClient::rpcClient()
+    : m_nextId(1),
+      m_bStop(false)
+{
+    m_fdEpoll = epoll_create1(EPOLL_CLOEXEC);
+    m_fdWake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (-1 == m_fdEpoll || -1 == m_fdWake)
+    {
+        throw std::system_error(errno, std::system_category(),
+                                "rpcClient: epoll setup failed");
+    }
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.ptr = &gcClientWakeTag;
+    epoll_ctl(m_fdEpoll, EPOLL_CTL_ADD, m_fdWake, &ev);
+
+    m_thread = std::thread(&rpcClient::run, this);
+}
+
+rpcClient::~rpcClient()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_queueLock);
+        m_bStop = true;
+    }
+    wake();
+    m_thread.join();
+    close(m_fdWake);
+    close(m_fdEpoll);
+}
+
+rpcClient::call_id_t rpcClient::start(const std::string& ssHost,
+                                      const std::string& ssService,
+                                      const void* pPacket, size_t stLen,
+                                      done_t done, int iDeadlineMs)
+{
+    return submit(ssHost, ssService, pPacket, stLen, std::move(done),
+                  iDeadlineMs, nullptr);
+}
+
+std::future<rpc_reply_t> rpcClient::call(const std::string& ssHost,
+                                         const std::string& ssService,
+                                         const void* pPacket, size_t stLen,
+                                         int iDeadlineMs, call_id_t* pId)
+{
+    auto pPromise = std::make_shared<std::promise<rpc_reply_t>>();
+    std::future<rpc_reply_t> result = pPromise->get_future();
+    submit(ssHost, ssService, pPacket, stLen,
+           [pPromise](rpc_reply_t&& reply) {
+               pPromise->set_value(std::move(reply));
+           },
+           iDeadlineMs, pId);
+    return result;
+}
+
+rpcClient::awaitable rpcClient::co_call(const std::string& ssHost,
+                                        const std::string& ssService,
+                                        const void* pPacket, size_t stLen,
+                                        int iDeadlineMs, call_id_t* pId)
+{
+    return awaitable(this, ssHost, ssService, pPacket, stLen,
+                     iDeadlineMs, pId);
+}
+
+void rpcClient::cancel(call_id_t id)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_queueLock);
+        m_cancelled.push_back(id);
+    }
+    wake();
+}
+
+/**
+ * The request is copied here rather than when the coroutine suspends, so
+ * the caller's packet may go out of scope once co_call() has returned.
+ */
+rpcClient::awaitable::awaitable(rpcClient* pClient, std::string ssHost,
+                                std::string ssService, const void* pPacket,
+                                size_t stLen, int iDeadlineMs,
+                                call_id_t* pId)
+    : m_pClient(pClient),
+      m_ssHost(std::move(ssHost)),
+      m_ssService(std::move(ssService)),
+      m_request((const char*)pPacket, (const char*)pPacket + stLen),
+      m_iDeadlineMs(iDeadlineMs),
+      m_pId(pId),
+      m_reply{0, {}}
+{
+}
+
+/**
+ * The coroutine may be resumed, and this awaitable destroyed, before
+ * submit() returns; nothing here touches the awaitable afterwards.
+ */
+void rpcClient::awaitable::await_suspend(std::coroutine_handle<> handle)
+{
+    m_pClient->submit(m_ssHost, m_ssService,
+                      m_request.data(), m_request.size(),
+                      [this, handle](rpc_reply_t&& reply) {
+                          m_reply = std::move(reply);
+                          handle.resume();
+                      },
+                      m_iDeadlineMs, m_pId);
+}
+
+/**
+ * Resolves the peer and checks the frame on the caller's thread. A call
+ * that cannot start is still queued, with iError set, so that its
+ * outcome is delivered on the loop thread like every other. Once the
+ * destructor has begun, nothing dequeues calls any more, so a call made
+ * then completes with ECANCELED here, on the caller's thread.
+ */
+rpcClient::call_id_t rpcClient::submit(const std::string& ssHost,
+                                       const std::string& ssService,
+                                       const void* pPacket, size_t stLen,
+                                       done_t done, int iDeadlineMs,
+                                       call_id_t* pId)
+{
+    auto* pCall = new rpc_async_call_t();
+    pCall->id = m_nextId++;
+    pCall->fd = -1;
+    pCall->iError = 0;
+    pCall->eState = RPC_CALL_CONNECTING;
+    pCall->addrLen = 0;
+    pCall->stDone = 0;
+    pCall->deadline = std::chrono::steady_clock::now() +
+                      std::chrono::milliseconds(iDeadlineMs);
+    pCall->done = std::move(done);
+
+    ssize_t iFrame = vparpc::frame_length(pPacket, stLen, stLen);
+    if (iFrame <= 0)
+    {
+        pCall->iError = EPROTO;
+    }
+    else
+    {
+        pCall->stFrame = iFrame;
+        pCall->buffer.assign((const char*)pPacket,
+                             (const char*)pPacket + iFrame);
+        pCall->buffer.resize(std::max(stLen, sizeof(vparpc_request_t)));
+
+        rpc_addr_t addr;
+        if (rpcResolver::resolve(ssHost, ssService, addr))
+        {
+            memcpy(&pCall->addr, &addr.addr, addr.addrLen);
+            pCall->addrLen = addr.addrLen;
+        }
+        else
+        {
+            pCall->iError = EHOSTUNREACH;
+        }
+    }
+
+    // The id is published under the queue lock, after the call is queued:
+    // a cancel() made with it is then queued after the call, and the loop
+    // cannot complete the call, or resume a coroutine that owns *pId,
+    // before the store.
+    call_id_t id = pCall->id;
+    bool bStop;
+    {
+        std::lock_guard<std::mutex> lock(m_queueLock);
+        bStop = m_bStop;
+        if (!bStop)
+        {
+            m_submitted.push_back(pCall);
+        }
+        if (nullptr != pId)
+        {
+            *pId = id;
+        }
+    }
+    if (bStop)
+    {
+        rpc_reply_t reply;
+        reply.iError = ECANCELED;
+        done_t done = std::move(pCall->done);
+        delete pCall;
+        done(std::move(reply));
+        return id;
+    }
+    wake();
+    return id;
+}
+
+void rpcClient::wake()
+{
+    uint64_t u = 1;
+    ssize_t n = write(m_fdWake, &u, sizeof(u));
+    (void)n;
+}
+
+/**
+ * The loop thread. Events are level-triggered; each call is registered
+ * for exactly the one direction its state needs. The pass that sees
+ * m_bStop fails every queued and open call; m_bStop is read under the
+ * same lock as the queue, so any later call is failed by submit().
+ */
+void rpcClient::run()
+{
+    struct epoll_event events[RPC_CLIENT_EVENTS_MAX];
+
+    for (;;)
+    {
+        int n = epoll_wait(m_fdEpoll, events, RPC_CLIENT_EVENTS_MAX,
+                           next_timeout());
+        for (int i = 0; i < n; i++)
+        {
+            if (&gcClientWakeTag == events[i].data.ptr)
+            {
+                uint64_t u;
+                ssize_t r = read(m_fdWake, &u, sizeof(u));
+                (void)r;
+                continue;
+            }
+            on_event((rpc_async_call_t*)events[i].data.ptr);
+        }
+
+        std::vector<rpc_async_call_t*> submitted;
+        std::vector<call_id_t> cancelled;
+        bool bStop;
+        {
+            std::lock_guard<std::mutex> lock(m_queueLock);
+            submitted.swap(m_submitted);
+            cancelled.swap(m_cancelled);
+            bStop = m_bStop;
+        }
+        for (rpc_async_call_t* pCall : submitted)
+        {
+            if (bStop)
+            {
+                finish(pCall, ECANCELED);
+            }
+            else
+            {
+                begin(pCall);
+            }
+        }
+        for (call_id_t id : cancelled)
+        {
+            auto it = m_calls.find(id);
+            if (it != m_calls.end())
+            {
+                finish(it->second, ECANCELED);
+            }
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        std::vector<rpc_async_call_t*> expired;
+        for (auto& entry : m_calls)
+        {
+            if (bStop || entry.second->deadline <= now)
+            {
+                expired.push_back(entry.second);
+            }
+        }
+        for (rpc_async_call_t* pCall : expired)
+        {
+            finish(pCall, bStop ? ECANCELED : ETIMEDOUT);
+        }
+
+        if (bStop)
+        {
+            return;
+        }
+    }
+}
+
+/**
+ * Milliseconds until the nearest deadline, for epoll_wait.
+ */
+int rpcClient::next_timeout()
+{
+    if (m_calls.empty())
+    {
+        return -1;
+    }
+    auto nearest = std::chrono::steady_clock::time_point::max();
+    for (auto& entry : m_calls)
+    {
+        nearest = std::min(nearest, entry.second->deadline);
+    }
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        nearest - std::chrono::steady_clock::now()).count();
+    return ms <= 0 ? 0 : (int)std::min<int64_t>(ms + 1, INT_MAX);
+}
+
+void rpcClient::begin(rpc_async_call_t* pCall)
+{
+    m_calls[pCall->id] = pCall;
+    if (0 != pCall->iError)
+    {
+        finish(pCall, pCall->iError);
+        return;
+    }
+
+    pCall->fd = socket(pCall->addr.ss_family,
+                       SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (-1 == pCall->fd)
+    {
+        finish(pCall, errno);
+        return;
+    }
+
+    if (0 == connect(pCall->fd, (struct sockaddr*)&pCall->addr,
+                     pCall->addrLen))
+    {
+        pCall->eState = RPC_CALL_WRITING;
+    }
+    else if (EINPROGRESS != errno)
+    {
+        finish(pCall, errno);
+        return;
+    }
+
+    struct epoll_event ev = {};
+    ev.events = EPOLLOUT;
+    ev.data.ptr = pCall;
+    if (-1 == epoll_ctl(m_fdEpoll, EPOLL_CTL_ADD, pCall->fd, &ev))
+    {
+        finish(pCall, errno);
+    }
+}
+
+/**
+ * Errors and hang-ups need no special case: they surface from SO_ERROR,
+ * send() or recv() in whichever state the call is in.
+ */
+void rpcClient::on_event(rpc_async_call_t* pCall)
+{
+    if (RPC_CALL_CONNECTING == pCall->eState)
+    {
+        int iErr = 0;
+        socklen_t len = sizeof(iErr);
+        getsockopt(pCall->fd, SOL_SOCKET, SO_ERROR, &iErr, &len);
+        if (0 != iErr)
+        {
+            finish(pCall, iErr);
+            return;
+        }
+        pCall->eState = RPC_CALL_WRITING;
+    }
+
+    if (RPC_CALL_WRITING == pCall->eState)
+    {
+        while (pCall->stDone < pCall->stFrame)
+        {
+            ssize_t n = send(pCall->fd, pCall->buffer.data() + pCall->stDone,
+                             pCall->stFrame - pCall->stDone, MSG_NOSIGNAL);
+            if (n > 0)
+            {
+                pCall->stDone += n;
+                continue;
+            }
+            if (-1 == n && (EAGAIN == errno || EWOULDBLOCK == errno))
+            {
+                return;
+            }
+            if (-1 == n && EINTR == errno)
+            {
+                continue;
+            }
+            finish(pCall, errno);
+            return;
+        }
+        pCall->eState = RPC_CALL_READING;
+        pCall->stDone = 0;
+
+        struct epoll_event ev = {};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.ptr = pCall;
+        epoll_ctl(m_fdEpoll, EPOLL_CTL_MOD, pCall->fd, &ev);
+        return;
+    }
+
+    for (;;)
+    {
+        ssize_t n = recv(pCall->fd, pCall->buffer.data() + pCall->stDone,
+                         pCall->buffer.size() - pCall->stDone, 0);
+        if (0 == n)
+        {
+            finish(pCall, ECONNRESET);
+            return;
+        }
+        if (n < 0)
+        {
+            if (EAGAIN == errno || EWOULDBLOCK == errno)
+            {
+                return;
+            }
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            finish(pCall, errno);
+            return;
+        }
+        pCall->stDone += n;
+
+        ssize_t iFrame = vparpc::frame_length(pCall->buffer.data(),
+                                              pCall->stDone,
+                                              pCall->buffer.size());
+        if (iFrame < 0)
+        {
+            finish(pCall, EPROTO);
+            return;
+        }
+        if (iFrame > 0 && pCall->stDone >= (size_t)iFrame)
+        {
+            pCall->buffer.resize(iFrame);
+            finish(pCall, 0);
+            return;
+        }
+    }
+}
+
+/**
+ * Closes the call's connection and delivers its outcome. The handler may
+ * start further calls; they are only queued, so m_calls is not disturbed.
+ */
+void rpcClient::finish(rpc_async_call_t* pCall, int iError)
+{
+    static shm_counter timeouts("rpc.client.timeouts");
+
+    if (-1 != pCall->fd)
+    {
+        epoll_ctl(m_fdEpoll, EPOLL_CTL_DEL, pCall->fd, nullptr);
+        close(pCall->fd);
+    }
+    m_calls.erase(pCall->id);
+    if (ETIMEDOUT == iError)
+    {
+        timeouts.add();
+    }
+
+    rpc_reply_t reply;
+    reply.iError = iError;
+    if (0 == iError)
+    {
+        reply.reply = std::move(pCall->buffer);
+    }
+    done_t done = std::move(pCall->done);
+    delete pCall;
+    done(std::move(reply));
+}
+
+/////////////////////////
+// eof - rpcClient.cpp //
+/////////////////////////
@@ -0,0 +1,524 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/rpcCompiler.cpp 2026-10-17 20:30 dwg -        //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#include "mwfw2.h"
+
+/**
+ * A function has a v2 codec and a client stub when its request struct
+ * has a status; the generic struct has none.
+ */
+bool rpcCompiler::func_t::has_codec() const
+{
+    for (const field_t& field : fields)
+    {
+        if ("status" == field.ssType)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string rpcCompiler::func_t::struct_name() const
+{
+    return "vparpc_request_" + ssMember + "_t";
+}
+
+/**
+ * Whether a field travels in the request or, with bReply, in the reply.
+ */
+bool rpcCompiler::carries(const field_t& field, bool bReply)
+{
+    if (0 == field.iTag)
+    {
+        return false;
+    }
+    return "inout" == field.ssDirection ||
+        (bReply ? "out" : "in") == field.ssDirection;
+}
+
+rpcCompiler::rpcCompiler(std::string ssIdlName, bool bDebug)
+{
+    m_ssIdl = ssIdlName;
+    m_pCsv = new readCsv(ssIdlName);
+    m_pCsv->parseData();
+    m_bOk = parse();
+    if (m_bOk)
+    {
+        write_types(m_pCsv->m_parsed_data[ROW_META_DATA][COL_IDL_META_TYPES]);
+        write_stubs(m_pCsv->m_parsed_data[ROW_META_DATA][COL_IDL_META_STUBS]);
+    }
+    if (bDebug)
+    {
+        std::cout << "rpcCompiler(" << ssIdlName << "): "
+            << (m_bOk ? "generated" : "nothing generated") << std::endl;
+    }
+    delete m_pCsv;
+    m_pCsv = nullptr;
+}
+
+/**
+ * Collects the active rows into m_funcs, checking that every field
+ * follows its function and that no tag repeats within a function.
+ */
+bool rpcCompiler::parse()
+{
+    const std::string* pMeta = m_pCsv->m_parsed_data[ROW_META_DATA];
+    if ("true" != pMeta[COL_IDL_META_ACTIVE] ||
+        "1" != pMeta[COL_IDL_META_VERSION])
+    {
+        return false;
+    }
+    m_ssFrameSize = pMeta[COL_IDL_META_FRAME_SIZE];
+    m_ssDescription = pMeta[COL_IDL_META_DESCRIPTION];
+
+    for (int iRow = ROW_DATA; iRow < m_pCsv->m_iRow; iRow++)
+    {
+        const std::string* pRow = m_pCsv->m_parsed_data[iRow];
+        if ("true" != pRow[COL_IDL_ACTIVE])
+        {
+            continue;
+        }
+        if ("func" == pRow[COL_IDL_KIND])
+        {
+            func_t func;
+            func.ssFunc = pRow[COL_IDL_FUNCTION];
+            func.ssMember = pRow[COL_IDL_MEMBER];
+            func.ssDescription = pRow[COL_IDL_DESCRIPTION];
+            func.bHandler = "handler" == pRow[COL_IDL_TYPE];
+            m_funcs.push_back(func);
+            continue;
+        }
+        if ("field" != pRow[COL_IDL_KIND] || m_funcs.empty() ||
+            m_funcs.back().ssFunc != pRow[COL_IDL_FUNCTION] ||
+            !m_funcs.back().has_struct())
+        {
+            gpSysLog->loginfo("rpcCompiler: field outside its function");
+            return false;
+        }
+        field_t field;
+        field.ssName = pRow[COL_IDL_MEMBER];
+        field.ssType = pRow[COL_IDL_TYPE];
+        field.ssSize = pRow[COL_IDL_SIZE];
+        field.ssDirection = pRow[COL_IDL_DIRECTION];
+        field.ssDescription = pRow[COL_IDL_DESCRIPTION];
+        field.iTag = atoi(pRow[COL_IDL_TAG].c_str());
+        for (const field_t& other : m_funcs.back().fields)
+        {
+            if (0 != field.iTag && other.iTag == field.iTag)
+            {
+                gpSysLog->loginfo("rpcCompiler: tag used twice");
+                return false;
+            }
+        }
+        m_funcs.back().fields.push_back(field);
+    }
+    return !m_funcs.empty();
+}
+
+std::string rpcCompiler::include_path(const std::string& ssHeader)
+{
+    std::string ssPath = __FILE__;
+    ssPath = std::filesystem::path(ssPath).remove_filename();
+    return ssPath + "include/" + ssHeader;
+}
+
+/**
+ * The usual file banner, saying where the file came from instead of who
+ * last edited it.
+ */
+void rpcCompiler::write_banner(std::ofstream& ofs, const std::string& ssHeader)
+{
+    auto line = [&ofs](std::string ssText) {
+        ssText.resize(62, ' ');
+        ofs << "// " << ssText << " //" << std::endl;
+    };
+    std::string ssRule(68, '/');
+    ofs << ssRule << std::endl;
+    line("~/public_html/fw/include/" + ssHeader);
+    line("Generated by rpcCompiler from schemas/v1/" + m_ssIdl + ".");
+    line("Do not edit; change the IDL and run \"vpautil -i\".");
+    ofs << ssRule << std::endl;
+    line("This file is made available under the");
+    line("Creative Commons CC0 1.0 Universal Public Domain Dedication.");
+    ofs << ssRule << std::endl << std::endl;
+    ofs << "#pragma once" << std::endl << std::endl;
+}
+
+void rpcCompiler::write_eof(std::ofstream& ofs, const std::string& ssHeader)
+{
+    std::string ssEof = "// eof - " + ssHeader + " //";
+    ofs << std::endl;
+    ofs << std::string(ssEof.size(), '/') << std::endl;
+    ofs << ssEof << std::endl;
+    ofs << std::string(ssEof.size(), '/') << std::endl;
+}
+
+/**
+ * The function enum, the request structs with their size checks, the
+ * request union and the function names.
+ */
+void rpcCompiler::write_types(const std::string& ssHeader)
+{
+    std::ofstream ofs(include_path(ssHeader));
+    write_banner(ofs, ssHeader);
+
+    ofs << "/**" << std::endl;
+    ofs << " * @enum vparpc_func_t" << std::endl;
+    ofs << " * @brief " << m_ssDescription << "." << std::endl;
+    ofs << " */" << std::endl;
+    ofs << "enum vparpc_func_t" << std::endl << "{" << std::endl;
+    for (size_t i = 0; i < m_funcs.size(); i++)
+    {
+        ofs << "    VPARPC_FUNC_" << m_funcs[i].ssFunc
+            << (0 == i ? " = 0," : ",");
+        if (!m_funcs[i].ssDescription.empty())
+        {
+            ofs << " // " << m_funcs[i].ssDescription;
+        }
+        ofs << std::endl;
+    }
+    ofs << "    VPARPC_FUNC_COUNT // Total count of available functions"
+        << std::endl << "};" << std::endl << std::endl;
+
+    ofs << "/**" << std::endl;
+    ofs << " * Every request struct is this long, so that a v1 peer can read"
+        << std::endl;
+    ofs << " * any request into a vparpc_request_t." << std::endl;
+    ofs << " */" << std::endl;
+    ofs << "#define VPARPC_IDL_FRAME_SIZE " << m_ssFrameSize << std::endl;
+
+    for (const func_t& func : m_funcs)
+    {
+        if (!func.has_struct())
+        {
+            continue;
+        }
+        ofs << std::endl << "/**" << std::endl;
+        ofs << " * @struct " << func.struct_name() << std::endl;
+        ofs << " * @brief VPARPC_FUNC_" << func.ssFunc << ": "
+            << func.ssDescription << "." << std::endl;
+        ofs << " */" << std::endl;
+        ofs << "struct " << func.struct_name() << std::endl << "{" << std::endl;
+        ofs << "    vparpc_version_t eVersion;" << std::endl;
+        ofs << "    uint32_t uRequestId;" << std::endl;
+        ofs << "    size_t nSize;" << std::endl;
+        ofs << "    vparpc_func_t eFunc;" << std::endl;
+        for (const field_t& field : func.fields)
+        {
+            std::ostringstream oss;
+            if ("char8" == field.ssType)
+            {
+                oss << "char8_t " << field.ssName << "[" << field.ssSize << "];";
+            }
+            else if ("char" == field.ssType || "pad" == field.ssType)
+            {
+                oss << "char " << field.ssName << "[" << field.ssSize << "];";
+            }
+            else if ("int" == field.ssType)
+            {
+                oss << "int " << field.ssName << ";";
+            }
+            else
+            {
+                oss << "vparpc_status_t " << field.ssName << ";";
+            }
+            ofs << "    " << oss.str();
+            if (!field.ssDescription.empty())
+            {
+                ofs << " // " << field.ssDescription;
+            }
+            ofs << std::endl;
+        }
+        ofs << "};" << std::endl << std::endl;
+        ofs << "static_assert(sizeof(" << func.struct_name()
+            << ") == VPARPC_IDL_FRAME_SIZE," << std::endl;
+        ofs << "              \"" << func.struct_name()
+            << " must keep the v1 frame size\");" << std::endl;
+        ofs << "static_assert(offsetof(" << func.struct_name()
+            << ", nSize) == 8," << std::endl;
+        ofs << "              \"" << func.struct_name()
+            << " must keep the v1 frame header\");" << std::endl;
+    }
+
+    ofs << std::endl << "union vparpc_request_t" << std::endl << "{" << std::endl;
+    for (const func_t& func : m_funcs)
+    {
+        if (func.has_struct())
+        {
+            ofs << "    struct " << func.struct_name() << " req_"
+                << func.ssMember << ";" << std::endl;
+        }
+    }
+    ofs << "};" << std::endl << std::endl;
+
+    ofs << "inline constexpr const char* vparpc_func_names[VPARPC_FUNC_COUNT] = {"
+        << std::endl;
+    for (const func_t& func : m_funcs)
+    {
+        // GET_AUTH reads "Get_Auth"
+        std::string ssLabel = func.ssFunc;
+        bool bWordStart = true;
+        for (char& c : ssLabel)
+        {
+            c = bWordStart ? toupper(c) : tolower(c);
+            bWordStart = '_' == c;
+        }
+        ofs << "    \"  Function " << ssLabel << "\"," << std::endl;
+    }
+    ofs << "};" << std::endl;
+
+    write_eof(ofs, ssHeader);
+}
+
+/**
+ * Straight-line field writes for each direction; the writer bounds every
+ * string by its array, so no field is measured twice or copied twice.
+ */
+void rpcCompiler::write_encode(std::ofstream& ofs, const func_t& func)
+{
+    ofs << "    static void encode(const " << func.struct_name()
+        << "& m, bool bReply," << std::endl;
+    ofs << "                       vparpcWire::writer& out)" << std::endl;
+    ofs << "    {" << std::endl;
+    ofs << "        if (bReply)" << std::endl << "        {" << std::endl;
+    for (const field_t& field : func.fields)
+    {
+        if ("status" == field.ssType)
+        {
+            ofs << "            out.status(m." << field.ssName << ");"
+                << std::endl;
+        }
+        else if (carries(field, true))
+        {
+            ofs << "            out.put(" << field.iTag << ", m."
+                << field.ssName << ");" << std::endl;
+        }
+    }
+    ofs << "            return;" << std::endl << "        }" << std::endl;
+    for (const field_t& field : func.fields)
+    {
+        if (carries(field, false))
+        {
+            ofs << "        out.put(" << field.iTag << ", m." << field.ssName
+                << ");" << std::endl;
+        }
+    }
+    ofs << "    }" << std::endl;
+}
+
+/**
+ * A switch on the tag per direction. A reply first clears the fields it
+ * carries, since an empty string or a zero is left off the wire.
+ */
+void rpcCompiler::write_decode(std::ofstream& ofs, const func_t& func)
+{
+    auto loop = [&](bool bReply, const std::string& ssIndent) {
+        bool bAny = false;
+        for (const field_t& field : func.fields)
+        {
+            bAny = bAny || carries(field, bReply);
+        }
+        ofs << ssIndent << "while (in.next(uTag, value))" << std::endl;
+        ofs << ssIndent << "{" << std::endl;
+        if (bAny)
+        {
+            ofs << ssIndent << "    switch (uTag)" << std::endl;
+            ofs << ssIndent << "    {" << std::endl;
+            for (const field_t& field : func.fields)
+            {
+                if (!carries(field, bReply))
+                {
+                    continue;
+                }
+                ofs << ssIndent << "    case " << field.iTag << ":"
+                    << std::endl;
+                if ("int" == field.ssType)
+                {
+                    ofs << ssIndent << "        if (!vparpcWire::get(m."
+                        << field.ssName << ", value))" << std::endl;
+                    ofs << ssIndent << "        {" << std::endl;
+                    ofs << ssIndent << "            return false;"
+                        << std::endl;
+                    ofs << ssIndent << "        }" << std::endl;
+                }
+                else
+                {
+                    ofs << ssIndent << "        vparpcWire::get(m."
+                        << field.ssName << ", value);" << std::endl;
+                }
+                ofs << ssIndent << "        break;" << std::endl;
+            }
+            ofs << ssIndent << "    }" << std::endl;
+        }
+        ofs << ssIndent << "}" << std::endl;
+        ofs << ssIndent << "return in.valid();" << std::endl;
+    };
+
+    ofs << "    static bool decode(" << func.struct_name()
+        << "& m, bool bReply," << std::endl;
+    ofs << "                       vparpcWire::reader& in)" << std::endl;
+    ofs << "    {" << std::endl;
+    ofs << "        uint32_t uTag;" << std::endl;
+    ofs << "        std::string_view value;" << std::endl;
+    ofs << "        if (bReply)" << std::endl << "        {" << std::endl;
+    for (const field_t& field : func.fields)
+    {
+        if ("status" == field.ssType)
+        {
+            ofs << "            m." << field.ssName
+                << " = (vparpc_status_t)in.status();" << std::endl;
+        }
+        else if (carries(field, true))
+        {
+            ofs << "            vparpcWire::clear(m." << field.ssName << ");"
+                << std::endl;
+        }
+    }
+    loop(true, "            ");
+    ofs << "        }" << std::endl;
+    loop(false, "        ");
+    ofs << "    }" << std::endl;
+}
+
+/**
+ * One function per RPC, taking the request fields as arguments and
+ * leaving the answered request in reply.
+ */
+void rpcCompiler::write_stub(std::ofstream& ofs, const func_t& func)
+{
+    ofs << std::endl << "/**" << std::endl;
+    ofs << " * Calls VPARPC_FUNC_" << func.ssFunc << ": " << func.ssDescription
+        << "." << std::endl;
+    ofs << " *" << std::endl;
+    ofs << " * @param reply Receives the answered request." << std::endl;
+    ofs << " * @return false if the call went unanswered." << std::endl;
+    ofs << " */" << std::endl;
+    ofs << "inline bool vparpc_call_" << func.ssMember << "(" << std::endl;
+    ofs << "    vparpc& rpc, const std::string& ssHost, "
+        << "const std::string& ssService," << std::endl;
+    for (const field_t& field : func.fields)
+    {
+        if (carries(field, false))
+        {
+            ofs << "    " << ("int" == field.ssType ? "int " : "std::string_view ")
+                << field.ssName << "," << std::endl;
+        }
+    }
+    ofs << "    " << func.struct_name() << "& reply)" << std::endl;
+    ofs << "{" << std::endl;
+    ofs << "    vparpc_idl<" << func.struct_name() << ">::init(reply);"
+        << std::endl;
+    for (const field_t& field : func.fields)
+    {
+        if (!carries(field, false))
+        {
+            continue;
+        }
+        if ("int" == field.ssType)
+        {
+            ofs << "    reply." << field.ssName << " = " << field.ssName << ";"
+                << std::endl;
+        }
+        else
+        {
+            ofs << "    vparpcWire::set(reply." << field.ssName << ", "
+                << field.ssName << ");" << std::endl;
+        }
+    }
+    ofs << "    vparpc_call_t call = {&reply, sizeof(reply)};" << std::endl;
+    ofs << "    return rpc.client_batch(ssHost, ssService, &call, 1);"
+        << std::endl;
+    ofs << "}" << std::endl;
+}
+
+/**
+ * Per-struct traits with the v2 codec, the codec jump table, the list of
+ * handled functions for the servers' dispatch tables, and the client
+ * stubs.
+ */
+void rpcCompiler::write_stubs(const std::string& ssHeader)
+{
+    std::ofstream ofs(include_path(ssHeader));
+    write_banner(ofs, ssHeader);
+
+    for (const func_t& func : m_funcs)
+    {
+        if (!func.has_codec())
+        {
+            continue;
+        }
+        ofs << "template <>" << std::endl;
+        ofs << "struct vparpc_idl<" << func.struct_name() << ">" << std::endl;
+        ofs << "{" << std::endl;
+        ofs << "    static constexpr vparpc_func_t eFunc = VPARPC_FUNC_"
+            << func.ssFunc << ";" << std::endl << std::endl;
+        ofs << "    static void init(" << func.struct_name() << "& m)"
+            << std::endl;
+        ofs << "    {" << std::endl;
+        ofs << "        memset(&m, 0, sizeof(m));" << std::endl;
+        ofs << "        m.eVersion = VPARPC_VERSION_1;" << std::endl;
+        ofs << "        m.nSize = sizeof(m);" << std::endl;
+        ofs << "        m.eFunc = eFunc;" << std::endl;
+        ofs << "    }" << std::endl << std::endl;
+        write_encode(ofs, func);
+        ofs << std::endl;
+        write_decode(ofs, func);
+        ofs << "};" << std::endl << std::endl;
+    }
+
+    ofs << "/**" << std::endl;
+    ofs << " * The v2 codec of each function, indexed by vparpc_func_t."
+        << std::endl;
+    ofs << " */" << std::endl;
+    ofs << "inline constexpr vparpc_idl_codec_t "
+        << "vparpc_idl_codecs[VPARPC_FUNC_COUNT] = {" << std::endl;
+    for (const func_t& func : m_funcs)
+    {
+        if (func.has_codec())
+        {
+            ofs << "    VPARPC_IDL_CODEC(" << func.struct_name() << "),";
+        }
+        else
+        {
+            ofs << "    {0, nullptr, nullptr},";
+        }
+        ofs << " // " << func.ssFunc << std::endl;
+    }
+    ofs << "};" << std::endl << std::endl;
+
+    ofs << "/**" << std::endl;
+    ofs << " * X(FUNC, member) for every function the servers handle, each by"
+        << std::endl;
+    ofs << " * a handle_<member>_request(char*, window*)." << std::endl;
+    ofs << " */" << std::endl;
+    ofs << "#define VPARPC_IDL_HANDLERS(X) \\" << std::endl;
+    for (const func_t& func : m_funcs)
+    {
+        if (func.bHandler)
+        {
+            ofs << "    X(" << func.ssFunc << ", " << func.ssMember << ") \\"
+                << std::endl;
+        }
+    }
+    ofs << std::endl;
+
+    for (const func_t& func : m_funcs)
+    {
+        if (func.has_codec())
+        {
+            write_stub(ofs, func);
+        }
+    }
+
+    write_eof(ofs, ssHeader);
+}
+
+///////////////////////////
+// eof - rpcCompiler.cpp //
+///////////////////////////
@@ -0,0 +1,242 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/rpcPool.cpp 2026-10-17 19:20 dwg -            //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#include "mwfw2.h"
+
+struct rpc_resolved_t
+{
+    bool bOk;
+    rpc_addr_t addr;
+    std::chrono::steady_clock::time_point expires;
+};
+
+static std::mutex gResolveLock;
+static std::unordered_map<std::string, rpc_resolved_t> gResolved;
+
+/**
+ * getaddrinfo() runs outside the lock, so a slow lookup does not hold up
+ * callers whose answer is cached. Two threads missing on the same name
+ * at once both look it up; the second answer simply replaces the first.
+ */
+bool rpcResolver::resolve(const std::string& ssHost,
+                          const std::string& ssService, rpc_addr_t& addr)
+{
+    static shm_counter misses("rpc.resolve.misses");
+
+    std::string ssKey = ssHost + ":" + ssService;
+    auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(gResolveLock);
+        auto it = gResolved.find(ssKey);
+        if (it != gResolved.end() && it->second.expires > now)
+        {
+            addr = it->second.addr;
+            return it->second.bOk;
+        }
+    }
+    misses.add();
+
+    rpc_resolved_t entry = {};
+    std::string ssPath;
+    if (unix_path(ssService, ssPath))
+    {
+        auto* pUnix = (struct sockaddr_un*)&entry.addr.addr;
+        pUnix->sun_family = AF_UNIX;
+        entry.bOk = ssPath.size() < sizeof(pUnix->sun_path);
+        if (entry.bOk)
+        {
+            memcpy(pUnix->sun_path, ssPath.c_str(), ssPath.size() + 1);
+            entry.addr.addrLen =
+                offsetof(struct sockaddr_un, sun_path) + ssPath.size() + 1;
+        }
+    }
+    else
+    {
+        struct addrinfo hints = {};
+        struct addrinfo* pResult = nullptr;
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        entry.bOk = 0 == getaddrinfo(ssHost.c_str(), ssService.c_str(),
+                                     &hints, &pResult) && nullptr != pResult;
+        if (entry.bOk)
+        {
+            memcpy(&entry.addr.addr, pResult->ai_addr, pResult->ai_addrlen);
+            entry.addr.addrLen = pResult->ai_addrlen;
+        }
+        if (nullptr != pResult)
+        {
+            freeaddrinfo(pResult);
+        }
+    }
+    entry.expires = now + std::chrono::milliseconds(
+        entry.bOk ? CFG_VPARPC_DNS_TTL_MS : CFG_VPARPC_DNS_NEG_TTL_MS);
+
+    std::lock_guard<std::mutex> lock(gResolveLock);
+    gResolved[ssKey] = entry;
+    addr = entry.addr;
+    return entry.bOk;
+}
+
+void rpcResolver::flush()
+{
+    std::lock_guard<std::mutex> lock(gResolveLock);
+    gResolved.clear();
+}
+
+bool rpcResolver::unix_path(const std::string& ssService, std::string& ssPath)
+{
+    static const std::string ssPrefix = CFG_VPARPC_UNIX_PREFIX;
+    if (0 != ssService.compare(0, ssPrefix.size(), ssPrefix))
+    {
+        return false;
+    }
+    ssPath = ssService.substr(ssPrefix.size());
+    if (ssPath.empty() || '/' != ssPath[0])
+    {
+        ssPath = std::string(CFG_VPARPC_UNIX_DIR) + "/" + ssPath + ".sock";
+    }
+    return true;
+}
+
+rpcPool::rpcPool()
+{
+}
+
+rpcPool::~rpcPool()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    for (auto& peer : m_idle)
+    {
+        for (idle_t& conn : peer.second)
+        {
+            close(conn.fd);
+        }
+    }
+    m_idle.clear();
+}
+
+/**
+ * A healthy idle connection has nothing to read: the server answers only
+ * when asked, so a readable socket means it has closed the connection or
+ * the stream is out of step.
+ */
+bool rpcPool::healthy(const idle_t& conn,
+                      std::chrono::steady_clock::time_point now)
+{
+    if (now - conn.since > std::chrono::milliseconds(CFG_VPARPC_POOL_IDLE_MS))
+    {
+        return false;
+    }
+    struct pollfd pfd = {conn.fd, POLLIN, 0};
+    return 0 == poll(&pfd, 1, 0);
+}
+
+/**
+ * Connections are handed out most recently used first; they are the ones
+ * least likely to have been closed by the server.
+ */
+int rpcPool::acquire(const std::string& ssHost, const std::string& ssService,
+                     bool& bReused)
+{
+    static shm_counter reused("rpc.pool.reused");
+    static shm_counter connects("rpc.pool.connects");
+
+    std::string ssKey = ssHost + ":" + ssService;
+    auto now = std::chrono::steady_clock::now();
+    std::vector<int> stale;
+    int fd = -1;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto it = m_idle.find(ssKey);
+        if (it != m_idle.end())
+        {
+            while (!it->second.empty() && -1 == fd)
+            {
+                idle_t conn = it->second.back();
+                it->second.pop_back();
+                if (healthy(conn, now))
+                {
+                    fd = conn.fd;
+                }
+                else
+                {
+                    stale.push_back(conn.fd);
+                }
+            }
+        }
+    }
+    for (int iStale : stale)
+    {
+        close(iStale);
+    }
+    if (-1 != fd)
+    {
+        reused.add();
+        bReused = true;
+        return fd;
+    }
+
+    bReused = false;
+    rpc_addr_t addr;
+    if (!rpcResolver::resolve(ssHost, ssService, addr))
+    {
+        errno = EHOSTUNREACH;
+        return -1;
+    }
+    fd = socket(addr.addr.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (-1 == fd)
+    {
+        return -1;
+    }
+    vparpc::set_io_timeout(fd);
+    if (-1 == connect(fd, (struct sockaddr*)&addr.addr, addr.addrLen))
+    {
+        int iErr = errno;
+        close(fd);
+        errno = iErr;
+        return -1;
+    }
+    connects.add();
+    return fd;
+}
+
+void rpcPool::release(const std::string& ssHost,
+                      const std::string& ssService, int fd)
+{
+    std::string ssKey = ssHost + ":" + ssService;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        std::deque<idle_t>& peer = m_idle[ssKey];
+        if (peer.size() < CFG_VPARPC_POOL_MAX_IDLE)
+        {
+            peer.push_back({fd, std::chrono::steady_clock::now()});
+            return;
+        }
+    }
+    close(fd);
+}
+
+void rpcPool::discard(int fd)
+{
+    close(fd);
+}
+
+size_t rpcPool::idle()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    size_t stIdle = 0;
+    for (auto& peer : m_idle)
+    {
+        stIdle += peer.second.size();
+    }
+    return stIdle;
+}
+
+///////////////////////
+// eof - rpcPool.cpp //
+///////////////////////
@@ -0,0 +1,533 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/rpcPrefork.cpp 2026-10-17 23:40 dwg -         //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#include "mwfw2.h"
+
+#define OBJ_PERMS (S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH)
+
+// Set in a worker by SIGHUP, SIGTERM or SIGINT, or by the death of the
+// master; never in the master itself.
+static volatile sig_atomic_t gbRetiring = 0;
+
+static void on_retire(int)
+{
+    gbRetiring = 1;
+}
+
+static std::string object_name(const std::string& ssName)
+{
+    return "/fw_prefork_" + ssName + ".v" +
+        std::to_string(RPCPREFORK_VERSION);
+}
+
+static void set_state(MFW_PREFORK_SLOT_T& slot, uint32_t uState)
+{
+    slot.i64Since = time(nullptr);
+    std::atomic_ref<uint32_t>(slot.uState).store(uState,
+                                                 std::memory_order_release);
+}
+
+static uint32_t get_state(MFW_PREFORK_SLOT_T& slot)
+{
+    return std::atomic_ref<uint32_t>(slot.uState).load(
+        std::memory_order_acquire);
+}
+
+static void empty_slot(MFW_PREFORK_SLOT_T& slot)
+{
+    slot.pid = 0;
+    slot.uRetire = 0;
+    set_state(slot, RPCPREFORK_EMPTY);
+}
+
+/**
+ * Whether the object open on fd is one this user made as a scoreboard:
+ * nobody else may write to it, or they could plant pids for the master
+ * to signal.
+ */
+static bool own_object(int fd)
+{
+    struct stat st = {};
+    return 0 == fstat(fd, &st) && geteuid() == st.st_uid &&
+        OBJ_PERMS == (st.st_mode & (S_IRWXU | S_IRWXG | S_IRWXO)) &&
+        sizeof(MFW_PREFORK_T) == (size_t)st.st_size;
+}
+
+/**
+ * Whether pid is a child of this process that has not been reaped yet,
+ * and so may be signalled: the pids on the scoreboard are only as
+ * trustworthy as the scoreboard. WNOWAIT leaves the child to reap(), and
+ * a pid cannot be reused before it is reaped.
+ */
+static bool is_child(pid_t pid)
+{
+    siginfo_t info = {};
+    return pid > 0 &&
+        0 == waitid(P_PID, pid, &info, WEXITED | WNOHANG | WNOWAIT);
+}
+
+/**
+ * A scoreboard whose master is this very process was left by a reload:
+ * the workers on it belong to the program image that has just been
+ * replaced, and have already been told to go. It is taken over only if
+ * this user owns it. Any other object of the name is unlinked and a new
+ * one created with O_EXCL, so that nobody else can hold it open.
+ */
+rpcPrefork::rpcPrefork(const std::string& ssName, int fdListen)
+    : m_ssObject(object_name(ssName)), m_fdListen(fdListen),
+      m_pBoard(nullptr), m_iRate(CFG_VPARPC_PREFORK_START)
+{
+    int fd = shm_open(m_ssObject.c_str(), O_RDWR, 0);
+    if (-1 != fd)
+    {
+        void* pMap = MAP_FAILED;
+        if (own_object(fd))
+        {
+            pMap = mmap(nullptr, sizeof(MFW_PREFORK_T),
+                        PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (MAP_FAILED != pMap)
+        {
+            m_pBoard = (MFW_PREFORK_T*)pMap;
+            if (RPCPREFORK_MAGIC == m_pBoard->uMagic &&
+                RPCPREFORK_VERSION == m_pBoard->uVersion &&
+                getpid() == m_pBoard->pidMaster)
+            {
+                m_pBoard->uGeneration++;
+                for (uint32_t u = 0; u < CFG_VPARPC_PREFORK_SLOTS; u++)
+                {
+                    if (0 != m_pBoard->slots[u].pid)
+                    {
+                        m_pBoard->slots[u].uRetire = 1;
+                    }
+                }
+                return;
+            }
+            munmap(pMap, sizeof(MFW_PREFORK_T));
+            m_pBoard = nullptr;
+        }
+    }
+    shm_unlink(m_ssObject.c_str());
+
+    fd = shm_open(m_ssObject.c_str(), O_RDWR | O_CREAT | O_EXCL, OBJ_PERMS);
+    if (-1 == fd)
+    {
+        throw std::system_error(errno, std::system_category(),
+                                "rpcPrefork: shm_open failed");
+    }
+    const char* pszFailed = nullptr;
+    if (-1 == fchmod(fd, OBJ_PERMS))
+    {
+        pszFailed = "rpcPrefork: fchmod failed";
+    }
+    else if (-1 == ftruncate(fd, sizeof(MFW_PREFORK_T)))
+    {
+        pszFailed = "rpcPrefork: ftruncate failed";
+    }
+    else if (!own_object(fd))
+    {
+        errno = EPERM;
+        pszFailed = "rpcPrefork: the scoreboard has the wrong owner or mode";
+    }
+    if (nullptr != pszFailed)
+    {
+        int iErr = errno;
+        close(fd);
+        shm_unlink(m_ssObject.c_str());
+        throw std::system_error(iErr, std::system_category(), pszFailed);
+    }
+    void* pMap = mmap(nullptr, sizeof(MFW_PREFORK_T), PROT_READ | PROT_WRITE,
+                      MAP_SHARED, fd, 0);
+    int iErr = errno;
+    close(fd);
+    if (MAP_FAILED == pMap)
+    {
+        shm_unlink(m_ssObject.c_str());
+        throw std::system_error(iErr, std::system_category(),
+                                "rpcPrefork: mmap failed");
+    }
+    m_pBoard = (MFW_PREFORK_T*)pMap;
+
+    m_pBoard->uMagic = RPCPREFORK_MAGIC;
+    m_pBoard->uVersion = RPCPREFORK_VERSION;
+    m_pBoard->pidMaster = getpid();
+    m_pBoard->uGeneration = 1;
+    m_pBoard->i64Started = time(nullptr);
+}
+
+rpcPrefork::~rpcPrefork()
+{
+    m_pBoard->pidMaster = 0;
+    munmap(m_pBoard, sizeof(MFW_PREFORK_T));
+    shm_unlink(m_ssObject.c_str());
+}
+
+bool rpcPrefork::is_listener(int fd)
+{
+    int iListening = 0;
+    socklen_t len = sizeof(iListening);
+    return 0 == getsockopt(fd, SOL_SOCKET, SO_ACCEPTCONN, &iListening,
+                           &len) && 0 != iListening;
+}
+
+bool rpcPrefork::snapshot(const std::string& ssName, MFW_PREFORK_T& board)
+{
+    int fd = shm_open(object_name(ssName).c_str(), O_RDONLY, 0);
+    if (-1 == fd)
+    {
+        return false;
+    }
+    struct stat st;
+    void* pMap = MAP_FAILED;
+    if (0 == fstat(fd, &st) && sizeof(MFW_PREFORK_T) == (size_t)st.st_size)
+    {
+        pMap = mmap(nullptr, sizeof(MFW_PREFORK_T), PROT_READ, MAP_SHARED,
+                    fd, 0);
+    }
+    close(fd);
+    if (MAP_FAILED == pMap)
+    {
+        return false;
+    }
+    memcpy(&board, pMap, sizeof(MFW_PREFORK_T));
+    munmap(pMap, sizeof(MFW_PREFORK_T));
+    return RPCPREFORK_MAGIC == board.uMagic &&
+        RPCPREFORK_VERSION == board.uVersion && 0 != board.pidMaster &&
+        (0 == kill(board.pidMaster, 0) || EPERM == errno);
+}
+
+bool rpcPrefork::retiring()
+{
+    return 0 != gbRetiring;
+}
+
+/**
+ * The slot is filled in before the fork, so that the worker finds its
+ * generation and counters in place; only the pid comes after.
+ */
+bool rpcPrefork::spawn(uint32_t uSlot, const conn_handler_t& handler)
+{
+    MFW_PREFORK_SLOT_T& slot = m_pBoard->slots[uSlot];
+    slot.uRetire = 0;
+    slot.uGeneration = m_pBoard->uGeneration;
+    slot.u64Connections = 0;
+    slot.u64Requests = 0;
+    slot.i64Started = time(nullptr);
+    set_state(slot, RPCPREFORK_STARTING);
+
+    pid_t pid = fork();
+    if (-1 == pid)
+    {
+        set_state(slot, RPCPREFORK_EMPTY);
+        gpSysLog->loginfo("rpcPrefork: fork failed");
+        return false;
+    }
+    if (0 == pid)
+    {
+        worker(uSlot, handler);
+    }
+    slot.pid = pid;
+    return true;
+}
+
+/**
+ * A signal interrupts accept() and the wait for a connection's next
+ * request, since the handler is installed without SA_RESTART; the
+ * transfer of a request that has begun is retried by vparpc::recv_frame()
+ * and vparpc::send_frame(), so it is still answered.
+ */
+void rpcPrefork::worker(uint32_t uSlot, const conn_handler_t& handler)
+{
+    MFW_PREFORK_SLOT_T& slot = m_pBoard->slots[uSlot];
+
+    struct sigaction sa = {};
+    sa.sa_handler = on_retire;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGHUP, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+    sigaction(SIGINT, &sa, nullptr);
+    signal(SIGCHLD, SIG_DFL);
+    sigset_t none;
+    sigemptyset(&none);
+    sigprocmask(SIG_SETMASK, &none, nullptr);
+    prctl(PR_SET_PDEATHSIG, SIGHUP);
+    if (getppid() != m_pBoard->pidMaster)
+    {
+        gbRetiring = 1;
+    }
+
+    set_state(slot, RPCPREFORK_IDLE);
+    while (!gbRetiring &&
+           slot.u64Connections < CFG_VPARPC_PREFORK_RECYCLE)
+    {
+        int fd = accept4(m_fdListen, nullptr, nullptr, SOCK_CLOEXEC);
+        if (-1 == fd)
+        {
+            if (EAGAIN == errno || EWOULDBLOCK == errno)
+            {
+                // xinetd's socket may be non-blocking; wait for it
+                struct pollfd pfd = {m_fdListen, POLLIN, 0};
+                poll(&pfd, 1, -1);
+            }
+            else if (EBADF == errno || EINVAL == errno ||
+                     ENOTSOCK == errno)
+            {
+                break;
+            }
+            else if (EINTR != errno && ECONNABORTED != errno)
+            {
+                // out of descriptors or memory: give them time to free up
+                usleep(100000);
+            }
+            continue;
+        }
+        set_state(slot, RPCPREFORK_BUSY);
+        slot.u64Connections++;
+        slot.u64Requests += handler(fd);
+        close(fd);
+        set_state(slot, RPCPREFORK_IDLE);
+    }
+    set_state(slot, RPCPREFORK_EXITING);
+    _exit(0);
+}
+
+/**
+ * Workers of an older program image are children of this one too, and
+ * are reaped here like the rest. An entry whose pid is not a child of
+ * this process is nobody's to reap, and is emptied.
+ */
+void rpcPrefork::reap()
+{
+    int iStatus;
+    pid_t pid;
+    while ((pid = waitpid(-1, &iStatus, WNOHANG)) > 0)
+    {
+        for (uint32_t u = 0; u < CFG_VPARPC_PREFORK_SLOTS; u++)
+        {
+            MFW_PREFORK_SLOT_T& slot = m_pBoard->slots[u];
+            if (pid == slot.pid)
+            {
+                empty_slot(slot);
+                break;
+            }
+        }
+        if (!WIFEXITED(iStatus) || 0 != WEXITSTATUS(iStatus))
+        {
+            static shm_counter crashes("rpc.prefork.crashes");
+            crashes.add();
+            gpSysLog->loginfo("rpcPrefork: a worker died");
+        }
+    }
+    for (uint32_t u = 0; u < CFG_VPARPC_PREFORK_SLOTS; u++)
+    {
+        MFW_PREFORK_SLOT_T& slot = m_pBoard->slots[u];
+        if (0 != slot.pid && !is_child(slot.pid))
+        {
+            empty_slot(slot);
+        }
+    }
+}
+
+/**
+ * Repeated while the worker lives, since a signal that lands between its
+ * check of retiring() and its next accept() would go unnoticed.
+ */
+void rpcPrefork::retire(uint32_t uSlot)
+{
+    MFW_PREFORK_SLOT_T& slot = m_pBoard->slots[uSlot];
+    if (0 != slot.pid)
+    {
+        slot.uRetire = 1;
+        if (is_child(slot.pid))
+        {
+            kill(slot.pid, SIGHUP);
+        }
+    }
+}
+
+void rpcPrefork::balance(const conn_handler_t& handler)
+{
+    int iLive = 0;
+    int iIdle = 0;
+    int iSpare = -1;
+    for (uint32_t u = 0; u < CFG_VPARPC_PREFORK_SLOTS; u++)
+    {
+        MFW_PREFORK_SLOT_T& slot = m_pBoard->slots[u];
+        if (0 == slot.pid)
+        {
+            continue;
+        }
+        if (0 != slot.uRetire)
+        {
+            retire(u);
+            continue;
+        }
+        iLive++;
+        if (RPCPREFORK_IDLE == get_state(slot))
+        {
+            iIdle++;
+            iSpare = u;
+        }
+    }
+
+    if (iIdle > CFG_VPARPC_PREFORK_MAX_IDLE)
+    {
+        retire(iSpare);
+    }
+
+    int iWant = std::max(CFG_VPARPC_PREFORK_MIN_IDLE - iIdle,
+                         CFG_VPARPC_PREFORK_START - iLive);
+    iWant = std::min(iWant, CFG_VPARPC_PREFORK_MAX - iLive);
+    if (iWant <= 0)
+    {
+        m_iRate = 1;
+        return;
+    }
+    iWant = std::min(iWant, m_iRate);
+    m_iRate = std::min(2 * m_iRate, CFG_VPARPC_PREFORK_MAX);
+    for (uint32_t u = 0; u < CFG_VPARPC_PREFORK_SLOTS && iWant > 0; u++)
+    {
+        MFW_PREFORK_SLOT_T& slot = m_pBoard->slots[u];
+        if (0 == slot.pid && RPCPREFORK_EMPTY == get_state(slot))
+        {
+            if (!spawn(u, handler))
+            {
+                break;
+            }
+            iWant--;
+        }
+    }
+}
+
+/**
+ * The re-executed program inherits the listening socket on standard
+ * input, the blocked signals and the children; every other descriptor
+ * is closed by the exec. It is found by the path this one was started
+ * from: /proc/self/exe itself would lead back to the old binary after an
+ * install has replaced it.
+ */
+void rpcPrefork::reload(char* const argv[])
+{
+    gpSysLog->loginfo("rpcPrefork: reloading");
+    m_pBoard->u64Reloads++;
+    for (uint32_t u = 0; u < CFG_VPARPC_PREFORK_SLOTS; u++)
+    {
+        retire(u);
+    }
+    if (nullptr != argv && STDIN_FILENO == m_fdListen)
+    {
+        char szPath[PATH_MAX];
+        ssize_t n = readlink("/proc/self/exe", szPath, sizeof(szPath) - 1);
+        n = std::max<ssize_t>(n, 0);
+        szPath[n] = 0;
+        static const char szDeleted[] = " (deleted)";
+        size_t stTail = sizeof(szDeleted) - 1;
+        if ((size_t)n > stTail && 0 == strcmp(szPath + n - stTail, szDeleted))
+        {
+            szPath[n - stTail] = 0;
+        }
+        close_range(STDERR_FILENO + 1, ~0U, CLOSE_RANGE_CLOEXEC);
+        execv(szPath, argv);
+        gpSysLog->loginfo("rpcPrefork: cannot re-execute, workers replaced");
+    }
+    m_pBoard->uGeneration++;
+    m_iRate = CFG_VPARPC_PREFORK_START;
+}
+
+/**
+ * Workers get CFG_VPARPC_KEEPALIVE_MS to answer what they hold, and are
+ * then killed.
+ */
+void rpcPrefork::drain()
+{
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGCHLD);
+    auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::milliseconds(CFG_VPARPC_KEEPALIVE_MS);
+    for (;;)
+    {
+        reap();
+        bool bLive = false;
+        for (uint32_t u = 0; u < CFG_VPARPC_PREFORK_SLOTS; u++)
+        {
+            if (0 != m_pBoard->slots[u].pid)
+            {
+                bLive = true;
+                if (std::chrono::steady_clock::now() < deadline)
+                {
+                    retire(u);
+                }
+                else if (is_child(m_pBoard->slots[u].pid))
+                {
+                    kill(m_pBoard->slots[u].pid, SIGKILL);
+                }
+            }
+        }
+        if (!bLive)
+        {
+            return;
+        }
+        struct timespec ts = {1, 0};
+        sigtimedwait(&set, nullptr, &ts);
+    }
+}
+
+/**
+ * The signals the master acts on are blocked and taken synchronously
+ * with sigtimedwait(), which doubles as the once-a-second tick. Their
+ * dispositions are reset first, since one that is ignored is discarded
+ * rather than left pending, and xinetd or nohup may have ignored it.
+ */
+int rpcPrefork::run(const conn_handler_t& handler, char* const argv[])
+{
+    sigset_t set;
+    sigemptyset(&set);
+    for (int iSig : {SIGCHLD, SIGHUP, SIGTERM, SIGINT})
+    {
+        signal(iSig, SIG_DFL);
+        sigaddset(&set, iSig);
+    }
+    sigprocmask(SIG_BLOCK, &set, nullptr);
+
+    std::string ssMsg = "rpcPrefork: master " + std::to_string(getpid()) +
+        ", generation " + std::to_string(m_pBoard->uGeneration);
+    gpSysLog->loginfo(ssMsg.c_str());
+
+    reap();
+    balance(handler);
+    auto next = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    for (;;)
+    {
+        struct timespec ts = {1, 0};
+        int iSig = sigtimedwait(&set, nullptr, &ts);
+        reap();
+        if (SIGTERM == iSig || SIGINT == iSig)
+        {
+            break;
+        }
+        if (SIGHUP == iSig)
+        {
+            reload(argv);
+        }
+        if (std::chrono::steady_clock::now() >= next)
+        {
+            balance(handler);
+            next = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        }
+    }
+
+    gpSysLog->loginfo("rpcPrefork: stopping");
+    drain();
+    return 0;
+}
+
+//////////////////////////
+// eof - rpcPrefork.cpp //
+//////////////////////////
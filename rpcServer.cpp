@@ -0,0 +1,1075 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/rpcServer.cpp 2026-10-17 17:50 dwg -          //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#include "mwfw2.h"
+
+#define RPC_EVENTS_MAX 256
+#define RPC_EXPIRE_MS  250      // how often the reactor looks for timeouts
+
+// The low bits of an io_uring user_data say which operation of a
+// connection completed; rpc_conn_t is at least 8-byte aligned.
+#define RPC_OP_READ    1
+#define RPC_OP_WRITE   2
+#define RPC_OP_MASK    3
+
+enum rpc_conn_state_t
+{
+    RPC_CONN_READING = 0,       // reactor, waiting for the request
+    RPC_CONN_PROCESSING,        // queued for or held by a worker
+    RPC_CONN_WRITING            // reactor, waiting to send the rest
+};
+
+/**
+ * One accepted connection. Only the reactor changes eState. While it is
+ * RPC_CONN_PROCESSING the rest belongs to a worker; the two queues, under
+ * m_queueLock, are where it changes hands.
+ */
+struct rpc_conn_t
+{
+    int fd;
+    rpc_conn_state_t eState;
+    size_t stHave;              // request bytes received
+    size_t stReply;             // reply length, once processed
+    size_t stSent;              // reply bytes sent
+    std::chrono::steady_clock::time_point deadline;
+    char* pBuffer;              // storage, or a slot of the uring arena
+    std::vector<char> storage;
+    std::vector<char> carry;    // bytes of the next request, if pipelined
+    int iSlot;                  // the arena slot, or -1
+    int iInflight;              // io_uring operations not yet completed
+    bool bClosed;               // shut down, freed once iInflight is 0
+    bool bReadQueued;           // a read is linked behind the last write
+    bool bTrusted;              // a local peer vouched for by SO_PEERCRED
+};
+
+// Epoll data, or io_uring user_data, for what is not a connection.
+static char gcListenTag;
+static char gcWakeTag;
+static char gcExpireTag;
+
+// Whether the request a worker is running came from a trusted peer.
+static thread_local bool gbPeerTrusted = false;
+
+static std::chrono::steady_clock::time_point io_deadline()
+{
+    return std::chrono::steady_clock::now() +
+           std::chrono::milliseconds(CFG_VPARPC_IO_TIMEOUT_MS);
+}
+
+rpcServer::rpcServer(size_t stMaxMessage, framer_t framer,
+                     handler_t handler)
+    : m_stMaxMessage(stMaxMessage),
+      m_framer(std::move(framer)),
+      m_handler(std::move(handler)),
+      m_fdListen(-1),
+      m_gidTrusted((gid_t)-1),
+      m_bStop(false),
+      m_eBackend(RPC_BACKEND_EPOLL),
+      m_pRing(nullptr),
+      m_bMultishot(true),
+      m_u64Wake(0),
+      m_tsExpire({0, RPC_EXPIRE_MS * 1000000LL})
+{
+    m_fdEpoll = epoll_create1(EPOLL_CLOEXEC);
+    m_fdWake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (-1 == m_fdEpoll || -1 == m_fdWake)
+    {
+        throw std::system_error(errno, std::system_category(),
+                                "rpcServer: epoll setup failed");
+    }
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.ptr = &gcWakeTag;
+    epoll_ctl(m_fdEpoll, EPOLL_CTL_ADD, m_fdWake, &ev);
+}
+
+rpcServer::~rpcServer()
+{
+    if (-1 != m_fdListen)
+    {
+        close(m_fdListen);
+    }
+    if (!m_ssUnixPath.empty())
+    {
+        unlink(m_ssUnixPath.c_str());
+    }
+    close(m_fdWake);
+    close(m_fdEpoll);
+}
+
+bool rpcServer::listen(int iPort, int iBacklog)
+{
+    m_fdListen = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                        0);
+    if (-1 == m_fdListen)
+    {
+        return false;
+    }
+
+    int opt = 1;
+    setsockopt(m_fdListen, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_port = htons(iPort);
+    if (-1 == bind(m_fdListen, (struct sockaddr*)&addr, sizeof(addr)) ||
+        -1 == ::listen(m_fdListen, iBacklog))
+    {
+        int iErr = errno;
+        close(m_fdListen);
+        m_fdListen = -1;
+        errno = iErr;
+        return false;
+    }
+
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.ptr = &gcListenTag;
+    return 0 == epoll_ctl(m_fdEpoll, EPOLL_CTL_ADD, m_fdListen, &ev);
+}
+
+/**
+ * The socket is left writable by everyone: connecting proves nothing,
+ * SO_PEERCRED does, and an untrusted peer can still authenticate with the
+ * PSK as over TCP. A socket left behind by a server that died is removed
+ * first, but one that still answers is not taken over.
+ */
+bool rpcServer::listen_unix(const std::string& ssPath, int iBacklog)
+{
+    struct sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (ssPath.size() >= sizeof(addr.sun_path))
+    {
+        errno = ENAMETOOLONG;
+        return false;
+    }
+    memcpy(addr.sun_path, ssPath.c_str(), ssPath.size() + 1);
+
+    m_fdListen = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                        0);
+    if (-1 == m_fdListen)
+    {
+        return false;
+    }
+    if (0 == connect(m_fdListen, (struct sockaddr*)&addr, sizeof(addr)))
+    {
+        close(m_fdListen);
+        m_fdListen = -1;
+        errno = EADDRINUSE;
+        return false;
+    }
+    unlink(ssPath.c_str());
+
+    if (-1 == bind(m_fdListen, (struct sockaddr*)&addr, sizeof(addr)) ||
+        -1 == chmod(ssPath.c_str(), 0666) ||
+        -1 == ::listen(m_fdListen, iBacklog))
+    {
+        int iErr = errno;
+        close(m_fdListen);
+        m_fdListen = -1;
+        errno = iErr;
+        return false;
+    }
+    m_ssUnixPath = ssPath;
+
+    struct group* pGroup = getgrnam(CFG_VPARPC_UNIX_GROUP);
+    if (nullptr != pGroup)
+    {
+        m_gidTrusted = pGroup->gr_gid;
+    }
+
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.ptr = &gcListenTag;
+    return 0 == epoll_ctl(m_fdEpoll, EPOLL_CTL_ADD, m_fdListen, &ev);
+}
+
+bool rpcServer::peer_trusted()
+{
+    return gbPeerTrusted;
+}
+
+void rpcServer::set_peer_trusted(bool bTrusted)
+{
+    gbPeerTrusted = bTrusted;
+}
+
+/**
+ * Root, the server's own user and the members of CFG_VPARPC_UNIX_GROUP,
+ * as the kernel recorded them when the peer connected. SO_PEERCRED
+ * carries only the peer's primary gid, so a peer that is in the group
+ * as a supplementary member is looked up in the group database.
+ */
+bool rpcServer::trusted(int fd) const
+{
+    struct ucred cred = {};
+    socklen_t len = sizeof(cred);
+    if (-1 == getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len))
+    {
+        return false;
+    }
+    if (0 == cred.uid || geteuid() == cred.uid)
+    {
+        return true;
+    }
+    if ((gid_t)-1 == m_gidTrusted)
+    {
+        return false;
+    }
+    if (m_gidTrusted == cred.gid)
+    {
+        return true;
+    }
+
+    struct passwd pw;
+    struct passwd* pPw = nullptr;
+    char szBuf[4096];
+    if (0 != getpwuid_r(cred.uid, &pw, szBuf, sizeof(szBuf), &pPw) ||
+        nullptr == pPw)
+    {
+        return false;
+    }
+    int iGroups = 64;
+    std::vector<gid_t> vGroups(iGroups);
+    if (-1 == getgrouplist(pPw->pw_name, cred.gid, vGroups.data(), &iGroups))
+    {
+        vGroups.resize(iGroups);
+        if (-1 == getgrouplist(pPw->pw_name, cred.gid, vGroups.data(),
+                               &iGroups))
+        {
+            return false;
+        }
+    }
+    vGroups.resize(iGroups);
+    return vGroups.end() !=
+           std::find(vGroups.begin(), vGroups.end(), m_gidTrusted);
+}
+
+void rpcServer::run(int iWorkers, rpc_backend_t eBackend)
+{
+    if (iWorkers <= 0)
+    {
+        iWorkers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    m_eBackend = RPC_BACKEND_EPOLL;
+    if (RPC_BACKEND_URING == eBackend)
+    {
+        if (uring_setup())
+        {
+            m_eBackend = RPC_BACKEND_URING;
+        }
+        else
+        {
+            gpSysLog->loginfo("rpcServer: io_uring unusable, using epoll");
+        }
+    }
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < iWorkers; i++)
+    {
+        workers.emplace_back(&rpcServer::worker, this);
+    }
+
+    if (RPC_BACKEND_URING == m_eBackend)
+    {
+        run_uring();
+    }
+    else
+    {
+        run_epoll();
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_queueLock);
+        m_queueCond.notify_all();
+    }
+    for (auto& thread : workers)
+    {
+        thread.join();
+    }
+
+    if (RPC_BACKEND_URING == m_eBackend)
+    {
+        // Closing the ring cancels whatever is in flight, after which
+        // nothing refers to a connection or the arena any more.
+        delete m_pRing;
+        m_pRing = nullptr;
+        m_ready.clear();
+        m_done.clear();
+        while (!m_conns.empty())
+        {
+            free_conn(*m_conns.begin());
+        }
+        m_arena.clear();
+        m_arena.shrink_to_fit();
+        m_freeSlots.clear();
+        return;
+    }
+
+    drain_done();
+    for (rpc_conn_t* pConn : m_ready)
+    {
+        close(pConn->fd);
+        m_conns.erase(pConn);
+        delete pConn;
+    }
+    m_ready.clear();
+    for (rpc_conn_t* pConn : m_conns)
+    {
+        close(pConn->fd);
+        delete pConn;
+    }
+    m_conns.clear();
+}
+
+/**
+ * The epoll reactor loop. Connection events are one-shot, so each is
+ * delivered once and the connection stays quiet until it is explicitly
+ * re-armed.
+ */
+void rpcServer::run_epoll()
+{
+    struct epoll_event events[RPC_EVENTS_MAX];
+    auto nextExpire = std::chrono::steady_clock::now();
+    while (!m_bStop.load(std::memory_order_acquire))
+    {
+        int iCount = epoll_wait(m_fdEpoll, events, RPC_EVENTS_MAX,
+                                RPC_EXPIRE_MS);
+        for (int i = 0; i < iCount; i++)
+        {
+            void* pTag = events[i].data.ptr;
+            if (&gcListenTag == pTag)
+            {
+                accept_all();
+            }
+            else if (&gcWakeTag == pTag)
+            {
+                uint64_t u64Count;
+                while (read(m_fdWake, &u64Count, sizeof(u64Count)) > 0)
+                {
+                }
+                drain_done();
+            }
+            else
+            {
+                auto* pConn = (rpc_conn_t*)pTag;
+                if (RPC_CONN_READING == pConn->eState)
+                {
+                    on_readable(pConn);
+                }
+                else
+                {
+                    on_writable(pConn);
+                }
+            }
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now >= nextExpire)
+        {
+            expire();
+            nextExpire = now + std::chrono::milliseconds(RPC_EXPIRE_MS);
+        }
+    }
+}
+
+void rpcServer::stop()
+{
+    m_bStop.store(true, std::memory_order_release);
+    uint64_t u64One = 1;
+    ssize_t n = write(m_fdWake, &u64One, sizeof(u64One));
+    (void)n;
+}
+
+/**
+ * Accepts until the backlog is empty. Beyond CFG_VPARPC_MAX_CONNS new
+ * peers are closed at once, so an overload costs them a retry rather
+ * than costing everyone their latency.
+ */
+void rpcServer::accept_all()
+{
+    static shm_counter accepted("rpc.accepted");
+    static shm_counter shed("rpc.shed");
+
+    for (;;)
+    {
+        int fd = accept4(m_fdListen, nullptr, nullptr,
+                         SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (-1 == fd)
+        {
+            if (EINTR == errno || ECONNABORTED == errno)
+            {
+                continue;
+            }
+            // EAGAIN: drained. EMFILE and the like: the next epoll_wait
+            // reports the listener again and we retry then.
+            return;
+        }
+        if (m_conns.size() >= CFG_VPARPC_MAX_CONNS)
+        {
+            close(fd);
+            shed.add();
+            continue;
+        }
+        accepted.add();
+
+        rpc_conn_t* pConn = new_conn(fd);
+        struct epoll_event ev = {};
+        ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+        ev.data.ptr = pConn;
+        if (-1 == epoll_ctl(m_fdEpoll, EPOLL_CTL_ADD, fd, &ev))
+        {
+            close_conn(pConn);
+        }
+    }
+}
+
+/**
+ * Sets up a connection that has just been accepted, with its buffer in
+ * the arena if io_uring is in use.
+ */
+rpc_conn_t* rpcServer::new_conn(int fd)
+{
+    auto* pConn = new rpc_conn_t;
+    pConn->fd = fd;
+    pConn->eState = RPC_CONN_READING;
+    pConn->stHave = 0;
+    pConn->stReply = 0;
+    pConn->stSent = 0;
+    pConn->deadline = io_deadline();
+    pConn->iInflight = 0;
+    pConn->bClosed = false;
+    pConn->bReadQueued = false;
+    pConn->bTrusted = !m_ssUnixPath.empty() && trusted(fd);
+    if (nullptr != m_pRing)
+    {
+        pConn->iSlot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        pConn->pBuffer = m_arena.data() +
+                         pConn->iSlot * (m_arena.size() / CFG_VPARPC_MAX_CONNS);
+    }
+    else
+    {
+        pConn->iSlot = -1;
+        pConn->storage.assign(m_stMaxMessage, 0);
+        pConn->pBuffer = pConn->storage.data();
+    }
+    m_conns.insert(pConn);
+    return pConn;
+}
+
+/**
+ * Hands the request at the front of the buffer to the workers if it is
+ * complete. Bytes past its end already belong to the next request and
+ * are set aside in carry until the reply has gone.
+ *
+ * @return 1 if the request was queued, 0 if more bytes are needed, or
+ *         -1 if the connection was closed as malformed.
+ */
+int rpcServer::dispatch(rpc_conn_t* pConn)
+{
+    static shm_counter malformed("rpc.malformed");
+
+    ssize_t iWant = m_framer(pConn->pBuffer, pConn->stHave);
+    if (iWant < 0 || (size_t)iWant > m_stMaxMessage ||
+        (0 == iWant && pConn->stHave == m_stMaxMessage))
+    {
+        malformed.add();
+        close_conn(pConn);
+        return -1;
+    }
+    if (0 == iWant || pConn->stHave < (size_t)iWant)
+    {
+        return 0;
+    }
+
+    pConn->carry.assign(pConn->pBuffer + iWant,
+                        pConn->pBuffer + pConn->stHave);
+    pConn->stHave = iWant;
+    std::lock_guard<std::mutex> guard(m_queueLock);
+    pConn->eState = RPC_CONN_PROCESSING;
+    m_ready.push_back(pConn);
+    m_queueCond.notify_one();
+    return 1;
+}
+
+/**
+ * Reads whatever has arrived. A complete request goes to the workers; a
+ * partial one re-arms the connection; anything else closes it.
+ */
+void rpcServer::on_readable(rpc_conn_t* pConn)
+{
+    for (;;)
+    {
+        ssize_t n = recv(pConn->fd, pConn->pBuffer + pConn->stHave,
+                         m_stMaxMessage - pConn->stHave, 0);
+        if (n > 0)
+        {
+            if (0 == pConn->stHave)
+            {
+                pConn->deadline = io_deadline();    // a request has begun
+            }
+            pConn->stHave += n;
+            if (0 != dispatch(pConn))
+            {
+                return;
+            }
+            continue;
+        }
+        if (-1 == n && EINTR == errno)
+        {
+            continue;
+        }
+        if (-1 == n && (EAGAIN == errno || EWOULDBLOCK == errno))
+        {
+            arm(pConn, EPOLLIN | EPOLLRDHUP);
+            return;
+        }
+        close_conn(pConn);      // orderly close or error
+        return;
+    }
+}
+
+void rpcServer::on_writable(rpc_conn_t* pConn)
+{
+    while (pConn->stSent < pConn->stReply)
+    {
+        ssize_t n = send(pConn->fd, pConn->pBuffer + pConn->stSent,
+                         pConn->stReply - pConn->stSent, MSG_NOSIGNAL);
+        if (n > 0)
+        {
+            pConn->stSent += n;
+            continue;
+        }
+        if (-1 == n && EINTR == errno)
+        {
+            continue;
+        }
+        if (-1 == n && (EAGAIN == errno || EWOULDBLOCK == errno))
+        {
+            arm(pConn, EPOLLOUT);
+            return;
+        }
+        close_conn(pConn);
+        return;
+    }
+    next_request(pConn);
+}
+
+/**
+ * Keeps the connection open for another request once a reply has gone.
+ * A pipelined request that is already in carry is dispatched at once;
+ * otherwise the peer has CFG_VPARPC_KEEPALIVE_MS to start one.
+ */
+void rpcServer::next_request(rpc_conn_t* pConn)
+{
+    pConn->eState = RPC_CONN_READING;
+    pConn->stReply = 0;
+    pConn->stSent = 0;
+    pConn->stHave = pConn->carry.size();
+    if (0 != pConn->stHave)
+    {
+        memcpy(pConn->pBuffer, pConn->carry.data(), pConn->stHave);
+        pConn->carry.clear();
+        pConn->deadline = io_deadline();
+        if (0 != dispatch(pConn))
+        {
+            return;
+        }
+    }
+    else
+    {
+        pConn->deadline = std::chrono::steady_clock::now() +
+                          std::chrono::milliseconds(CFG_VPARPC_KEEPALIVE_MS);
+    }
+    if (nullptr != m_pRing)
+    {
+        uring_read(pConn);
+    }
+    else
+    {
+        arm(pConn, EPOLLIN | EPOLLRDHUP);
+    }
+}
+
+/**
+ * Takes back the connections the workers have finished with. Most have
+ * already sent their whole reply and go straight back to reading.
+ */
+void rpcServer::drain_done()
+{
+    std::deque<rpc_conn_t*> done;
+    {
+        std::lock_guard<std::mutex> guard(m_queueLock);
+        done.swap(m_done);
+    }
+    for (rpc_conn_t* pConn : done)
+    {
+        pConn->eState = RPC_CONN_WRITING;
+        pConn->deadline = io_deadline();
+        on_writable(pConn);
+    }
+}
+
+/**
+ * Closes connections whose current transfer or keep-alive wait has
+ * outlived its deadline. Connections held by the workers are left alone.
+ */
+void rpcServer::expire()
+{
+    static shm_counter timeouts("rpc.timeouts");
+
+    auto now = std::chrono::steady_clock::now();
+    std::vector<rpc_conn_t*> expired;
+    for (rpc_conn_t* pConn : m_conns)
+    {
+        if (RPC_CONN_PROCESSING != pConn->eState && !pConn->bClosed &&
+            now > pConn->deadline)
+        {
+            expired.push_back(pConn);
+        }
+    }
+    for (rpc_conn_t* pConn : expired)
+    {
+        // An idle keep-alive connection simply ends; only a transfer
+        // that stalled part way counts as a timeout.
+        if (RPC_CONN_READING != pConn->eState || 0 != pConn->stHave)
+        {
+            timeouts.add();
+        }
+        close_conn(pConn);
+    }
+}
+
+void rpcServer::arm(rpc_conn_t* pConn, uint32_t uEvents)
+{
+    struct epoll_event ev = {};
+    ev.events = uEvents | EPOLLONESHOT;
+    ev.data.ptr = pConn;
+    if (-1 == epoll_ctl(m_fdEpoll, EPOLL_CTL_MOD, pConn->fd, &ev))
+    {
+        close_conn(pConn);
+    }
+}
+
+/**
+ * With io_uring, operations still in flight refer to the buffer, so the
+ * socket is only shut down here, which makes them complete, and the last
+ * completion frees the connection.
+ */
+void rpcServer::close_conn(rpc_conn_t* pConn)
+{
+    if (nullptr == m_pRing)
+    {
+        free_conn(pConn);
+        return;
+    }
+    if (!pConn->bClosed)
+    {
+        pConn->bClosed = true;
+        shutdown(pConn->fd, SHUT_RDWR);
+    }
+    if (0 == pConn->iInflight)
+    {
+        free_conn(pConn);
+    }
+}
+
+/**
+ * Closing the descriptor also removes it from the epoll set.
+ */
+void rpcServer::free_conn(rpc_conn_t* pConn)
+{
+    close(pConn->fd);
+    if (-1 != pConn->iSlot)
+    {
+        m_freeSlots.push_back(pConn->iSlot);
+    }
+    m_conns.erase(pConn);
+    delete pConn;
+}
+
+/**
+ * Sets up the ring and registers the arena, one slot of it for each
+ * connection there may be. Any failure leaves the server on epoll.
+ */
+bool rpcServer::uring_setup()
+{
+    if (-1 == m_fdListen || !rpcUring::supported())
+    {
+        return false;
+    }
+    size_t stSlot = (m_stMaxMessage + 63) & ~(size_t)63;
+    m_pRing = new rpcUring();
+    m_arena.assign(stSlot * CFG_VPARPC_MAX_CONNS, 0);
+    if (!m_pRing->setup(CFG_VPARPC_URING_ENTRIES) ||
+        !m_pRing->register_buffer(m_arena.data(), m_arena.size()))
+    {
+        delete m_pRing;
+        m_pRing = nullptr;
+        m_arena.clear();
+        m_arena.shrink_to_fit();
+        return false;
+    }
+    m_freeSlots.clear();
+    for (int i = CFG_VPARPC_MAX_CONNS - 1; i >= 0; i--)
+    {
+        m_freeSlots.push_back(i);
+    }
+    m_bMultishot = true;
+    return true;
+}
+
+/**
+ * The io_uring reactor loop. Everything queued while handling the last
+ * completions is submitted by the same io_uring_enter() that waits for
+ * the next one.
+ */
+void rpcServer::run_uring()
+{
+    uring_accept();
+    uring_arm_wake();
+    uring_arm_expire();
+    while (!m_bStop.load(std::memory_order_acquire))
+    {
+        if (-1 == m_pRing->submit(1) && EBUSY != errno)
+        {
+            gpSysLog->loginfo("rpcServer: io_uring_enter failed");
+            return;
+        }
+        struct io_uring_cqe cqe;
+        while (m_pRing->cqe(cqe))
+        {
+            uring_event(cqe);
+        }
+    }
+}
+
+/**
+ * One accept serves every new peer until the kernel ends it, which a
+ * kernel older than 5.19 does at once with EINVAL; single accepts are
+ * used from then on.
+ */
+void rpcServer::uring_accept()
+{
+    struct io_uring_sqe* pSqe = m_pRing->sqe();
+    if (nullptr == pSqe)
+    {
+        return;
+    }
+    pSqe->opcode = IORING_OP_ACCEPT;
+    pSqe->fd = m_fdListen;
+    pSqe->accept_flags = SOCK_CLOEXEC;
+    pSqe->ioprio = m_bMultishot ? IORING_ACCEPT_MULTISHOT : 0;
+    pSqe->user_data = (uint64_t)&gcListenTag;
+}
+
+void rpcServer::uring_read(rpc_conn_t* pConn)
+{
+    struct io_uring_sqe* pSqe = m_pRing->sqe();
+    if (nullptr == pSqe)
+    {
+        close_conn(pConn);
+        return;
+    }
+    pSqe->opcode = IORING_OP_READ_FIXED;
+    pSqe->fd = pConn->fd;
+    pSqe->addr = (uint64_t)(pConn->pBuffer + pConn->stHave);
+    pSqe->len = m_stMaxMessage - pConn->stHave;
+    pSqe->buf_index = 0;
+    pSqe->user_data = (uint64_t)pConn | RPC_OP_READ;
+    pConn->iInflight++;
+}
+
+/**
+ * Sends the rest of the reply. Unless the next request has already
+ * arrived, the read for it is linked behind the write, so the kernel
+ * starts it as soon as the reply is out. Both entries are reserved
+ * before either is filled, so the pair reaches the kernel together; if
+ * there is no room for both the write goes alone and uring_on_write()
+ * queues the read. A short write breaks the link: the read completes
+ * with ECANCELED and is queued again with the rest.
+ */
+void rpcServer::uring_write(rpc_conn_t* pConn)
+{
+    bool bLink = pConn->carry.empty() && m_pRing->reserve(2);
+    struct io_uring_sqe* pSqe = m_pRing->sqe();
+    if (nullptr == pSqe)
+    {
+        close_conn(pConn);
+        return;
+    }
+    pSqe->opcode = IORING_OP_WRITE_FIXED;
+    pSqe->fd = pConn->fd;
+    pSqe->addr = (uint64_t)(pConn->pBuffer + pConn->stSent);
+    pSqe->len = pConn->stReply - pConn->stSent;
+    pSqe->buf_index = 0;
+    pSqe->user_data = (uint64_t)pConn | RPC_OP_WRITE;
+    pConn->iInflight++;
+    pConn->bReadQueued = bLink;
+    if (!bLink)
+    {
+        return;
+    }
+
+    struct io_uring_sqe* pRead = m_pRing->sqe();
+    pSqe->flags |= IOSQE_IO_LINK;
+    pRead->opcode = IORING_OP_READ_FIXED;
+    pRead->fd = pConn->fd;
+    pRead->addr = (uint64_t)pConn->pBuffer;
+    pRead->len = m_stMaxMessage;
+    pRead->buf_index = 0;
+    pRead->user_data = (uint64_t)pConn | RPC_OP_READ;
+    pConn->iInflight++;
+}
+
+void rpcServer::uring_event(const struct io_uring_cqe& cqe)
+{
+    if ((uint64_t)&gcListenTag == cqe.user_data)
+    {
+        uring_on_accept(cqe);
+        return;
+    }
+    if ((uint64_t)&gcWakeTag == cqe.user_data)
+    {
+        uring_drain_done();
+        uring_arm_wake();
+        return;
+    }
+    if ((uint64_t)&gcExpireTag == cqe.user_data)
+    {
+        expire();
+        uring_arm_expire();
+        return;
+    }
+
+    auto* pConn = (rpc_conn_t*)(cqe.user_data & ~(uint64_t)RPC_OP_MASK);
+    pConn->iInflight--;
+    if (pConn->bClosed)
+    {
+        close_conn(pConn);
+    }
+    else if (RPC_OP_READ == (cqe.user_data & RPC_OP_MASK))
+    {
+        uring_on_read(pConn, cqe.res);
+    }
+    else
+    {
+        uring_on_write(pConn, cqe.res);
+    }
+}
+
+/**
+ * Beyond CFG_VPARPC_MAX_CONNS new peers are closed at once, as in
+ * accept_all().
+ */
+void rpcServer::uring_on_accept(const struct io_uring_cqe& cqe)
+{
+    static shm_counter accepted("rpc.accepted");
+    static shm_counter shed("rpc.shed");
+
+    if (cqe.res >= 0)
+    {
+        if (m_conns.size() >= CFG_VPARPC_MAX_CONNS || m_freeSlots.empty())
+        {
+            close(cqe.res);
+            shed.add();
+        }
+        else
+        {
+            accepted.add();
+            uring_read(new_conn(cqe.res));
+        }
+    }
+    else if (-EINVAL == cqe.res && m_bMultishot)
+    {
+        m_bMultishot = false;
+    }
+    if (0 == (cqe.flags & IORING_CQE_F_MORE))
+    {
+        uring_accept();
+    }
+}
+
+/**
+ * The counterpart of on_readable(). ECANCELED is a read that was linked
+ * to a write cut short; uring_on_write() has queued another.
+ */
+void rpcServer::uring_on_read(rpc_conn_t* pConn, int iResult)
+{
+    if (-ECANCELED == iResult)
+    {
+        return;
+    }
+    if (iResult <= 0)
+    {
+        close_conn(pConn);      // orderly close or error
+        return;
+    }
+    if (0 == pConn->stHave)
+    {
+        pConn->deadline = io_deadline();    // a request has begun
+    }
+    pConn->stHave += iResult;
+    if (0 == dispatch(pConn))
+    {
+        uring_read(pConn);
+    }
+}
+
+/**
+ * Once the whole reply is out the connection waits for the next request,
+ * whose read is linked behind the write, queued here if there was no
+ * room to link it, or, if the request is already in carry, not needed.
+ */
+void rpcServer::uring_on_write(rpc_conn_t* pConn, int iResult)
+{
+    if (iResult <= 0)
+    {
+        close_conn(pConn);
+        return;
+    }
+    pConn->stSent += iResult;
+    if (pConn->stSent < pConn->stReply)
+    {
+        uring_write(pConn);
+        return;
+    }
+    if (!pConn->carry.empty())
+    {
+        next_request(pConn);
+        return;
+    }
+    pConn->eState = RPC_CONN_READING;
+    pConn->stReply = 0;
+    pConn->stSent = 0;
+    pConn->stHave = 0;
+    pConn->deadline = std::chrono::steady_clock::now() +
+                      std::chrono::milliseconds(CFG_VPARPC_KEEPALIVE_MS);
+    if (!pConn->bReadQueued)
+    {
+        uring_read(pConn);
+    }
+}
+
+/**
+ * The counterpart of drain_done(); the workers have sent nothing.
+ */
+void rpcServer::uring_drain_done()
+{
+    std::deque<rpc_conn_t*> done;
+    {
+        std::lock_guard<std::mutex> guard(m_queueLock);
+        done.swap(m_done);
+    }
+    for (rpc_conn_t* pConn : done)
+    {
+        pConn->eState = RPC_CONN_WRITING;
+        pConn->deadline = io_deadline();
+        if (0 == pConn->stReply)
+        {
+            next_request(pConn);
+        }
+        else
+        {
+            uring_write(pConn);
+        }
+    }
+}
+
+void rpcServer::uring_arm_wake()
+{
+    struct io_uring_sqe* pSqe = m_pRing->sqe();
+    if (nullptr == pSqe)
+    {
+        return;
+    }
+    pSqe->opcode = IORING_OP_READ;
+    pSqe->fd = m_fdWake;
+    pSqe->addr = (uint64_t)&m_u64Wake;
+    pSqe->len = sizeof(m_u64Wake);
+    pSqe->user_data = (uint64_t)&gcWakeTag;
+}
+
+void rpcServer::uring_arm_expire()
+{
+    struct io_uring_sqe* pSqe = m_pRing->sqe();
+    if (nullptr == pSqe)
+    {
+        return;
+    }
+    pSqe->opcode = IORING_OP_TIMEOUT;
+    pSqe->fd = -1;
+    pSqe->addr = (uint64_t)&m_tsExpire;
+    pSqe->len = 1;
+    pSqe->user_data = (uint64_t)&gcExpireTag;
+}
+
+/**
+ * Runs requests until stop(). The eventfd is written only when the done
+ * queue goes from empty to non-empty, so a busy reactor is woken once
+ * per batch rather than once per reply.
+ */
+void rpcServer::worker()
+{
+    for (;;)
+    {
+        rpc_conn_t* pConn;
+        {
+            std::unique_lock<std::mutex> lock(m_queueLock);
+            m_queueCond.wait(lock, [this] {
+                return !m_ready.empty() ||
+                       m_bStop.load(std::memory_order_acquire);
+            });
+            if (m_bStop.load(std::memory_order_acquire))
+            {
+                return;
+            }
+            pConn = m_ready.front();
+            m_ready.pop_front();
+        }
+
+        gbPeerTrusted = pConn->bTrusted;
+        pConn->stReply = m_handler(pConn->pBuffer, pConn->stHave,
+                                   m_stMaxMessage);
+        gbPeerTrusted = false;
+        pConn->stSent = 0;
+        // With io_uring the reactor sends, linked to the next read.
+        while (RPC_BACKEND_EPOLL == m_eBackend &&
+               pConn->stSent < pConn->stReply)
+        {
+            ssize_t n = send(pConn->fd,
+                             pConn->pBuffer + pConn->stSent,
+                             pConn->stReply - pConn->stSent,
+                             MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (n <= 0)
+            {
+                break;          // the reactor finishes or gives up
+            }
+            pConn->stSent += n;
+        }
+
+        bool bWake;
+        {
+            std::lock_guard<std::mutex> guard(m_queueLock);
+            bWake = m_done.empty();
+            m_done.push_back(pConn);
+        }
+        if (bWake)
+        {
+            uint64_t u64One = 1;
+            ssize_t n = write(m_fdWake, &u64One, sizeof(u64One));
+            (void)n;
+        }
+    }
+}
+
+/////////////////////////
+// eof - rpcServer.cpp //
+/////////////////////////
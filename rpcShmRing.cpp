@@ -0,0 +1,622 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/rpcShmRing.cpp 2026-10-17 22:30 dwg -         //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#include "mwfw2.h"
+
+#define OBJ_PERMS (S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP)
+#define RPCSHM_MASK    (CFG_VPARPC_SHM_SLOTS - 1)
+#define RPCSHM_REAP_MS 1000     // how often an idle worker looks for dead callers
+
+// The futexes below never use FUTEX_PRIVATE_FLAG: callers and the server
+// are different processes that map the region at different addresses.
+
+static std::mutex gAttachLock;
+static std::unordered_map<std::string, rpcShmRing*> gAttached;
+
+static void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+static void futex_wake(uint32_t* puWord, int iCount)
+{
+    syscall(SYS_futex, puWord, FUTEX_WAKE, iCount, nullptr, nullptr, 0);
+}
+
+/**
+ * @return -1 with errno ETIMEDOUT once iTimeoutMs has passed.
+ */
+static int futex_wait(uint32_t* puWord, uint32_t uSeen, int iTimeoutMs)
+{
+    struct timespec ts;
+    ts.tv_sec = iTimeoutMs / 1000;
+    ts.tv_nsec = (iTimeoutMs % 1000) * 1000000L;
+    return (int)syscall(SYS_futex, puWord, FUTEX_WAIT, uSeen, &ts,
+                        nullptr, 0);
+}
+
+static std::string object_name(const std::string& ssRing)
+{
+    return "/fw_vparpc_" + ssRing + ".v" + std::to_string(RPCSHM_VERSION);
+}
+
+/**
+ * Whether a ring object may be mapped: it must belong to root, to this
+ * process's user or to the user that owns CFG_VPARPC_UNIX_DIR, which is
+ * where the local servers live, and nobody else may write to it. Any
+ * other owner could have planted it to read or answer our requests.
+ */
+static bool trusted_object(const struct stat& st)
+{
+    if (st.st_mode & S_IWOTH)
+    {
+        return false;
+    }
+    if (0 == st.st_uid || geteuid() == st.st_uid)
+    {
+        return true;
+    }
+    struct stat stDir = {};
+    return 0 == stat(CFG_VPARPC_UNIX_DIR, &stDir) &&
+           stDir.st_uid == st.st_uid;
+}
+
+/**
+ * Maps a ring object if it passes trusted_object() and is large enough.
+ *
+ * @return The mapping, or nullptr.
+ */
+static MFW_RPCSHM_T* map_object(const std::string& ssObject)
+{
+    int fd = shm_open(ssObject.c_str(), O_RDWR, 0);
+    if (-1 == fd)
+    {
+        return nullptr;
+    }
+    struct stat st = {};
+    void* pMap = MAP_FAILED;
+    if (0 == fstat(fd, &st) && trusted_object(st) &&
+        (size_t)st.st_size >= sizeof(MFW_RPCSHM_T))
+    {
+        pMap = mmap(nullptr, sizeof(MFW_RPCSHM_T), PROT_READ | PROT_WRITE,
+                    MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    return (MAP_FAILED == pMap) ? nullptr : (MFW_RPCSHM_T*)pMap;
+}
+
+/**
+ * Fails the calls in flight on a ring that is being replaced: it is
+ * marked unused, so callers drop their mapping of it, and sleeping
+ * callers are woken to find that their epoch has gone.
+ */
+static void retire(MFW_RPCSHM_T* pRing)
+{
+    std::atomic_ref<uint32_t>(pRing->uState).store(
+        RPCSHM_UNUSED, std::memory_order_release);
+    std::atomic_ref<uint32_t>(pRing->uEpoch).fetch_add(1);
+    for (uint32_t u = 0; u < CFG_VPARPC_SHM_SLOTS; u++)
+    {
+        futex_wake(&pRing->slots[u].uState, INT_MAX);
+    }
+}
+
+/**
+ * The object is always created afresh with O_EXCL, never adopted: one
+ * that some other user created first could be mapped by them too, and
+ * ring requests are trusted. An older ring we own is retired before it
+ * is unlinked. The new region is formatted before it is published as
+ * RPCSHM_READY, so a caller attaching meanwhile waits for it.
+ */
+rpcShmRing::rpcShmRing(const std::string& ssName)
+    : m_pRing(nullptr), m_bStop(false),
+      m_bSpin(std::thread::hardware_concurrency() > 1)
+{
+    std::string ssObject = object_name(ssName);
+    MFW_RPCSHM_T* pOld = map_object(ssObject);
+    if (nullptr != pOld)
+    {
+        retire(pOld);
+        munmap(pOld, sizeof(MFW_RPCSHM_T));
+    }
+    shm_unlink(ssObject.c_str());
+
+    int fd = shm_open(ssObject.c_str(), O_RDWR | O_CREAT | O_EXCL,
+                      OBJ_PERMS);
+    if (-1 == fd)
+    {
+        throw std::system_error(errno, std::system_category(),
+                                "rpcShmRing: shm_open failed");
+    }
+    const char* pszFailed = nullptr;
+    struct group* pGroup = getgrnam(CFG_VPARPC_UNIX_GROUP);
+    struct stat st = {};
+    if (-1 == fchmod(fd, OBJ_PERMS))
+    {
+        pszFailed = "rpcShmRing: fchmod failed";
+    }
+    else if (nullptr != pGroup &&
+             -1 == fchown(fd, (uid_t)-1, pGroup->gr_gid))
+    {
+        pszFailed = "rpcShmRing: cannot hand the ring to "
+                    CFG_VPARPC_UNIX_GROUP;
+    }
+    else if (-1 == fstat(fd, &st))
+    {
+        pszFailed = "rpcShmRing: fstat failed";
+    }
+    else if (geteuid() != st.st_uid ||
+             OBJ_PERMS != (st.st_mode & (S_IRWXU | S_IRWXG | S_IRWXO)))
+    {
+        errno = EPERM;
+        pszFailed = "rpcShmRing: the ring has the wrong owner or mode";
+    }
+    else if (-1 == ftruncate(fd, sizeof(MFW_RPCSHM_T)))
+    {
+        pszFailed = "rpcShmRing: ftruncate failed";
+    }
+    if (nullptr != pszFailed)
+    {
+        int iErr = errno;
+        close(fd);
+        shm_unlink(ssObject.c_str());
+        throw std::system_error(iErr, std::system_category(), pszFailed);
+    }
+    void* pMap = mmap(nullptr, sizeof(MFW_RPCSHM_T), PROT_READ | PROT_WRITE,
+                      MAP_SHARED, fd, 0);
+    int iErr = errno;
+    close(fd);
+    if (MAP_FAILED == pMap)
+    {
+        shm_unlink(ssObject.c_str());
+        throw std::system_error(iErr, std::system_category(),
+                                "rpcShmRing: mmap failed");
+    }
+    m_pRing = (MFW_RPCSHM_T*)pMap;
+
+    // ftruncate() zero-filled the region: every slot is FREE and the
+    // epoch 0; only the queue's cells need numbering.
+    m_pRing->uMagic = RPCSHM_MAGIC;
+    m_pRing->uVersion = RPCSHM_VERSION;
+    m_pRing->pidServer = getpid();
+    for (uint32_t u = 0; u < CFG_VPARPC_SHM_SLOTS; u++)
+    {
+        m_pRing->cells[u].u64Seq = u;
+    }
+    std::atomic_ref<uint32_t>(m_pRing->uState).store(
+        RPCSHM_READY, std::memory_order_release);
+}
+
+rpcShmRing::rpcShmRing(MFW_RPCSHM_T* pRing)
+    : m_pRing(pRing), m_bStop(false),
+      m_bSpin(std::thread::hardware_concurrency() > 1)
+{
+}
+
+rpcShmRing::~rpcShmRing()
+{
+    munmap(m_pRing, sizeof(MFW_RPCSHM_T));
+}
+
+bool rpcShmRing::ring_name(const std::string& ssService, std::string& ssRing)
+{
+    static const std::string ssPrefix = CFG_VPARPC_SHM_PREFIX;
+    if (0 != ssService.compare(0, ssPrefix.size(), ssPrefix) ||
+        ssService.size() == ssPrefix.size())
+    {
+        return false;
+    }
+    ssRing = ssService.substr(ssPrefix.size());
+    return true;
+}
+
+/**
+ * A ring that is missing, or not ready, is not remembered, so a server
+ * started later is found by the next call. A remembered ring that a new
+ * server has retired is forgotten the same way; its mapping is kept,
+ * since other threads may still be using it.
+ */
+rpcShmRing* rpcShmRing::attach(const std::string& ssRing)
+{
+    std::lock_guard<std::mutex> lock(gAttachLock);
+    auto it = gAttached.find(ssRing);
+    if (it != gAttached.end())
+    {
+        if (RPCSHM_READY == std::atomic_ref<uint32_t>(
+                it->second->m_pRing->uState).load(std::memory_order_acquire))
+        {
+            return it->second;
+        }
+        gAttached.erase(it);
+    }
+
+    MFW_RPCSHM_T* pRing = map_object(object_name(ssRing));
+    if (nullptr == pRing)
+    {
+        return nullptr;
+    }
+    std::atomic_ref<uint32_t> state(pRing->uState);
+    for (int iMs = 0; iMs < CFG_SHM_READY_TIMEOUT_MS &&
+         RPCSHM_READY != state.load(std::memory_order_acquire); iMs++)
+    {
+        usleep(1000);
+    }
+    if (RPCSHM_READY != state.load(std::memory_order_acquire) ||
+        RPCSHM_MAGIC != pRing->uMagic || RPCSHM_VERSION != pRing->uVersion)
+    {
+        munmap(pRing, sizeof(MFW_RPCSHM_T));
+        return nullptr;
+    }
+    auto* pShmRing = new rpcShmRing(pRing);
+    gAttached[ssRing] = pShmRing;
+    return pShmRing;
+}
+
+MFW_RPCSHM_SLOT_T* rpcShmRing::slot_of(char* pBuffer)
+{
+    return (MFW_RPCSHM_SLOT_T*)(pBuffer -
+                                offsetof(MFW_RPCSHM_SLOT_T, buffer));
+}
+
+/**
+ * Each thread starts its search where it last found a slot, so callers on
+ * different threads mostly claim different slots without contending.
+ */
+char* rpcShmRing::claim()
+{
+    static shm_counter full("rpc.shm.full");
+    static thread_local uint32_t tuHint = (uint32_t)gettid();
+
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(CFG_VPARPC_IO_TIMEOUT_MS);
+    for (;;)
+    {
+        for (uint32_t u = 0; u < CFG_VPARPC_SHM_SLOTS; u++)
+        {
+            uint32_t uSlot = (tuHint + u) & RPCSHM_MASK;
+            MFW_RPCSHM_SLOT_T& slot = m_pRing->slots[uSlot];
+            uint32_t uFree = RPCSHM_SLOT_FREE;
+            if (std::atomic_ref<uint32_t>(slot.uState).compare_exchange_strong(
+                    uFree, RPCSHM_SLOT_CLAIMED, std::memory_order_acquire))
+            {
+                tuHint = uSlot;
+                slot.pidOwner = getpid();
+                slot.uWaiting = 0;
+                slot.uEpoch = std::atomic_ref<uint32_t>(m_pRing->uEpoch).load(
+                    std::memory_order_acquire);
+                return slot.buffer;
+            }
+        }
+        full.add();
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            return nullptr;
+        }
+        usleep(100);
+    }
+}
+
+/**
+ * The enqueue half of the bounded MPMC queue: a cell whose sequence
+ * number equals the tail is empty, and advancing the tail claims it.
+ *
+ * A server that retired the ring since the slot was claimed has moved
+ * the epoch, so the slot is only queued if the ring is still ready, the
+ * epoch has not moved and the slot is still CLAIMED.
+ */
+bool rpcShmRing::submit(char* pBuffer, size_t stLen)
+{
+    MFW_RPCSHM_SLOT_T* pSlot = slot_of(pBuffer);
+    if (RPCSHM_READY != std::atomic_ref<uint32_t>(m_pRing->uState).load(
+            std::memory_order_acquire) ||
+        pSlot->uEpoch != std::atomic_ref<uint32_t>(m_pRing->uEpoch).load(
+            std::memory_order_acquire))
+    {
+        return false;
+    }
+    pSlot->u64Len = stLen;
+    uint32_t uClaimed = RPCSHM_SLOT_CLAIMED;
+    if (!std::atomic_ref<uint32_t>(pSlot->uState).compare_exchange_strong(
+            uClaimed, RPCSHM_SLOT_QUEUED, std::memory_order_release))
+    {
+        return false;
+    }
+
+    std::atomic_ref<uint64_t> tail(m_pRing->u64Tail);
+    uint64_t u64Pos = tail.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        uint64_t u64Seq = std::atomic_ref<uint64_t>(
+            m_pRing->cells[u64Pos & RPCSHM_MASK].u64Seq).load(
+            std::memory_order_acquire);
+        if (u64Seq == u64Pos)
+        {
+            if (tail.compare_exchange_weak(u64Pos, u64Pos + 1,
+                                           std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else
+        {
+            u64Pos = tail.load(std::memory_order_relaxed);
+        }
+    }
+    auto& cell = m_pRing->cells[u64Pos & RPCSHM_MASK];
+    cell.uSlot = pSlot - m_pRing->slots;
+    std::atomic_ref<uint64_t>(cell.u64Seq).store(u64Pos + 1,
+                                                 std::memory_order_release);
+
+    // As in shm_notify: the doorbell moves before uSleepers is read, and
+    // a worker counts itself in uSleepers before it reads the queue.
+    std::atomic_ref<uint32_t>(m_pRing->uDoorbell).fetch_add(1);
+    if (0 != std::atomic_ref<uint32_t>(m_pRing->uSleepers).load())
+    {
+        futex_wake(&m_pRing->uDoorbell, 1);
+    }
+    return true;
+}
+
+/**
+ * Polls, then sleeps on the slot state. A caller that times out abandons
+ * the slot to the server; one whose server reset the ring just leaves it.
+ */
+size_t rpcShmRing::wait(char* pBuffer)
+{
+    static shm_counter timeouts("rpc.shm.timeouts");
+
+    MFW_RPCSHM_SLOT_T* pSlot = slot_of(pBuffer);
+    std::atomic_ref<uint32_t> state(pSlot->uState);
+    std::atomic_ref<uint32_t> waiting(pSlot->uWaiting);
+    std::atomic_ref<uint32_t> epoch(m_pRing->uEpoch);
+    uint32_t uEpoch = pSlot->uEpoch;
+
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(CFG_VPARPC_IO_TIMEOUT_MS);
+    int iSpin = m_bSpin ? CFG_VPARPC_SHM_SPIN : 0;
+    for (;;)
+    {
+        uint32_t uState = state.load(std::memory_order_acquire);
+        if (RPCSHM_SLOT_REPLIED == uState)
+        {
+            size_t stReply = pSlot->u64Len;
+            if (0 == stReply)
+            {
+                release(pBuffer);       // the server refused it
+            }
+            return stReply;
+        }
+        if ((RPCSHM_SLOT_QUEUED != uState && RPCSHM_SLOT_BUSY != uState) ||
+            uEpoch != epoch.load(std::memory_order_acquire))
+        {
+            return 0;
+        }
+        if (iSpin-- > 0)
+        {
+            cpu_relax();
+            continue;
+        }
+
+        auto remaining = std::chrono::duration_cast<
+            std::chrono::milliseconds>(deadline -
+                                       std::chrono::steady_clock::now());
+        if (remaining.count() <= 0)
+        {
+            if (state.compare_exchange_strong(uState,
+                                              RPCSHM_SLOT_ABANDONED))
+            {
+                timeouts.add();
+                return 0;
+            }
+            continue;
+        }
+        waiting.store(1);
+        if (uState == state.load())
+        {
+            futex_wait(&pSlot->uState, uState, (int)remaining.count());
+        }
+    }
+}
+
+/**
+ * Only a slot this process holds in the current epoch is freed, so a
+ * caller that lost its slot to a server restart cannot free the next
+ * owner's, even when that owner is another thread of the same process.
+ */
+void rpcShmRing::release(char* pBuffer)
+{
+    MFW_RPCSHM_SLOT_T* pSlot = slot_of(pBuffer);
+    std::atomic_ref<uint32_t> state(pSlot->uState);
+    uint32_t uState = state.load(std::memory_order_acquire);
+    if (getpid() == pSlot->pidOwner &&
+        pSlot->uEpoch == std::atomic_ref<uint32_t>(m_pRing->uEpoch).load(
+            std::memory_order_acquire) &&
+        (RPCSHM_SLOT_REPLIED == uState || RPCSHM_SLOT_CLAIMED == uState))
+    {
+        state.compare_exchange_strong(uState, RPCSHM_SLOT_FREE,
+                                      std::memory_order_release);
+    }
+}
+
+/**
+ * The dequeue half: a cell whose sequence number is one past the head
+ * holds a slot, and handing the cell back sets it a lap ahead.
+ */
+bool rpcShmRing::dequeue(uint32_t& uSlot)
+{
+    std::atomic_ref<uint64_t> head(m_pRing->u64Head);
+    uint64_t u64Pos = head.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        auto& cell = m_pRing->cells[u64Pos & RPCSHM_MASK];
+        uint64_t u64Seq = std::atomic_ref<uint64_t>(cell.u64Seq).load(
+            std::memory_order_acquire);
+        if (u64Seq == u64Pos + 1)
+        {
+            if (head.compare_exchange_weak(u64Pos, u64Pos + 1,
+                                           std::memory_order_relaxed))
+            {
+                uSlot = cell.uSlot & RPCSHM_MASK;
+                std::atomic_ref<uint64_t>(cell.u64Seq).store(
+                    u64Pos + CFG_VPARPC_SHM_SLOTS, std::memory_order_release);
+                return true;
+            }
+        }
+        else if ((int64_t)(u64Seq - (u64Pos + 1)) < 0)
+        {
+            return false;
+        }
+        else
+        {
+            u64Pos = head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * The request is framed as over TCP before the handler sees it, so a
+ * caller cannot make it read past the slot.
+ */
+void rpcShmRing::handle(uint32_t uSlot, const rpcServer::handler_t& handler)
+{
+    static shm_counter malformed("rpc.shm.malformed");
+
+    MFW_RPCSHM_SLOT_T& slot = m_pRing->slots[uSlot];
+    std::atomic_ref<uint32_t> state(slot.uState);
+    uint32_t uState = RPCSHM_SLOT_QUEUED;
+    if (!state.compare_exchange_strong(uState, RPCSHM_SLOT_BUSY,
+                                       std::memory_order_acquire))
+    {
+        if (RPCSHM_SLOT_ABANDONED == uState)
+        {
+            state.store(RPCSHM_SLOT_FREE, std::memory_order_release);
+        }
+        return;
+    }
+
+    size_t stLen = slot.u64Len;
+    size_t stReply = 0;
+    if (stLen <= sizeof(slot.buffer) &&
+        (ssize_t)stLen == vparpc::frame_length(slot.buffer, stLen,
+                                               sizeof(slot.buffer)))
+    {
+        rpcServer::set_peer_trusted(true);
+        stReply = handler(slot.buffer, stLen, sizeof(slot.buffer));
+        rpcServer::set_peer_trusted(false);
+    }
+    else
+    {
+        malformed.add();
+    }
+    slot.u64Len = stReply;
+
+    uState = RPCSHM_SLOT_BUSY;
+    if (!state.compare_exchange_strong(uState, RPCSHM_SLOT_REPLIED))
+    {
+        state.store(RPCSHM_SLOT_FREE, std::memory_order_release);
+        return;
+    }
+    if (0 != std::atomic_ref<uint32_t>(slot.uWaiting).load())
+    {
+        futex_wake(&slot.uState, 1);
+    }
+}
+
+/**
+ * Frees the slots that callers which have since exited claimed or were
+ * answered in, so a crashed caller costs the ring nothing for long.
+ */
+void rpcShmRing::reap()
+{
+    static shm_counter reaped("rpc.shm.reaped");
+
+    for (auto& slot : m_pRing->slots)
+    {
+        std::atomic_ref<uint32_t> state(slot.uState);
+        uint32_t uState = state.load(std::memory_order_acquire);
+        if ((RPCSHM_SLOT_CLAIMED == uState ||
+             RPCSHM_SLOT_REPLIED == uState) && 0 != slot.pidOwner &&
+            -1 == kill(slot.pidOwner, 0) && ESRCH == errno &&
+            state.compare_exchange_strong(uState, RPCSHM_SLOT_FREE))
+        {
+            reaped.add();
+        }
+    }
+}
+
+void rpcShmRing::worker(const rpcServer::handler_t& handler)
+{
+    std::atomic_ref<uint32_t> doorbell(m_pRing->uDoorbell);
+    std::atomic_ref<uint32_t> sleepers(m_pRing->uSleepers);
+
+    int iSpin = 0;
+    while (!m_bStop.load(std::memory_order_acquire))
+    {
+        uint32_t uSlot;
+        if (dequeue(uSlot))
+        {
+            handle(uSlot, handler);
+            iSpin = m_bSpin ? CFG_VPARPC_SHM_SPIN : 0;
+            continue;
+        }
+        if (iSpin-- > 0)
+        {
+            cpu_relax();
+            continue;
+        }
+
+        uint32_t uBell = doorbell.load();
+        sleepers.fetch_add(1);
+        bool bFound = dequeue(uSlot);
+        int iResult = 0;
+        if (!bFound && !m_bStop.load())
+        {
+            iResult = futex_wait(&m_pRing->uDoorbell, uBell, RPCSHM_REAP_MS);
+        }
+        sleepers.fetch_sub(1);
+        if (bFound)
+        {
+            handle(uSlot, handler);
+            iSpin = m_bSpin ? CFG_VPARPC_SHM_SPIN : 0;
+        }
+        else if (-1 == iResult && ETIMEDOUT == errno)
+        {
+            reap();
+        }
+    }
+}
+
+void rpcShmRing::serve(int iWorkers, const rpcServer::handler_t& handler)
+{
+    if (iWorkers <= 0)
+    {
+        iWorkers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::vector<std::thread> workers;
+    for (int i = 0; i < iWorkers; i++)
+    {
+        workers.emplace_back(&rpcShmRing::worker, this, std::cref(handler));
+    }
+    for (auto& thread : workers)
+    {
+        thread.join();
+    }
+}
+
+void rpcShmRing::stop()
+{
+    m_bStop.store(true, std::memory_order_release);
+    std::atomic_ref<uint32_t>(m_pRing->uDoorbell).fetch_add(1);
+    futex_wake(&m_pRing->uDoorbell, INT_MAX);
+}
+
+//////////////////////////
+// eof - rpcShmRing.cpp //
+//////////////////////////
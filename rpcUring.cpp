@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/rpcUring.cpp 2026-10-17 21:10 dwg -           //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#include "mwfw2.h"
+
+rpcUring::rpcUring()
+    : m_fd(-1),
+      m_pSqRing(MAP_FAILED), m_stSqRing(0),
+      m_pCqRing(MAP_FAILED), m_stCqRing(0),
+      m_pSqes((struct io_uring_sqe*)MAP_FAILED), m_stSqes(0),
+      m_puSqHead(nullptr), m_puSqTail(nullptr), m_puSqArray(nullptr),
+      m_uSqMask(0), m_uSqEntries(0), m_uSqTail(0),
+      m_puCqHead(nullptr), m_puCqTail(nullptr), m_uCqMask(0),
+      m_pCqes(nullptr)
+{
+}
+
+rpcUring::~rpcUring()
+{
+    if (MAP_FAILED != (void*)m_pSqes)
+    {
+        munmap(m_pSqes, m_stSqes);
+    }
+    if (MAP_FAILED != m_pCqRing && m_pCqRing != m_pSqRing)
+    {
+        munmap(m_pCqRing, m_stCqRing);
+    }
+    if (MAP_FAILED != m_pSqRing)
+    {
+        munmap(m_pSqRing, m_stSqRing);
+    }
+    if (-1 != m_fd)
+    {
+        close(m_fd);
+    }
+}
+
+/**
+ * With IORING_FEAT_SINGLE_MMAP both rings share one mapping.
+ */
+bool rpcUring::setup(unsigned uEntries)
+{
+    struct io_uring_params params = {};
+    m_fd = (int)syscall(__NR_io_uring_setup, uEntries, &params);
+    if (-1 == m_fd)
+    {
+        return false;
+    }
+
+    m_stSqRing = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_stCqRing = params.cq_off.cqes +
+                 params.cq_entries * sizeof(struct io_uring_cqe);
+    bool bSingle = 0 != (params.features & IORING_FEAT_SINGLE_MMAP);
+    if (bSingle)
+    {
+        m_stSqRing = m_stCqRing = std::max(m_stSqRing, m_stCqRing);
+    }
+
+    m_pSqRing = mmap(nullptr, m_stSqRing, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+    if (MAP_FAILED == m_pSqRing)
+    {
+        return false;
+    }
+    m_pCqRing = bSingle ? m_pSqRing :
+                mmap(nullptr, m_stCqRing, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+    if (MAP_FAILED == m_pCqRing)
+    {
+        return false;
+    }
+    m_stSqes = params.sq_entries * sizeof(struct io_uring_sqe);
+    m_pSqes = (struct io_uring_sqe*)mmap(
+        nullptr, m_stSqes, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+    if (MAP_FAILED == (void*)m_pSqes)
+    {
+        return false;
+    }
+
+    auto* pSq = (char*)m_pSqRing;
+    m_puSqHead = (unsigned*)(pSq + params.sq_off.head);
+    m_puSqTail = (unsigned*)(pSq + params.sq_off.tail);
+    m_puSqArray = (unsigned*)(pSq + params.sq_off.array);
+    m_uSqMask = *(unsigned*)(pSq + params.sq_off.ring_mask);
+    m_uSqEntries = params.sq_entries;
+    m_uSqTail = *m_puSqTail;
+
+    auto* pCq = (char*)m_pCqRing;
+    m_puCqHead = (unsigned*)(pCq + params.cq_off.head);
+    m_puCqTail = (unsigned*)(pCq + params.cq_off.tail);
+    m_uCqMask = *(unsigned*)(pCq + params.cq_off.ring_mask);
+    m_pCqes = (struct io_uring_cqe*)(pCq + params.cq_off.cqes);
+    return true;
+}
+
+bool rpcUring::supported()
+{
+    static const int iNeeded[] = {
+        IORING_OP_ACCEPT, IORING_OP_READ, IORING_OP_READ_FIXED,
+        IORING_OP_WRITE_FIXED, IORING_OP_TIMEOUT
+    };
+
+    struct io_uring_params params = {};
+    int fd = (int)syscall(__NR_io_uring_setup, 2, &params);
+    if (-1 == fd)
+    {
+        return false;
+    }
+    bool bOk = 0 != (params.features & IORING_FEAT_NODROP);
+
+    size_t stProbe = sizeof(struct io_uring_probe) +
+                     256 * sizeof(struct io_uring_probe_op);
+    std::vector<char> probe(stProbe, 0);
+    auto* pProbe = (struct io_uring_probe*)probe.data();
+    if (bOk && 0 == syscall(__NR_io_uring_register, fd,
+                            IORING_REGISTER_PROBE, pProbe, 256))
+    {
+        for (int iOp : iNeeded)
+        {
+            bOk = bOk && iOp <= pProbe->last_op &&
+                  0 != (pProbe->ops[iOp].flags & IO_URING_OP_SUPPORTED);
+        }
+    }
+    else
+    {
+        bOk = false;        // older than 5.6, which added the probe
+    }
+    close(fd);
+    return bOk;
+}
+
+bool rpcUring::register_buffer(void* pBase, size_t stLen)
+{
+    struct iovec iov = {pBase, stLen};
+    return 0 == syscall(__NR_io_uring_register, m_fd,
+                        IORING_REGISTER_BUFFERS, &iov, 1);
+}
+
+bool rpcUring::reserve(unsigned uCount)
+{
+    unsigned uHead = __atomic_load_n(m_puSqHead, __ATOMIC_ACQUIRE);
+    if (m_uSqTail - uHead + uCount > m_uSqEntries)
+    {
+        submit(0);
+        uHead = __atomic_load_n(m_puSqHead, __ATOMIC_ACQUIRE);
+        if (m_uSqTail - uHead + uCount > m_uSqEntries)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct io_uring_sqe* rpcUring::sqe()
+{
+    if (!reserve(1))
+    {
+        return nullptr;
+    }
+    unsigned uIndex = m_uSqTail & m_uSqMask;
+    struct io_uring_sqe* pSqe = &m_pSqes[uIndex];
+    memset(pSqe, 0, sizeof(*pSqe));
+    m_puSqArray[uIndex] = uIndex;
+    m_uSqTail++;
+    return pSqe;
+}
+
+int rpcUring::submit(unsigned uWait)
+{
+    unsigned uSubmit = m_uSqTail - *m_puSqTail;
+    __atomic_store_n(m_puSqTail, m_uSqTail, __ATOMIC_RELEASE);
+    if (0 == uSubmit && 0 == uWait)
+    {
+        return 0;
+    }
+    for (;;)
+    {
+        int iDone = (int)syscall(__NR_io_uring_enter, m_fd, uSubmit, uWait,
+                                 uWait ? IORING_ENTER_GETEVENTS : 0,
+                                 nullptr, 0);
+        if (-1 != iDone || EINTR != errno)
+        {
+            return iDone;
+        }
+    }
+}
+
+bool rpcUring::cqe(struct io_uring_cqe& cqe)
+{
+    unsigned uHead = *m_puCqHead;
+    if (uHead == __atomic_load_n(m_puCqTail, __ATOMIC_ACQUIRE))
+    {
+        return false;
+    }
+    cqe = m_pCqes[uHead & m_uCqMask];
+    __atomic_store_n(m_puCqHead, uHead + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+////////////////////////
+// eof - rpcUring.cpp //
+////////////////////////
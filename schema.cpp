@@ -514,8 +514,8 @@ void schema::gen_from_schema(int iHandle,
         "content", "0"
     });
     sprintf(szTemp, "%s%s%s",
-            gpSh->m_pShMemng->szProtocol,
-            gpSh->m_pShMemng->szIP,
+            gpShMemCfg->get(SHM_STR_PROTOCOL).c_str(),
+            gpShMemCfg->get(SHM_STR_IP).c_str(),
             "/action.py");
     gpHtml->title(szTemp);
 
@@ -607,8 +607,8 @@ void schema::gen_from_schema(int iHandle,
         "content", "0"
     });
     sprintf(szTemp, "%s%s%s",
-            gpSh->m_pShMemng->szProtocol,
-            gpSh->m_pShMemng->szIP,
+            gpShMemCfg->get(SHM_STR_PROTOCOL).c_str(),
+            gpShMemCfg->get(SHM_STR_IP).c_str(),
             "/action.py");
     gpHtml->title(szTemp);
 
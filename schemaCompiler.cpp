@@ -269,7 +269,7 @@ schemaCompiler::schemaCompiler(std::string ssSchemaName, bool bDebug)
             std::ofstream ofs(m_ssHFN);
             ofs << "/////////////////////////////////////////////"
                 << "///////////////////////" << std::endl;
-            ofs << "// " << gpSh->m_pShMemng->szHostname << ":" << ssPath
+            ofs << "// " << gpShMemCfg->get(SHM_STR_HOSTNAME) << ":" << ssPath
                 << "" << std::endl;
             ofs << "// Copyright (c) 2025 Douglas Wade Goodall. "
                 << "All rights reserved." << std::endl;
@@ -5,8 +5,19 @@
 ########################################################################
 # Remove all shared memory regions used by the Goodall Multiware Framework.
 # Used when we make changes to the schema of the shared region (size).
-ipcrm --shmem-key 0x00005164 2> /tmp/ipcrm#5164.stderr # MultiWare Main ShMem
+# Layout changes no longer need this; see CFG_SHM_LAYOUT_VERSION.
+ipcrm --shmem-key 0x00005164 2> /tmp/ipcrm#5164.stderr # MultiWare Main ShMem (legacy)
+ipcrm --shmem-key 0x00015164 2> /tmp/ipcrm#15164.stderr # MultiWare Main ShMem layout 1
+ipcrm --shmem-key 0x00025164 2> /tmp/ipcrm#25164.stderr # MultiWare Main ShMem layout 2
+ipcrm --shmem-key 0x00035164 2> /tmp/ipcrm#35164.stderr # MultiWare Main ShMem layout 3
+ipcrm --shmem-key 0x00045164 2> /tmp/ipcrm#45164.stderr # MultiWare Main ShMem layout 4
+ipcrm --shmem-key 0x00055164 2> /tmp/ipcrm#55164.stderr # MultiWare Main ShMem layout 5
+ipcrm --shmem-key 0x00065164 2> /tmp/ipcrm#65164.stderr # MultiWare Main ShMem layout 6
+ipcrm --shmem-key 0x00075164 2> /tmp/ipcrm#75164.stderr # MultiWare Main ShMem layout 7
+ipcrm --shmem-key 0x00085164 2> /tmp/ipcrm#85164.stderr # MultiWare Main ShMem layout 8
+ipcrm --shmem-key 0x00095164 2> /tmp/ipcrm#95164.stderr # MultiWare Main ShMem layout 9
 ipcrm --shmem-key 0x00005165 2> /tmp/ipcrm#5165.stderr # vpad control/status
 ipcrm --shmem-key 0x00005167 2> /tmp/ipcrm#5167.stderr # admin  user descriptor
 ipcrm --shmem-key 0x00005168 2> /tmp/ipcrm#5168.stderr # doug   user descriptor
 ipcrm --shmem-key 0x00005169 2> /tmp/ipcrm#5169.stderr # marcus user descriptor
+rm -f /dev/shm/fw_shmem_heap.v1 # variable-size records heap, version 1
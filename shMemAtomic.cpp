@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/shMemAtomic.cpp 2026-10-17 14:10 dwg -        //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#include "mwfw2.h"
+
+static_assert((CFG_COUNTER_SHARDS & (CFG_COUNTER_SHARDS - 1)) == 0,
+              "CFG_COUNTER_SHARDS must be a power of two");
+
+/**
+ * Takes the segment lock for a shm_atomic<T> whose T is not lock-free.
+ */
+void shm_atomic_lock()
+{
+    gpShMemMutex->lock();
+}
+
+/**
+ * Releases the segment lock taken by shm_atomic_lock().
+ */
+void shm_atomic_unlock()
+{
+    gpShMemMutex->unlock();
+}
+
+/**
+ * The counters[] table is scanned exactly like the lock table in
+ * SharedMemoryMutex's constructor: a ready slot with the requested name
+ * is reused, the first unused slot is claimed with a CAS and published
+ * once its name is written, and a slot another process is still
+ * claiming is waited for.
+ */
+shm_counter::shm_counter(const char* pszName)
+{
+    m_pCounter = nullptr;
+
+    for (auto& slot : gpSh->m_pShMemng->counters.counters)
+    {
+        std::atomic_ref<uint32_t> state(slot.uState);
+        uint32_t uState = state.load(std::memory_order_acquire);
+
+        if (SHMCOUNTER_UNUSED == uState)
+        {
+            uint32_t uExpected = SHMCOUNTER_UNUSED;
+            if (state.compare_exchange_strong(uExpected,
+                                              SHMCOUNTER_INITIALIZING,
+                                              std::memory_order_acq_rel))
+            {
+                memset(slot.shards, 0, sizeof(slot.shards));
+                strncpy(slot.szName, pszName, SHM_COUNTER_NAME_SIZE_MAX - 1);
+                state.store(SHMCOUNTER_READY, std::memory_order_release);
+                m_pCounter = &slot;
+                return;
+            }
+            uState = uExpected;
+        }
+
+        for (int iSpin = 0;
+             SHMCOUNTER_INITIALIZING == uState && iSpin < 100000; iSpin++)
+        {
+            sched_yield();
+            uState = state.load(std::memory_order_acquire);
+        }
+
+        if (SHMCOUNTER_READY == uState &&
+            0 == strncmp(slot.szName, pszName, SHM_COUNTER_NAME_SIZE_MAX - 1))
+        {
+            m_pCounter = &slot;
+            return;
+        }
+    }
+
+    throw std::system_error(ENOSPC, std::system_category(),
+                            "shared counter table is full");
+}
+
+/**
+ * Sums the shards with relaxed loads.
+ */
+uint64_t shm_counter::value() const
+{
+    uint64_t u64Total = 0;
+    for (auto& shard : m_pCounter->shards)
+    {
+        u64Total += std::atomic_ref<uint64_t>(shard.u64Count).load(
+            std::memory_order_relaxed);
+    }
+    return u64Total;
+}
+
+/**
+ * Returns the name of the counter.
+ */
+const char* shm_counter::name() const
+{
+    return m_pCounter->szName;
+}
+
+/**
+ * Walks the ready slots without claiming anything.
+ */
+void shm_counter::for_each(
+    const std::function<void(const char*, uint64_t)>& fn)
+{
+    for (auto& slot : gpSh->m_pShMemng->counters.counters)
+    {
+        if (SHMCOUNTER_READY != std::atomic_ref<uint32_t>(slot.uState).load(
+                std::memory_order_acquire))
+        {
+            continue;
+        }
+        uint64_t u64Total = 0;
+        for (auto& shard : slot.shards)
+        {
+            u64Total += std::atomic_ref<uint64_t>(shard.u64Count).load(
+                std::memory_order_relaxed);
+        }
+        fn(slot.szName, u64Total);
+    }
+}
+
+/**
+ * Copies the table, then frees any slot that was still being claimed.
+ */
+void shm_counter::migrate(void* pDst, const void* pSrc,
+                          size_t stDst, size_t stSrc)
+{
+    memcpy(pDst, pSrc, std::min(stDst, stSrc));
+    auto* pTable = (MFW_COUNTER_TABLE_T*)pDst;
+    size_t stSlots = std::min(stDst, stSrc) / sizeof(MFW_COUNTER_T);
+    for (size_t i = 0; i < stSlots; i++)
+    {
+        if (SHMCOUNTER_READY != pTable->counters[i].uState)
+        {
+            memset(&pTable->counters[i], 0, sizeof(MFW_COUNTER_T));
+        }
+    }
+}
+
+/////////////////////////////
+// eof - shMemAtomic.cpp //
+/////////////////////////////
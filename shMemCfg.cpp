@@ -0,0 +1,313 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/shMemCfg.cpp 2026-10-17 09:40 dwg -           //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#include "mwfw2.h"
+
+/**
+ * Legacy field name and size of every pool string, indexed by
+ * shm_str_t. The sizes are those of the fixed char arrays the strings
+ * used to occupy in MFW_SHMEMNG_T, so callers see the same truncation
+ * behaviour as before.
+ */
+static const struct
+{
+    const char* pszName;
+    uint16_t    uMaxSize;
+} gStrInfo[] = {
+    { "szProtocol",       INET_PROT_NAME_MAX },
+    { "szIP",             DNS_FQDN_SIZE_MAX  },
+    { "szUser",           UT_NAMESIZE        },
+    { "szCgiRoot",        INET_URL_SIZE_MAX  },
+    { "szImgRoot",        INET_URL_SIZE_MAX  },
+    { "szLogFQDS",        FILENAME_MAX       },
+    { "szRpcUuid",        UUID_SIZE          },
+    { "szConfigFQDS",     FILENAME_MAX       },
+    { "szConfigFQFS",     FILENAME_MAX       },
+    { "szStylesFQDS",     FILENAME_MAX       },
+    { "szHtmlRoot",       INET_URL_SIZE_MAX  },
+    { "szStylesFileRoot", INET_URL_SIZE_MAX  },
+    { "szHostname",       DNS_FQDN_SIZE_MAX  },
+    { "szPublicIP",       DNS_FQDN_SIZE_MAX  },
+    { "szIface",          IFNAMSIZ           },
+    { "szDevoDir",        FILENAME_MAX       },
+    { "szBuildFQDS",      FILENAME_MAX       },
+    { "szCgiBinFQDS",     FILENAME_MAX       },
+    { "szDocFQDS",        FILENAME_MAX       },
+    { "szHomeFQDS",       UT_NAMESIZE        },
+    { "szImgFQDS",        FILENAME_MAX       },
+    { "szIncludeFQDS",    FILENAME_MAX       },
+    { "szSchemasFQDS",    FILENAME_MAX       },
+    { "szScriptsFQDS",    FILENAME_MAX       },
+    { "szSourceFQDS",     FILENAME_MAX       },
+    { "szTempFQDS",       FILENAME_MAX       },
+    { "szUserdirFQDS",    UT_NAMESIZE        },
+    { "szCgiBinFQFS",     FILENAME_MAX       },
+};
+static_assert(sizeof(gStrInfo) / sizeof(gStrInfo[0]) == SHM_STR_COUNT,
+              "gStrInfo must have one entry per shm_str_t");
+static_assert(CFG_STRPOOL_SIZE <= 65535,
+              "MFW_STRDESC_T offsets are 16 bits");
+
+/**
+ * Binds to the config block inside the attached segment and makes sure
+ * the segment has an RPC UUID. The UUID used to be generated by the
+ * shared constructor; it lives in the pool now, so it is generated here
+ * under the config region lock, once per segment.
+ */
+SharedMemoryConfig::SharedMemoryConfig()
+{
+    m_pBlock = &gpSh->m_pShMemng->config;
+
+    if (get(SHM_STR_RPC_UUID).empty())
+    {
+        shmConfigGuard guard;
+        if (0 == m_pBlock->pool.desc[SHM_STR_RPC_UUID].uLength)
+        {
+            uuid_t uuid;
+            char szUUID[UUID_SIZE];
+            uuid_generate(uuid);
+            uuid_unparse(uuid, szUUID);
+            store(SHM_STR_RPC_UUID, szUUID);
+        }
+    }
+}
+
+/**
+ * Seqlock read side. The sequence is sampled before and after the copy;
+ * if it was odd (a writer was active) or moved, the copy may be torn and
+ * is retried. Only the descriptors and the used part of the arena are
+ * copied. The acquire fence orders the data loads before the second
+ * sequence load.
+ *
+ * A sequence that stays odd for CFG_SEQLOCK_STALL yields may belong to a
+ * writer that died in store(). Writers hold the config region lock
+ * throughout, so if the reader can take that lock and the sequence is
+ * still odd, nobody is writing, and the reader makes it even.
+ */
+uint32_t SharedMemoryConfig::snapshot(MFW_STRPOOL_T& pool) const
+{
+    std::atomic_ref<uint32_t> seq(m_pBlock->uSequence);
+    int iStall = 0;
+    for (;;)
+    {
+        uint32_t uBefore = seq.load(std::memory_order_acquire);
+        if (uBefore & 1)
+        {
+            if (++iStall >= CFG_SEQLOCK_STALL)
+            {
+                iStall = 0;
+                SharedMemoryMutex& lock =
+                    gpShMemMgr->getRegionMutex(SHM_REGION_CONFIG);
+                if (lock.try_lock())
+                {
+                    uint32_t uOdd = uBefore;
+                    seq.compare_exchange_strong(uOdd, uOdd + 1,
+                                                std::memory_order_release);
+                    lock.unlock();
+                }
+            }
+            sched_yield();
+            continue;
+        }
+        memcpy(&pool, &m_pBlock->pool, offsetof(MFW_STRPOOL_T, arena));
+        uint32_t uUsed = std::min<uint32_t>(pool.uUsed, CFG_STRPOOL_SIZE);
+        memcpy(pool.arena, m_pBlock->pool.arena, uUsed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq.load(std::memory_order_relaxed) == uBefore)
+        {
+            return uBefore >> 1;
+        }
+    }
+}
+
+/**
+ * Returns the thread-local copy, refreshed only if the shared sequence
+ * differs from the one the copy was taken at. The copy is per thread so
+ * that the workers of vparpc::server_pool() never refresh a pool another
+ * thread is reading; there is only one SharedMemoryConfig per process.
+ */
+const MFW_STRPOOL_T& SharedMemoryConfig::current()
+{
+    thread_local MFW_STRPOOL_T t_cache = {};
+    thread_local uint32_t t_uCacheSeq = 1;  // odd, so the first call loads
+
+    std::atomic_ref<uint32_t> seq(m_pBlock->uSequence);
+    if (seq.load(std::memory_order_acquire) != t_uCacheSeq)
+    {
+        t_uCacheSeq = snapshot(t_cache) << 1;
+    }
+    return t_cache;
+}
+
+/**
+ * Returns a copy of one string from the process-local pool.
+ */
+std::string SharedMemoryConfig::get(shm_str_t id)
+{
+    return str(current(), id);
+}
+
+/**
+ * Takes the config region lock and stores the value.
+ */
+bool SharedMemoryConfig::set(shm_str_t id, const std::string& ssValue)
+{
+    shmConfigGuard guard;
+    return store(id, ssValue);
+}
+
+/**
+ * Seqlock write side; the caller holds the config region lock, which
+ * makes it the only writer and lets it read the shared pool directly.
+ *
+ * The new pool is built on the stack, repacked in enum order so the hot
+ * strings always lead the arena, and then published: the sequence is
+ * made odd before the shared copy is touched and even again, with
+ * release ordering, once it is complete. Nothing is written when the
+ * value is unchanged, so the many CGI processes that run environment's
+ * constructor do not invalidate every reader's cache.
+ */
+bool SharedMemoryConfig::store(shm_str_t id, const std::string& ssValue)
+{
+    std::string ssNew = ssValue.substr(0, max_size(id) - 1);
+    const MFW_STRPOOL_T& cur = m_pBlock->pool;
+    if (ssNew == str(cur, id))
+    {
+        return true;
+    }
+
+    MFW_STRPOOL_T pool;
+    uint32_t uUsed = 0;
+    for (int i = 0; i < SHM_STR_COUNT; i++)
+    {
+        const char* psz = (i == id) ? ssNew.c_str()
+                                    : str(cur, (shm_str_t)i);
+        size_t stLen = strlen(psz);
+        if (0 == stLen)
+        {
+            pool.desc[i].uOffset = 0;
+            pool.desc[i].uLength = 0;
+            continue;
+        }
+        if (uUsed + stLen + 1 > CFG_STRPOOL_SIZE)
+        {
+            // The constructor stores the RPC UUID before gpSysLog exists
+            if (nullptr != gpSysLog)
+            {
+                gpSysLog->loginfo("SharedMemoryConfig::set: string pool "
+                                  "full");
+            }
+            return false;
+        }
+        memcpy(&pool.arena[uUsed], psz, stLen + 1);
+        pool.desc[i].uOffset = (uint16_t)uUsed;
+        pool.desc[i].uLength = (uint16_t)stLen;
+        uUsed += stLen + 1;
+    }
+    pool.uUsed = uUsed;
+
+    // A writer that died between the two stores left the sequence odd;
+    // starting from the odd value above it puts the parity right again.
+    std::atomic_ref<uint32_t> seq(m_pBlock->uSequence);
+    uint32_t uOdd = seq.load(std::memory_order_relaxed) | 1;
+    seq.store(uOdd, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(&m_pBlock->pool, &pool, offsetof(MFW_STRPOOL_T, arena) + uUsed);
+    seq.store(uOdd + 1, std::memory_order_release);
+    shm_notify::publish(SHM_CHANNEL_CONFIG);
+    return true;
+}
+
+/**
+ * Returns the published version without copying anything.
+ */
+uint32_t SharedMemoryConfig::version() const
+{
+    std::atomic_ref<uint32_t> seq(m_pBlock->uSequence);
+    return seq.load(std::memory_order_acquire) >> 1;
+}
+
+/**
+ * Returns the arena bytes in use in the current version.
+ */
+size_t SharedMemoryConfig::used()
+{
+    return current().uUsed;
+}
+
+/**
+ * Resolves a descriptor against its pool. Descriptors that would point
+ * outside the arena are treated as empty rather than trusted.
+ */
+const char* SharedMemoryConfig::str(const MFW_STRPOOL_T& pool, shm_str_t id)
+{
+    const MFW_STRDESC_T& desc = pool.desc[id];
+    if (0 == desc.uLength ||
+        (uint32_t)desc.uOffset + desc.uLength >= CFG_STRPOOL_SIZE)
+    {
+        return "";
+    }
+    return &pool.arena[desc.uOffset];
+}
+
+/**
+ * Returns the legacy field name of a pool string.
+ */
+const char* SharedMemoryConfig::name(shm_str_t id)
+{
+    return gStrInfo[id].pszName;
+}
+
+/**
+ * Returns the legacy field size of a pool string.
+ */
+size_t SharedMemoryConfig::max_size(shm_str_t id)
+{
+    return gStrInfo[id].uMaxSize;
+}
+
+/**
+ * Runs the same read loop as snapshot() against the older block, but
+ * copies the whole pool, and starts the new block at the version the old
+ * one had reached so that the version keeps counting up across the
+ * migration. A block of a different size means the arena
+ * size changed; the pool is then left empty and environment's
+ * constructor probes the values again.
+ */
+void SharedMemoryConfig::migrate(void* pDst, const void* pSrc,
+                                 size_t stDst, size_t stSrc)
+{
+    if (stDst != stSrc || stDst != sizeof(MFW_CONFIG_BLOCK_T))
+    {
+        return;
+    }
+    auto* pTo = (MFW_CONFIG_BLOCK_T*)pDst;
+    auto* pFrom = (MFW_CONFIG_BLOCK_T*)pSrc;
+
+    std::atomic_ref<uint32_t> seq(pFrom->uSequence);
+    for (;;)
+    {
+        uint32_t uBefore = seq.load(std::memory_order_acquire);
+        if (uBefore & 1)
+        {
+            sched_yield();
+            continue;
+        }
+        memcpy(&pTo->pool, &pFrom->pool, sizeof(MFW_STRPOOL_T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq.load(std::memory_order_relaxed) == uBefore)
+        {
+            pTo->uSequence = uBefore;
+            return;
+        }
+    }
+}
+
+////////////////////////
+// eof - shMemCfg.cpp //
+////////////////////////
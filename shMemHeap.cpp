@@ -0,0 +1,419 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/shMemHeap.cpp 2026-10-17 16:20 dwg -          //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#include "mwfw2.h"
+
+#define OBJ_PERMS (S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP)
+
+#define HEAD_OFF_BITS 40
+#define HEAD_OFF_MASK ((1ull << HEAD_OFF_BITS) - 1)
+
+static_assert(sizeof(MFW_HEAPBLOCK_T) == 16,
+              "blocks must keep their payload 16-byte aligned");
+static_assert(CFG_SHMHEAP_SIZE <= HEAD_OFF_MASK,
+              "free list heads pack offsets into 40 bits");
+
+/**
+ * @return The size class whose blocks hold stBytes plus the block header,
+ *         or SHMHEAP_CLASSES if no class is large enough.
+ */
+static uint32_t class_for(size_t stBytes)
+{
+    size_t stNeed = stBytes + sizeof(MFW_HEAPBLOCK_T);
+    uint32_t uClass = 0;
+    while (uClass < SHMHEAP_CLASSES &&
+           ((size_t)SHMHEAP_MIN_BLOCK << uClass) < stNeed)
+    {
+        uClass++;
+    }
+    return uClass;
+}
+
+/**
+ * Formats a newly created region. ftruncate() has already zeroed it.
+ */
+static void format(MFW_HEAP_T* pHeap, size_t stSize)
+{
+    pHeap->uMagic = SHMHEAP_MAGIC;
+    pHeap->uVersion = CFG_SHMHEAP_VERSION;
+    pHeap->u64Size = stSize;
+    pHeap->u64Used = (sizeof(MFW_HEAP_T) + SHMHEAP_MIN_BLOCK - 1) &
+                     ~(uint64_t)(SHMHEAP_MIN_BLOCK - 1);
+}
+
+/**
+ * Creation follows shared's constructor: the process whose O_EXCL open
+ * succeeds sizes and formats the region and then publishes it, and every
+ * other process waits for it to be published. If the creator died on the
+ * way, the waiter finishes the job after CFG_SHM_READY_TIMEOUT_MS.
+ */
+shm_heap::shm_heap(const char* pszName, size_t stSize)
+{
+    snprintf(m_szName, sizeof(m_szName), "%s.v%d", pszName,
+             CFG_SHMHEAP_VERSION);
+    m_stSize = stSize;
+
+    bool bJustCreated = false;
+    int fd = shm_open(m_szName, O_RDWR | O_CREAT | O_EXCL, OBJ_PERMS);
+    if (-1 != fd)
+    {
+        bJustCreated = true;
+        fchmod(fd, OBJ_PERMS);
+    }
+    else if (EEXIST == errno)
+    {
+        fd = shm_open(m_szName, O_RDWR, OBJ_PERMS);
+    }
+    if (-1 == fd)
+    {
+        throw std::system_error(errno, std::system_category(),
+                                "shm_open failed");
+    }
+
+    struct stat st = {};
+    if (bJustCreated)
+    {
+        if (-1 == ftruncate(fd, stSize))
+        {
+            int iErr = errno;
+            close(fd);
+            shm_unlink(m_szName);
+            throw std::system_error(iErr, std::system_category(),
+                                    "ftruncate failed");
+        }
+    }
+    else
+    {
+        for (int iMs = 0; iMs < CFG_SHM_READY_TIMEOUT_MS; iMs++)
+        {
+            if (-1 == fstat(fd, &st) || (size_t)st.st_size >= stSize)
+            {
+                break;
+            }
+            usleep(1000);
+        }
+        if ((size_t)st.st_size < stSize && -1 == ftruncate(fd, stSize))
+        {
+            int iErr = errno;
+            close(fd);
+            throw std::system_error(iErr, std::system_category(),
+                                    "ftruncate failed");
+        }
+    }
+
+    void* pMap = mmap(nullptr, stSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      fd, 0);
+    int iErr = errno;
+    close(fd);
+    if (MAP_FAILED == pMap)
+    {
+        throw std::system_error(iErr, std::system_category(),
+                                "mmap failed");
+    }
+    m_pHeap = (MFW_HEAP_T*)pMap;
+
+    std::atomic_ref<uint32_t> state(m_pHeap->uState);
+    if (bJustCreated)
+    {
+        format(m_pHeap, stSize);
+        state.store(SHMHEAP_READY, std::memory_order_release);
+        return;
+    }
+
+    for (int iMs = 0; iMs < CFG_SHM_READY_TIMEOUT_MS; iMs++)
+    {
+        if (SHMHEAP_READY == state.load(std::memory_order_acquire))
+        {
+            break;
+        }
+        usleep(1000);
+    }
+    if (SHMHEAP_READY != state.load(std::memory_order_acquire))
+    {
+        gpSysLog->loginfo("shm_heap: region was never published; "
+                          "taking it over");
+        if (SHMHEAP_MAGIC != m_pHeap->uMagic)
+        {
+            format(m_pHeap, stSize);
+        }
+        state.store(SHMHEAP_READY, std::memory_order_release);
+    }
+    if (SHMHEAP_MAGIC != m_pHeap->uMagic ||
+        CFG_SHMHEAP_VERSION != m_pHeap->uVersion ||
+        m_pHeap->u64Size != stSize)
+    {
+        munmap(m_pHeap, stSize);
+        throw std::system_error(EPROTO, std::system_category(),
+                                "shared heap has an unexpected header");
+    }
+}
+
+shm_heap::~shm_heap()
+{
+    munmap(m_pHeap, m_stSize);
+}
+
+/**
+ * Pops the free list of the class, or else carves a new block from the
+ * unused part of the region with a CAS on u64Used. A block is always
+ * aligned to its own size, so the payload after the 16-byte header is
+ * 16-byte aligned.
+ */
+uint64_t shm_heap::allocate(size_t stBytes)
+{
+    uint32_t uClass = class_for(stBytes);
+    if (SHMHEAP_CLASSES == uClass)
+    {
+        std::atomic_ref<uint64_t>(m_pHeap->u64Failures).fetch_add(
+            1, std::memory_order_relaxed);
+        return 0;
+    }
+    uint64_t u64Block = 0;
+
+    std::atomic_ref<uint64_t> head(m_pHeap->freelists[uClass]);
+    uint64_t u64Head = head.load(std::memory_order_acquire);
+    while (0 != (u64Head & HEAD_OFF_MASK))
+    {
+        uint64_t u64Off = u64Head & HEAD_OFF_MASK;
+        // The block may be popped and reused under us; the stale next
+        // offset it yields is then rejected by the CAS on the count.
+        uint64_t u64Next = std::atomic_ref<uint64_t>(
+            at<MFW_HEAPBLOCK_T>(u64Off)->u64Next).load(
+            std::memory_order_relaxed);
+        uint64_t u64New = (u64Head & ~HEAD_OFF_MASK) + (1ull << HEAD_OFF_BITS) +
+                          (u64Next & HEAD_OFF_MASK);
+        if (head.compare_exchange_weak(u64Head, u64New,
+                                       std::memory_order_acquire))
+        {
+            u64Block = u64Off;
+            break;
+        }
+    }
+
+    if (0 == u64Block)
+    {
+        uint64_t u64BlockSize = (uint64_t)SHMHEAP_MIN_BLOCK << uClass;
+        std::atomic_ref<uint64_t> used(m_pHeap->u64Used);
+        uint64_t u64Used = used.load(std::memory_order_relaxed);
+        uint64_t u64Start;
+        do
+        {
+            u64Start = (u64Used + u64BlockSize - 1) & ~(u64BlockSize - 1);
+            if (u64Start + u64BlockSize > m_stSize)
+            {
+                std::atomic_ref<uint64_t>(m_pHeap->u64Failures).fetch_add(
+                    1, std::memory_order_relaxed);
+                return 0;
+            }
+        } while (!used.compare_exchange_weak(u64Used,
+                                             u64Start + u64BlockSize,
+                                             std::memory_order_relaxed));
+        u64Block = u64Start;
+    }
+
+    auto* pBlock = at<MFW_HEAPBLOCK_T>(u64Block);
+    pBlock->uClass = uClass;
+    std::atomic_ref<uint32_t>(pBlock->uMagic).store(
+        SHMHEAP_BLOCK_USED, std::memory_order_relaxed);
+    std::atomic_ref<uint64_t>(m_pHeap->u64Live[uClass]).fetch_add(
+        1, std::memory_order_relaxed);
+    return u64Block + sizeof(MFW_HEAPBLOCK_T);
+}
+
+/**
+ * The magic word is swapped rather than stored, so of two processes
+ * freeing the same block only one pushes it.
+ */
+void shm_heap::deallocate(uint64_t u64Off)
+{
+    if (0 == u64Off)
+    {
+        return;
+    }
+    uint64_t u64Block = u64Off - sizeof(MFW_HEAPBLOCK_T);
+    auto* pBlock = at<MFW_HEAPBLOCK_T>(u64Block);
+    if (!contains(u64Block, sizeof(MFW_HEAPBLOCK_T)) ||
+        pBlock->uClass >= SHMHEAP_CLASSES ||
+        SHMHEAP_BLOCK_USED != std::atomic_ref<uint32_t>(pBlock->uMagic)
+                                  .exchange(SHMHEAP_BLOCK_FREE))
+    {
+        char szMsg[96];
+        snprintf(szMsg, sizeof(szMsg),
+                 "shm_heap::deallocate: 0x%llx is not an allocated block",
+                 (unsigned long long)u64Off);
+        gpSysLog->loginfo(szMsg);
+        return;
+    }
+
+    uint32_t uClass = pBlock->uClass;
+    std::atomic_ref<uint64_t>(m_pHeap->u64Live[uClass]).fetch_sub(
+        1, std::memory_order_relaxed);
+
+    std::atomic_ref<uint64_t> head(m_pHeap->freelists[uClass]);
+    std::atomic_ref<uint64_t> next(pBlock->u64Next);
+    uint64_t u64Head = head.load(std::memory_order_relaxed);
+    uint64_t u64New;
+    do
+    {
+        next.store(u64Head & HEAD_OFF_MASK, std::memory_order_relaxed);
+        u64New = (u64Head & ~HEAD_OFF_MASK) + (1ull << HEAD_OFF_BITS) +
+                 u64Block;
+    } while (!head.compare_exchange_weak(u64Head, u64New,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed));
+}
+
+size_t shm_heap::usable(uint64_t u64Off) const
+{
+    auto* pBlock = at<MFW_HEAPBLOCK_T>(u64Off - sizeof(MFW_HEAPBLOCK_T));
+    return ((size_t)SHMHEAP_MIN_BLOCK << pBlock->uClass) -
+           sizeof(MFW_HEAPBLOCK_T);
+}
+
+/**
+ * Scans and claims roots[] like shm_counter scans the counter table. The
+ * storage is allocated and zeroed before the slot is published, so a
+ * process that finds a ready slot always finds a usable object.
+ */
+uint64_t shm_heap::root(const char* pszName, size_t stBytes)
+{
+    for (auto& slot : m_pHeap->roots)
+    {
+        std::atomic_ref<uint32_t> state(slot.uState);
+        uint32_t uState = state.load(std::memory_order_acquire);
+
+        if (SHMHEAP_UNUSED == uState)
+        {
+            uint32_t uExpected = SHMHEAP_UNUSED;
+            if (state.compare_exchange_strong(uExpected,
+                                              SHMHEAP_INITIALIZING,
+                                              std::memory_order_acq_rel))
+            {
+                uint64_t u64Off = allocate(stBytes);
+                if (0 == u64Off)
+                {
+                    state.store(SHMHEAP_UNUSED, std::memory_order_release);
+                    return 0;
+                }
+                memset(at<char>(u64Off), 0, stBytes);
+                strncpy(slot.szName, pszName, SHMHEAP_ROOT_NAME_SIZE - 1);
+                slot.u64Off = u64Off;
+                state.store(SHMHEAP_READY, std::memory_order_release);
+                return u64Off;
+            }
+            uState = uExpected;
+        }
+
+        for (int iSpin = 0;
+             SHMHEAP_INITIALIZING == uState && iSpin < 100000; iSpin++)
+        {
+            sched_yield();
+            uState = state.load(std::memory_order_acquire);
+        }
+
+        if (SHMHEAP_READY == uState &&
+            0 == strncmp(slot.szName, pszName, SHMHEAP_ROOT_NAME_SIZE - 1))
+        {
+            return slot.u64Off;
+        }
+    }
+    return 0;
+}
+
+shm_blob shm_heap::store(const void* pData, size_t stLen)
+{
+    shm_blob blob = {allocate(stLen), stLen};
+    if (0 != blob.u64Off)
+    {
+        memcpy(at<char>(blob.u64Off), pData, stLen);
+    }
+    return blob;
+}
+
+std::string_view shm_heap::view(const shm_blob& blob) const
+{
+    if (!contains(blob.u64Off, blob.u64Len))
+    {
+        return {};
+    }
+    return std::string_view(at<const char>(blob.u64Off), blob.u64Len);
+}
+
+uint64_t shm_heap::used() const
+{
+    return std::atomic_ref<uint64_t>(m_pHeap->u64Used).load(
+        std::memory_order_relaxed);
+}
+
+std::pair<uint64_t, uint64_t> shm_heap::live() const
+{
+    uint64_t u64Blocks = 0;
+    uint64_t u64Bytes = 0;
+    for (uint32_t uClass = 0; uClass < SHMHEAP_CLASSES; uClass++)
+    {
+        uint64_t u64Count = std::atomic_ref<uint64_t>(
+            m_pHeap->u64Live[uClass]).load(std::memory_order_relaxed);
+        u64Blocks += u64Count;
+        u64Bytes += u64Count * ((uint64_t)SHMHEAP_MIN_BLOCK << uClass);
+    }
+    return {u64Blocks, u64Bytes};
+}
+
+uint64_t shm_heap::failures() const
+{
+    return std::atomic_ref<uint64_t>(m_pHeap->u64Failures).load(
+        std::memory_order_relaxed);
+}
+
+void shm_heap::for_each_root(
+    const std::function<void(const char*, uint64_t)>& fn) const
+{
+    for (auto& slot : m_pHeap->roots)
+    {
+        if (SHMHEAP_READY == std::atomic_ref<uint32_t>(
+                const_cast<uint32_t&>(slot.uState)).load(
+                std::memory_order_acquire))
+        {
+            fn(slot.szName, slot.u64Off);
+        }
+    }
+}
+
+/**
+ * The new blob is written before the map lock is taken, and the map
+ * frees the blob it replaces.
+ */
+bool shm_string_map::set(std::string_view svKey, std::string_view svValue)
+{
+    shm_blob blob = m_heap.store(svValue.data(), svValue.size());
+    if (0 == blob.u64Off)
+    {
+        return false;
+    }
+    if (!insert_or_assign(svKey, blob))
+    {
+        m_heap.release(blob);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * The bytes are copied inside read(), so a value replaced while it was
+ * being copied is retried rather than returned torn.
+ */
+bool shm_string_map::get(std::string_view svKey, std::string& ssValue) const
+{
+    return read(svKey, [&](const shm_blob& blob) {
+        ssValue.assign(m_heap.view(blob));
+    });
+}
+
+/////////////////////////
+// eof - shMemHeap.cpp //
+/////////////////////////
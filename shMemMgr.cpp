@@ -24,17 +24,23 @@
 SharedMemoryManager::SharedMemoryManager(const char* name)
     : mutex_(name)
 {
-    // Create mutex with a unique name
+    // Create one lock per region, named after the segment lock
+    for (int i = 0; i < SHM_REGION_COUNT; i++)
+    {
+        char szName[CFG_MUTEX_MAX_SIZE];
+        snprintf(szName, sizeof(szName), "%s.%s", name,
+                 getRegionName((shm_region_t)i));
+        m_pRegion[i] = std::make_unique<SharedMemoryMutex>(szName);
+    }
 }
 
 /**
- * Acquires a lock on the shared memory to ensure thread-safe and
- * synchronized access to shared resources.
+ * Acquires a lock on the whole shared memory segment.
  *
- * This method uses a `SharedMemoryMutex` in conjunction with a
- * RAII-style `std::lock_guard` to automatically manage the lock lifecycle.
- * The lock is acquired upon calling this method and will remain active
- * until the lifetime of the `std::lock_guard` object ends.
+ * The segment lock is taken first and then every region lock in
+ * ascending shm_region_t order, which is the same order any multi-region
+ * caller must use, so this cannot deadlock against region guards. The
+ * locks stay held until releaseSharedMemory() is called.
  *
  * Thread-safety: This function ensures that access to the shared memory
  * resource is safely coordinated between multiple threads or processes.
@@ -48,7 +54,11 @@ SharedMemoryManager::SharedMemoryManager(const char* name)
  */
 void SharedMemoryManager::lockSharedMemory()
 {
-    std::lock_guard<SharedMemoryMutex> lock(mutex_);
+    mutex_.lock();
+    for (int i = 0; i < SHM_REGION_COUNT; i++)
+    {
+        m_pRegion[i]->lock();
+    }
 }
 
 /**
@@ -84,10 +94,10 @@ void SharedMemoryManager::accessSharedMemory()
 /**
  * Releases the lock held on the shared memory resource.
  *
- * This method ensures that the mutex associated with the shared memory
- * is safely unlocked, using RAII (Resource Acquisition Is Initialization)
- * principles. It is typically called after shared memory operations are
- * completed to allow other threads or processes to access the resource.
+ * The region locks are released in descending order and the segment
+ * lock last, undoing lockSharedMemory(). It is typically called after
+ * shared memory operations are completed to allow other processes to
+ * access the segment.
  *
  * Note:
  * - Proper usage involves locking the shared memory using the corresponding
@@ -96,12 +106,67 @@ void SharedMemoryManager::accessSharedMemory()
  *   could lead to deadlock or resource contention in a multi-threaded
  *   environment.
  *
- * Thread safety:
- * - This method uses a `std::lock_guard` to automatically manage the
- *   locking and unlocking of the `SharedMemoryMutex` object.
  */
 void SharedMemoryManager::releaseSharedMemory()
 {
-    // RAII-style unlocking
-    std::lock_guard<SharedMemoryMutex> unlock(mutex_);
+    for (int i = SHM_REGION_COUNT - 1; i >= 0; i--)
+    {
+        m_pRegion[i]->unlock();
+    }
+    mutex_.unlock();
+}
+
+/**
+ * Acquires the lock of a single region of the shared memory segment.
+ *
+ * @param region The region to lock.
+ */
+void SharedMemoryManager::lockRegion(shm_region_t region)
+{
+    m_pRegion[region]->lock();
+}
+
+/**
+ * Releases the lock of a single region of the shared memory segment.
+ *
+ * @param region The region to unlock.
+ */
+void SharedMemoryManager::unlockRegion(shm_region_t region)
+{
+    m_pRegion[region]->unlock();
 }
+
+/**
+ * Returns the mutex guarding a region.
+ *
+ * @param region The region of interest.
+ * @return A reference to the region's SharedMemoryMutex.
+ */
+SharedMemoryMutex& SharedMemoryManager::getRegionMutex(shm_region_t region)
+{
+    return *m_pRegion[region];
+}
+
+/**
+ * Returns the short name of a region, which is also the suffix of its
+ * lock name in the shared lock table.
+ *
+ * @param region The region of interest.
+ * @return A static string such as "config" or "prefs".
+ */
+const char* SharedMemoryManager::getRegionName(shm_region_t region)
+{
+    switch (region)
+    {
+    case SHM_REGION_CONFIG: return "config";
+    case SHM_REGION_CREDS:  return "creds";
+    case SHM_REGION_PREFS:  return "prefs";
+    case SHM_REGION_TESTS:  return "tests";
+    case SHM_REGION_LEDS:   return "leds";
+    default:                return "unknown";
+    }
+}
+
+////////////////////////
+// eof - shMemMgr.cpp //
+////////////////////////
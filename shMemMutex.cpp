@@ -9,88 +9,277 @@
 #include "mwfw2.h"
 
 /**
- * Constructs a SharedMemoryMutex object by creating or opening a named
- * semaphore.
+ * Returns CLOCK_MONOTONIC in nanoseconds. clock_gettime() is served by
+ * the vDSO, so timing a contended wait costs no extra system call.
+ */
+static uint64_t monotonic_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Initializes the mutex of a slot this process has claimed, names it and
+ * publishes it as ready.
  *
- * This constructor initializes a POSIX named semaphore with the given name.
- * If the semaphore cannot be created or opened, it throws a
- * `std::system_error` exception with the specific error code and message.
+ * @throws std::system_error if pthread_mutex_init() fails; the slot is
+ *         then unused again.
+ */
+static void init_slot(MFW_SHMLOCK_T& slot, const char* name)
+{
+    std::atomic_ref<uint32_t> state(slot.uState);
+
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+    int rc = pthread_mutex_init(&slot.mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+    if (0 != rc)
+    {
+        state.store(SHMLOCK_UNUSED, std::memory_order_release);
+        throw std::system_error(rc, std::system_category(),
+                                "pthread_mutex_init failed");
+    }
+    strncpy(slot.szName, name, CFG_MUTEX_MAX_SIZE - 1);
+    state.store(SHMLOCK_READY, std::memory_order_release);
+}
+
+/**
+ * Claims a slot left SHMLOCK_INITIALIZING by a process that died before
+ * publishing it. A slot whose initializer never got to record its pid
+ * counts as abandoned too, since by the time this is asked the
+ * initializer has had a long spin to do so.
  *
- * @param name A pointer to a null-terminated string representing the name of
- *             the semaphore. The name should start with a forward slash ('/')
- *             and be followed by one or more characters.
- * @return A new instance of SharedMemoryMutex with the semaphore initialized.
- *         Throws a `std::system_error` if semaphore initialization fails.
+ * @return True if this process is now the slot's initializer.
+ */
+static bool take_over(MFW_SHMLOCK_T& slot)
+{
+    std::atomic_ref<pid_t> owner(slot.pidInit);
+    pid_t pid = owner.load(std::memory_order_acquire);
+    if (0 != pid && (0 == kill(pid, 0) || EPERM == errno))
+    {
+        return false;
+    }
+    return owner.compare_exchange_strong(pid, getpid(),
+                                         std::memory_order_acq_rel);
+}
+
+/**
+ * Constructs a SharedMemoryMutex object bound to the named lock in the
+ * shared segment.
+ *
+ * The locks[] table is scanned in order. A slot that is ready and
+ * carries the requested name is reused. The first unused slot is claimed
+ * with a CAS, and its mutex is initialized as process-shared and robust
+ * before the slot is published as ready. A slot that another process is
+ * still initializing is waited for, so that two processes asking for the
+ * same new name always end up on the same slot; if that process has died
+ * meanwhile, the slot is taken over and initialized afresh.
+ *
+ * @param name A pointer to a null-terminated string naming the lock.
+ * @throws std::system_error if the table is full or initialization
+ *         fails.
  */
 SharedMemoryMutex::SharedMemoryMutex(const char* name)
 {
-    // Create or open a named semaphore
-    mutex_ = sem_open(name, O_CREAT, 0644, 1);
-    if (mutex_ == SEM_FAILED)
+    m_pLock = nullptr;
+
+    for (auto& slot : gpSh->m_pShMemng->locks)
     {
-        throw std::system_error(errno, std::system_category(),
-                                "sem_open failed");
+        std::atomic_ref<uint32_t> state(slot.uState);
+        uint32_t uState = state.load(std::memory_order_acquire);
+
+        if (SHMLOCK_UNUSED == uState)
+        {
+            uint32_t uExpected = SHMLOCK_UNUSED;
+            if (state.compare_exchange_strong(uExpected,
+                                              SHMLOCK_INITIALIZING,
+                                              std::memory_order_acq_rel))
+            {
+                std::atomic_ref<pid_t>(slot.pidInit).store(
+                    getpid(), std::memory_order_release);
+                init_slot(slot, name);
+                m_pLock = &slot;
+                return;
+            }
+            uState = uExpected;
+        }
+
+        // Another process is initializing this slot; wait until it is
+        // published before looking at its name.
+        while (SHMLOCK_INITIALIZING == uState)
+        {
+            for (int iSpin = 0;
+                 SHMLOCK_INITIALIZING == uState && iSpin < 100000; iSpin++)
+            {
+                sched_yield();
+                uState = state.load(std::memory_order_acquire);
+            }
+            if (SHMLOCK_INITIALIZING == uState && take_over(slot))
+            {
+                if (nullptr != gpSysLog)
+                {
+                    gpSysLog->loginfo("SharedMemoryMutex: took over a lock "
+                                      "slot abandoned while initializing");
+                }
+                init_slot(slot, name);
+                m_pLock = &slot;
+                return;
+            }
+            uState = state.load(std::memory_order_acquire);
+        }
+
+        if (SHMLOCK_READY == uState &&
+            0 == strncmp(slot.szName, name, CFG_MUTEX_MAX_SIZE - 1))
+        {
+            m_pLock = &slot;
+            return;
+        }
     }
+
+    throw std::system_error(ENOSPC, std::system_category(),
+                            "shared lock table is full");
 }
 
 /**
  * @brief Destructor for the SharedMemoryMutex class.
  *
- * This destructor is responsible for cleaning up the underlying semaphore
- * used by the SharedMemoryMutex instance. If the semaphore was successfully
- * initialized and is not in an invalid state (`SEM_FAILED`), it is closed
- * to release system resources. This ensures proper resource management and
- * avoids potential resource leaks.
+ * The pthread mutex lives in the shared segment and outlives every
+ * process that uses it, so the destructor deliberately leaves it alone.
  */
-SharedMemoryMutex::~SharedMemoryMutex()
+SharedMemoryMutex::~SharedMemoryMutex() = default;
+
+/**
+ * Updates the statistics of the lock. Called only while the lock is
+ * held, which is what makes plain increments safe here.
+ */
+void SharedMemoryMutex::record_acquisition(bool bContended,
+                                           uint64_t u64WaitNs)
 {
-    if (mutex_ != SEM_FAILED)
+    m_pLock->u64Acquisitions++;
+    if (bContended)
     {
-        sem_close(mutex_);
+        m_pLock->u64Contentions++;
+        m_pLock->u64WaitNsTotal += u64WaitNs;
+        if (u64WaitNs > m_pLock->u64WaitNsMax)
+        {
+            m_pLock->u64WaitNsMax = u64WaitNs;
+        }
+    }
+}
+
+/**
+ * Takes over a mutex whose owner died holding it: marks it consistent,
+ * counts the death and logs it, if gpSysLog exists yet; the config block
+ * takes its lock before it does.
+ */
+void SharedMemoryMutex::recover()
+{
+    pthread_mutex_consistent(&m_pLock->mutex);
+    m_pLock->u64OwnerDeaths++;
+    if (nullptr != gpSysLog)
+    {
+        std::string ssMsg = "SharedMemoryMutex: recovered lock ";
+        ssMsg += m_pLock->szName;
+        ssMsg += " from a dead owner";
+        gpSysLog->loginfo(ssMsg.c_str());
     }
 }
 
 /**
  * Acquires the lock for the shared memory mutex.
  *
- * The lock() method attempts to decrement (wait on) the semaphore associated
- * with the shared memory mutex. This operation blocks the calling thread
- * until the semaphore value is greater than zero, effectively acquiring the
- * lock.
+ * The fast path is pthread_mutex_trylock(), which for an uncontended
+ * mutex is a single atomic operation on the futex word. Only when that
+ * fails does the call block in pthread_mutex_lock(), and the wait is
+ * timed for the statistics. EOWNERDEAD means the previous holder exited
+ * without unlocking; the protected data may be half-updated, but every
+ * structure guarded by these locks is plain strings and counters, so the
+ * mutex is simply marked consistent and the recovery is counted.
  *
- * If the semaphore operation fails (e.g., due to an interruption or internal
- * error), a `std::system_error` exception is thrown with the appropriate
- * error code and description.
+ * @throws std::system_error if the mutex cannot be acquired.
+ */
+void SharedMemoryMutex::lock()
+{
+    bool bContended = false;
+    uint64_t u64WaitNs = 0;
+
+    int rc = pthread_mutex_trylock(&m_pLock->mutex);
+    if (EBUSY == rc)
+    {
+        bContended = true;
+        uint64_t u64Start = monotonic_ns();
+        rc = pthread_mutex_lock(&m_pLock->mutex);
+        u64WaitNs = monotonic_ns() - u64Start;
+    }
+
+    if (EOWNERDEAD == rc)
+    {
+        recover();
+        rc = 0;
+    }
+
+    if (0 != rc)
+    {
+        throw std::system_error(rc, std::system_category(),
+                                "pthread_mutex_lock failed");
+    }
+
+    record_acquisition(bContended, u64WaitNs);
+}
+
+/**
+ * Attempts to acquire the lock without blocking. A lock abandoned by a
+ * dead owner is recovered exactly as in lock().
  *
- * @throws std::system_error Thrown if the semaphore operation (`sem_wait`)
- * fails.
+ * @return True if the lock is now held by the caller.
  */
-void SharedMemoryMutex::SharedMemoryMutex::lock()
+bool SharedMemoryMutex::try_lock()
 {
-    if (sem_wait(mutex_) != 0)
+    int rc = pthread_mutex_trylock(&m_pLock->mutex);
+    if (EOWNERDEAD == rc)
+    {
+        recover();
+        rc = 0;
+    }
+    if (0 != rc)
     {
-        throw std::system_error(errno, std::system_category(),
-                                "sem_wait failed");
+        return false;
     }
+    record_acquisition(false, 0);
+    return true;
 }
 
 /**
  * Releases the lock held by the shared memory mutex.
  *
- * This method increments the value of the semaphore, allowing other processes
- * or threads waiting to acquire the lock to proceed. It indicates that the
- * critical section is no longer being accessed. If the semaphore operation
- * fails, a `std::system_error` exception is thrown, providing detailed
- * information about the error.
- *
- * @throws std::system_error if the semaphore operation (`sem_post`) fails,
- *         including the error code and a corresponding message.
+ * Failure, for example because the calling thread does not own the
+ * mutex, is logged rather than thrown: this runs in std::lock_guard's
+ * destructor, where an exception would terminate the process.
  */
-void SharedMemoryMutex::unlock()
+void SharedMemoryMutex::unlock() noexcept
 {
-    if (sem_post(mutex_) != 0)
+    int rc = pthread_mutex_unlock(&m_pLock->mutex);
+    if (0 != rc && nullptr != gpSysLog)
     {
-        throw std::system_error(errno, std::system_category(),
-                                "sem_post failed");
+        std::string ssMsg = "SharedMemoryMutex::unlock: "
+            "pthread_mutex_unlock failed (";
+        ssMsg += strerror(rc);
+        ssMsg += ")";
+        gpSysLog->loginfo(ssMsg.c_str());
     }
 }
+
+/**
+ * Returns the lock slot this object is bound to.
+ */
+const MFW_SHMLOCK_T* SharedMemoryMutex::get_lock() const
+{
+    return m_pLock;
+}
+
+//////////////////////////
+// eof - shMemMutex.cpp //
+//////////////////////////
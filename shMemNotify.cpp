@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/shMemNotify.cpp 2026-10-17 15:05 dwg -        //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#include "mwfw2.h"
+
+static_assert(SHM_CHANNEL_COUNT <= CFG_SHM_NOTIFY_CHANNELS,
+              "CFG_SHM_NOTIFY_CHANNELS is too small");
+static_assert((int)SHM_CHANNEL_LEDS == (int)SHM_REGION_LEDS &&
+              (int)SHM_REGION_COUNT == 5,
+              "region channels must match shm_region_t");
+
+// The futexes below never use FUTEX_PRIVATE_FLAG: waiters and publishers
+// are different processes that map the segment at different addresses.
+
+/**
+ * An acquire load, so state read after it is at least as new as the
+ * generation returned.
+ */
+uint32_t shm_notify::generation(shm_channel_t channel)
+{
+    return std::atomic_ref<uint32_t>(
+        gpSh->m_pShMemng->notify.channels[channel].uGeneration).load(
+        std::memory_order_acquire);
+}
+
+/**
+ * Advances one generation word and wakes its waiters, if any.
+ *
+ * The generation is advanced before uWaiters is read, and wait() counts
+ * itself in uWaiters before it reads the generation. Both are sequentially
+ * consistent, so either the publisher sees the waiter and wakes it or the
+ * waiter sees the new generation and does not sleep.
+ */
+static void advance(shm_channel_t channel)
+{
+    auto& slot = gpSh->m_pShMemng->notify.channels[channel];
+    std::atomic_ref<uint32_t>(slot.uGeneration).fetch_add(1);
+    if (0 != std::atomic_ref<uint32_t>(slot.uWaiters).load())
+    {
+        syscall(SYS_futex, &slot.uGeneration, FUTEX_WAKE, INT_MAX,
+                nullptr, nullptr, 0);
+    }
+}
+
+/**
+ * Advances the channel and then SHM_CHANNEL_ANY.
+ */
+void shm_notify::publish(shm_channel_t channel)
+{
+    advance(channel);
+    if (SHM_CHANNEL_ANY != channel)
+    {
+        advance(SHM_CHANNEL_ANY);
+    }
+}
+
+/**
+ * FUTEX_WAIT sleeps only while the word still equals uSeen, so a publish
+ * that lands between the check and the system call is not missed. Signals
+ * and spurious wake-ups just go round the loop again, with the remaining
+ * time recomputed from a monotonic deadline.
+ */
+bool shm_notify::wait(shm_channel_t channel, uint32_t uSeen, int iTimeoutMs)
+{
+    auto& slot = gpSh->m_pShMemng->notify.channels[channel];
+    std::atomic_ref<uint32_t> gen(slot.uGeneration);
+    std::atomic_ref<uint32_t> waiters(slot.uWaiters);
+
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(iTimeoutMs);
+
+    waiters.fetch_add(1);
+    bool bChanged = false;
+    for (;;)
+    {
+        if (gen.load() != uSeen)
+        {
+            bChanged = true;
+            break;
+        }
+
+        struct timespec ts;
+        struct timespec* pts = nullptr;
+        if (iTimeoutMs >= 0)
+        {
+            auto remaining = deadline - std::chrono::steady_clock::now();
+            if (remaining <= std::chrono::nanoseconds::zero())
+            {
+                break;
+            }
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                remaining).count();
+            ts.tv_sec = ns / 1000000000;
+            ts.tv_nsec = ns % 1000000000;
+            pts = &ts;
+        }
+        syscall(SYS_futex, &slot.uGeneration, FUTEX_WAIT, uSeen, pts,
+                nullptr, 0);
+    }
+    waiters.fetch_sub(1);
+    return bChanged;
+}
+
+///////////////////////////
+// eof - shMemNotify.cpp //
+///////////////////////////
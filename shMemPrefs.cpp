@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/shMemPrefs.cpp 2026-10-17 17:05 dwg -         //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#include "mwfw2.h"
+
+/**
+ * Called by a reader that has seen the odd sequence uOdd for
+ * CFG_SEQLOCK_STALL yields. Writers hold the prefs region lock
+ * throughout, so if the lock is free and the sequence has not moved,
+ * its writer died, and the sequence is made even.
+ */
+static void unwedge(std::atomic_ref<uint32_t>& seq, uint32_t uOdd)
+{
+    SharedMemoryMutex& lock = gpShMemMgr->getRegionMutex(SHM_REGION_PREFS);
+    if (lock.try_lock())
+    {
+        seq.compare_exchange_strong(uOdd, uOdd + 1,
+                                    std::memory_order_release);
+        lock.unlock();
+    }
+}
+
+/**
+ * Reads whichever copy is published. The copy's sequence number is
+ * checked around the memcpy exactly like the seqlock of the config pool;
+ * it only moves if two publishes completed during the read. A sequence
+ * that stays odd is handed to unwedge().
+ */
+bool SharedMemoryPrefs::load(int iHandle, MFW_PREFS_T& prefs)
+{
+    if (iHandle < 0 || iHandle >= SHM_PREFS_HANDLES)
+    {
+        return false;
+    }
+    MFW_PREFS_SLOT_T& slot = gpSh->m_pShMemng->prefs[iHandle];
+    std::atomic_ref<uint32_t> active(slot.uActive);
+
+    int iStall = 0;
+    for (;;)
+    {
+        uint32_t uCopy = active.load(std::memory_order_acquire) & 1;
+        std::atomic_ref<uint32_t> seq(slot.uSequence[uCopy]);
+        uint32_t uBefore = seq.load(std::memory_order_acquire);
+        if (uBefore & 1)
+        {
+            if (++iStall >= CFG_SEQLOCK_STALL)
+            {
+                iStall = 0;
+                unwedge(seq, uBefore);
+            }
+            sched_yield();
+            continue;
+        }
+        memcpy(&prefs, &slot.copies[uCopy], sizeof(MFW_PREFS_T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq.load(std::memory_order_relaxed) == uBefore)
+        {
+            return true;
+        }
+    }
+}
+
+/**
+ * Writers are serialised by the prefs region lock, so the copy that is
+ * not published belongs to this writer alone until it flips uActive.
+ * The copy's sequence is rounded up to odd first, in case the last
+ * writer of that copy died mid-copy and left it odd.
+ */
+bool SharedMemoryPrefs::publish(int iHandle, const MFW_PREFS_T& prefs)
+{
+    if (iHandle < 0 || iHandle >= SHM_PREFS_HANDLES)
+    {
+        return false;
+    }
+    MFW_PREFS_SLOT_T& slot = gpSh->m_pShMemng->prefs[iHandle];
+    std::atomic_ref<uint32_t> active(slot.uActive);
+    {
+        shmPrefsGuard guard;
+        uint32_t uCopy = active.load(std::memory_order_relaxed) & 1;
+        if (0 == memcmp(&slot.copies[uCopy], &prefs, sizeof(MFW_PREFS_T)))
+        {
+            return true;
+        }
+
+        uint32_t uNext = uCopy ^ 1;
+        std::atomic_ref<uint32_t> seq(slot.uSequence[uNext]);
+        uint32_t uOdd = seq.load(std::memory_order_relaxed) | 1;
+        seq.store(uOdd, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(&slot.copies[uNext], &prefs, sizeof(MFW_PREFS_T));
+        seq.store(uOdd + 1, std::memory_order_release);
+        active.store(uNext, std::memory_order_release);
+    }
+    shm_notify::publish(SHM_CHANNEL_PREFS);
+    return true;
+}
+
+void SharedMemoryPrefs::set(char (&szColor)[COLOR_SIZE_MAX],
+                            const std::string& ssValue)
+{
+    memset(szColor, 0, COLOR_SIZE_MAX);
+    strncpy(szColor, ssValue.c_str(), COLOR_SIZE_MAX - 1);
+}
+
+void SharedMemoryPrefs::migrate(void* pDst, const void* pSrc,
+                                size_t stDst, size_t stSrc)
+{
+    auto* pTo = (MFW_PREFS_SLOT_T*)pDst;
+    size_t stSlots = stDst / sizeof(MFW_PREFS_SLOT_T);
+
+    if (stSrc == stDst)
+    {
+        // The copies are consistent only between publishes; take the
+        // published one of each slot through load()'s protocol. This
+        // runs before the region locks exist, so a copy left odd by a
+        // dead writer is taken as it stands after CFG_SEQLOCK_STALL
+        // tries rather than waited on forever.
+        auto* pFrom = (MFW_PREFS_SLOT_T*)pSrc;
+        for (size_t i = 0; i < stSlots; i++)
+        {
+            std::atomic_ref<uint32_t> active(pFrom[i].uActive);
+            for (int iTry = 0; iTry < CFG_SEQLOCK_STALL; iTry++)
+            {
+                uint32_t uCopy = active.load(std::memory_order_acquire) & 1;
+                std::atomic_ref<uint32_t> seq(pFrom[i].uSequence[uCopy]);
+                uint32_t uBefore = seq.load(std::memory_order_acquire);
+                memcpy(&pTo[i].copies[0], &pFrom[i].copies[uCopy],
+                       sizeof(MFW_PREFS_T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (0 == (uBefore & 1) &&
+                    seq.load(std::memory_order_relaxed) == uBefore)
+                {
+                    break;
+                }
+                sched_yield();
+            }
+        }
+        return;
+    }
+
+    if (stSrc == SHM_PREFS_HANDLES * sizeof(MFW_PREFS_T))
+    {
+        auto* pFrom = (const MFW_PREFS_T*)pSrc;
+        for (size_t i = 0; i < stSlots; i++)
+        {
+            pTo[i].copies[0] = pFrom[i];
+        }
+    }
+}
+
+//////////////////////////
+// eof - shMemPrefs.cpp //
+//////////////////////////
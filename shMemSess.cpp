@@ -0,0 +1,769 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/shMemSess.cpp 2026-10-17 06:50 dwg -          //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#include "mwfw2.h"
+
+static_assert((CFG_SESSION_INDEX_SIZE & (CFG_SESSION_INDEX_SIZE - 1)) == 0,
+              "CFG_SESSION_INDEX_SIZE must be a power of two");
+static_assert(CFG_SESSION_INDEX_SIZE >= 2 * CFG_MAX_SESSIONS,
+              "session index load factor must stay at or below one half");
+static_assert(offsetof(MFW_SESSION_T, tCreated) == 16,
+              "uLease must fit in the former padding before tCreated");
+
+/**
+ * Picks the wheel bucket for a session that expires at second uExpiry,
+ * when the wheel has been swept up to second uTick.
+ *
+ * The level is the lowest whose span covers the remaining time, and the
+ * bucket within it is taken from the deadline's own bits, so the bucket
+ * comes round at the start of the deadline's slice of that level: never
+ * after the deadline, and never before the next sweep. A deadline that is
+ * already due goes in the next second's bucket; one beyond the span of the
+ * wheel is parked in the top level and rescheduled when it comes round.
+ */
+static uint32_t wheel_bucket(uint32_t uTick, uint32_t uExpiry)
+{
+    if (uExpiry <= uTick)
+    {
+        uExpiry = uTick + 1;
+    }
+    if (uExpiry - uTick >= SESSION_WHEEL_SPAN)
+    {
+        uExpiry = uTick + SESSION_WHEEL_SPAN - 1;
+    }
+    uint32_t uDelta = uExpiry - uTick;
+    int iLevel = 0;
+    while (iLevel < CFG_WHEEL_LEVELS - 1 &&
+           uDelta >= (1u << (CFG_WHEEL_SHIFT * (iLevel + 1))))
+    {
+        iLevel++;
+    }
+    return iLevel * SESSION_WHEEL_SLOTS +
+           ((uExpiry >> (CFG_WHEEL_SHIFT * iLevel)) & (SESSION_WHEEL_SLOTS - 1));
+}
+
+/**
+ * Takes a slot off the wheel, if it is on it. Caller holds the lock.
+ */
+static void wheel_unlink(MFW_SESSION_TABLE_T* pTable, uint32_t uSlot)
+{
+    auto& wheel = pTable->wheel;
+    auto& link = wheel.links[uSlot];
+    if (0 == link.uBucket)
+    {
+        return;
+    }
+    if (link.uPrev)
+    {
+        wheel.links[link.uPrev - 1].uNext = link.uNext;
+    }
+    else
+    {
+        wheel.buckets[link.uBucket - 1] = link.uNext;
+    }
+    if (link.uNext)
+    {
+        wheel.links[link.uNext - 1].uPrev = link.uPrev;
+    }
+    link.uNext = link.uPrev = link.uBucket = 0;
+    wheel.uScheduled--;
+}
+
+/**
+ * (Re)schedules a slot to expire at second uExpiry. Caller holds the lock.
+ */
+static void wheel_schedule(MFW_SESSION_TABLE_T* pTable, uint32_t uSlot,
+                           uint32_t uExpiry)
+{
+    wheel_unlink(pTable, uSlot);
+    auto& wheel = pTable->wheel;
+    uint32_t uBucket = wheel_bucket(wheel.uTick, uExpiry);
+    auto& link = wheel.links[uSlot];
+    link.uBucket = uBucket + 1;
+    link.uPrev = 0;
+    link.uNext = wheel.buckets[uBucket];
+    if (link.uNext)
+    {
+        wheel.links[link.uNext - 1].uPrev = uSlot + 1;
+    }
+    wheel.buckets[uBucket] = uSlot + 1;
+    wheel.uScheduled++;
+}
+
+/**
+ * Empties one bucket and returns its former members, appended to vSlots.
+ * Caller holds the lock.
+ */
+static void wheel_detach(MFW_SESSION_TABLE_T* pTable, uint32_t uBucket,
+                         std::vector<uint32_t>& vSlots)
+{
+    auto& wheel = pTable->wheel;
+    for (uint32_t uNext = wheel.buckets[uBucket]; uNext; )
+    {
+        auto& link = wheel.links[uNext - 1];
+        vSlots.push_back(uNext - 1);
+        uNext = link.uNext;
+        link.uNext = link.uPrev = link.uBucket = 0;
+        wheel.uScheduled--;
+    }
+    wheel.buckets[uBucket] = 0;
+}
+
+/**
+ * Rebuilds the index without its tombstones. Entries are put back in the
+ * order they stood, starting after an empty entry so that no run is cut
+ * in two, which puts each no further from its home position than it was
+ * and so keeps it within CFG_SESSION_MAX_PROBE. Lookups that miss while
+ * uIndexGen is odd, or has moved, look again. Caller holds the lock.
+ */
+static void index_rebuild(MFW_SESSION_TABLE_T* pTable)
+{
+    const uint32_t uMask = CFG_SESSION_INDEX_SIZE - 1;
+    uint32_t uStart = 0;
+    while (uStart < CFG_SESSION_INDEX_SIZE &&
+           SESSION_INDEX_EMPTY != pTable->index[uStart])
+    {
+        uStart++;
+    }
+
+    std::vector<uint64_t> vEntries;
+    vEntries.reserve(pTable->uLive);
+    for (uint32_t u = 0; u < CFG_SESSION_INDEX_SIZE; u++)
+    {
+        uint64_t uEntry = pTable->index[(uStart + u) & uMask];
+        if (SESSION_INDEX_EMPTY != uEntry && SESSION_INDEX_TOMBSTONE != uEntry)
+        {
+            vEntries.push_back(uEntry);
+        }
+    }
+
+    std::atomic_ref<uint32_t> gen(pTable->uIndexGen);
+    gen.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (uint32_t u = 0; u < CFG_SESSION_INDEX_SIZE; u++)
+    {
+        std::atomic_ref<uint64_t>(pTable->index[u]).store(
+            SESSION_INDEX_EMPTY, std::memory_order_relaxed);
+    }
+    for (uint64_t uEntry : vEntries)
+    {
+        uint32_t uPos = (uint32_t)(uEntry >> 32) & uMask;
+        while (SESSION_INDEX_EMPTY != pTable->index[uPos])
+        {
+            uPos = (uPos + 1) & uMask;
+        }
+        std::atomic_ref<uint64_t>(pTable->index[uPos]).store(
+            uEntry, std::memory_order_relaxed);
+    }
+    pTable->uTombs = 0;
+    gen.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * Constructs the session table accessor. The table itself lives in the
+ * shared segment and is zero-filled when the segment is created, which
+ * is exactly the "all slots free, all index entries empty" state, so no
+ * further initialization is needed here.
+ */
+SharedMemorySessions::SharedMemorySessions()
+{
+    m_pTable = &gpSh->m_pShMemng->sessions;
+    m_pLock = std::make_unique<SharedMemoryMutex>(CFG_MUTEX_NAME ".sessions");
+}
+
+/**
+ * FNV-1a over the UUID text. UUIDs are already random, so the hash only
+ * has to be cheap and spread the 36 characters across 32 bits.
+ */
+uint32_t SharedMemorySessions::hash(const char* pszUUID)
+{
+    uint32_t h = 2166136261u;
+    for (const char* p = pszUUID; *p; p++)
+    {
+        h ^= (uint8_t)*p;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * Takes a consistent copy of one slot. The copy is bracketed by two
+ * loads of the slot generation; if a writer got in between, or the slot
+ * is not live, the copy is discarded. A torn copy can only mean the slot
+ * was released and reused, so the caller treats it as "not found" rather
+ * than retrying, which is what keeps readers wait-free.
+ */
+bool SharedMemorySessions::copy_slot(uint32_t uSlot, MFW_SESSION_T& sess)
+{
+    MFW_SESSION_T* pSlot = &m_pTable->slots[uSlot];
+    std::atomic_ref<uint32_t> gen(pSlot->uGeneration);
+    std::atomic_ref<uint32_t> state(pSlot->uState);
+
+    uint32_t uGen1 = gen.load(std::memory_order_acquire);
+    if ((uGen1 & 1) || state.load(std::memory_order_acquire) !=
+        SESSION_SLOT_LIVE)
+    {
+        return false;
+    }
+    memcpy(&sess, pSlot, sizeof(MFW_SESSION_T));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return uGen1 == gen.load(std::memory_order_relaxed);
+}
+
+/**
+ * Claims a free slot, fills it, marks it live and then publishes it in
+ * the UUID index. The slot is fully written before the index entry that
+ * points to it becomes visible, so a reader that finds the entry always
+ * finds a complete session behind it. Publishing it and putting it on the
+ * timing wheel are the only steps that take the sessions lock.
+ */
+int SharedMemorySessions::create(const MFW_SESSION_T& sess)
+{
+    if (0 == sess.szAuthUUID[0])
+    {
+        return -1;
+    }
+
+    // Claim a slot, starting from a rotating hint so that concurrent
+    // logins spread out instead of all fighting over slot zero.
+    std::atomic_ref<uint32_t> cursor(m_pTable->uCursor);
+    uint32_t uStart = cursor.fetch_add(1, std::memory_order_relaxed);
+    int iSlot = -1;
+    for (uint32_t i = 0; i < CFG_MAX_SESSIONS; i++)
+    {
+        uint32_t uSlot = (uStart + i) % CFG_MAX_SESSIONS;
+        std::atomic_ref<uint32_t> state(m_pTable->slots[uSlot].uState);
+        uint32_t uExpected = SESSION_SLOT_FREE;
+        if (state.compare_exchange_strong(uExpected, SESSION_SLOT_CLAIMED,
+                                          std::memory_order_acq_rel))
+        {
+            iSlot = (int)uSlot;
+            break;
+        }
+    }
+    if (-1 == iSlot)
+    {
+        gpSysLog->loginfo("SharedMemorySessions::create: table is full");
+        return -1;
+    }
+
+    // Fill the slot between an odd and an even generation.
+    MFW_SESSION_T* pSlot = &m_pTable->slots[iSlot];
+    std::atomic_ref<uint32_t> gen(pSlot->uGeneration);
+    gen.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    size_t stOffset = offsetof(MFW_SESSION_T, iAuthHandle);
+    memcpy((char*)pSlot + stOffset, (const char*)&sess + stOffset,
+           sizeof(MFW_SESSION_T) - stOffset);
+    pSlot->szAuthUUID[UUID_SIZE - 1] = 0;
+    if (0 == pSlot->tCreated)
+    {
+        pSlot->tCreated = time(nullptr);
+    }
+    if (0 == pSlot->uLease)
+    {
+        pSlot->uLease = now() + CFG_SESSION_LEASE_S;
+    }
+
+    gen.fetch_add(1, std::memory_order_release);
+    std::atomic_ref<uint32_t>(pSlot->uState).store(
+        SESSION_SLOT_LIVE, std::memory_order_release);
+
+    // Publish the slot in the index. Tombstones left by earlier logouts
+    // are reused; UUIDs are unique so no duplicate check is needed.
+    uint32_t uHash = hash(pSlot->szAuthUUID);
+    uint64_t uEntry = ((uint64_t)uHash << 32) | (uint64_t)(iSlot + 1);
+    uint32_t uPos = uHash & (CFG_SESSION_INDEX_SIZE - 1);
+    bool bIndexed = false;
+    {
+        std::lock_guard<SharedMemoryMutex> guard(*m_pLock);
+        for (int iProbe = 0; iProbe < CFG_SESSION_MAX_PROBE; iProbe++)
+        {
+            std::atomic_ref<uint64_t> entry(m_pTable->index[uPos]);
+            uint64_t uCur = entry.load(std::memory_order_relaxed);
+            if (SESSION_INDEX_EMPTY == uCur || SESSION_INDEX_TOMBSTONE == uCur)
+            {
+                entry.store(uEntry, std::memory_order_release);
+                if (SESSION_INDEX_TOMBSTONE == uCur)
+                {
+                    m_pTable->uTombs--;
+                }
+                std::atomic_ref<uint32_t>(m_pTable->uLive).fetch_add(
+                    1, std::memory_order_relaxed);
+                wheel_schedule(m_pTable, (uint32_t)iSlot, pSlot->uLease);
+                bIndexed = true;
+                break;
+            }
+            uPos = (uPos + 1) & (CFG_SESSION_INDEX_SIZE - 1);
+        }
+    }
+    if (bIndexed)
+    {
+        shm_notify::publish(SHM_CHANNEL_SESSIONS);
+        return iSlot;
+    }
+
+    // No index position within the probe limit; give the slot back.
+    gpSysLog->loginfo("SharedMemorySessions::create: index probe limit hit");
+    gen.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memset((char*)pSlot + stOffset, 0, sizeof(MFW_SESSION_T) - stOffset);
+    gen.fetch_add(1, std::memory_order_release);
+    std::atomic_ref<uint32_t>(pSlot->uState).store(
+        SESSION_SLOT_FREE, std::memory_order_release);
+    return -1;
+}
+
+/**
+ * Walks the probe sequence for pszUUID and returns the slot number of
+ * the live session carrying it, or -1. The walk stops at the first
+ * never-used index entry or after CFG_SESSION_MAX_PROBE entries,
+ * whichever comes first. A miss while sweep() is rebuilding the index,
+ * or after it has, does not count, and the walk is made again.
+ */
+int SharedMemorySessions::find_slot(const char* pszUUID)
+{
+    if (nullptr == pszUUID || 0 == pszUUID[0])
+    {
+        return -1;
+    }
+
+    std::atomic_ref<uint32_t> indexGen(m_pTable->uIndexGen);
+    uint32_t uHash = hash(pszUUID);
+    for (;;)
+    {
+        uint32_t uGen = indexGen.load(std::memory_order_acquire);
+        uint32_t uPos = uHash & (CFG_SESSION_INDEX_SIZE - 1);
+        for (int iProbe = 0; iProbe < CFG_SESSION_MAX_PROBE; iProbe++)
+        {
+            uint64_t uCur = std::atomic_ref<uint64_t>(m_pTable->index[uPos]).
+                load(std::memory_order_acquire);
+            if (SESSION_INDEX_EMPTY == uCur)
+            {
+                break;
+            }
+            if (SESSION_INDEX_TOMBSTONE != uCur &&
+                (uint32_t)(uCur >> 32) == uHash)
+            {
+                uint32_t uSlot = (uint32_t)(uCur & 0xFFFFFFFF) - 1;
+                MFW_SESSION_T* pSlot = &m_pTable->slots[uSlot];
+                if (SESSION_SLOT_LIVE ==
+                    std::atomic_ref<uint32_t>(pSlot->uState).load(
+                        std::memory_order_acquire) &&
+                    0 == strncmp(pSlot->szAuthUUID, pszUUID, UUID_SIZE))
+                {
+                    return (int)uSlot;
+                }
+            }
+            uPos = (uPos + 1) & (CFG_SESSION_INDEX_SIZE - 1);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (0 == (uGen & 1) &&
+            uGen == indexGen.load(std::memory_order_relaxed))
+        {
+            return -1;
+        }
+        sched_yield();
+    }
+}
+
+/**
+ * Resolves pszUUID and copies the session out. The UUID is compared
+ * again on the copy, because the slot found by find_slot() may have
+ * been recycled for a different session by the time it is copied.
+ *
+ * Expiry is one compare of the copied lease against now(), so a session
+ * whose lease has lapsed is refused even before sweep() reclaims it.
+ * Renewal is a CAS from the lease that was copied, so it can never land
+ * on a slot that has since been recycled; it is skipped while more than
+ * half of the lease remains, which keeps lookups from writing the slot
+ * on every request.
+ */
+bool SharedMemorySessions::find(const char* pszUUID, MFW_SESSION_T& sess)
+{
+    int iSlot = find_slot(pszUUID);
+    if (-1 == iSlot)
+    {
+        return false;
+    }
+    if (!copy_slot((uint32_t)iSlot, sess) ||
+        0 != strncmp(sess.szAuthUUID, pszUUID, UUID_SIZE))
+    {
+        return false;
+    }
+
+    uint32_t uNow = now();
+    if (sess.uLease <= uNow)
+    {
+        return false;
+    }
+    if (sess.uLease - uNow < CFG_SESSION_LEASE_S / 2)
+    {
+        uint32_t uExpected = sess.uLease;
+        if (std::atomic_ref<uint32_t>(m_pTable->slots[iSlot].uLease)
+                .compare_exchange_strong(uExpected, uNow + CFG_SESSION_LEASE_S,
+                                         std::memory_order_relaxed))
+        {
+            sess.uLease = uNow + CFG_SESSION_LEASE_S;
+        }
+    }
+    return true;
+}
+
+/**
+ * The row is only used to learn the UUID of the login it holds; the
+ * credentials themselves come from the session, through find(), so a
+ * lookup by handle renews the lease just as one by UUID does, and a row
+ * whose session has lapsed, or that holds no login at all, is refused.
+ * The handle is bounds-checked because it arrives straight off the wire.
+ */
+bool SharedMemorySessions::resolve(const char* pszUUID, int iHandle,
+                                   MFW_SESSION_T& sess)
+{
+    if (nullptr != pszUUID && 0 != pszUUID[0])
+    {
+        return nullptr != memchr(pszUUID, 0, UUID_SIZE) &&
+               find(pszUUID, sess);
+    }
+
+    if (iHandle < ROW_DATA || iHandle >= ROW_DATA + CFG_MAX_USERS)
+    {
+        return false;
+    }
+
+    char szUUID[UUID_SIZE];
+    memcpy(szUUID, gpSh->m_pShMemng->creds[iHandle].szAuthUUID, UUID_SIZE);
+    szUUID[UUID_SIZE - 1] = 0;
+    if (0 == szUUID[0] || !find(szUUID, sess))
+    {
+        return false;
+    }
+    return sess.iAuthHandle == iHandle;
+}
+
+/**
+ * Removes a session and takes it off the timing wheel. Both happen under
+ * the sessions lock, so a create() that recycles the slot at once can
+ * only schedule it after the old entry is gone.
+ */
+bool SharedMemorySessions::remove(const char* pszUUID)
+{
+    if (nullptr == pszUUID || 0 == pszUUID[0])
+    {
+        return false;
+    }
+
+    std::lock_guard<SharedMemoryMutex> guard(*m_pLock);
+    uint32_t uSlot;
+    if (!release(pszUUID, &uSlot))
+    {
+        return false;
+    }
+    wheel_unlink(m_pTable, uSlot);
+    return true;
+}
+
+/**
+ * Releases a session without touching the wheel. The index entry is
+ * replaced by a tombstone first so that no new reader can reach the slot,
+ * and only then is the slot cleared and returned to the free pool.
+ * Caller holds the lock.
+ *
+ * @param puSlot Receives the slot that was released.
+ */
+bool SharedMemorySessions::release(const char* pszUUID, uint32_t* puSlot)
+{
+
+    uint32_t uHash = hash(pszUUID);
+    uint32_t uPos = uHash & (CFG_SESSION_INDEX_SIZE - 1);
+    for (int iProbe = 0; iProbe < CFG_SESSION_MAX_PROBE; iProbe++)
+    {
+        std::atomic_ref<uint64_t> entry(m_pTable->index[uPos]);
+        uint64_t uCur = entry.load(std::memory_order_acquire);
+        if (SESSION_INDEX_EMPTY == uCur)
+        {
+            return false;
+        }
+        if (SESSION_INDEX_TOMBSTONE != uCur && (uint32_t)(uCur >> 32) == uHash)
+        {
+            uint32_t uSlot = (uint32_t)(uCur & 0xFFFFFFFF) - 1;
+            MFW_SESSION_T* pSlot = &m_pTable->slots[uSlot];
+            if (0 == strncmp(pSlot->szAuthUUID, pszUUID, UUID_SIZE))
+            {
+                if (!entry.compare_exchange_strong(uCur,
+                                                   SESSION_INDEX_TOMBSTONE,
+                                                   std::memory_order_acq_rel))
+                {
+                    return false; // somebody else removed it first
+                }
+
+                std::atomic_ref<uint32_t> gen(pSlot->uGeneration);
+                std::atomic_ref<uint32_t>(pSlot->uState).store(
+                    SESSION_SLOT_CLAIMED, std::memory_order_relaxed);
+                gen.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                size_t stOffset = offsetof(MFW_SESSION_T, iAuthHandle);
+                memset((char*)pSlot + stOffset, 0,
+                       sizeof(MFW_SESSION_T) - stOffset);
+                gen.fetch_add(1, std::memory_order_release);
+                std::atomic_ref<uint32_t>(pSlot->uState).store(
+                    SESSION_SLOT_FREE, std::memory_order_release);
+                std::atomic_ref<uint32_t>(m_pTable->uLive).fetch_sub(
+                    1, std::memory_order_relaxed);
+                m_pTable->uTombs++;
+                shm_notify::publish(SHM_CHANNEL_SESSIONS);
+                *puSlot = uSlot;
+                return true;
+            }
+        }
+        uPos = (uPos + 1) & (CFG_SESSION_INDEX_SIZE - 1);
+    }
+    return false;
+}
+
+/**
+ * Advances the wheel from the last second swept to now().
+ *
+ * Each second empties the level-0 bucket for that second together with
+ * every higher-level bucket whose slice starts at it. A session found in
+ * a bucket is expired only if its lease really has lapsed; otherwise it
+ * is scheduled again, one or more levels lower, or, if its lease was
+ * renewed since it was scheduled, wherever the new lease puts it. So
+ * renewal never has to touch the wheel, each session is handled at most
+ * once per level, and a second with nothing due costs one bucket load.
+ *
+ * If no process has swept for longer than a level-0 revolution, the wheel
+ * is rebuilt from its members rather than stepped second by second.
+ *
+ * Once logouts and expiry have left more than CFG_SESSION_MAX_TOMBS
+ * tombstones in the index, it is rebuilt without them.
+ *
+ * Expired sessions are released under the sessions lock; the creds[] rows
+ * they came from are cleared after it is dropped, because logout takes
+ * the creds lock before the sessions lock.
+ */
+int SharedMemorySessions::sweep()
+{
+    auto& wheel = m_pTable->wheel;
+    uint32_t uNow = now();
+    if (uNow <= std::atomic_ref<uint32_t>(wheel.uTick).load(
+            std::memory_order_acquire) || !m_pLock->try_lock())
+    {
+        return 0;
+    }
+
+    std::vector<std::pair<std::string, int>> vExpired;
+    std::vector<uint32_t> vSlots;
+    auto settle = [&](uint32_t uTick)
+    {
+        for (uint32_t uSlot : vSlots)
+        {
+            MFW_SESSION_T* pSlot = &m_pTable->slots[uSlot];
+            uint32_t uLease = std::atomic_ref<uint32_t>(pSlot->uLease).load(
+                std::memory_order_relaxed);
+            if (uLease > uTick)
+            {
+                wheel_schedule(m_pTable, uSlot, uLease);
+                continue;
+            }
+            char szUUID[UUID_SIZE];
+            memcpy(szUUID, pSlot->szAuthUUID, UUID_SIZE);
+            szUUID[UUID_SIZE - 1] = 0;
+            int iHandle = pSlot->iAuthHandle;
+            uint32_t uReleased;
+            if (release(szUUID, &uReleased))
+            {
+                vExpired.emplace_back(szUUID, iHandle);
+            }
+        }
+        vSlots.clear();
+    };
+
+    if (uNow - wheel.uTick > SESSION_WHEEL_SLOTS)
+    {
+        for (uint32_t uBucket = 0;
+             uBucket < CFG_WHEEL_LEVELS * SESSION_WHEEL_SLOTS; uBucket++)
+        {
+            wheel_detach(m_pTable, uBucket, vSlots);
+        }
+        wheel.uTick = uNow;
+        settle(uNow);
+    }
+    else
+    {
+        for (uint32_t uTick = wheel.uTick + 1; uTick <= uNow; uTick++)
+        {
+            // Buckets of this second are taken off before anything is
+            // rescheduled against it, so nothing can land in one of them.
+            std::atomic_ref<uint32_t>(wheel.uTick).store(
+                uTick, std::memory_order_release);
+            for (int iLevel = CFG_WHEEL_LEVELS - 1; iLevel >= 0; iLevel--)
+            {
+                uint32_t uShift = CFG_WHEEL_SHIFT * iLevel;
+                if (0 == (uTick & ((1u << uShift) - 1)))
+                {
+                    wheel_detach(m_pTable, iLevel * SESSION_WHEEL_SLOTS +
+                                 ((uTick >> uShift) & (SESSION_WHEEL_SLOTS - 1)),
+                                 vSlots);
+                }
+            }
+            settle(uTick);
+        }
+    }
+    if (m_pTable->uTombs > CFG_SESSION_MAX_TOMBS)
+    {
+        index_rebuild(m_pTable);
+    }
+    m_pLock->unlock();
+
+    if (vExpired.empty())
+    {
+        return 0;
+    }
+
+    bool bCreds = false;
+    for (const auto& expired : vExpired)
+    {
+        int iHandle = expired.second;
+        if (iHandle < ROW_DATA || iHandle >= ROW_DATA + CFG_MAX_USERS)
+        {
+            continue;
+        }
+        shmCredsGuard guard;
+        auto& row = gpSh->m_pShMemng->creds[iHandle];
+        if (0 == strncmp(row.szAuthUUID, expired.first.c_str(),
+                         sizeof(row.szAuthUUID)))
+        {
+            memset(row.szAuthUserName, 0, sizeof(row.szAuthUserName));
+            memset(row.szAuthFirstName, 0, sizeof(row.szAuthFirstName));
+            memset(row.szAuthLastName, 0, sizeof(row.szAuthLastName));
+            memset(row.szAuthUUID, 0, sizeof(row.szAuthUUID));
+            row.iAuthHandle = 0;
+            bCreds = true;
+        }
+    }
+    if (bCreds)
+    {
+        shm_notify::publish(SHM_CHANNEL_CREDS);
+    }
+
+    char szMsg[80];
+    snprintf(szMsg, sizeof(szMsg),
+             "SharedMemorySessions::sweep: expired %zu sessions",
+             vExpired.size());
+    gpSysLog->loginfo(szMsg);
+    return (int)vExpired.size();
+}
+
+/**
+ * Reads the coarse monotonic clock; see the header.
+ */
+uint32_t SharedMemorySessions::now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return (uint32_t)ts.tv_sec;
+}
+
+/**
+ * Copies out the session in slot iSlot, if that slot is live.
+ */
+bool SharedMemorySessions::get(int iSlot, MFW_SESSION_T& sess)
+{
+    if (iSlot < 0 || iSlot >= CFG_MAX_SESSIONS)
+    {
+        return false;
+    }
+    return copy_slot((uint32_t)iSlot, sess);
+}
+
+/**
+ * Returns the number of live sessions.
+ */
+int SharedMemorySessions::count()
+{
+    return (int)std::atomic_ref<uint32_t>(m_pTable->uLive).load(
+        std::memory_order_relaxed);
+}
+
+/**
+ * The slots are copied as they stand and then checked one by one: a slot
+ * that is not live, or whose generation is odd, was being written by an
+ * older binary when the copy was taken and is cleared. The index is not
+ * copied at all but rebuilt from the surviving slots, which also drops
+ * its tombstones. The sizes must match, because the index position of a
+ * session depends on CFG_SESSION_INDEX_SIZE; if they differ the table
+ * starts out empty and users simply log in again. A table from before
+ * the timing wheel was added is accepted as well: it is the same table
+ * without the trailing wheel, and its sessions, which had no lease, are
+ * given a full one. The wheel is always rebuilt.
+ */
+void SharedMemorySessions::migrate(void* pDst, const void* pSrc,
+                                   size_t stDst, size_t stSrc)
+{
+    bool bNoLeases = stSrc == offsetof(MFW_SESSION_TABLE_T, wheel);
+    if (stDst != sizeof(MFW_SESSION_TABLE_T) ||
+        (stSrc != stDst && !bNoLeases))
+    {
+        return;
+    }
+    auto* pTo = (MFW_SESSION_TABLE_T*)pDst;
+    auto* pFrom = (const MFW_SESSION_TABLE_T*)pSrc;
+
+    memcpy(pTo->slots, pFrom->slots, sizeof(pTo->slots));
+    memset(pTo->index, 0, sizeof(pTo->index));
+    memset(&pTo->wheel, 0, sizeof(pTo->wheel));
+    pTo->uCursor = 0;
+    pTo->uLive = 0;
+    pTo->uTombs = 0;
+    pTo->uIndexGen = 0;
+    pTo->wheel.uTick = now();
+
+    for (uint32_t uSlot = 0; uSlot < CFG_MAX_SESSIONS; uSlot++)
+    {
+        MFW_SESSION_T* pSlot = &pTo->slots[uSlot];
+        if (SESSION_SLOT_LIVE != pSlot->uState || (pSlot->uGeneration & 1) ||
+            0 == pSlot->szAuthUUID[0])
+        {
+            if (SESSION_SLOT_FREE != pSlot->uState || pSlot->szAuthUUID[0])
+            {
+                memset(pSlot, 0, sizeof(MFW_SESSION_T));
+            }
+            continue;
+        }
+        pSlot->szAuthUUID[UUID_SIZE - 1] = 0;
+
+        uint32_t uHash = hash(pSlot->szAuthUUID);
+        uint32_t uPos = uHash & (CFG_SESSION_INDEX_SIZE - 1);
+        int iProbe = 0;
+        while (iProbe < CFG_SESSION_MAX_PROBE &&
+               SESSION_INDEX_EMPTY != pTo->index[uPos])
+        {
+            uPos = (uPos + 1) & (CFG_SESSION_INDEX_SIZE - 1);
+            iProbe++;
+        }
+        if (CFG_SESSION_MAX_PROBE == iProbe)
+        {
+            memset(pSlot, 0, sizeof(MFW_SESSION_T));
+            continue;
+        }
+        pTo->index[uPos] = ((uint64_t)uHash << 32) | (uint64_t)(uSlot + 1);
+        pTo->uLive++;
+        if (bNoLeases || 0 == pSlot->uLease)
+        {
+            pSlot->uLease = pTo->wheel.uTick + CFG_SESSION_LEASE_S;
+        }
+        wheel_schedule(pTo, uSlot, pSlot->uLease);
+    }
+}
+
+/////////////////////////
+// eof - shMemSess.cpp //
+/////////////////////////
@@ -10,21 +10,166 @@
 
 #define OBJ_PERMS (S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP)
 
+#define SHM_FIELD(f, ver, flags, fn)                                    \
+    { #f, offsetof(shared::MFW_SHMEMNG_T, f),                           \
+      sizeof(shared::MFW_SHMEMNG_T::f), ver, flags, fn }
+
+/**
+ * Field table of the current layout, written into the header of every
+ * segment this binary creates. Keep it in step with shmemng.h: every
+ * member except hdr must be listed, in any order. A member that is not
+ * listed here is never migrated.
+ */
+static const shm_field_desc_t gFields[] = {
+    SHM_FIELD(iSignature,           1, SHMFIELD_NOMIGRATE, nullptr),
+    SHM_FIELD(szStatus,             1, 0, nullptr),
+    SHM_FIELD(bLedCntl,             1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(stShMemSize,          1, SHMFIELD_NOMIGRATE, nullptr),
+    SHM_FIELD(szRemoteHost,         1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(szRemoteAddr,         1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(szRemoteAuth,         1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(szRemoteVer,          1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(creds,                1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(sessions,             1, SHMFIELD_VOLATILE,
+              SharedMemorySessions::migrate),
+    SHM_FIELD(locks,                1, SHMFIELD_NOMIGRATE, nullptr),
+    SHM_FIELD(config,               1, 0, SharedMemoryConfig::migrate),
+    SHM_FIELD(prefs,                1, 0, SharedMemoryPrefs::migrate),
+    SHM_FIELD(tests_started,        1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(time_started,         1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(szTimeStarted,        1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(tests_processed_bits, 1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(tests_passed_bits,    1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(tests_failed_bits,    1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(tests_skipped_bits,   1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(num_tests_processed,  1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(num_tests_skipped,    1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(num_tests_passed,     1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(num_tests_failed,     1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(tests_completed,      1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(overall_test_results, 1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(time_completed,       1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(szTimeCompleted,      1, SHMFIELD_VOLATILE, nullptr),
+    SHM_FIELD(bDisplayShmVars,      1, 0, nullptr),
+    SHM_FIELD(bDisplayEnvVars,      1, 0, nullptr),
+    SHM_FIELD(bDisplaySchema,       1, 0, nullptr),
+    SHM_FIELD(warm,                 1, SHMFIELD_NOMIGRATE, nullptr),
+    SHM_FIELD(vars,                 1, SHMFIELD_VOLATILE, shmvars::migrate),
+    SHM_FIELD(counters,             1, SHMFIELD_VOLATILE, shm_counter::migrate),
+    SHM_FIELD(notify,               1, SHMFIELD_NOMIGRATE, nullptr),
+};
+static const int giFieldCount = sizeof(gFields) / sizeof(gFields[0]);
+static_assert(sizeof(gFields) / sizeof(gFields[0]) <= CFG_SHM_MAX_FIELDS,
+              "CFG_SHM_MAX_FIELDS is too small for the field table");
+static_assert(offsetof(shared::MFW_SHMEMNG_T, hdr) == 0,
+              "the segment header must be the first member");
+
+/**
+ * gpSysLog is constructed after gpSh, so the shared constructor logs
+ * through syslog() directly.
+ */
+static void shm_log(const char* pszFormat, ...)
+{
+    char szMsg[256];
+    va_list args;
+    va_start(args, pszFormat);
+    vsnprintf(szMsg, sizeof(szMsg), pszFormat, args);
+    va_end(args);
+    syslog(LOG_LOCAL1 | LOG_INFO, "%s", szMsg);
+}
+
+/**
+ * Fills in the field table of hdr from gFields, leaving out the members
+ * flagged in uSkipFlags. In a segment every member sits at its compiled
+ * offset; in a snapshot (bPacked) the members follow the header, each on
+ * its own cache line, and the offsets are counted from the header.
+ *
+ * @return The number of bytes from the header to the end of the last
+ *         member.
+ */
+static size_t fill_field_table(MFW_SHMHDR_T& hdr, uint32_t uSkipFlags,
+                               bool bPacked)
+{
+    size_t stEnd = sizeof(MFW_SHMHDR_T);
+    uint32_t uCount = 0;
+    for (int i = 0; i < giFieldCount; i++)
+    {
+        if (gFields[i].uFlags & uSkipFlags)
+        {
+            continue;
+        }
+        MFW_SHMFIELD_T& field = hdr.fields[uCount++];
+        memset(&field, 0, sizeof(field));
+        strncpy(field.szName, gFields[i].pszName, SHMHDR_FIELD_NAME_SIZE - 1);
+        field.uOffset = (uint32_t)gFields[i].stOffset;
+        if (bPacked)
+        {
+            field.uOffset = (uint32_t)((stEnd + 63) & ~(size_t)63);
+        }
+        field.uSize = (uint32_t)gFields[i].stSize;
+        field.uVersion = gFields[i].uVersion;
+        field.uFlags = gFields[i].uFlags;
+        stEnd = std::max<size_t>(stEnd, field.uOffset + field.uSize);
+    }
+    hdr.uFieldCount = uCount;
+    return stEnd;
+}
+
+/**
+ * FNV-1a over a snapshot, used to reject a file that was truncated or
+ * overwritten outside of checkpoint().
+ */
+static uint64_t snapshot_checksum(const void* pData, size_t stLength)
+{
+    const unsigned char* p = (const unsigned char*)pData;
+    uint64_t u64Hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < stLength; i++)
+    {
+        u64Hash ^= p[i];
+        u64Hash *= 0x100000001B3ULL;
+    }
+    return u64Hash;
+}
+
+/**
+ * Layout version v is kept at SHARED_ROOT_KEY + (v << 16): 0x5164 for the
+ * legacy segment, 0x15164 for layout 1, and so on, so the VPA port number
+ * stays recognizable in ipcs output.
+ */
+key_t shared::key_for(uint32_t uLayoutVersion)
+{
+    return (key_t)(SHARED_ROOT_KEY + (uLayoutVersion << 16));
+}
+
 /**
  * @brief The function of the shared class constructor is to open the region
- * if it already exists, and to create it and open it if not. It also is
- * responsible for creating a new szRpcUUID each time the memory region is
- * created. All other shared region initialization is performed in the
- * environment class constructor.
+ * if it already exists, and to create it and open it if not. The RPC UUID
+ * for a new region is created by the SharedMemoryConfig constructor, since
+ * it lives in the config string pool. All other shared region
+ * initialization is performed in the environment class constructor.
+ *
+ * Exactly one process creates a given layout's segment (IPC_EXCL). That
+ * process writes the header and field table, carries over the contents of
+ * the newest older-layout segment it can find, and only then publishes
+ * the segment as ready. If there is no older segment, as after a reboot,
+ * the warm-start snapshot is restored instead. Everyone else waits for
+ * that, so no process ever sees a half-migrated segment. The older
+ * segment is marked retired, and removed once no process is attached to
+ * it any more; until then binaries of the older layout keep sharing it.
+ * What they write there is not carried over, so every process should be
+ * upgraded at once, not one by one.
  *
- * @return True if the resource is shared; false otherwise.
+ * @throws std::system_error if the segment cannot be created or
+ *         attached, typically because a segment with the same layout
+ *         version but a different size exists: the layout was changed
+ *         without bumping CFG_SHM_LAYOUT_VERSION.
  */
 shared::shared()
 {
     bool bJustCreated = false;
 
-    // Set key to hex version of my VPA port number (recognizable)
-    key_t key = 0x5164;
+    // One key per layout version, derived from my VPA port number
+    key_t key = key_for(CFG_SHM_LAYOUT_VERSION);
 
     // Set size to the size of my shared data structure (member data)
     size_t size = sizeof(MFW_SHMEMNG_T);
@@ -38,27 +183,42 @@ shared::shared()
     {
         if (ENOENT == errno)
         {
-            shmflg = IPC_CREAT | OBJ_PERMS;
+            shmflg = IPC_CREAT | IPC_EXCL | OBJ_PERMS;
             m_smsi = shmget(key, size, shmflg);
-            bJustCreated = true;
+            if (-1 != m_smsi)
+            {
+                bJustCreated = true;
+            }
+            else if (EEXIST == errno)
+            {
+                // Lost the race to create it; attach the winner's.
+                m_smsi = shmget(key, size, OBJ_PERMS);
+            }
         }
     }
+    if (-1 == m_smsi)
+    {
+        int iErr = errno;
+        shm_log("shared: cannot get segment 0x%x of layout %d (%s)",
+                (unsigned)key, CFG_SHM_LAYOUT_VERSION, strerror(iErr));
+        throw std::system_error(iErr, std::system_category(), "shmget failed");
+    }
 
     shmflg = 0;
     m_pShMemng = (MFW_SHMEMNG_T*)shmat(m_smsi, nullptr, shmflg);
+    if ((void*)-1 == (void*)m_pShMemng)
+    {
+        throw std::system_error(errno, std::system_category(),
+                                "shmat failed");
+    }
 
     if (bJustCreated)
     {
+        build_header();
+
         m_pShMemng->iSignature = UNIVERSAL_ANSWER;
         m_pShMemng->stShMemSize = size;
 
-
-        uuid_t uuid;
-        char szUUID[37];
-        uuid_generate(uuid);
-        uuid_unparse(uuid, szUUID);
-        strcpy(m_pShMemng->szRpcUuid, szUUID);
-
         size_t credsSize = sizeof(MFW_SHMEMNG_T::creds);
         memset(m_pShMemng->creds, 0, credsSize);
 
@@ -68,7 +228,421 @@ shared::shared()
         m_pShMemng->bDisplaySchema = false;
         m_pShMemng->bDisplayEnvVars = false;
         m_pShMemng->bDisplayShmVars = false;
+
+        migrate_from_predecessor();
+        if (0 == m_pShMemng->hdr.uMigratedFrom)
+        {
+            restore_snapshot();
+        }
+
+        std::atomic_ref<uint32_t>(m_pShMemng->hdr.uState).store(
+            SHMHDR_READY, std::memory_order_release);
+    }
+    else
+    {
+        wait_until_ready();
+    }
+    reap_retired();
+}
+
+/**
+ * Writes the magic value, layout version, size and field table, leaving
+ * the segment in the SHMHDR_BUILDING state.
+ */
+void shared::build_header()
+{
+    MFW_SHMHDR_T& hdr = m_pShMemng->hdr;
+    hdr.uMagic = SHMHDR_MAGIC;
+    hdr.uLayoutVersion = CFG_SHM_LAYOUT_VERSION;
+    hdr.u64Size = sizeof(MFW_SHMEMNG_T);
+    hdr.tCreated = time(nullptr);
+    hdr.uMigratedFrom = 0;
+    hdr.uMigratedFields = 0;
+    fill_field_table(hdr, 0, false);
+    std::atomic_ref<uint32_t>(hdr.uState).store(SHMHDR_BUILDING,
+                                                std::memory_order_release);
+}
+
+/**
+ * Waits for the creator of the segment to publish it. If the creator
+ * died while building, the segment is published as it stands after
+ * CFG_SHM_READY_TIMEOUT_MS; whatever the migration did not carry over is
+ * simply probed again by environment's constructor.
+ */
+void shared::wait_until_ready()
+{
+    std::atomic_ref<uint32_t> state(m_pShMemng->hdr.uState);
+    for (int iMs = 0; iMs < CFG_SHM_READY_TIMEOUT_MS; iMs++)
+    {
+        if (SHMHDR_READY == state.load(std::memory_order_acquire))
+        {
+            return;
+        }
+        usleep(1000);
+    }
+
+    shm_log("shared: segment 0x%x was never published; taking it over",
+            (unsigned)key_for(CFG_SHM_LAYOUT_VERSION));
+    if (SHMHDR_MAGIC != m_pShMemng->hdr.uMagic)
+    {
+        build_header();
+    }
+    state.store(SHMHDR_READY, std::memory_order_release);
+}
+
+/**
+ * Looks for a segment in an older layout, newest first, and migrates the
+ * first one found. Only segments that carry a valid header can be
+ * migrated; the legacy headerless segment is merely reported.
+ */
+void shared::migrate_from_predecessor()
+{
+    for (int iVersion = CFG_SHM_LAYOUT_VERSION - 1; iVersion >= 1; iVersion--)
+    {
+        int iOld = shmget(key_for(iVersion), 0, OBJ_PERMS);
+        if (-1 == iOld)
+        {
+            continue;
+        }
+
+        struct shmid_ds ds;
+        if (-1 == shmctl(iOld, IPC_STAT, &ds) ||
+            ds.shm_segsz < sizeof(MFW_SHMHDR_T))
+        {
+            continue;
+        }
+        auto* pOld = (MFW_SHMHDR_T*)shmat(iOld, nullptr, 0);
+        if ((void*)-1 == (void*)pOld)
+        {
+            continue;
+        }
+
+        std::atomic_ref<uint32_t> oldState(pOld->uState);
+        if (SHMHDR_MAGIC == pOld->uMagic &&
+            (uint32_t)iVersion == pOld->uLayoutVersion &&
+            SHMHDR_READY == oldState.load(std::memory_order_acquire))
+        {
+            uint32_t uFields = migrate_fields(pOld, ds.shm_segsz,
+                                              SHMFIELD_NOMIGRATE);
+            m_pShMemng->hdr.uMigratedFrom = iVersion;
+            m_pShMemng->hdr.uMigratedFields = uFields;
+
+            // Retire the old segment, but leave its key in place while
+            // binaries of that layout still use it: without the key, the
+            // next of them to start would create an empty segment and
+            // carry on in that. reap_retired() removes it later.
+            oldState.store(SHMHDR_RETIRED, std::memory_order_release);
+            shm_log("shared: migrated %u fields from layout %d to %d",
+                    uFields, iVersion, CFG_SHM_LAYOUT_VERSION);
+        }
+        shmdt(pOld);
+        return;
+    }
+
+    if (-1 != shmget(SHARED_ROOT_KEY, 0, OBJ_PERMS))
+    {
+        shm_log("shared: legacy segment 0x%x has no header and cannot be "
+                "migrated; remove it with scripts/remove-shared-memory.sh",
+                SHARED_ROOT_KEY);
+    }
+}
+
+/**
+ * Removes the retired segments of older layouts that no process is
+ * attached to any more.
+ */
+void shared::reap_retired()
+{
+    for (int iVersion = CFG_SHM_LAYOUT_VERSION - 1; iVersion >= 1; iVersion--)
+    {
+        int iOld = shmget(key_for(iVersion), 0, OBJ_PERMS);
+        struct shmid_ds ds;
+        if (-1 == iOld || -1 == shmctl(iOld, IPC_STAT, &ds) ||
+            0 != ds.shm_nattch || ds.shm_segsz < sizeof(MFW_SHMHDR_T))
+        {
+            continue;
+        }
+        auto* pOld = (MFW_SHMHDR_T*)shmat(iOld, nullptr, SHM_RDONLY);
+        if ((void*)-1 == (void*)pOld)
+        {
+            continue;
+        }
+        bool bRetired = SHMHDR_MAGIC == pOld->uMagic &&
+            SHMHDR_RETIRED == std::atomic_ref<uint32_t>(pOld->uState).load(
+                std::memory_order_acquire);
+        shmdt(pOld);
+        if (bRetired && 0 == shmctl(iOld, IPC_RMID, nullptr))
+        {
+            shm_log("shared: removed retired segment 0x%x of layout %d",
+                    (unsigned)key_for(iVersion), iVersion);
+        }
+    }
+}
+
+/**
+ * Copies every member of the current layout that the old field table
+ * also lists under the same name and member version, and that lies
+ * inside the old segment or snapshot. Members flagged in uSkipFlags are
+ * left alone. Members with a migrate function are handed to
+ * it; the rest are copied up to the smaller of the two sizes.
+ *
+ * @return The number of members carried over.
+ */
+uint32_t shared::migrate_fields(const MFW_SHMHDR_T* pOld, size_t stOldSize,
+                                uint32_t uSkipFlags)
+{
+    uint32_t uCount = std::min<uint32_t>(pOld->uFieldCount,
+                                         CFG_SHM_MAX_FIELDS);
+    uint32_t uMigrated = 0;
+
+    for (int i = 0; i < giFieldCount; i++)
+    {
+        const shm_field_desc_t& desc = gFields[i];
+        if (desc.uFlags & uSkipFlags)
+        {
+            continue;
+        }
+        for (uint32_t j = 0; j < uCount; j++)
+        {
+            const MFW_SHMFIELD_T& old = pOld->fields[j];
+            if (0 != strncmp(old.szName, desc.pszName,
+                             SHMHDR_FIELD_NAME_SIZE))
+            {
+                continue;
+            }
+            if (old.uVersion == desc.uVersion &&
+                (uint64_t)old.uOffset + old.uSize <= stOldSize)
+            {
+                char* pDst = (char*)m_pShMemng + desc.stOffset;
+                const char* pSrc = (const char*)pOld + old.uOffset;
+                if (desc.pfnMigrate)
+                {
+                    desc.pfnMigrate(pDst, pSrc, desc.stSize, old.uSize);
+                }
+                else
+                {
+                    memcpy(pDst, pSrc, std::min<size_t>(desc.stSize,
+                                                        old.uSize));
+                }
+                uMigrated++;
+            }
+            break;
+        }
+    }
+    return uMigrated;
+}
+
+/**
+ * The snapshot lives in the config dir, which environment derives from
+ * the user name embedded in __FILE__ (/home/<user>/public_html/fw/...).
+ * The same rule is applied here because the snapshot is restored before
+ * environment has run. A build outside /home has no config dir, and
+ * warm starts are then simply disabled.
+ *
+ * @return The snapshot path, or an empty string.
+ */
+std::string shared::snapshot_path()
+{
+    std::string ssFile = __FILE__;
+    if (0 != ssFile.compare(0, 6, "/home/"))
+    {
+        return "";
+    }
+    std::string ssUser = ssFile.substr(6, ssFile.find('/', 6) - 6);
+    return "/home/" + ssUser + "/.config/multiware/" CFG_SHM_SNAPSHOT_NAME;
+}
+
+/**
+ * Lays the checkpointed members out after a copy of the header, copies
+ * them from the segment into a shared mapping of a temporary file, seals
+ * the file with its checksum and renames it over the previous snapshot.
+ * The config block is copied with the seqlock protocol by its migrate
+ * function; the other members are plain data and a write racing the copy
+ * at worst leaves one stale preference. Checkpoints of an unchanged
+ * config block are skipped. uConfigVersion only moves forward once the
+ * snapshot is in place, so a checkpoint that fails is tried again by the
+ * next caller.
+ */
+bool shared::checkpoint(bool bForce)
+{
+    MFW_WARMSTART_T& warm = m_pShMemng->warm;
+    std::atomic_ref<uint32_t> lastVersion(warm.uConfigVersion);
+    uint32_t uVersion = std::atomic_ref<uint32_t>(
+        m_pShMemng->config.uSequence).load(std::memory_order_acquire) >> 1;
+    if (!bForce && lastVersion.load(std::memory_order_relaxed) == uVersion)
+    {
+        return true;
+    }
+
+    std::string ssPath = snapshot_path();
+    if (ssPath.empty())
+    {
+        return false;
+    }
+
+    MFW_SHMHDR_T hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.uMagic = SHMHDR_MAGIC;
+    hdr.uLayoutVersion = CFG_SHM_LAYOUT_VERSION;
+    hdr.u64Size = sizeof(MFW_SHMEMNG_T);
+    hdr.tCreated = m_pShMemng->hdr.tCreated;
+    hdr.uState = SHMHDR_READY;
+    size_t stLength = fill_field_table(hdr, SHMFIELD_NOMIGRATE |
+                                            SHMFIELD_VOLATILE, true);
+    size_t stFile = offsetof(MFW_SHMSNAP_T, hdr) + stLength;
+
+    std::string ssTemp = ssPath + "." + std::to_string(getpid());
+    int fd = open(ssTemp.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0640);
+    if (-1 == fd)
+    {
+        shm_log("shared::checkpoint: cannot create %s (%s)",
+                ssTemp.c_str(), strerror(errno));
+        return false;
+    }
+    void* pMap = MAP_FAILED;
+    if (0 == ftruncate(fd, (off_t)stFile))
+    {
+        pMap = mmap(nullptr, stFile, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (MAP_FAILED == pMap)
+    {
+        shm_log("shared::checkpoint: cannot map %s (%s)",
+                ssTemp.c_str(), strerror(errno));
+        unlink(ssTemp.c_str());
+        return false;
+    }
+
+    auto* pSnap = (MFW_SHMSNAP_T*)pMap;
+    pSnap->u64Magic = SHMSNAP_MAGIC;
+    pSnap->u64Length = stLength;
+    pSnap->tSaved = time(nullptr);
+    gethostname(pSnap->szHostname, sizeof(pSnap->szHostname) - 1);
+    pSnap->hdr = hdr;
+
+    uint32_t uField = 0;
+    for (int i = 0; i < giFieldCount; i++)
+    {
+        const shm_field_desc_t& desc = gFields[i];
+        if (desc.uFlags & (SHMFIELD_NOMIGRATE | SHMFIELD_VOLATILE))
+        {
+            continue;
+        }
+        char* pDst = (char*)&pSnap->hdr + hdr.fields[uField++].uOffset;
+        char* pSrc = (char*)m_pShMemng + desc.stOffset;
+        if (desc.pfnMigrate)
+        {
+            desc.pfnMigrate(pDst, pSrc, desc.stSize, desc.stSize);
+        }
+        else
+        {
+            memcpy(pDst, pSrc, desc.stSize);
+        }
+    }
+    pSnap->u64Checksum = snapshot_checksum(&pSnap->hdr, stLength);
+
+    msync(pMap, stFile, MS_SYNC);
+    munmap(pMap, stFile);
+    if (-1 == rename(ssTemp.c_str(), ssPath.c_str()))
+    {
+        shm_log("shared::checkpoint: cannot rename %s (%s)",
+                ssTemp.c_str(), strerror(errno));
+        unlink(ssTemp.c_str());
+        return false;
+    }
+
+    // Another process may have saved a later version meanwhile
+    uint32_t uLast = lastVersion.load(std::memory_order_relaxed);
+    while ((int32_t)(uVersion - uLast) > 0 &&
+           !lastVersion.compare_exchange_weak(uLast, uVersion,
+                                              std::memory_order_relaxed))
+    {
+    }
+    warm.tCheckpoint = time(nullptr);
+    std::atomic_ref<uint32_t>(warm.uCheckpoints).fetch_add(
+        1, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * Maps the snapshot read-only and, if it is intact and was taken on this
+ * host, carries its members into the new segment through
+ * migrate_fields(), exactly as an older segment would be migrated. The
+ * segment is then marked SHM_WARM_RESTORED so that environment checks
+ * the restored network identity before relying on it.
+ *
+ * @return True if the snapshot was restored.
+ */
+bool shared::restore_snapshot()
+{
+    std::string ssPath = snapshot_path();
+    if (ssPath.empty())
+    {
+        return false;
+    }
+    int fd = open(ssPath.c_str(), O_RDONLY);
+    if (-1 == fd)
+    {
+        return false;
+    }
+    struct stat st;
+    void* pMap = MAP_FAILED;
+    if (0 == fstat(fd, &st) && (size_t)st.st_size >= sizeof(MFW_SHMSNAP_T))
+    {
+        pMap = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (MAP_FAILED == pMap)
+    {
+        return false;
+    }
+
+    auto* pSnap = (const MFW_SHMSNAP_T*)pMap;
+    char szHostname[DNS_FQDN_SIZE_MAX] = {0};
+    gethostname(szHostname, sizeof(szHostname) - 1);
+
+    const char* pszReject = nullptr;
+    if (SHMSNAP_MAGIC != pSnap->u64Magic ||
+        SHMHDR_MAGIC != pSnap->hdr.uMagic)
+    {
+        pszReject = "bad magic";
+    }
+    else if (pSnap->u64Length !=
+             (uint64_t)st.st_size - offsetof(MFW_SHMSNAP_T, hdr))
+    {
+        pszReject = "truncated";
+    }
+    else if (pSnap->u64Checksum !=
+             snapshot_checksum(&pSnap->hdr, pSnap->u64Length))
+    {
+        pszReject = "bad checksum";
+    }
+    else if (0 != strncmp(pSnap->szHostname, szHostname, sizeof(szHostname)))
+    {
+        pszReject = "taken on another host";
+    }
+
+    bool bRestored = false;
+    if (pszReject)
+    {
+        shm_log("shared: ignoring snapshot %s: %s", ssPath.c_str(), pszReject);
+    }
+    else
+    {
+        uint32_t uFields = migrate_fields(&pSnap->hdr, pSnap->u64Length,
+                                          SHMFIELD_NOMIGRATE |
+                                          SHMFIELD_VOLATILE);
+        MFW_WARMSTART_T& warm = m_pShMemng->warm;
+        warm.uState = SHM_WARM_RESTORED;
+        warm.tRestored = time(nullptr);
+        warm.tCheckpoint = pSnap->tSaved;
+        warm.uConfigVersion = m_pShMemng->config.uSequence >> 1;
+        shm_log("shared: restored %u fields from snapshot of layout %u",
+                uFields, pSnap->hdr.uLayoutVersion);
+        bRestored = true;
     }
+    munmap(pMap, st.st_size);
+    return bRestored;
 }
 
 
@@ -1,57 +1,359 @@
 ////////////////////////////////////////////////////////////////////
-// ~/public_html/fw/shmvars.cpp 2025-07-15 18:16 dwg -            //
+// ~/public_html/fw/shmvars.cpp 2026-10-17 13:20 dwg -            //
 // This file is part of MultiWare Engineering's VPA and FrameWork //
 ////////////////////////////////////////////////////////////////////
 // This file is made available under the                          //
 // Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
 ////////////////////////////////////////////////////////////////////
 
-
 #include "mwfw2.h"
 
+static_assert(sizeof(MFW_SHMVAR_T) == 64,
+              "a variable slot must fill exactly one cache line");
+static_assert((CFG_SHMVAR_INDEX_SIZE & (CFG_SHMVAR_INDEX_SIZE - 1)) == 0,
+              "CFG_SHMVAR_INDEX_SIZE must be a power of two");
+static_assert(CFG_SHMVAR_INDEX_SIZE >= 2 * CFG_SHMVAR_MAX,
+              "the name index must be at most half full");
+
+/**
+ * Binds to the registry and to the lock that serializes registration.
+ * The lock is a named slot in the shared lock table, like the region
+ * locks of SharedMemoryManager.
+ */
 shmvars::shmvars()
 {
+    m_pVars = &gpSh->m_pShMemng->vars;
+    m_pLock = std::make_unique<SharedMemoryMutex>(CFG_MUTEX_NAME ".vars");
+}
+
+/**
+ * FNV-1a over the name. Never zero, so a slot's uHash is also a cheap
+ * "was this slot ever filled" test.
+ */
+uint32_t shmvars::hash(const char* pszName)
+{
+    uint32_t uHash = 2166136261u;
+    for (const char* p = pszName; *p; p++)
+    {
+        uHash ^= (unsigned char)*p;
+        uHash *= 16777619u;
+    }
+    return uHash ? uHash : 1;
+}
+
+/**
+ * Validates a handle and its type.
+ *
+ * @return The slot, or nullptr.
+ */
+MFW_SHMVAR_T* shmvars::slot(int iHandle, svar_type_t type)
+{
+    if (iHandle < 0 || iHandle >= count() ||
+        (uint32_t)type != m_pVars->vars[iHandle].uType)
+    {
+        return nullptr;
+    }
+    return &m_pVars->vars[iHandle];
+}
+
+/**
+ * Tries a lock-free lookup first, since nearly every call registers a
+ * name that some earlier process already registered. Otherwise the slot
+ * and, for strings, its heap buffer are allocated under the registration
+ * lock, filled in, and only then published in the index with a release
+ * store, so a concurrent find() either misses the name or sees a
+ * complete slot.
+ */
+int shmvars::reg(const char* pszName, svar_type_t type, size_t stCapacity)
+{
+    if (SVAR_TYPE_NONE == type || 0 == pszName[0] ||
+        strlen(pszName) >= SHMVAR_NAME_SIZE_MAX)
+    {
+        return -1;
+    }
+
+    int iHandle = find(pszName);
+    if (-1 == iHandle)
+    {
+        std::lock_guard<SharedMemoryMutex> guard(*m_pLock);
+        iHandle = find(pszName);
+        if (-1 == iHandle)
+        {
+            uint32_t uCount = m_pVars->uCount;
+            uint32_t uCapacity = (SVAR_TYPE_STRING == type)
+                                     ? (uint32_t)std::max<size_t>(stCapacity, 2)
+                                     : 0;
+            if (uCount >= CFG_SHMVAR_MAX ||
+                m_pVars->uHeapUsed + uCapacity > CFG_SHMVAR_HEAP_SIZE)
+            {
+                gpSysLog->loginfo("shmvars::reg: registry is full");
+                return -1;
+            }
+
+            MFW_SHMVAR_T& var = m_pVars->vars[uCount];
+            memset(&var, 0, sizeof(var));
+            strncpy(var.szName, pszName, SHMVAR_NAME_SIZE_MAX - 1);
+            var.uType = type;
+            var.uHash = hash(pszName);
+            var.uCapacity = uCapacity;
+            var.uOffset = m_pVars->uHeapUsed;
+            m_pVars->uHeapUsed += uCapacity;
+
+            uint32_t uPos = var.uHash & (CFG_SHMVAR_INDEX_SIZE - 1);
+            while (0 != m_pVars->index[uPos])
+            {
+                uPos = (uPos + 1) & (CFG_SHMVAR_INDEX_SIZE - 1);
+            }
+            std::atomic_ref<uint32_t>(m_pVars->uCount).store(
+                uCount + 1, std::memory_order_release);
+            std::atomic_ref<uint32_t>(m_pVars->index[uPos]).store(
+                uCount + 1, std::memory_order_release);
+            shm_notify::publish(SHM_CHANNEL_VARS);
+            return (int)uCount;
+        }
+    }
+
+    return (m_pVars->vars[iHandle].uType == (uint32_t)type) ? iHandle : -1;
+}
+
+/**
+ * Probes the index from the name's home position until an empty entry.
+ * The hash is compared before the name, so a probe past a colliding
+ * entry almost never touches the other slot's name.
+ */
+int shmvars::find(const char* pszName) const
+{
+    uint32_t uHash = hash(pszName);
+    uint32_t uPos = uHash & (CFG_SHMVAR_INDEX_SIZE - 1);
+    for (int iProbe = 0; iProbe < CFG_SHMVAR_INDEX_SIZE; iProbe++)
+    {
+        uint32_t uEntry = std::atomic_ref<uint32_t>(m_pVars->index[uPos])
+                              .load(std::memory_order_acquire);
+        if (0 == uEntry)
+        {
+            return -1;
+        }
+        const MFW_SHMVAR_T& var = m_pVars->vars[uEntry - 1];
+        if (var.uHash == uHash &&
+            0 == strncmp(var.szName, pszName, SHMVAR_NAME_SIZE_MAX))
+        {
+            return (int)(uEntry - 1);
+        }
+        uPos = (uPos + 1) & (CFG_SHMVAR_INDEX_SIZE - 1);
+    }
+    return -1;
+}
+
+/**
+ * A single relaxed store: nothing else is published along with it.
+ */
+void shmvars::set(int iHandle, int64_t i64Value)
+{
+    MFW_SHMVAR_T* pVar = slot(iHandle, SVAR_TYPE_INT64);
+    if (pVar)
+    {
+        std::atomic_ref<uint64_t>(pVar->u64Value).store(
+            (uint64_t)i64Value, std::memory_order_relaxed);
+        shm_notify::publish(SHM_CHANNEL_VARS);
+    }
+}
+
+/**
+ * The double is stored as its bit pattern, so it too is one atomic
+ * 64-bit store.
+ */
+void shmvars::set(int iHandle, double dValue)
+{
+    MFW_SHMVAR_T* pVar = slot(iHandle, SVAR_TYPE_DOUBLE);
+    if (pVar)
+    {
+        std::atomic_ref<uint64_t>(pVar->u64Value).store(
+            std::bit_cast<uint64_t>(dValue), std::memory_order_relaxed);
+        shm_notify::publish(SHM_CHANNEL_VARS);
+    }
+}
+
+/**
+ * Seqlock write side. Writers exclude each other with the registry lock,
+ * which is robust, so a writer that dies mid-copy cannot wedge the
+ * variable: the next writer starts from the sequence rounded up to odd
+ * and leaves it even. The lock is held only for the copy.
+ */
+void shmvars::set(int iHandle, const std::string& ssValue)
+{
+    MFW_SHMVAR_T* pVar = slot(iHandle, SVAR_TYPE_STRING);
+    if (nullptr == pVar)
+    {
+        return;
+    }
+    size_t stLen = std::min<size_t>(ssValue.length(), pVar->uCapacity - 1);
+
+    {
+        std::lock_guard<SharedMemoryMutex> guard(*m_pLock);
+        std::atomic_ref<uint32_t> seq(pVar->uSequence);
+        uint32_t uOdd = seq.load(std::memory_order_relaxed) | 1;
+        seq.store(uOdd, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(&m_pVars->heap[pVar->uOffset], ssValue.data(), stLen);
+        m_pVars->heap[pVar->uOffset + stLen] = 0;
+        pVar->uLength = (uint32_t)stLen;
+        seq.store(uOdd + 1, std::memory_order_release);
+    }
+    shm_notify::publish(SHM_CHANNEL_VARS);
 }
 
-void shmvars::set(shmvar_index_t index,
-                  std::string ssName,
-                  std::string ssValue)
+/**
+ * One fetch_add on the shared slot; safe from any number of processes.
+ */
+int64_t shmvars::add(int iHandle, int64_t i64Delta)
 {
-    std::cout << "set: " << ssName << " " << ssValue << std::endl;
-    gpSh->m_pShMemng->shmvar[index].svar_type = SVAR_TYPE_CHAR;
-    strcpy(gpSh->m_pShMemng->shmvar[index].svar_name, ssName.c_str());
-    strcpy(gpSh->m_pShMemng->shmvar[index].svar_value.uChar.data,
-           ssValue.c_str());
-    gpSh->m_pShMemng->shmvar[index].svar_status = SVAR_STATUS_OK;
+    MFW_SHMVAR_T* pVar = slot(iHandle, SVAR_TYPE_INT64);
+    if (nullptr == pVar)
+    {
+        return 0;
+    }
+    int64_t i64New = (int64_t)std::atomic_ref<uint64_t>(pVar->u64Value)
+                         .fetch_add((uint64_t)i64Delta,
+                                    std::memory_order_relaxed) + i64Delta;
+    shm_notify::publish(SHM_CHANNEL_VARS);
+    return i64New;
 }
 
-void shmvars::set(shmvar_index_t index,
-                  std::string ssName,
-                  int iValue)
+/**
+ * A single relaxed load; never blocks.
+ */
+int64_t shmvars::get_int(int iHandle) const
 {
-    std::cout << "set: " << ssName << " " << iValue << std::endl;
-    gpSh->m_pShMemng->shmvar[index].svar_type = SVAR_TYPE_INT;
-    strcpy(gpSh->m_pShMemng->shmvar[index].svar_name, ssName.c_str());
-    gpSh->m_pShMemng->shmvar[index].svar_value.uInt.data = iValue;
-    gpSh->m_pShMemng->shmvar[index].svar_status = SVAR_STATUS_OK;
+    MFW_SHMVAR_T* pVar = const_cast<shmvars*>(this)->slot(iHandle,
+                                                          SVAR_TYPE_INT64);
+    return pVar ? (int64_t)std::atomic_ref<uint64_t>(pVar->u64Value).load(
+                      std::memory_order_relaxed)
+                : 0;
 }
 
-std::string shmvars::get_string(int index)
+/**
+ * A single relaxed load; never blocks.
+ */
+double shmvars::get_double(int iHandle) const
 {
-    char szBuffer[1024];
-    switch (gpSh->m_pShMemng->shmvar[index].svar_type)
+    MFW_SHMVAR_T* pVar = const_cast<shmvars*>(this)->slot(iHandle,
+                                                          SVAR_TYPE_DOUBLE);
+    return pVar ? std::bit_cast<double>(std::atomic_ref<uint64_t>(
+                      pVar->u64Value).load(std::memory_order_relaxed))
+                : 0.0;
+}
+
+/**
+ * Numbers are formatted with std::to_chars, which needs no locale and no
+ * format string parsing. Strings are copied with the seqlock read
+ * protocol and retried only if a writer was active. A sequence that
+ * stays odd while the registry lock is free was left by a writer that
+ * died, and the reader makes it even.
+ */
+std::string shmvars::get_string(int iHandle) const
+{
+    char szBuffer[32];
+    switch (type(iHandle))
+    {
+    case SVAR_TYPE_INT64:
     {
-    case SVAR_TYPE_CHAR:
-        return gpSh->m_pShMemng->shmvar[index].svar_value.uChar.data;
-    case SVAR_TYPE_INT:
-        sprintf(szBuffer, "%d",
-                gpSh->m_pShMemng->shmvar[index].svar_value.uInt.data);
-        return szBuffer;
+        auto res = std::to_chars(szBuffer, szBuffer + sizeof(szBuffer),
+                                 get_int(iHandle));
+        return std::string(szBuffer, res.ptr);
+    }
     case SVAR_TYPE_DOUBLE:
-        sprintf(szBuffer, "%f",
-                gpSh->m_pShMemng->shmvar[index].svar_value.uDouble.data);
-        return szBuffer;
+    {
+        auto res = std::to_chars(szBuffer, szBuffer + sizeof(szBuffer),
+                                 get_double(iHandle));
+        return std::string(szBuffer, res.ptr);
+    }
+    case SVAR_TYPE_STRING:
+    {
+        MFW_SHMVAR_T& var = m_pVars->vars[iHandle];
+        std::atomic_ref<uint32_t> seq(var.uSequence);
+        std::string ssValue;
+        int iStall = 0;
+        for (;;)
+        {
+            uint32_t uBefore = seq.load(std::memory_order_acquire);
+            if (uBefore & 1)
+            {
+                if (++iStall >= CFG_SEQLOCK_STALL)
+                {
+                    iStall = 0;
+                    if (m_pLock->try_lock())
+                    {
+                        uint32_t uOdd = uBefore;
+                        seq.compare_exchange_strong(uOdd, uOdd + 1,
+                                                    std::memory_order_release);
+                        m_pLock->unlock();
+                    }
+                }
+                sched_yield();
+                continue;
+            }
+            uint32_t uLen = std::min(var.uLength, var.uCapacity - 1);
+            ssValue.assign(&m_pVars->heap[var.uOffset], uLen);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) == uBefore)
+            {
+                return ssValue;
+            }
+        }
+    }
     default:
-        return "ERROR";
+        return "";
+    }
+}
+
+/**
+ * Returns the name of a variable.
+ */
+const char* shmvars::name(int iHandle) const
+{
+    return (iHandle < 0 || iHandle >= count())
+               ? "" : m_pVars->vars[iHandle].szName;
+}
+
+/**
+ * Returns the type of a variable.
+ */
+svar_type_t shmvars::type(int iHandle) const
+{
+    return (iHandle < 0 || iHandle >= count())
+               ? SVAR_TYPE_NONE : (svar_type_t)m_pVars->vars[iHandle].uType;
+}
+
+/**
+ * Returns the number of registered variables.
+ */
+int shmvars::count() const
+{
+    return (int)std::atomic_ref<uint32_t>(m_pVars->uCount).load(
+        std::memory_order_acquire);
+}
+
+/**
+ * Copies the registry as it stands. Registration in the old segment is
+ * locked but reads of uCount are not, so the slot count is clamped, and
+ * every string sequence is rounded up to the next even value.
+ */
+void shmvars::migrate(void* pDst, const void* pSrc,
+                      size_t stDst, size_t stSrc)
+{
+    if (stDst != stSrc || stDst != sizeof(MFW_SHMVARS_T))
+    {
+        return;
+    }
+    auto* pTo = (MFW_SHMVARS_T*)pDst;
+    memcpy(pTo, pSrc, sizeof(MFW_SHMVARS_T));
+    pTo->uCount = std::min<uint32_t>(pTo->uCount, CFG_SHMVAR_MAX);
+    for (uint32_t i = 0; i < pTo->uCount; i++)
+    {
+        pTo->vars[i].uSequence = (pTo->vars[i].uSequence + 1) & ~1u;
     }
 }
+
+///////////////////////
+// eof - shmvars.cpp //
+///////////////////////
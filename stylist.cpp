@@ -315,7 +315,7 @@ stylist::stylist(int handle)
     // std::string ssCssFQFS =
     //     "/home/devo/public_html/fw/styles/doug.css";
 
-    std::string ssUser = gpSh->m_pShMemng->szUser;
+    std::string ssUser = gpShMemCfg->get(SHM_STR_USER);
     std::string ssCssFQFS = gpOS->genStyleFQFS(
         (const char*)ssUser.append(".css").c_str(), false);
     gpSysLog->loginfo(ssCssFQFS.c_str());
@@ -329,34 +329,39 @@ stylist::stylist(int handle)
     fprintf(fp, "%s\n", journal_reset());
     fprintf(fp, "%s\n", journal_textarea());
 
+    // One consistent copy of the colours, however often they are
+    // republished while the file is being written
+    MFW_PREFS_T prefs;
+    SharedMemoryPrefs::load(handle, prefs);
+
     fprintf(fp, "%s\n", table(
-                gpSh->m_pShMemng->prefs[handle].szTableFGcolor,
-                gpSh->m_pShMemng->prefs[handle].szTableFGcolor)
+                prefs.szTableFGcolor,
+                prefs.szTableFGcolor)
     );
 
     fprintf(fp, "%s\n", body(
-                gpSh->m_pShMemng->prefs[handle].szBodyFGcolor,
-                gpSh->m_pShMemng->prefs[handle].szBodyBGcolor)
+                prefs.szBodyFGcolor,
+                prefs.szBodyBGcolor)
     );
 
     fprintf(fp, "%s\n", tr(
-                gpSh->m_pShMemng->prefs[handle].szTrFGcolor,
-                gpSh->m_pShMemng->prefs[handle].szTrBGcolor)
+                prefs.szTrFGcolor,
+                prefs.szTrBGcolor)
     );
 
     fprintf(fp, "%s\n", th(
-                gpSh->m_pShMemng->prefs[handle].szThFGcolor,
-                gpSh->m_pShMemng->prefs[handle].szThBGcolor)
+                prefs.szThFGcolor,
+                prefs.szThBGcolor)
     );
 
     fprintf(fp, "%s\n", dot_dashboard(
-                gpSh->m_pShMemng->prefs[handle].szDbFGcolor,
-                gpSh->m_pShMemng->prefs[handle].szDbBGcolor)
+                prefs.szDbFGcolor,
+                prefs.szDbBGcolor)
     );
 
     fprintf(fp, "%s\n", td(
-                gpSh->m_pShMemng->prefs[handle].szTdFGcolor,
-                gpSh->m_pShMemng->prefs[handle].szTdBGcolor)
+                prefs.szTdFGcolor,
+                prefs.szTdBGcolor)
     );
 
     fclose(fp);
@@ -33,7 +33,9 @@
  * Requires linking with the MultiWare Framework library and proper include paths.
  * 
  * @section usage Usage
- * Run the executable directly - displays all shared memory information
+ * Run the executable directly - displays all shared memory information.
+ * With -w (or --watch) it stays up and redraws whenever a writer publishes
+ * a change (see shm_notify); it sleeps in between, without polling.
  */
 
 #include "mwfw2.h"
@@ -41,7 +43,7 @@
 #include <vector>
 
 /**
- * @brief Main entry point for the shared memory viewer utility
+ * @brief Draws one complete view of the shared memory segment
  * 
  * This utility provides a clean, organized view of the framework's shared memory
  * contents. It creates a compact window interface that displays all shared memory
@@ -58,17 +60,9 @@
  * - Display preferences
  * - Authentication credentials
  * - User color preferences
- * 
- * @param argc Number of command line arguments (currently unused)
- * @param argv Array of command line argument strings (currently unused)
- * 
- * @return EXIT_SUCCESS on successful completion
  */
-int main(int argc, char** argv)
+static void render_view()
 {
-    // Initialize the MultiWare Framework
-    auto* pMwFw = new mwfw2(__FILE__, __FUNCTION__);
-
     // Clear screen and position cursor
     gpCrt->crtclr();
     gpCrt->crtlc(1,1);
@@ -107,48 +101,48 @@ int main(int argc, char** argv)
 
     // Development directories section
     pWin->add_row("=== DEVELOPMENT DIRECTORIES ===");
-    pWin->add_row(std::string("Development:      ") + gpSh->m_pShMemng->szDevoDir);
-    pWin->add_row(std::string("Build:            ") + gpSh->m_pShMemng->szBuildFQDS);
-    pWin->add_row(std::string("CGI-Bin:          ") + gpSh->m_pShMemng->szCgiBinFQDS);
-    pWin->add_row(std::string("Documentation:    ") + gpSh->m_pShMemng->szDocFQDS);
-    pWin->add_row(std::string("Images:           ") + gpSh->m_pShMemng->szImgFQDS);
-    pWin->add_row(std::string("Include:          ") + gpSh->m_pShMemng->szIncludeFQDS);
-    pWin->add_row(std::string("Logs:             ") + gpSh->m_pShMemng->szLogFQDS);
-    pWin->add_row(std::string("Schemas:          ") + gpSh->m_pShMemng->szSchemasFQDS);
-    pWin->add_row(std::string("Scripts:          ") + gpSh->m_pShMemng->szScriptsFQDS);
-    pWin->add_row(std::string("Styles:           ") + gpSh->m_pShMemng->szStylesFQDS);
-    pWin->add_row(std::string("Temp:             ") + gpSh->m_pShMemng->szTempFQDS);
+    pWin->add_row(std::string("Development:      ") + gpShMemCfg->get(SHM_STR_DEVO_DIR));
+    pWin->add_row(std::string("Build:            ") + gpShMemCfg->get(SHM_STR_BUILD_FQDS));
+    pWin->add_row(std::string("CGI-Bin:          ") + gpShMemCfg->get(SHM_STR_CGIBIN_FQDS));
+    pWin->add_row(std::string("Documentation:    ") + gpShMemCfg->get(SHM_STR_DOC_FQDS));
+    pWin->add_row(std::string("Images:           ") + gpShMemCfg->get(SHM_STR_IMG_FQDS));
+    pWin->add_row(std::string("Include:          ") + gpShMemCfg->get(SHM_STR_INCLUDE_FQDS));
+    pWin->add_row(std::string("Logs:             ") + gpShMemCfg->get(SHM_STR_LOG_FQDS));
+    pWin->add_row(std::string("Schemas:          ") + gpShMemCfg->get(SHM_STR_SCHEMAS_FQDS));
+    pWin->add_row(std::string("Scripts:          ") + gpShMemCfg->get(SHM_STR_SCRIPTS_FQDS));
+    pWin->add_row(std::string("Styles:           ") + gpShMemCfg->get(SHM_STR_STYLES_FQDS));
+    pWin->add_row(std::string("Temp:             ") + gpShMemCfg->get(SHM_STR_TEMP_FQDS));
     pWin->add_row("");
 
     // User information section  
     pWin->add_row("=== USER & CONFIGURATION ===");
-    pWin->add_row(std::string("User:             ") + gpSh->m_pShMemng->szUser);
-    pWin->add_row(std::string("Home:             ") + gpSh->m_pShMemng->szHomeFQDS);
-    pWin->add_row(std::string("User Directory:   ") + gpSh->m_pShMemng->szUserdirFQDS);
-    pWin->add_row(std::string("Source:           ") + gpSh->m_pShMemng->szSourceFQDS);
-    pWin->add_row(std::string("Config Dir:       ") + gpSh->m_pShMemng->szConfigFQDS);
-    pWin->add_row(std::string("Config File:      ") + gpSh->m_pShMemng->szConfigFQFS);
+    pWin->add_row(std::string("User:             ") + gpShMemCfg->get(SHM_STR_USER));
+    pWin->add_row(std::string("Home:             ") + gpShMemCfg->get(SHM_STR_HOME_FQDS));
+    pWin->add_row(std::string("User Directory:   ") + gpShMemCfg->get(SHM_STR_USERDIR_FQDS));
+    pWin->add_row(std::string("Source:           ") + gpShMemCfg->get(SHM_STR_SOURCE_FQDS));
+    pWin->add_row(std::string("Config Dir:       ") + gpShMemCfg->get(SHM_STR_CONFIG_FQDS));
+    pWin->add_row(std::string("Config File:      ") + gpShMemCfg->get(SHM_STR_CONFIG_FQFS));
     pWin->add_row("");
 
     // Network information section
     pWin->add_row("=== NETWORK SETTINGS ===");
-    pWin->add_row(std::string("Hostname:         ") + gpSh->m_pShMemng->szHostname);
-    pWin->add_row(std::string("Interface:        ") + gpSh->m_pShMemng->szIface);
-    pWin->add_row(std::string("IP Address:       ") + gpSh->m_pShMemng->szIP);
-    pWin->add_row(std::string("Public IP:        ") + gpSh->m_pShMemng->szPublicIP);
-    pWin->add_row(std::string("Protocol:         ") + gpSh->m_pShMemng->szProtocol);
+    pWin->add_row(std::string("Hostname:         ") + gpShMemCfg->get(SHM_STR_HOSTNAME));
+    pWin->add_row(std::string("Interface:        ") + gpShMemCfg->get(SHM_STR_IFACE));
+    pWin->add_row(std::string("IP Address:       ") + gpShMemCfg->get(SHM_STR_IP));
+    pWin->add_row(std::string("Public IP:        ") + gpShMemCfg->get(SHM_STR_PUBLIC_IP));
+    pWin->add_row(std::string("Protocol:         ") + gpShMemCfg->get(SHM_STR_PROTOCOL));
     pWin->add_row("");
 
     // Web server configuration
     pWin->add_row("=== WEB SERVER ROOTS ===");
-    pWin->add_row(std::string("CGI Root:         ") + gpSh->m_pShMemng->szCgiRoot);
-    pWin->add_row(std::string("HTML Root:        ") + gpSh->m_pShMemng->szHtmlRoot);
-    pWin->add_row(std::string("Image Root:       ") + gpSh->m_pShMemng->szImgRoot);
+    pWin->add_row(std::string("CGI Root:         ") + gpShMemCfg->get(SHM_STR_CGI_ROOT));
+    pWin->add_row(std::string("HTML Root:        ") + gpShMemCfg->get(SHM_STR_HTML_ROOT));
+    pWin->add_row(std::string("Image Root:       ") + gpShMemCfg->get(SHM_STR_IMG_ROOT));
     pWin->add_row("");
 
     // RPC and remote access information
     pWin->add_row("=== RPC & REMOTE ACCESS ===");
-    pWin->add_row(std::string("RPC UUID:         ") + gpSh->m_pShMemng->szRpcUuid);
+    pWin->add_row(std::string("RPC UUID:         ") + gpShMemCfg->get(SHM_STR_RPC_UUID));
     pWin->add_row(std::string("Remote Host:      ") + gpSh->m_pShMemng->szRemoteHost);
     pWin->add_row(std::string("Remote Address:   ") + gpSh->m_pShMemng->szRemoteAddr);
     pWin->add_row(std::string("Remote Auth:      ") + gpSh->m_pShMemng->szRemoteAuth);
@@ -214,18 +208,115 @@ int main(int argc, char** argv)
     
     pWin->add_row("");
 
+    // Session table summary
+    pWin->add_row("=== SESSIONS ===");
+    sprintf(szInfo, "Live Sessions:    %d of %d slots",
+            gpShMemSess->count(), SharedMemorySessions::capacity());
+    pWin->add_row(szInfo);
+    const MFW_SESSION_WHEEL_T& wheel = gpSh->m_pShMemng->sessions.wheel;
+    sprintf(szInfo, "Expiry Wheel:     %u scheduled, swept %us ago",
+            wheel.uScheduled, SharedMemorySessions::now() - wheel.uTick);
+    pWin->add_row(szInfo);
+    pWin->add_row("");
+
+    // Self-describing segment header
+    const MFW_SHMHDR_T& hdr = gpSh->m_pShMemng->hdr;
+    pWin->add_row("=== SEGMENT LAYOUT ===");
+    sprintf(szInfo, "Layout Version:   %u (key 0x%x, %u fields)",
+            hdr.uLayoutVersion, (unsigned)shared::key_for(hdr.uLayoutVersion),
+            hdr.uFieldCount);
+    pWin->add_row(szInfo);
+    if (hdr.uMigratedFrom) {
+        sprintf(szInfo, "Migrated From:    layout %u (%u fields carried over)",
+                hdr.uMigratedFrom, hdr.uMigratedFields);
+    } else {
+        sprintf(szInfo, "Migrated From:    (built from scratch)");
+    }
+    pWin->add_row(szInfo);
+    const MFW_WARMSTART_T& warm = gpSh->m_pShMemng->warm;
+    sprintf(szInfo, "Warm Start:       %s, %u checkpoints",
+            SHM_WARM_COLD == warm.uState ? "cold" :
+            SHM_WARM_RESTORED == warm.uState ? "restored" : "restored+validated",
+            warm.uCheckpoints);
+    pWin->add_row(szInfo);
+    pWin->add_row("");
+
+    // Seqlock-protected configuration block
+    pWin->add_row("=== CONFIG BLOCK ===");
+    sprintf(szInfo, "Config Version:   %u", gpShMemCfg->version());
+    pWin->add_row(szInfo);
+    sprintf(szInfo, "String Pool:      %zu of %d bytes",
+            gpShMemCfg->used(), CFG_STRPOOL_SIZE);
+    pWin->add_row(szInfo);
+    pWin->add_row("");
+
+    // Registered shared variables
+    pWin->add_row("=== VARIABLES ===");
+    for (int i = 0; i < gpShMemVars->count(); i++) {
+        sprintf(szInfo, "%-24s %s", gpShMemVars->name(i),
+                gpShMemVars->get_string(i).substr(0, 48).c_str());
+        pWin->add_row(szInfo);
+    }
+    pWin->add_row("");
+
+    // Sharded event counters, summed across CPUs
+    pWin->add_row("=== COUNTERS ===");
+    shm_counter::for_each([&](const char* pszName, uint64_t u64Value) {
+        sprintf(szInfo, "%-24s %llu", pszName, (unsigned long long)u64Value);
+        pWin->add_row(szInfo);
+    });
+    pWin->add_row("");
+
+    // Variable-size records in the POSIX shm heap
+    pWin->add_row("=== HEAP ===");
+    auto live = gpShMemHeap->live();
+    sprintf(szInfo, "Carved: %llu of %llu KiB, %llu blocks live (%llu KiB)",
+            (unsigned long long)(gpShMemHeap->used() >> 10),
+            (unsigned long long)(gpShMemHeap->size() >> 10),
+            (unsigned long long)live.first,
+            (unsigned long long)(live.second >> 10));
+    pWin->add_row(szInfo);
+    sprintf(szInfo, "Failed allocations: %llu",
+            (unsigned long long)gpShMemHeap->failures());
+    pWin->add_row(szInfo);
+    gpShMemHeap->for_each_root([&](const char* pszName, uint64_t u64Off) {
+        sprintf(szInfo, "%-24s @0x%llx", pszName, (unsigned long long)u64Off);
+        pWin->add_row(szInfo);
+    });
+    pWin->add_row("");
+
+    // Shared lock statistics
+    pWin->add_row("=== LOCK STATISTICS ===");
+    for (auto& lock : gpSh->m_pShMemng->locks) {
+        if (SHMLOCK_READY != lock.uState) {
+            continue;
+        }
+        sprintf(szInfo, "%-20s acq=%llu cont=%llu avg=%lluns max=%lluns dead=%llu",
+                lock.szName,
+                (unsigned long long)lock.u64Acquisitions,
+                (unsigned long long)lock.u64Contentions,
+                (unsigned long long)(lock.u64Contentions ?
+                    lock.u64WaitNsTotal / lock.u64Contentions : 0),
+                (unsigned long long)lock.u64WaitNsMax,
+                (unsigned long long)lock.u64OwnerDeaths);
+        pWin->add_row(szInfo);
+    }
+    pWin->add_row("");
+
     // User preferences summary
     pWin->add_row("=== USER PREFERENCES ===");
     bool foundPrefs = false;
     int prefCount = 0;
     
+    MFW_PREFS_T prefs;
     for (int i = 0; i < ROW_DATA+CFG_MAX_USERS && prefCount < 3; i++) {
-        if (strlen(gpSh->m_pShMemng->prefs[i].szBodyFGcolor) > 0) {
+        SharedMemoryPrefs::load(i, prefs);
+        if (strlen(prefs.szBodyFGcolor) > 0) {
             sprintf(szInfo, "User %d: Body=%s/%s, Table=%s/%s", i,
-                    gpSh->m_pShMemng->prefs[i].szBodyFGcolor,
-                    gpSh->m_pShMemng->prefs[i].szBodyBGcolor,
-                    gpSh->m_pShMemng->prefs[i].szTableFGcolor,
-                    gpSh->m_pShMemng->prefs[i].szTableBGcolor);
+                    prefs.szBodyFGcolor,
+                    prefs.szBodyBGcolor,
+                    prefs.szTableFGcolor,
+                    prefs.szTableBGcolor);
             pWin->add_row(szInfo);
             
             foundPrefs = true;
@@ -239,6 +330,37 @@ int main(int argc, char** argv)
     
     // Render the complete window
     pWin->render();
+    delete pWin;
+}
+
+/**
+ * @brief Main entry point for the shared memory viewer utility
+ *
+ * In watch mode the generation of SHM_CHANNEL_ANY is taken before each
+ * redraw, so a change that lands while the view is being drawn still
+ * triggers the next one.
+ *
+ * @param argc Number of command line arguments
+ * @param argv Array of command line argument strings; -w or --watch
+ *             selects watch mode
+ *
+ * @return EXIT_SUCCESS on successful completion
+ */
+int main(int argc, char** argv)
+{
+    // Initialize the MultiWare Framework
+    auto* pMwFw = new mwfw2(__FILE__, __FUNCTION__);
+
+    bool bWatch = argc > 1 && (0 == strcmp(argv[1], "-w") ||
+                               0 == strcmp(argv[1], "--watch"));
+
+    uint32_t uSeen;
+    do
+    {
+        uSeen = shm_notify::generation(SHM_CHANNEL_ANY);
+        render_view();
+    }
+    while (bWatch && shm_notify::wait(SHM_CHANNEL_ANY, uSeen));
 
     return EXIT_SUCCESS;
 }
@@ -12,45 +12,13 @@
 //#define DISPLAY_PROCESS_INFO
 //#define DISPLAY_PROCESS_DETAILS
 
-
 /**
- * @brief Array of RPC function name strings for use in debugging or display
- * purposes
- *
- * This constant array maps the internal identifiers for RPC functions to their
- * corresponding human-readable names. The names are prefixed with "Function"
- * for clarity during debugging, logging, or monitoring operations.
- *
- * The functions represented in this array include:
- * - "Function None": Indicates no operation or a placeholder function.
- * - "Function Get_Auth": Represents the function used to obtain authentication
- * details.
- * - "Function Host2ipv4addr": Converts a hostname to its corresponding IPv4
- * address.
- * - "Function Version": Retrieves the version of the application or service.
- * - "Function Lookup": Performs a lookup operation based on specific
- * parameters.
- * - "Function Creds": Handles credential-related operations.
- *
- * This data is typically used by window-based debugging utilities to present a
- * clear and user-friendly description of the operations being processed.
- *
- * @note The indices in this array correspond directly to the enumerated values
- *       for function identifiers (e.g., `VPARPC_FUNC_GET_AUTH`).
- *
- * @warning Ensure that any changes to the function enumeration or identifiers
- *          are reflected in this array to avoid mismatches or incorrect
- *          mappings.
+ * Set when process() and the handlers keep a diagnostics window; the
+ * per-request CLog and syslog traces come and go with it.
  */
-const char* vparpc_func_names[] = {
-    "  Function None",
-    "  Function Get_Auth",
-    "  Function Host2ipv4addr",
-    "  Function Version",
-    "  Function Lookup",
-    "  Function Creds",
-    "  Function URLS"
-};
+#if defined(DISPLAY_PROCESS_INFO) || defined(DISPLAY_PROCESS_DETAILS)
+#define DISPLAY_PROCESS
+#endif
 
 /**
  * @return The result or status from the vparpc function execution.
@@ -59,8 +27,176 @@ vparpc::vparpc()
 {
     CLog log(__FILE__, __FUNCTION__);
     log.write(__PRETTY_FUNCTION__);
+    v_nSendSocket = -1;
+    v_uNextId = 1;
+    v_bPipelineOk = true;
+}
+
+/**
+ * Closes the connection of a pipeline that was never collected; its
+ * replies would put the connection out of step for the next user.
+ */
+vparpc::~vparpc()
+{
+    if (-1 != v_nSendSocket)
+    {
+        close(v_nSendSocket);
+    }
+}
+
+/**
+ * Bounds every blocking read and write on a socket, so neither a stalled
+ * server nor a stalled client can hold the other up indefinitely.
+ */
+void vparpc::set_io_timeout(int fd)
+{
+    struct timeval tv;
+    tv.tv_sec = CFG_VPARPC_IO_TIMEOUT_MS / 1000;
+    tv.tv_usec = (CFG_VPARPC_IO_TIMEOUT_MS % 1000) * 1000;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+
+/**
+ * True if the peer has already sent more, without waiting for it.
+ */
+static bool request_waiting(int fd)
+{
+    struct pollfd pfd = {fd, POLLIN, 0};
+    return 1 == poll(&pfd, 1, 0);
+}
+
+/**
+ * recv() on a socket, read() on anything else; the inetd server's
+ * standard input is a socket in service but may be a pipe under test.
+ */
+static ssize_t read_some(int fd, char* pBuffer, size_t stLen)
+{
+    ssize_t n = recv(fd, pBuffer, stLen, 0);
+    if (-1 == n && ENOTSOCK == errno)
+    {
+        n = read(fd, pBuffer, stLen);
+    }
+    return n;
+}
+
+ssize_t vparpc::frame_length(const void* pBuffer, size_t stHave,
+                             size_t stMax)
+{
+    if (stHave < VPARPC_FRAME_HEADER_SIZE)
+    {
+        return 0;
+    }
+    size_t nSize;
+    memcpy(&nSize, (const char*)pBuffer +
+           offsetof(vparpc_request_generic_t, nSize), sizeof(nSize));
+    if (nSize < VPARPC_FRAME_HEADER_SIZE || nSize > stMax)
+    {
+        return -1;
+    }
+    return (ssize_t)nSize;
 }
 
+/**
+ * MSG_NOSIGNAL turns a peer that has gone away into EPIPE rather than a
+ * SIGPIPE that would kill the calling CGI.
+ */
+bool vparpc::send_frame(int fd, const void* pFrame, size_t stLen)
+{
+    const char* p = (const char*)pFrame;
+    while (stLen > 0)
+    {
+        ssize_t n = send(fd, p, stLen, MSG_NOSIGNAL);
+        if (-1 == n && ENOTSOCK == errno)
+        {
+            n = write(fd, p, stLen);
+        }
+        if (n > 0)
+        {
+            p += n;
+            stLen -= n;
+            continue;
+        }
+        if (-1 == n && EINTR == errno)
+        {
+            continue;
+        }
+        return false;
+    }
+    return true;
+}
+
+ssize_t vparpc::recv_frame(int fd, void* pBuffer, size_t stMax)
+{
+    char* p = (char*)pBuffer;
+    size_t stHave = 0;
+    size_t stWant = VPARPC_FRAME_HEADER_SIZE;
+    bool bSized = false;
+
+    if (stMax < VPARPC_FRAME_HEADER_SIZE)
+    {
+        return -1;
+    }
+    while (stHave < stWant)
+    {
+        ssize_t n = read_some(fd, p + stHave, stWant - stHave);
+        if (0 == n)
+        {
+            return 0 == stHave ? 0 : -1;
+        }
+        if (n < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            return -1;
+        }
+        stHave += n;
+        if (!bSized && stHave == VPARPC_FRAME_HEADER_SIZE)
+        {
+            ssize_t iLength = frame_length(p, stHave, stMax);
+            if (iLength < 0)
+            {
+                return -1;
+            }
+            stWant = iLength;
+            bSized = true;
+        }
+    }
+    return (ssize_t)stWant;
+}
+
+typedef void (vparpc::*vparpc_handler_t)(char*, window*);
+
+/**
+ * Compares a request's token with the RPC UUID in this thread's copy of
+ * the config pool, which costs an atomic load and a strcmp rather than
+ * the std::string that gpShMemCfg->get() would build. A trusted local
+ * peer needs no token.
+ */
+static bool authorized(const char8_t* szAuth)
+{
+    return rpcServer::peer_trusted() ||
+           0 == strcmp(SharedMemoryConfig::str(gpShMemCfg->current(),
+                                               SHM_STR_RPC_UUID),
+                       (const char*)szAuth);
+}
+
+/**
+ * The handlers the IDL lists, indexed by vparpc_func_t; the other entries
+ * are null.
+ */
+static constexpr std::array<vparpc_handler_t, VPARPC_FUNC_COUNT> gHandlers =
+    [] {
+        std::array<vparpc_handler_t, VPARPC_FUNC_COUNT> handlers = {};
+#define VPARPC_HANDLER(func, member) \
+        handlers[VPARPC_FUNC_##func] = &vparpc::handle_##member##_request;
+        VPARPC_IDL_HANDLERS(VPARPC_HANDLER)
+#undef VPARPC_HANDLER
+        return handlers;
+    }();
+
 /**
  * Processes the given input and performs operations as defined in the
  * implementation.
@@ -76,22 +212,31 @@ vparpc::vparpc()
 //
 void vparpc::process(char* pszBuffer)
 {
+    auto start = std::chrono::steady_clock::now();
+
+#ifdef DISPLAY_PROCESS
     CLog log(__FILE__, __FUNCTION__);
     log.write(__PRETTY_FUNCTION__);
 
     gpSysLog->loginfo(__PRETTY_FUNCTION__);
+#endif // DISPLAY_PROCESS
 
     // std::cout << "vparpc::process()" << std::endl;
     // std::cout << "vparpc::process() at line # " << __LINE__ << std::endl;
 
-    // Create window for debugging/monitoring
-    auto* pWin = new window();
+    // Create window for debugging/monitoring, only when something will
+    // be shown in it: process() runs on every worker thread of
+    // server_pool() and must not touch shared drawing state otherwise.
+    window* pWin = nullptr;
+#ifdef DISPLAY_PROCESS
+    pWin = new window();
     pWin->set_title("vparpc::process()");
     gpSemiGr->cosmetics(
         SRUL, SRUR,
         SRLL, SRLR,
         SVSR, SVSL,
         SH, SV);
+#endif
 
     // We don't know what type of request it is yet, we we cast it
     // generic long enough to decode the eFunc
@@ -107,36 +252,36 @@ void vparpc::process(char* pszBuffer)
 
     //pWin->add_row(szDebug);
 
-    gpSysLog->loginfo("server at switch");
-    switch (request->eFunc)
-    {
-    case VPARPC_FUNC_GET_AUTH:
-        handle_auth_request(pszBuffer, pWin);
-        break;
+    // Request accounting: one relaxed atomic add on this CPU's shard.
+    static shm_counter requests("vparpc.requests");
+    static shm_counter nanos("vparpc.process.ns");
+    requests.add();
+    gpShMemSess->sweep();
 
-    case VPARPC_FUNC_VERSION:
-        handle_version_request(pszBuffer, pWin);
-        break;
-
-    case VPARPC_FUNC_LOOKUP:
-        handle_lookup_request(pszBuffer, pWin);
-        break;
-
-    case VPARPC_FUNC_CREDS:
-        handle_creds_request(pszBuffer, pWin);
-        break;
-
-
-    default:
+    uint32_t uFunc = request->eFunc;
+    if (uFunc < VPARPC_FUNC_COUNT && nullptr != gHandlers[uFunc])
+    {
+        (this->*gHandlers[uFunc])(pszBuffer, pWin);
+    }
+    else
+    {
+        static shm_counter unknown("vparpc.unknown");
+        unknown.add();
+#ifdef DISPLAY_PROCESS
         gpSysLog->loginfo("server at default, ignoring request");
-        break;
+#endif // DISPLAY_PROCESS
     }
 
 #ifdef DISPLAY_PROCESS_INFO
     pWin->render();
 #endif // DISPLAY_PROCESS_INFO
 
+#ifdef DISPLAY_PROCESS
     delete pWin;
+#endif // DISPLAY_PROCESS
+
+    nanos.add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
 }
 
 
@@ -151,7 +296,8 @@ void vparpc::process(char* pszBuffer)
  *
  * If the provided PSK matches the expected value, the function sets the
  * authentication status to success and populates the `szAuth` field with a
- * UUID. Otherwise, it marks the request as authentication failed. The size
+ * UUID. A trusted local peer without the PSK succeeds with an empty
+ * `szAuth`. Otherwise, it marks the request as authentication failed. The size
  * of the packet is also logged in the provided window object.
  *
  * @param buffer The incoming request buffer containing the authentication
@@ -162,10 +308,12 @@ void vparpc::process(char* pszBuffer)
  */
 void vparpc::handle_auth_request(char* buffer, window* pWin)
 {
+#ifdef DISPLAY_PROCESS
     CLog log(__FILE__, __FUNCTION__);
     log.write(__PRETTY_FUNCTION__);
 
     gpSysLog->loginfo(__PRETTY_FUNCTION__);
+#endif // DISPLAY_PROCESS
 
 #ifdef DISPLAY_PROCESS_DETAILS
     pWin->add_row("  Processing AUTH request");
@@ -174,10 +322,24 @@ void vparpc::handle_auth_request(char* buffer, window* pWin)
     // up the PSK out of the request packet, and know more about the response
     // fields.
     vparpc_request_auth_t* pReq = (vparpc_request_auth_t*)buffer;
-    if (0 == strcmp((char*)CFG_VPA_RPC_PSK, (const char*)pReq->szPSK))
+    bool bKey = 0 == strcmp((char*)CFG_VPA_RPC_PSK, (const char*)pReq->szPSK);
+    if (bKey || rpcServer::peer_trusted())
     {
-        // Caller presented correct pre-shared key
-        strcpy(pReq->szAuth, gpSh->m_pShMemng->szRpcUuid);
+        // Caller presented correct pre-shared key, or is a trusted local
+        // peer that needs none. The RPC UUID opens every VPA on the
+        // network, so only a caller holding the key is given it; a
+        // trusted peer gets an empty token, which authorized() accepts
+        // on its own connection.
+        if (bKey)
+        {
+            strcpy(pReq->szAuth,
+                   SharedMemoryConfig::str(gpShMemCfg->current(),
+                                           SHM_STR_RPC_UUID));
+        }
+        else
+        {
+            pReq->szAuth[0] = 0;
+        }
 #ifdef DISPLAY_PROCESS_DETAILS
         std::string ssPSKmsg = "  Current Auth is: ";
         ssPSKmsg += pReq->szAuth;
@@ -229,7 +391,9 @@ void vparpc::handle_auth_request(char* buffer, window* pWin)
  */
 void vparpc::handle_version_request(char* buffer, window* pWin)
 {
+#ifdef DISPLAY_PROCESS
     gpSysLog->loginfo(__PRETTY_FUNCTION__);
+#endif // DISPLAY_PROCESS
 
 #ifdef DISPLAY_PROCESS_DETAILS
     pWin->add_row("  Processing VERSION request");
@@ -237,7 +401,7 @@ void vparpc::handle_version_request(char* buffer, window* pWin)
 
     vparpc_request_version_t* pReq = (vparpc_request_version_t*)buffer;
 
-    if (0 == strcmp(gpSh->m_pShMemng->szRpcUuid, (const char*)pReq->szAuth))
+    if (authorized(pReq->szAuth))
     {
         strcpy(pReq->szVersion,RSTRING);
         pReq->eStatus = VPARPC_STATUS_OK;
@@ -268,22 +432,28 @@ void vparpc::handle_version_request(char* buffer, window* pWin)
  */
 void vparpc::handle_lookup_request(char* buffer, window* pWin)
 {
+#ifdef DISPLAY_PROCESS
     CLog log(__FILE__, __FUNCTION__);
     log.write(__PRETTY_FUNCTION__);
 
     gpSysLog->loginfo(__PRETTY_FUNCTION__);
+#endif // DISPLAY_PROCESS
 
 #ifdef DISPLAY_PROCESS_DETAILS
     pWin->add_row("  Processing LOOKUP request");
 #endif // DISPLAY_PROCESS_DETAILS
 
     vparpc_request_lookup_t* pReq = (vparpc_request_lookup_t*)buffer;
-    if (0 == strcmp(gpSh->m_pShMemng->szRpcUuid, (const char*)pReq->szAuth))
+    if (authorized(pReq->szAuth))
     {
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  Auth match, authentication successful");
 #endif // DISPLAY_PROCESS_DETAILS
 
+        // gpCsv and gpPassword are process-wide; serialise the worker
+        // threads of server_pool() on them.
+        static std::mutex lookupLock;
+        std::lock_guard<std::mutex> guard(lookupLock);
         gpCsv = new readCsv("passwd.csv");
         gpCsv->parseData();
         pReq->iHandle =
@@ -311,71 +481,77 @@ void vparpc::handle_lookup_request(char* buffer, window* pWin)
  */
 void vparpc::handle_creds_request(char* buffer, window* pWin)
 {
+#ifdef DISPLAY_PROCESS
     CLog log(__FILE__, __FUNCTION__);
     log.write(__PRETTY_FUNCTION__);
+#endif // DISPLAY_PROCESS
 
 #ifdef DISPLAY_PROCESS_DETAILS
     pWin->add_row("  Processing CREDS request");
 #endif // DISPLAY_PROCESS_DETAILS
 
     vparpc_request_creds_t* pReq = (vparpc_request_creds_t*)buffer;
-    if (0 == strcmp(gpSh->m_pShMemng->szRpcUuid, (const char*)pReq->szAuth))
+    if (authorized(pReq->szAuth))
     {
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  Auth match, authentication successful");
 #endif // DISPLAY_PROCESS_DETAILS
 
-        strcpy(pReq->szAuthUserName,
-               gpSh->m_pShMemng->creds[pReq->iHandle].szAuthUserName);
+        // Resolve by session UUID when the caller supplied one, falling
+        // back to the passwd.csv row for older clients.
+        MFW_SESSION_T sess;
+        if (!gpShMemSess->resolve(pReq->szAuthUUID, pReq->iHandle, sess))
+        {
+#ifdef DISPLAY_PROCESS_DETAILS
+            pWin->add_row("  No session for UUID or handle");
+#endif // DISPLAY_PROCESS_DETAILS
+            pReq->eStatus = VPARPC_STATUS_ERROR;
+            return;
+        }
+
+        strcpy(pReq->szAuthUserName, sess.szAuthUserName);
 
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  AuthUserName: " + std::string(pReq->szAuthUserName));
 #endif // DISPLAY_PROCESS_DETAILS
 
-        strcpy(pReq->szAuthFirstName,
-               gpSh->m_pShMemng->creds[pReq->iHandle].szAuthFirstName);
+        strcpy(pReq->szAuthFirstName, sess.szAuthFirstName);
 
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  AuthFirstName: " + std::string(pReq->szAuthFirstName));
 #endif // DISPLAY_PROCESS_DETAILS
 
-        strcpy(pReq->szAuthLastName,
-               gpSh->m_pShMemng->creds[pReq->iHandle].szAuthLastName);
+        strcpy(pReq->szAuthLastName, sess.szAuthLastName);
 
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  AuthLastName: " + std::string(pReq->szAuthLastName));
 #endif // DISPLAY_PROCESS_DETAILS
 
-        strcpy(pReq->szAuthUUID,
-               gpSh->m_pShMemng->creds[pReq->iHandle].szAuthUUID);
+        strcpy(pReq->szAuthUUID, sess.szAuthUUID);
 
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  Auth UUID: " + std::string(pReq->szAuthUUID));
 #endif // DISPLAY_PROCESS_DETAILS
 
-        strcpy(pReq->szAuthLevel,
-               gpSh->m_pShMemng->creds[pReq->iHandle].szAuthLevel);
+        strcpy(pReq->szAuthLevel, sess.szAuthLevel);
 
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  AuthLevel: " + std::string(pReq->szAuthLevel));
 #endif // DISPLAY_PROCESS_DETAILS
 
-        strcpy(pReq->szRemoteHost,
-               gpSh->m_pShMemng->creds[pReq->iHandle].szRemoteHost);
+        strcpy(pReq->szRemoteHost, sess.szRemoteHost);
 
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  RemoteHost: " + std::string(pReq->szRemoteHost));
 #endif // DISPLAY_PROCESS_DETAILS
 
-        strcpy(pReq->szRemoteAddr,
-               gpSh->m_pShMemng->creds[pReq->iHandle].szRemoteAddr);
+        strcpy(pReq->szRemoteAddr, sess.szRemoteAddr);
 
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  RemoteAddr: " + std::string(pReq->szRemoteAddr));
 #endif // DISPLAY_PROCESS_DETAILS
 
-        strcpy(pReq->szHttpUserAgent,
-               gpSh->m_pShMemng->creds[pReq->iHandle].szHttpUserAgent);
+        strcpy(pReq->szHttpUserAgent, sess.szHttpUserAgent);
 
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  HttpUserAgent: " + std::string(pReq->szHttpUserAgent));
@@ -491,6 +667,16 @@ void vparpc::server(std::string ssService)
     CLog log(__FILE__, __FUNCTION__);
     log.write(__PRETTY_FUNCTION__);
 
+    // Only rpcServer reads peer credentials, so a local socket is served
+    // by it, one request at a time as here; a ring likewise.
+    std::string ssPath;
+    if (rpcResolver::unix_path(ssService, ssPath) ||
+        rpcShmRing::ring_name(ssService, ssPath))
+    {
+        server_pool(ssService, 1);
+        return;
+    }
+
     // BlockCipher cipher(16);
     // cipher.setKey("DouglasWGoodall");
     // char ciphertext[sizeof(vparpc_request_t)];
@@ -557,8 +743,8 @@ void vparpc::server(std::string ssService)
     }
     pWin->add_row("  Server bound to port " + std::to_string(iPort));
 
-    // Start listening for incoming connections (queue up to 5 pending cons)
-    if (listen(server_fd, 5) < 0)
+    // Start listening for incoming connections
+    if (listen(server_fd, CFG_VPARPC_BACKLOG) < 0)
     {
         perror("listen failed");
         close(server_fd);
@@ -581,6 +767,7 @@ void vparpc::server(std::string ssService)
                    &client_addr_len)) < 0)
         {
             pWin->add_row("  Error: accept failed");
+            delete pWin;
             continue; // Continue to next iteration on error
         }
 
@@ -591,22 +778,30 @@ void vparpc::server(std::string ssService)
         std::string ssClient = ssClientAddr + ":" + ssClientPort;
         pWin->add_row("  Client connected from " + ssClient);
 
-        // Clear receive buffer
-        memset(buffer, 0, BUFSIZ);
-
-        // Receive data from client
-        ssize_t bytes_received = recv(client_fd, buffer, BUFSIZ - 1, 0);
-        //ssize_t bytes_received = recv(client_fd, ciphertext, BUFSIZ - 1, 0);
-        if (bytes_received < 0)
-        {
-            pWin->add_row("  Error: recv failed");
-        }
-        else if (bytes_received == 0)
-        {
-            pWin->add_row("  Error: Client disconnected");
-        }
-        else
+        // Serve the request, and any others the client sent with it as a
+        // batch; stop as soon as none is waiting so that one client cannot
+        // hold up those queued behind it. A client whose later requests
+        // had not arrived yet sends them again on a new connection.
+        set_io_timeout(client_fd);
+        do
         {
+            // Clear receive buffer
+            memset(buffer, 0, BUFSIZ);
+
+            // Receive exactly one request frame from client
+            ssize_t bytes_received =
+                recv_frame(client_fd, buffer, sizeof(vparpc_request_t));
+            //ssize_t bytes_received = recv(client_fd, ciphertext, BUFSIZ - 1, 0);
+            if (bytes_received < 0)
+            {
+                pWin->add_row("  Error: recv failed");
+                break;
+            }
+            if (bytes_received == 0)
+            {
+                pWin->add_row("  Client disconnected");
+                break;
+            }
             buffer[bytes_received] = '\0'; // Null-terminate the received data
             pWin->add_row("  Received " + std::to_string(bytes_received));
 
@@ -619,23 +814,24 @@ void vparpc::server(std::string ssService)
             //
 
 
-            process(buffer);
+            size_t stReply = vparpcWire::respond(
+                buffer, bytes_received, sizeof(buffer),
+                [this](char* pRequest) { process(pRequest); });
 
             // Send response back to client
             ssize_t bytes_sent =
-                send(client_fd, buffer, bytes_received, 0);
+                send_frame(client_fd, buffer, stReply) ? stReply : -1;
 
             pWin->add_row("  Sent     " + std::to_string(bytes_sent));
 
             if (bytes_sent < 0)
             {
                 pWin->add_row("  Error: send failed");
+                break;
             }
-            else
-            {
-                pWin->add_row("  Response sent to client");
-            }
+            pWin->add_row("  Response sent to client");
         }
+        while (request_waiting(client_fd));
 
         // Close client connection
         close(client_fd);
@@ -651,148 +847,604 @@ void vparpc::server(std::string ssService)
 }
 
 /**
- * Sends a request to a specified client and processes the response.
- *
- * @param clientId The unique identifier of the client to which the request
- * will be sent.
- * @param request The request data to be sent to the client.
- * @param timeout The timeout value in milliseconds for waiting for the client
- * response.
- * @param isSecure A boolean flag indicating whether the request should use a
- * secure connection.
- * @param response A reference to a string where the client's response will
- * be stored.
- *
- * @return True if the request was successful and a response was received,
- * false otherwise.
+ * The reply is the request packet with its response fields filled in, or
+ * its v2 encoding, exactly as in server(), so clients cannot tell the two
+ * modes apart. Requests are framed by their nSize, and a client may send
+ * any number of them on one connection.
  */
+void vparpc::server_pool(std::string ssService, int iWorkers, int iBacklog,
+                         rpc_backend_t eBackend)
+{
+    CLog log(__FILE__, __FUNCTION__);
+    log.write(__PRETTY_FUNCTION__);
+
+    rpcServer::handler_t handler =
+        [this](char* pBuffer, size_t stLen, size_t stMax) {
+            // A connection's buffer, or a ring slot, is reused; clear
+            // what an earlier, longer request left behind this one.
+            memset(pBuffer + stLen, 0, stMax - stLen);
+            return vparpcWire::respond(
+                pBuffer, stLen, stMax,
+                [this](char* pRequest) { process(pRequest); });
+        };
+
+    std::string ssRing;
+    if (rpcShmRing::ring_name(ssService, ssRing))
+    {
+        try
+        {
+            rpcShmRing ring(ssRing);
+            ring.serve(iWorkers, handler);
+        }
+        catch (const std::system_error& e)
+        {
+            std::string ssMsg = "vparpc::server_pool: cannot set up ring ";
+            ssMsg += ssRing + " (" + e.what() + ")";
+            gpSysLog->loginfo(ssMsg.c_str());
+        }
+        return;
+    }
+
+    std::string ssPath;
+    bool bUnix = rpcResolver::unix_path(ssService, ssPath);
+    int iPort = bUnix ? 0 : svc2port(ssService);
+
+    rpcServer server(
+        sizeof(vparpc_request_t),
+        [](const char* pBuffer, size_t stHave) {
+            return frame_length(pBuffer, stHave, sizeof(vparpc_request_t));
+        },
+        handler);
+
+    if (bUnix && 0 == ssPath.compare(0, sizeof(CFG_VPARPC_UNIX_DIR),
+                                     CFG_VPARPC_UNIX_DIR "/"))
+    {
+        mkdir(CFG_VPARPC_UNIX_DIR, 0755);
+    }
+    if (bUnix ? !server.listen_unix(ssPath, iBacklog) :
+                !server.listen(iPort, iBacklog))
+    {
+        std::string ssMsg = "vparpc::server_pool: cannot listen on ";
+        ssMsg += bUnix ? ssPath : "port " + std::to_string(iPort);
+        ssMsg += " (" + std::string(strerror(errno)) + ")";
+        gpSysLog->loginfo(ssMsg.c_str());
+        return;
+    }
+    server.run(iWorkers, eBackend);
+}
 
 /**
- * @brief Establishes a TCP client connection to a remote server and sends data
+ * Runs calls through a shared-memory ring: each request is copied into a
+ * slot of its own and up to CFG_VPARPC_PIPELINE_DEPTH are queued before
+ * the first reply is awaited, so the server can work on them together.
  *
- * Creates a TCP client socket, resolves the target hostname, connects to the
- * specified service port, sends a data packet, receives the response, and
- * displays all communication details in a visual window.
+ * A call the ring cannot take, because it has no free slot or its server
+ * reset it under the caller, is not queued, and neither are the calls
+ * after it.
+ *
+ * @param nAnswered Set to the number of calls answered, from the first.
+ * @return false if a call that was queued went unanswered; the calls
+ *         from nAnswered on may then have run. Otherwise the calls from
+ *         nAnswered on were never queued.
+ */
+static bool shm_calls(rpcShmRing* pRing, vparpc_call_t* pCalls,
+                      size_t nCalls, size_t& nAnswered)
+{
+    bool bOk = true;
+    bool bQueued = true;
+    nAnswered = 0;
+    for (size_t i = 0; i < nCalls && bOk && bQueued;)
+    {
+        char* buffers[CFG_VPARPC_PIPELINE_DEPTH];
+        size_t n = 0;
+        for (; n < CFG_VPARPC_PIPELINE_DEPTH && i + n < nCalls; n++)
+        {
+            const vparpc_call_t& call = pCalls[i + n];
+            ssize_t stLen = vparpc::frame_length(call.pPacket, call.stLen,
+                                                 sizeof(vparpc_request_t));
+            if (stLen <= 0)
+            {
+                bOk = false;
+                break;
+            }
+            buffers[n] = pRing->claim();
+            if (nullptr == buffers[n])
+            {
+                bQueued = false;
+                break;
+            }
+            memcpy(buffers[n], call.pPacket, stLen);
+            if (!pRing->submit(buffers[n], stLen))
+            {
+                bQueued = false;
+                break;
+            }
+        }
+        for (size_t j = 0; j < n; j++)
+        {
+            const vparpc_call_t& call = pCalls[i + j];
+            size_t stReply = pRing->wait(buffers[j]);
+            if (0 == stReply || stReply > call.stLen)
+            {
+                if (0 != stReply)
+                {
+                    pRing->release(buffers[j]);
+                }
+                bOk = false;
+                continue;
+            }
+            memcpy(call.pPacket, buffers[j], stReply);
+            pRing->release(buffers[j]);
+            ((vparpc_request_generic_t*)call.pPacket)->eVersion =
+                VPARPC_VERSION_1;
+            if (bOk)
+            {
+                nAnswered++;
+            }
+        }
+        i += n;
+    }
+    return bOk;
+}
+
+/**
+ * Checks that each packet is a valid frame and gives it the next request
+ * number.
+ */
+bool vparpc::number_calls(vparpc_call_t* pCalls, size_t nCalls, window& win)
+{
+    for (size_t i = 0; i < nCalls; i++)
+    {
+        if (frame_length(pCalls[i].pPacket, pCalls[i].stLen,
+                         pCalls[i].stLen) <= 0)
+        {
+            win.add_row(" Error: packet nSize is not a valid frame length");
+            return false;
+        }
+        auto* pReq = (vparpc_request_generic_t*)pCalls[i].pPacket;
+        if (0 == v_uNextId)
+        {
+            v_uNextId++;
+        }
+        pReq->uRequestId = v_uNextId++;
+        if (pReq->eFunc >= 0 && pReq->eFunc < VPARPC_FUNC_COUNT)
+        {
+            win.add_row(vparpc_func_names[pReq->eFunc]);
+        }
+    }
+    return true;
+}
+
+/**
+ * Appends a call's request to frames in the given encoding, and marks the
+ * packet's eVersion with the encoding used, so that its reply is read the
+ * same way. A request v2 cannot carry goes as v1.
+ */
+static void append_frame(std::vector<char>& frames, const vparpc_call_t& call,
+                         vparpc_version_t eWire)
+{
+    auto* pReq = (vparpc_request_generic_t*)call.pPacket;
+    size_t stAt = frames.size();
+    if (VPARPC_VERSION_2 <= eWire)
+    {
+        frames.resize(stAt + call.stLen);
+        size_t stLen = vparpcWire::encode(call.pPacket, false,
+                                          frames.data() + stAt, call.stLen);
+        frames.resize(stAt + stLen);
+        if (0 != stLen)
+        {
+            pReq->eVersion = VPARPC_VERSION_2;
+            return;
+        }
+    }
+    pReq->eVersion = VPARPC_VERSION_1;
+    const char* pFrame = (const char*)call.pPacket;
+    frames.insert(frames.end(), pFrame,
+                  pFrame + vparpc::frame_length(pFrame, call.stLen,
+                                                call.stLen));
+}
+
+/**
+ * Writes the frames of the calls with a single send. Unless fd already
+ * holds a connection, one is taken from gpRpcPool; a pooled connection
+ * the server has closed in the meantime is discarded and another tried,
+ * down to a new connection.
+ *
+ * @param fd The connection used; -1 if none could be had.
+ * @param bFresh Set to whether the calls went out on a new connection.
+ */
+bool vparpc::start_calls(const std::string& ssHostName,
+                         const std::string& ssServiceName,
+                         const vparpc_call_t* pCalls, size_t nCalls,
+                         window& win, int& fd, bool& bFresh)
+{
+    vparpc_version_t eWire = vparpcWire::peer_version(ssHostName,
+                                                      ssServiceName);
+    std::vector<char> frames;
+    for (size_t i = 0; i < nCalls; i++)
+    {
+        append_frame(frames, pCalls[i], eWire);
+    }
+
+    for (;;)
+    {
+        bFresh = false;
+        if (-1 == fd)
+        {
+            bool bReused;
+            fd = gpRpcPool->acquire(ssHostName, ssServiceName, bReused);
+            if (-1 == fd)
+            {
+                win.add_row(" Error: could not connect to " + ssHostName +
+                            ":" + ssServiceName + " (" + strerror(errno) +
+                            ")");
+                return false;
+            }
+            bFresh = !bReused;
+        }
+        win.add_row(bFresh ? "  Connected to server" : "  Reusing connection");
+
+        // Send data packets to server
+        if (send_frame(fd, frames.data(), frames.size()))
+        {
+            win.add_row("  Sent     " + std::to_string(frames.size()) +
+                        " bytes");
+            return true;
+        }
+        gpRpcPool->discard(fd);
+        fd = -1;
+        if (bFresh)
+        {
+            win.add_row(" Error: send failed");
+            return false;
+        }
+    }
+}
+
+/**
+ * Reads replies until every pending call has one, copying or decoding
+ * each into the packet whose uRequestId it carries and dropping that call
+ * from pending. The packet is left marked VPARPC_VERSION_1 either way.
+ *
+ * @param ePeer Set to the newest encoding the replies say the server
+ *        accepts; left alone if no reply arrives.
+ * @return 1 when all are answered, 0 if the connection failed first, or
+ *         -1 if a reply matches no pending call or cannot be decoded.
+ */
+int vparpc::receive_calls(int fd, std::vector<vparpc_call_t>& pending,
+                          vparpc_version_t& ePeer)
+{
+    vparpc_request_t reply;
+    while (!pending.empty())
+    {
+        ssize_t n = recv_frame(fd, &reply, sizeof(reply));
+        if (n <= 0)
+        {
+            return 0;
+        }
+        uint32_t uId = ((vparpc_request_generic_t*)&reply)->uRequestId;
+        auto it = std::find_if(pending.begin(), pending.end(),
+                               [uId](const vparpc_call_t& call) {
+                                   return uId == ((vparpc_request_generic_t*)
+                                       call.pPacket)->uRequestId;
+                               });
+        if (it == pending.end())
+        {
+            return -1;
+        }
+        auto* pPacket = (vparpc_request_generic_t*)it->pPacket;
+        if (VPARPC_VERSION_2 == pPacket->eVersion)
+        {
+            // A v1 server echoes a v2 request unanswered.
+            if (!vparpcWire::decode((const char*)&reply, n, it->pPacket,
+                                    it->stLen, true))
+            {
+                ePeer = VPARPC_VERSION_1;
+                return -1;
+            }
+            ePeer = VPARPC_VERSION_2;
+        }
+        else
+        {
+            if ((size_t)n > it->stLen)
+            {
+                return -1;
+            }
+            memcpy(it->pPacket, &reply, n);
+            ePeer = pPacket->eVersion;
+            pPacket->eVersion = VPARPC_VERSION_1;
+        }
+        pending.erase(it);
+    }
+    return 1;
+}
+
+/**
+ * Collects the replies to calls already sent on fd. If the connection
+ * drops first, the calls still unanswered are sent again on another;
+ * every VPA RPC is a lookup or an idempotent update, so repeating one is
+ * harmless. A new connection must answer at least one call each time,
+ * which bounds the retries. On success fd is still open and in step.
+ *
+ * @param bFresh Whether the calls went out on a new connection.
+ */
+bool vparpc::complete_calls(const std::string& ssHostName,
+                            const std::string& ssServiceName,
+                            std::vector<vparpc_call_t>& pending,
+                            window& win, int& fd, bool bFresh)
+{
+    while (!pending.empty())
+    {
+        size_t nBefore = pending.size();
+        vparpc_version_t ePeer = VPARPC_VERSION_NONE;
+        int iResult = receive_calls(fd, pending, ePeer);
+        if (VPARPC_VERSION_NONE != ePeer)
+        {
+            vparpcWire::set_peer_version(ssHostName, ssServiceName, ePeer);
+        }
+        if (1 == iResult)
+        {
+            break;
+        }
+        gpRpcPool->discard(fd);
+        fd = -1;
+        if (-1 == iResult)
+        {
+            win.add_row(" Error: reply matches no request or is malformed");
+            return false;
+        }
+        if (bFresh && pending.size() == nBefore)
+        {
+            win.add_row(" Error: no reply from server");
+            return false;
+        }
+        if (!start_calls(ssHostName, ssServiceName,
+                         pending.data(), pending.size(), win, fd, bFresh))
+        {
+            return false;
+        }
+    }
+    win.add_row("  Received all replies");
+    return true;
+}
+
+/**
+ * Waits for the outstanding pipelined replies and returns the pipeline's
+ * connection to the pool.
+ */
+bool vparpc::collect_pipeline(window& win)
+{
+    if (v_pipeline.empty())
+    {
+        return true;
+    }
+    bool bOk = complete_calls(v_ssPipeHost, v_ssPipeService,
+                              v_pipeline, win, v_nSendSocket, false);
+    if (bOk)
+    {
+        gpRpcPool->release(v_ssPipeHost, v_ssPipeService, v_nSendSocket);
+    }
+    else if (-1 != v_nSendSocket)
+    {
+        gpRpcPool->discard(v_nSendSocket);
+    }
+    v_nSendSocket = -1;
+    v_pipeline.clear();
+    return bOk;
+}
+
+/**
+ * @brief Sends a request packet to a VPA RPC server and receives the reply
+ *        in its place.
+ *
+ * The connection comes from gpRpcPool and goes back to it after the
+ * reply, so repeated calls to the same host and service skip name
+ * resolution and the TCP handshake. The packet's nSize is its frame
+ * length; exactly that many bytes are sent, and the reply is read frame
+ * by frame however the network splits it.
+ *
+ * If a pooled connection turns out to be dead (the server closed it
+ * after CFG_VPARPC_KEEPALIVE_MS, or was restarted) the call is repeated
+ * on a fresh connection.
  *
  * @param ssHostName The hostname or IP address of the target server
  * @param ssServiceName The service name to resolve to a port number
- * @param packet The data packet to send to the server
+ * @param packet The request packet; overwritten with the reply
+ * @param pktlen The size of the packet buffer
  *
- * @note Creates a visual window to display connection progress and data transfer
- * @note Uses gethostbyname() for hostname resolution (IPv4 only)
- * @note Synchronous operation - blocks until completion or error
- * @note Automatically closes connection after single request-response cycle
- *
- * @warning Uses deprecated gethostbyname() function (not thread-safe)
- * @warning No timeout mechanism implemented for network operations
- * @warning Response buffer limited to BUFSIZ (typically 8192 bytes)
+ * @note Names are resolved through rpcResolver's cache (IPv4 only)
+ * @note Synchronous operation - blocks until completion, error or
+ *       CFG_VPARPC_IO_TIMEOUT_MS
+ * @note Calls on one vparpc object are serialised, and wait for any
+ *       pipelined calls to be answered first
  */
 void vparpc::client(std::string ssHostName,
                     std::string ssServiceName,
                     void* packet, size_t pktlen)
 {
+    // A ring answers in microseconds, so it is not logged per call.
+    vparpc_call_t call = {packet, pktlen};
+    std::string ssRing;
+    if (rpcShmRing::ring_name(ssServiceName, ssRing))
+    {
+        client_batch(ssHostName, ssServiceName, &call, 1);
+        return;
+    }
+
     CLog log(__FILE__, __FUNCTION__);
     log.write(__PRETTY_FUNCTION__);
 
     gpSysLog->loginfo(__PRETTY_FUNCTION__);
 
+    client_batch(ssHostName, ssServiceName, &call, 1);
+}
+
+bool vparpc::client_batch(std::string ssHostName,
+                          std::string ssServiceName,
+                          vparpc_call_t* pCalls, size_t nCalls)
+{
+    // A ring is shared by every thread and needs neither the lock nor a
+    // connection; the host is ignored.
+    std::string ssRing;
+    if (rpcShmRing::ring_name(ssServiceName, ssRing))
+    {
+        rpcShmRing* pRing = rpcShmRing::attach(ssRing);
+        size_t nAnswered = 0;
+        if (nullptr != pRing &&
+            !shm_calls(pRing, pCalls, nCalls, nAnswered))
+        {
+            return false;
+        }
+        if (nAnswered == nCalls)
+        {
+            return true;
+        }
+
+        // The calls the ring never queued go to the local socket of the
+        // same name, which is as trusted as the ring, so they keep their
+        // empty tokens. A call the ring lost is not repeated: it may
+        // have run.
+        ssServiceName = CFG_VPARPC_UNIX_PREFIX + ssRing;
+        pCalls += nAnswered;
+        nCalls -= nAnswered;
+    }
+
+    std::lock_guard<std::mutex> lock(v_sendLock);
+
     // Create visual window for client status display
-    auto* pWin = new window();
+    window win;
     gpSemiGr->cosmetics(SRUL, SRUR, SRLL,
                         SRLR,SVSR,SVSL,
                         SH, SV);
 
-    // Build copyright string
-    std::string ssCopr = "Copyright ";
-    ssCopr.append("(c)");
-    ssCopr.append(" 2025 Douglas Wade Goodall. All Rights Reserved.");
-
     // Set window title with connection parameters
-    pWin->set_title("vparpc::client(" + ssHostName + "," + ssServiceName + ")");
-
-    int client_fd;
-    struct sockaddr_in server_addr;
-    struct hostent* host_entry;
-    char response_buffer[BUFSIZ]; // Response buffer (BUFSIZ = 8192)
+    win.set_title("vparpc::client(" + ssHostName + "," + ssServiceName + ")");
 
-    // Resolve hostname to IP address using system DNS lookup
-    host_entry = gethostbyname(ssHostName.c_str());
-    if (host_entry == nullptr)
+    if (!collect_pipeline(win))
     {
-        pWin->add_row(" Error: Could not resolve hostname " + ssHostName);
-        pWin->render();
-        return;
+        v_bPipelineOk = false;
     }
 
-    vparpc_request_generic_t* pReq = (vparpc_request_generic_t*)packet;
-    pWin->add_row(vparpc_func_names[pReq->eFunc]);
-
-    pWin->add_row("  Host resolved: " + ssHostName);
+    int fd = -1;
+    bool bFresh = true;
+    std::vector<vparpc_call_t> pending(pCalls, pCalls + nCalls);
+    if (!number_calls(pCalls, nCalls, win) ||
+        !start_calls(ssHostName, ssServiceName, pCalls, nCalls,
+                     win, fd, bFresh) ||
+        !complete_calls(ssHostName, ssServiceName, pending, win, fd, bFresh))
+    {
+        if (-1 != fd)
+        {
+            gpRpcPool->discard(fd);
+        }
+        win.render();
+        return false;
+    }
+    gpRpcPool->release(ssHostName, ssServiceName, fd);
+    return true;
+}
 
-    // Create TCP client socket
-    if ((client_fd = socket(AF_INET, SOCK_STREAM, 0)) < 0)
+bool vparpc::pipeline_send(std::string ssHostName,
+                           std::string ssServiceName,
+                           void* packet, size_t pktlen)
+{
+    // A ring call is answered before this returns, which is as good as
+    // pipelined; only a failure is left for pipeline_collect() to report.
+    std::string ssRing;
+    if (rpcShmRing::ring_name(ssServiceName, ssRing))
     {
-        pWin->add_row(" Error: socket creation failed");
-        pWin->render();
-        return;
+        vparpc_call_t call = {packet, pktlen};
+        if (client_batch(ssHostName, ssServiceName, &call, 1))
+        {
+            return true;
+        }
+        std::lock_guard<std::mutex> lock(v_sendLock);
+        v_bPipelineOk = false;
+        return false;
     }
-    pWin->add_row("  Client socket created");
 
-    // Configure server address structure
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_port = htons(svc2port(ssServiceName));
-    server_addr.sin_addr.s_addr = *((unsigned long*)host_entry->h_addr);
+    std::lock_guard<std::mutex> lock(v_sendLock);
 
-    pWin->add_row("  Connecting to port "
-        + std::to_string(svc2port(ssServiceName)));
+    window win;
+    gpSemiGr->cosmetics(SRUL, SRUR, SRLL,
+                        SRLR,SVSR,SVSL,
+                        SH, SV);
+    win.set_title("vparpc::pipeline_send(" + ssHostName + "," +
+                  ssServiceName + ")");
 
-    // Establish connection to server
-    if (connect(client_fd,
-                (struct sockaddr*)&server_addr,
-                sizeof(server_addr)) < 0)
+    if (!v_pipeline.empty() &&
+        (v_ssPipeHost != ssHostName || v_ssPipeService != ssServiceName ||
+         v_pipeline.size() >= CFG_VPARPC_PIPELINE_DEPTH))
     {
-        pWin->add_row(" Error: connection failed");
-        close(client_fd);
-        return;
+        if (!collect_pipeline(win))
+        {
+            v_bPipelineOk = false;
+        }
     }
-    pWin->add_row("  Connected to server");
 
-    // Send data packet to server
-    ssize_t bytes_sent = send(client_fd, packet, pktlen, 0);
-    if (bytes_sent < 0)
+    vparpc_call_t call = {packet, pktlen};
+    if (!number_calls(&call, 1, win))
     {
-        pWin->add_row(" Error: send failed");
-        close(client_fd);
-        pWin->render();
-        return;
+        win.render();
+        v_bPipelineOk = false;
+        return false;
     }
-    pWin->add_row("  Sent     " + std::to_string(bytes_sent) + " bytes");
-
 
-    // Receive response from server
-    ssize_t bytes_received = recv(client_fd, packet, pktlen, 0);
-    if (bytes_received < 0)
+    bool bFresh;
+    if (!v_pipeline.empty())
     {
-        perror("recv failed");
-    }
-    else if (bytes_received == 0)
-    {
-        std::cout << "  Server closed connection" << std::endl;
+        v_pipeline.push_back(call);
+        std::vector<char> frame;
+        append_frame(frame, call,
+                     vparpcWire::peer_version(ssHostName, ssServiceName));
+        if (send_frame(v_nSendSocket, frame.data(), frame.size()))
+        {
+            return true;
+        }
+
+        // The connection dropped under the pipeline; send everything
+        // still unanswered again on another.
+        gpRpcPool->discard(v_nSendSocket);
+        v_nSendSocket = -1;
+        if (start_calls(ssHostName, ssServiceName, v_pipeline.data(),
+                        v_pipeline.size(), win, v_nSendSocket, bFresh))
+        {
+            return true;
+        }
+        v_pipeline.clear();
     }
-    else
+    else if (start_calls(ssHostName, ssServiceName, &call, 1, win,
+                         v_nSendSocket, bFresh))
     {
-        response_buffer[bytes_received] = '\0'; // Null-terminate response
-        pWin->add_row("  Received " + std::to_string(bytes_received));
+        v_ssPipeHost = ssHostName;
+        v_ssPipeService = ssServiceName;
+        v_pipeline.push_back(call);
+        return true;
     }
+    win.render();
+    v_bPipelineOk = false;
+    return false;
+}
 
-    //cipher.decryptData((uint8_t *)ciphertext,pktlen,(uint8_t *)packet);
+bool vparpc::pipeline_collect()
+{
+    std::lock_guard<std::mutex> lock(v_sendLock);
 
-    // Close client connection
-    close(client_fd);
-    pWin->add_row("  Client connection closed");
-    //pWin->render();
-}
+    window win;
+    gpSemiGr->cosmetics(SRUL, SRUR, SRLL,
+                        SRLR,SVSR,SVSL,
+                        SH, SV);
+    win.set_title("vparpc::pipeline_collect(" + v_ssPipeHost + "," +
+                  v_ssPipeService + ")");
 
+    bool bOk = collect_pipeline(win) && v_bPipelineOk;
+    v_bPipelineOk = true;
+    if (!bOk)
+    {
+        win.render();
+    }
+    return bOk;
+}
 
 /**
  * @brief Resolves a service name to its corresponding port number
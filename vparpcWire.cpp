@@ -0,0 +1,297 @@
+////////////////////////////////////////////////////////////////////
+// ~/public_html/fw/vparpcWire.cpp 2026-10-17 19:50 dwg -         //
+// This file is part of MultiWare Engineering's VPA and FrameWork //
+////////////////////////////////////////////////////////////////////
+// This file is made available under the                          //
+// Creative Commons CC0 1.0 Universal Public Domain Dedication.   //
+////////////////////////////////////////////////////////////////////
+
+#include "mwfw2.h"
+
+/**
+ * @return The generated codec of a function, or nullptr if it has none.
+ */
+static const vparpc_idl_codec_t* codec_of(uint32_t uFunc)
+{
+    if (uFunc >= VPARPC_FUNC_COUNT ||
+        nullptr == vparpc_idl_codecs[uFunc].pfnEncode)
+    {
+        return nullptr;
+    }
+    return &vparpc_idl_codecs[uFunc];
+}
+
+static std::mutex gPeerLock;
+static std::unordered_map<std::string, vparpc_version_t> gPeerVersions;
+
+/**
+ * Appends an unsigned LEB128 varint.
+ *
+ * @return false if it would not fit.
+ */
+static bool put_varint(char* pFrame, size_t stMax, size_t& stAt, uint64_t u)
+{
+    do
+    {
+        if (stAt >= stMax)
+        {
+            return false;
+        }
+        uint8_t uByte = u & 0x7f;
+        u >>= 7;
+        pFrame[stAt++] = (char)(uByte | (u ? 0x80 : 0));
+    }
+    while (u);
+    return true;
+}
+
+static bool get_varint(const char* pFrame, size_t stLen, size_t& stAt,
+                       uint64_t& u)
+{
+    u = 0;
+    for (int iShift = 0; iShift < 64; iShift += 7)
+    {
+        if (stAt >= stLen)
+        {
+            return false;
+        }
+        uint8_t uByte = pFrame[stAt++];
+        u |= (uint64_t)(uByte & 0x7f) << iShift;
+        if (0 == (uByte & 0x80))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint64_t zigzag(int64_t i)
+{
+    return ((uint64_t)i << 1) ^ (uint64_t)(i >> 63);
+}
+
+static int64_t unzigzag(uint64_t u)
+{
+    return (int64_t)(u >> 1) ^ -(int64_t)(u & 1);
+}
+
+vparpcWire::reader::reader(const char* pFrame, size_t stLen)
+    : m_pFrame(pFrame), m_stLen(stLen), m_stAt(VPARPC_WIRE_HEADER_SIZE),
+      m_bValid(stLen >= VPARPC_WIRE_HEADER_SIZE &&
+               VPARPC_VERSION_2 ==
+               ((const vparpc_request_generic_t*)pFrame)->eVersion)
+{
+}
+
+uint8_t vparpcWire::reader::func() const
+{
+    return m_pFrame[VPARPC_WIRE_FUNC_OFFSET];
+}
+
+uint8_t vparpcWire::reader::status() const
+{
+    return m_pFrame[VPARPC_WIRE_STATUS_OFFSET];
+}
+
+bool vparpcWire::reader::reply() const
+{
+    return 0 != (m_pFrame[VPARPC_WIRE_FLAGS_OFFSET] & VPARPC_WIRE_FLAG_REPLY);
+}
+
+bool vparpcWire::reader::next(uint32_t& uTag, std::string_view& value)
+{
+    if (!m_bValid || m_stAt == m_stLen)
+    {
+        return false;
+    }
+    uint64_t u64Tag;
+    uint64_t u64Len;
+    if (!get_varint(m_pFrame, m_stLen, m_stAt, u64Tag) ||
+        !get_varint(m_pFrame, m_stLen, m_stAt, u64Len) ||
+        u64Tag > UINT32_MAX || u64Len > m_stLen - m_stAt)
+    {
+        m_bValid = false;
+        return false;
+    }
+    uTag = (uint32_t)u64Tag;
+    value = std::string_view(m_pFrame + m_stAt, u64Len);
+    m_stAt += u64Len;
+    return true;
+}
+
+vparpcWire::writer::writer(char* pFrame, size_t stMax)
+    : m_pFrame(pFrame), m_stMax(stMax), m_stAt(VPARPC_WIRE_HEADER_SIZE),
+      m_bOk(stMax >= VPARPC_WIRE_HEADER_SIZE)
+{
+}
+
+void vparpcWire::writer::put_bytes(uint32_t uTag, const char* pValue,
+                                   size_t stLen)
+{
+    if (0 == stLen || !m_bOk)
+    {
+        return;
+    }
+    m_bOk = put_varint(m_pFrame, m_stMax, m_stAt, uTag) &&
+        put_varint(m_pFrame, m_stMax, m_stAt, stLen) &&
+        stLen <= m_stMax - m_stAt;
+    if (m_bOk)
+    {
+        memcpy(m_pFrame + m_stAt, pValue, stLen);
+        m_stAt += stLen;
+    }
+}
+
+void vparpcWire::writer::put(uint32_t uTag, int iValue)
+{
+    char szValue[10];
+    size_t stLen = 0;
+    put_varint(szValue, sizeof(szValue), stLen, zigzag(iValue));
+    put_bytes(uTag, szValue, stLen);
+}
+
+void vparpcWire::writer::status(vparpc_status_t eStatus)
+{
+    if (m_bOk)
+    {
+        m_pFrame[VPARPC_WIRE_STATUS_OFFSET] = (char)eStatus;
+    }
+}
+
+bool vparpcWire::get(int& iValue, std::string_view value)
+{
+    size_t stAt = 0;
+    uint64_t u;
+    if (!get_varint(value.data(), value.size(), stAt, u))
+    {
+        return false;
+    }
+    iValue = (int)unzigzag(u);
+    return true;
+}
+
+size_t vparpcWire::encode(const void* pPacket, bool bReply, char* pFrame,
+                          size_t stMax)
+{
+    const auto* pReq = (const vparpc_request_generic_t*)pPacket;
+    const vparpc_idl_codec_t* pCodec = codec_of(pReq->eFunc);
+    if (nullptr == pCodec || stMax < VPARPC_WIRE_HEADER_SIZE)
+    {
+        return 0;
+    }
+
+    vparpc_request_generic_t header;
+    header.eVersion = VPARPC_VERSION_2;
+    header.uRequestId = pReq->uRequestId;
+    memcpy(pFrame, &header, VPARPC_FRAME_HEADER_SIZE);
+    pFrame[VPARPC_WIRE_FUNC_OFFSET] = (char)pReq->eFunc;
+    pFrame[VPARPC_WIRE_STATUS_OFFSET] = 0;
+    pFrame[VPARPC_WIRE_FLAGS_OFFSET] = bReply ? VPARPC_WIRE_FLAG_REPLY : 0;
+
+    writer out(pFrame, stMax);
+    pCodec->pfnEncode(pPacket, bReply, out);
+    if (!out.ok())
+    {
+        return 0;
+    }
+    size_t nSize = out.length();
+    memcpy(pFrame + offsetof(vparpc_request_generic_t, nSize), &nSize,
+           sizeof(nSize));
+    return nSize;
+}
+
+bool vparpcWire::decode(const char* pFrame, size_t stLen, void* pPacket,
+                        size_t stMax, bool bReply)
+{
+    reader fields(pFrame, stLen);
+    if (!fields.valid() || fields.reply() != bReply)
+    {
+        return false;
+    }
+    const vparpc_idl_codec_t* pCodec = codec_of(fields.func());
+    if (nullptr == pCodec || pCodec->stSize > stMax)
+    {
+        return false;
+    }
+    if (!bReply)
+    {
+        memset(pPacket, 0, pCodec->stSize);
+    }
+    if (!pCodec->pfnDecode(pPacket, bReply, fields))
+    {
+        return false;
+    }
+
+    auto* pReq = (vparpc_request_generic_t*)pPacket;
+    memcpy(pReq, pFrame, VPARPC_FRAME_HEADER_SIZE);
+    pReq->eVersion = VPARPC_VERSION_1;
+    pReq->nSize = pCodec->stSize;
+    pReq->eFunc = (vparpc_func_t)fields.func();
+    return true;
+}
+
+/**
+ * The decoded request is processed in a struct of its own, so the reply
+ * can be encoded straight over the request frame in pBuffer.
+ */
+size_t vparpcWire::respond(char* pBuffer, size_t stLen, size_t stMax,
+                           const std::function<void(char*)>& process)
+{
+    static shm_counter v2requests("vparpc.v2.requests");
+
+    auto* pGeneric = (vparpc_request_generic_t*)pBuffer;
+    if (VPARPC_VERSION_2 != pGeneric->eVersion)
+    {
+        process(pBuffer);
+        pGeneric->eVersion = VPARPC_VERSION_LATEST;
+        return stLen;
+    }
+    v2requests.add();
+
+    vparpc_request_t req;
+    size_t stReply = 0;
+    if (decode(pBuffer, stLen, &req, sizeof(req), false))
+    {
+        process((char*)&req);
+        stReply = encode(&req, true, pBuffer, stMax);
+    }
+    if (0 == stReply)
+    {
+        // Undecodable, or an answer too long to encode: a bare error.
+        stReply = VPARPC_WIRE_HEADER_SIZE;
+        memcpy(pBuffer + offsetof(vparpc_request_generic_t, nSize),
+               &stReply, sizeof(stReply));
+        pBuffer[VPARPC_WIRE_STATUS_OFFSET] = VPARPC_STATUS_ERROR;
+        pBuffer[VPARPC_WIRE_FLAGS_OFFSET] = VPARPC_WIRE_FLAG_REPLY;
+    }
+    return stReply;
+}
+
+vparpc_version_t vparpcWire::peer_version(const std::string& ssHost,
+                                          const std::string& ssService)
+{
+    std::lock_guard<std::mutex> lock(gPeerLock);
+    auto it = gPeerVersions.find(ssHost + ":" + ssService);
+    return it == gPeerVersions.end() ? VPARPC_VERSION_1 : it->second;
+}
+
+/**
+ * A server may be replaced by an older one at any time, so a lower
+ * version replaces a higher one as readily as the other way round.
+ */
+void vparpcWire::set_peer_version(const std::string& ssHost,
+                                  const std::string& ssService,
+                                  vparpc_version_t eVersion)
+{
+    if (eVersion < VPARPC_VERSION_1 || eVersion > VPARPC_VERSION_LATEST)
+    {
+        eVersion = eVersion < VPARPC_VERSION_1 ?
+            VPARPC_VERSION_1 : VPARPC_VERSION_LATEST;
+    }
+    std::lock_guard<std::mutex> lock(gPeerLock);
+    gPeerVersions[ssHost + ":" + ssService] = eVersion;
+}
+
+//////////////////////////
+// eof - vparpcWire.cpp //
+//////////////////////////
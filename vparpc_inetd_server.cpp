@@ -16,7 +16,9 @@
  * 
  * ## Key Differences from Standalone Server:
  * - **Connection Management**: Uses inetd for socket handling (STDIN/STDOUT)
- * - **Process Model**: One process per client connection
+ * - **Process Model**: One process per client connection, or, as an
+ *   xinetd "wait = yes" service or with --daemon, a pre-forked pool of
+ *   workers that each serve many (see rpcPrefork)
  * - **UI Display**: No visual interface (daemon mode)
  * - **Service Registration**: Configured through inetd.conf or xinetd.d
  * 
@@ -33,6 +35,14 @@
 
 #include "mwfw2.h"
 
+/**
+ * Set when process() and the handlers keep a diagnostics window; the
+ * per-request CLog and syslog traces come and go with it.
+ */
+#if defined(DISPLAY_PROCESS_INFO) || defined(DISPLAY_PROCESS_DETAILS)
+#define DISPLAY_PROCESS
+#endif
+
 /**
  * @brief Specifies the size of the buffer for reading or writing operations.
  *
@@ -61,11 +71,13 @@ const int BUFFER_SIZE = BUFSIZ;
  */
 void handle_auth_request(char* buffer, window* pWin)
 {
+#ifdef DISPLAY_PROCESS
     CLog log(__FILE__, __FUNCTION__);
     log.write(__PRETTY_FUNCTION__);
 
     here;
     gpSysLog->loginfo(__PRETTY_FUNCTION__);
+#endif // DISPLAY_PROCESS
 
 #ifdef DISPLAY_PROCESS_DETAILS
     pWin->add_row("  Processing AUTH request");
@@ -73,7 +85,7 @@ void handle_auth_request(char* buffer, window* pWin)
     vparpc_request_auth_t* pReq = (vparpc_request_auth_t*)buffer;
     if (0 == strcmp((char*)CFG_VPA_RPC_PSK, (const char*)pReq->szPSK))
     {
-        strcpy(pReq->szAuth, gpSh->m_pShMemng->szRpcUuid);
+        strcpy(pReq->szAuth, gpShMemCfg->get(SHM_STR_RPC_UUID).c_str());
 #ifdef DISPLAY_PROCESS_DETAILS
         std::string ssPSKmsg = "  Current Auth is: ";
         ssPSKmsg += pReq->szAuth;
@@ -116,9 +128,11 @@ void handle_auth_request(char* buffer, window* pWin)
  */
 void handle_version_request(char* buffer, window* pWin)
 {
+#ifdef DISPLAY_PROCESS
     CLog log(__FILE__, __FUNCTION__);
     log.write(__PRETTY_FUNCTION__);
     gpSysLog->loginfo(__PRETTY_FUNCTION__);
+#endif // DISPLAY_PROCESS
 
 #ifdef DISPLAY_PROCESS_DETAILS
     pWin->add_row("  Processing VERSION request");
@@ -126,7 +140,7 @@ void handle_version_request(char* buffer, window* pWin)
 
     vparpc_request_version_t* pReq = (vparpc_request_version_t*)buffer;
 
-    if (0 == strcmp(gpSh->m_pShMemng->szRpcUuid, (const char*)pReq->szAuth))
+    if (0 == strcmp(gpShMemCfg->get(SHM_STR_RPC_UUID).c_str(), (const char*)pReq->szAuth))
     {
         strcpy(pReq->szVersion,RSTRING);
         pReq->eStatus = VPARPC_STATUS_OK;
@@ -169,7 +183,7 @@ void handle_lookup_request(char* buffer, window* pWin)
     // Initialize iHandle to a default value
     pReq->iHandle = -1;
 
-    if (0 == strcmp(gpSh->m_pShMemng->szRpcUuid, (const char*)pReq->szAuth))
+    if (0 == strcmp(gpShMemCfg->get(SHM_STR_RPC_UUID).c_str(), (const char*)pReq->szAuth))
     {
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  Auth match, authentication successful");
@@ -277,73 +291,79 @@ void handle_lookup_request(char* buffer, window* pWin)
  */
 void handle_creds_request(char* buffer, window* pWin)
 {
+#ifdef DISPLAY_PROCESS
     CLog log(__FILE__, __FUNCTION__);
     log.write(__PRETTY_FUNCTION__);
 
     gpSysLog->loginfo(__PRETTY_FUNCTION__);
+#endif // DISPLAY_PROCESS
 
 #ifdef DISPLAY_PROCESS_DETAILS
     pWin->add_row("  Processing CREDS request");
 #endif // DISPLAY_PROCESS_DETAILS
 
     vparpc_request_creds_t* pReq = (vparpc_request_creds_t*)buffer;
-    if (0 == strcmp(gpSh->m_pShMemng->szRpcUuid, (const char*)pReq->szAuth))
+    if (0 == strcmp(gpShMemCfg->get(SHM_STR_RPC_UUID).c_str(), (const char*)pReq->szAuth))
     {
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  Auth match, authentication successful");
 #endif // DISPLAY_PROCESS_DETAILS
 
-        strcpy(pReq->szAuthUserName,
-               gpSh->m_pShMemng->creds[pReq->iHandle].szAuthUserName);
+        // Resolve by session UUID when the caller supplied one, falling
+        // back to the passwd.csv row for older clients.
+        MFW_SESSION_T sess;
+        if (!gpShMemSess->resolve(pReq->szAuthUUID, pReq->iHandle, sess))
+        {
+#ifdef DISPLAY_PROCESS_DETAILS
+            pWin->add_row("  No session for UUID or handle");
+#endif // DISPLAY_PROCESS_DETAILS
+            pReq->eStatus = VPARPC_STATUS_ERROR;
+            return;
+        }
+
+        strcpy(pReq->szAuthUserName, sess.szAuthUserName);
 
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  AuthUserName: " + std::string(pReq->szAuthUserName));
 #endif // DISPLAY_PROCESS_DETAILS
 
-        strcpy(pReq->szAuthFirstName,
-               gpSh->m_pShMemng->creds[pReq->iHandle].szAuthFirstName);
+        strcpy(pReq->szAuthFirstName, sess.szAuthFirstName);
 
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  AuthFirstName: " + std::string(pReq->szAuthFirstName));
 #endif // DISPLAY_PROCESS_DETAILS
 
-        strcpy(pReq->szAuthLastName,
-               gpSh->m_pShMemng->creds[pReq->iHandle].szAuthLastName);
+        strcpy(pReq->szAuthLastName, sess.szAuthLastName);
 
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  AuthLastName: " + std::string(pReq->szAuthLastName));
 #endif // DISPLAY_PROCESS_DETAILS
 
-        strcpy(pReq->szAuthUUID,
-               gpSh->m_pShMemng->creds[pReq->iHandle].szAuthUUID);
+        strcpy(pReq->szAuthUUID, sess.szAuthUUID);
 
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  Auth UUID: " + std::string(pReq->szAuthUUID));
 #endif // DISPLAY_PROCESS_DETAILS
 
-        strcpy(pReq->szAuthLevel,
-               gpSh->m_pShMemng->creds[pReq->iHandle].szAuthLevel);
+        strcpy(pReq->szAuthLevel, sess.szAuthLevel);
 
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  AuthLevel: " + std::string(pReq->szAuthLevel));
 #endif // DISPLAY_PROCESS_DETAILS
 
-        strcpy(pReq->szRemoteHost,
-               gpSh->m_pShMemng->creds[pReq->iHandle].szRemoteHost);
+        strcpy(pReq->szRemoteHost, sess.szRemoteHost);
 
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  RemoteHost: " + std::string(pReq->szRemoteHost));
 #endif // DISPLAY_PROCESS_DETAILS
 
-        strcpy(pReq->szRemoteAddr,
-               gpSh->m_pShMemng->creds[pReq->iHandle].szRemoteAddr);
+        strcpy(pReq->szRemoteAddr, sess.szRemoteAddr);
 
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  RemoteAddr: " + std::string(pReq->szRemoteAddr));
 #endif // DISPLAY_PROCESS_DETAILS
 
-        strcpy(pReq->szHttpUserAgent,
-               gpSh->m_pShMemng->creds[pReq->iHandle].szHttpUserAgent);
+        strcpy(pReq->szHttpUserAgent, sess.szHttpUserAgent);
 
 #ifdef DISPLAY_PROCESS_DETAILS
         pWin->add_row("  HttpUserAgent: " + std::string(pReq->szHttpUserAgent));
@@ -361,8 +381,20 @@ void handle_creds_request(char* buffer, window* pWin)
     }
 }
 
+typedef void (*handler_t)(char*, window*);
 
-
+/**
+ * The handlers the IDL lists, indexed by vparpc_func_t; the other entries
+ * are null.
+ */
+static constexpr std::array<handler_t, VPARPC_FUNC_COUNT> gHandlers = [] {
+    std::array<handler_t, VPARPC_FUNC_COUNT> handlers = {};
+#define VPARPC_HANDLER(func, member) \
+    handlers[VPARPC_FUNC_##func] = &handle_##member##_request;
+    VPARPC_IDL_HANDLERS(VPARPC_HANDLER)
+#undef VPARPC_HANDLER
+    return handlers;
+}();
 
 /**
  * @brief Processes the given input data based on the implemented logic.
@@ -371,72 +403,262 @@ void handle_creds_request(char* buffer, window* pWin)
  */
 void process(char* pszBuffer)
 {
+#ifdef DISPLAY_PROCESS
     CLog log(__FILE__, __FUNCTION__);
     log.write(__PRETTY_FUNCTION__);
 
     gpSysLog->loginfo(__PRETTY_FUNCTION__);
+#endif // DISPLAY_PROCESS
 
     // std::cout << "vparpc::process()" << std::endl;
     // std::cout << "vparpc::process() at line # " << __LINE__ << std::endl;
 
-    // Create window for debugging/monitoring
-    auto* pWin = new window();
+    // Create window for debugging/monitoring; a daemon worker answers
+    // many requests and must not pay for one on each of them otherwise
+    window* pWin = nullptr;
+#ifdef DISPLAY_PROCESS
+    pWin = new window();
     pWin->set_title("vparpc::process()");
     gpSemiGr->cosmetics(
         SRUL, SRUR,
         SRLL, SRLR,
         SVSR, SVSL,
         SH, SV);
+#endif // DISPLAY_PROCESS
 
     // We don't know what type of request it is yet, we we cast it
     // generic long enough to decode the eFunc
     const auto* request = (const vparpc_request_generic_t*)pszBuffer;
 
-    size_t response;
+    // Request accounting: one relaxed atomic add on this CPU's shard.
+    static shm_counter requests("vparpc.requests");
+    requests.add();
+    gpShMemSess->sweep();
 
-    switch (request->eFunc)
+    uint32_t uFunc = request->eFunc;
+    if (uFunc < VPARPC_FUNC_COUNT && nullptr != gHandlers[uFunc])
     {
-    case VPARPC_FUNC_GET_AUTH:
-        gpSysLog->loginfo("VPA RPC: GET_AUTH");
-        handle_auth_request(pszBuffer, pWin);
-        break;
+#ifdef DISPLAY_PROCESS
+        gpSysLog->loginfo(vparpc_func_names[uFunc]);
+#endif // DISPLAY_PROCESS
+        gHandlers[uFunc](pszBuffer, pWin);
+    }
 
-    case VPARPC_FUNC_VERSION:
-        gpSysLog->loginfo("VPA RPC: VERSION");
-        handle_version_request(pszBuffer, pWin);
-        break;
+#ifdef DISPLAY_PROCESS_INFO
+        pWin->render();
+#endif // DISPLAY_PROCESS_INFO
 
-    case VPARPC_FUNC_LOOKUP:
+#ifdef DISPLAY_PROCESS
+    delete pWin;
+#endif // DISPLAY_PROCESS
+}
 
-        handle_lookup_request(pszBuffer, pWin);
-        break;
+/**
+ * Answers the requests on one connection until the client closes it or
+ * stays idle past the keep-alive interval, or until a daemon worker is
+ * told to go.
+ *
+ * @return The number of requests answered.
+ */
+static size_t serve(int fdIn, int fdOut)
+{
+    char buffer[BUFFER_SIZE];
+    ssize_t bytesRead;
+    size_t stServed = 0;
 
-    case VPARPC_FUNC_CREDS:
-        gpSysLog->loginfo("VPA RPC: CREDS");
-        handle_creds_request(pszBuffer, pWin);
-        break;
+    // Bound each transfer; failure to set the timeout only means a
+    // stalled client is waited on longer.
+    vparpc::set_io_timeout(fdIn);
 
+    // Read each RPC request from client (via inetd), one exact frame at a time
+    for (;;)
+    {
+        // The client may send several requests on the connection. The
+        // wait for the next one is a poll(), which a signal interrupts,
+        // so that a retiring worker need not sit out the keep-alive.
+        struct pollfd pfd = {fdIn, POLLIN, 0};
+        int iReady;
+        do
+        {
+            iReady = poll(&pfd, 1, CFG_VPARPC_KEEPALIVE_MS);
+        }
+        while (-1 == iReady && EINTR == errno && !rpcPrefork::retiring());
+        if (iReady <= 0)
+        {
+            break;
+        }
+
+        memset(buffer, 0, sizeof(buffer));
+        bytesRead = vparpc::recv_frame(fdIn, buffer,
+                                       sizeof(vparpc_request_t));
+        if (bytesRead <= 0)
+        {
+            if (bytesRead < 0)
+            {
+                gpSysLog->loginfo("Failed to read request from client");
+            }
+            break;
+        }
+#ifdef DISPLAY_PROCESS
+        gpSysLog->loginfo("Received bytes from client");
+#endif // DISPLAY_PROCESS
+
+        // Process the RPC request (this modifies the buffer in-place);
+        // a v2 request's reply may be shorter or longer than the request
+        size_t stReply = vparpcWire::respond(buffer, bytesRead,
+                                             sizeof(buffer), process);
 
-    default:
-        break;
+        // Write the processed buffer back to client (via inetd)
+        if (!vparpc::send_frame(fdOut, buffer, stReply))
+        {
+            gpSysLog->loginfo("Failed to send response");
+            break;
+        }
+#ifdef DISPLAY_PROCESS
+        gpSysLog->loginfo("Response sent: bytes");
+#endif // DISPLAY_PROCESS
+        stServed++;
+        if (rpcPrefork::retiring())
+        {
+            break;
+        }
     }
+    return stServed;
+}
 
-#ifdef DISPLAY_PROCESS_INFO
-        pWin->render();
-#endif // DISPLAY_PROCESS_INFO
+/**
+ * Opens the listening socket of a daemon started by hand on standard
+ * input, where xinetd would have put it and where a reload expects it.
+ *
+ * @param pszService A service name or port number.
+ */
+static bool listen_stdin(const char* pszService)
+{
+    int iPort = isdigit((unsigned char)pszService[0])
+                    ? atoi(pszService)
+                    : gpVpaRpc->svc2port(pszService);
+    if (iPort <= 0 || iPort > 65535)
+    {
+        return false;
+    }
 
-    delete pWin;
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (-1 == fd)
+    {
+        return false;
+    }
+    int opt = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_port = htons(iPort);
+    if (-1 == bind(fd, (struct sockaddr*)&addr, sizeof(addr)) ||
+        -1 == listen(fd, CFG_VPARPC_BACKLOG) ||
+        -1 == dup2(fd, STDIN_FILENO))
+    {
+        close(fd);
+        return false;
+    }
+    close(fd);
+    return true;
+}
+
+/**
+ * Serves as a pre-forked daemon (see rpcPrefork) on the listening socket
+ * on standard input: xinetd's, for a "wait = yes" service, or one opened
+ * for the service or port named after --daemon, "vpa" by default.
+ *
+ * @return The exit status.
+ */
+static int run_daemon(int argc, char* argv[])
+{
+    if (!rpcPrefork::is_listener(STDIN_FILENO) &&
+        !listen_stdin(argc > 2 ? argv[2] : "vpa"))
+    {
+        gpSysLog->loginfo("VPA RPC daemon: cannot open its listening socket");
+        return 1;
+    }
+
+    // Under xinetd standard output and error are the listening socket
+    // too; nothing is written to them, but nothing should try.
+    int fdNull = open("/dev/null", O_RDWR);
+    if (-1 != fdNull)
+    {
+        for (int fd : {STDOUT_FILENO, STDERR_FILENO})
+        {
+            if (rpcPrefork::is_listener(fd))
+            {
+                dup2(fdNull, fd);
+            }
+        }
+        close(fdNull);
+    }
+
+    try
+    {
+        rpcPrefork pool("vparpc", STDIN_FILENO);
+        gpSysLog->loginfo("*** VPA RPC daemon started");
+        return pool.run([](int fd) { return serve(fd, fd); }, argv);
+    }
+    catch (const std::system_error& e)
+    {
+        gpSysLog->loginfo(e.what());
+        return 1;
+    }
+}
+
+/**
+ * Prints the scoreboard of the running daemon.
+ *
+ * @return The exit status: 1 if no daemon is running.
+ */
+static int status()
+{
+    static const char* pszStates[] = {
+        "empty", "starting", "idle", "busy", "exiting"
+    };
+
+    MFW_PREFORK_T board;
+    if (!rpcPrefork::snapshot("vparpc", board))
+    {
+        std::cout << "No VPA RPC daemon is running" << std::endl;
+        return 1;
+    }
+    std::cout << "master " << board.pidMaster
+              << ", generation " << board.uGeneration
+              << ", " << board.u64Reloads << " reloads" << std::endl;
+    for (const MFW_PREFORK_SLOT_T& slot : board.slots)
+    {
+        if (0 == slot.pid)
+        {
+            continue;
+        }
+        std::cout << "  " << slot.pid
+                  << " gen " << slot.uGeneration << " "
+                  << pszStates[slot.uState % 5]
+                  << (slot.uRetire ? " (retiring)" : "")
+                  << ", " << slot.u64Connections << " connections"
+                  << ", " << slot.u64Requests << " requests" << std::endl;
+    }
+    return 0;
 }
 
 /**
  * The main function serves as the entry point of the program.
  * It performs the initialization and triggers execution.
  *
+ * Run by xinetd as a "wait = no" service, it answers the one connection
+ * on standard input and output and exits. As a "wait = yes" service,
+ * with --daemon, or re-executed by a reload, it becomes a pre-forked
+ * daemon instead. --status prints the daemon's scoreboard.
+ *
  * @return An integer value indicating the program's execution result.
  *         Typically, returning 0 indicates successful execution,
  *         while non-zero values represent errors.
  */
-int main()
+int main(int argc, char* argv[])
 {
     // Initialize the middleware framework
     auto* pMwFw = new mwfw2(__FILE__, __FUNCTION__);
@@ -445,9 +667,12 @@ int main()
 
     gpSysLog->loginfo(__PRETTY_FUNCTION__);
 
-
-    char buffer[BUFFER_SIZE];
-    ssize_t bytesRead;
+    if (argc > 1 && 0 == strcmp(argv[1], "--status"))
+    {
+        int iStatus = status();
+        delete pMwFw;
+        return iStatus;
+    }
 
     // Log server startup
     gbHere = true;
@@ -456,34 +681,16 @@ int main()
     gpSysLog->loginfo("*** VPA RPC inetd server started (version 5.5.10.2)");
     here;
 
-    // Read the RPC request from client (via inetd)
-    bytesRead = read(STDIN_FILENO, buffer, sizeof(vparpc_request_t));
-
-    if (bytesRead > 0)
+    if ((argc > 1 && 0 == strcmp(argv[1], "--daemon")) ||
+        rpcPrefork::is_listener(STDIN_FILENO))
     {
-        gpSysLog->loginfo("Received bytes from client");
-
-        // Process the RPC request (this modifies the buffer in-place)
-        process(buffer);
-
-        // Write the processed buffer back to client (via inetd)
-        // Make sure we write the exact same size we read
-        ssize_t bytesWritten = write(STDOUT_FILENO, buffer, bytesRead);
-
-        if (bytesWritten > 0)
-        {
-            gpSysLog->loginfo("Response sent: bytes");
-        }
-        else
-        {
-            gpSysLog->loginfo("Failed to send response");
-        }
-    }
-    else
-    {
-        gpSysLog->loginfo("Failed to read request from client");
+        int iStatus = run_daemon(argc, argv);
+        delete pMwFw;
+        return iStatus;
     }
 
+    serve(STDIN_FILENO, STDOUT_FILENO);
+
     // Log normal termination
     gpSysLog->loginfo("VPA RPC inetd server session completed");
 
@@ -300,7 +300,13 @@ int main(int argc, char** argv)
      * ## Operational Characteristics:
      * - **Blocking Operation**: This call does not return under normal operation
      * - **Infinite Loop**: Server runs continuously until terminated
-     * - **Sequential Processing**: Handles one client at a time
+     * - **Concurrent Processing**: An epoll reactor and one worker thread
+     *   per CPU (vparpc::server_pool); `--serial` selects the original
+     *   one-client-at-a-time loop, and `--uring` the io_uring reactor
+     *   (epoll is used instead where the kernel cannot support it);
+     *   `--unix` also serves local clients on the socket unix:vparpc,
+     *   where root, this user and CFG_VPARPC_UNIX_GROUP skip the PSK,
+     *   and `--shm` the shared-memory ring shm:vparpc
      * - **Real-time Monitoring**: Displays all client interactions visually
      * - **Automatic Restart**: Continues accepting new connections after each client
      * 
@@ -329,12 +335,48 @@ int main(int argc, char** argv)
      * 
      * @warning **Infinite Execution**: Under normal operation, this function call
      *          never returns, making any code after it unreachable
-     * @warning **Single-Threaded**: Server processes clients sequentially, which
-     *          may cause performance bottlenecks with multiple concurrent clients
+     * @warning **Single-Threaded** (`--serial` only): Server processes clients
+     *          sequentially, so one slow client stalls all the others
      * @warning **No Authentication**: Server accepts connections from any client
      *          without authentication or authorization checks
      */
-    gpVpaRpc->server("vparpc");
+    if (argc > 1 && 0 == strcmp(argv[1], "--serial"))
+    {
+        gpVpaRpc->server("vparpc");     // the original one-at-a-time loop
+    }
+    else if (argc > 1 && 0 == strcmp(argv[1], "--uring"))
+    {
+        gpVpaRpc->server_pool("vparpc", CFG_VPARPC_WORKERS,
+                              CFG_VPARPC_BACKLOG, RPC_BACKEND_URING);
+    }
+    else if (argc > 1 && 0 == strcmp(argv[1], "--unix"))
+    {
+        // Local clients may use CFG_VPARPC_UNIX_PREFIX "vparpc" as well.
+        std::thread local([] {
+            gpVpaRpc->server_pool(CFG_VPARPC_UNIX_PREFIX "vparpc");
+        });
+        gpVpaRpc->server_pool("vparpc");
+        local.join();
+    }
+    else if (argc > 1 && 0 == strcmp(argv[1], "--shm"))
+    {
+        // Local clients may use CFG_VPARPC_SHM_PREFIX "vparpc" as well,
+        // and fall back to CFG_VPARPC_UNIX_PREFIX "vparpc" when the ring
+        // cannot take a call.
+        std::thread local([] {
+            gpVpaRpc->server_pool(CFG_VPARPC_SHM_PREFIX "vparpc");
+        });
+        std::thread fallback([] {
+            gpVpaRpc->server_pool(CFG_VPARPC_UNIX_PREFIX "vparpc");
+        });
+        gpVpaRpc->server_pool("vparpc");
+        local.join();
+        fallback.join();
+    }
+    else
+    {
+        gpVpaRpc->server_pool("vparpc");
+    }
 
     // ========================================================================
     // UNREACHABLE CODE SECTION (NORMAL OPERATION)
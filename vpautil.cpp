@@ -53,12 +53,18 @@ int main(int argc, char** argv)
         }
         else if (strcmp(argv[1], "-h") == 0)
         {
-            std::cout << "Usage: vpautil [-v] [-h] [-l]" << std::endl;
+            std::cout << "Usage: vpautil [-v] [-h] [-l] [-i]" << std::endl;
         }
         else if (strcmp(argv[1], "-l") == 0)
         {
             system("rm -f /home/devo/public_html/fw/log/*.log");
         }
+        else if (strcmp(argv[1], "-i") == 0)
+        {
+            // Regenerate the RPC message types, codecs and stubs
+            rpcCompiler idl("vparpc-idl.csv", true);
+            return idl.ok() ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
         else if (strcmp(argv[1], "-p") == 0)
         {
             system(
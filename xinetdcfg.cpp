@@ -23,7 +23,10 @@ void xinetcfg::initializeDefaultServices()
 {
     vpaServices.clear();
 
-    // Main VPA Service (XML-RPC server)
+    // Main VPA Service (XML-RPC server). With "wait = yes" xinetd hands
+    // the listening socket to the first server it starts and leaves the
+    // connections to it: vparpc_inetd_server then runs as a pre-forked
+    // daemon rather than being started once per connection.
     XinetdServiceConfig vpaService;
     vpaService.serviceName = "vpa";
     vpaService.port = "5164";
@@ -32,8 +35,9 @@ void xinetcfg::initializeDefaultServices()
     vpaService.socketType = "stream";
     vpaService.protocol = "tcp";
     vpaService.user = "1000";
-    vpaService.wait = "no";
+    vpaService.wait = "yes";
     vpaService.server = "/home/devo/public_html/fw/bin/vparpc_inetd_server";
+    vpaService.serverArgs = "--daemon";
     vpaServices.push_back(vpaService);
 
     // VPA Discovery Daemon Start Service
@@ -165,6 +169,10 @@ std::string xinetcfg::formatServiceBlock(
     block << "\tuser = " << service.user << std::endl;
     block << "\twait = " << service.wait << std::endl;
     block << "\tserver = " << service.server << std::endl;
+    if (!service.serverArgs.empty())
+    {
+        block << "\tserver_args = " << service.serverArgs << std::endl;
+    }
     block << "}" << std::endl;
 
     return block.str();